@@ -48,6 +48,8 @@
 #include "core/module.h"
 #include "T3D/decal/decalData.h"
 #include "console/engineAPI.h"
+#include "collision/concretePolyList.h"
+#include "platform/threads/threadPool.h"
 
 
 extern bool gEditingMission;
@@ -83,6 +85,8 @@ F32       DecalManager::smDecalLifeTimeScale = 1.0f;
 bool      DecalManager::smPoolBuffers = true;
 const U32 DecalManager::smMaxVerts = 6000;
 const U32 DecalManager::smMaxIndices = 10000;
+bool      DecalManager::smAsyncClipping = true;
+S32       DecalManager::smMaxClipsPerFrame = 8;
 
 DecalManager *gDecalManager = NULL;
 
@@ -244,6 +248,17 @@ void DecalManager::consoleInit()
       "If false, will just clear them at the end of a frame.\n"
       "@ingroup Decals" );
 
+   Con::addVariable( "$Decals::asyncClipping", TypeBool, &smAsyncClipping,
+      "If true, decals are clipped against the scene on worker threads and show "
+      "a flat quad until their clipped geometry is ready.\n"
+      "If false, decals are clipped on the main thread when first rendered.\n"
+      "@ingroup Decals" );
+
+   Con::addVariable( "$Decals::maxClipsPerFrame", TypeS32, &smMaxClipsPerFrame,
+      "The maximum number of decals that will start clipping each frame when "
+      "$Decals::asyncClipping is enabled.  The rest wait for a later frame.\n"
+      "@ingroup Decals" );
+
    Con::addVariable( "$Decals::debugRender", TypeBool, &smDebugRender,
       "If true, the decal spheres will be visualized when in the editor.\n\n"
       "@ingroup Decals" );
@@ -288,23 +303,103 @@ bool DecalManager::_handleGFXEvent(GFXDevice::GFXDeviceEventType event)
    return true;
 }
 
-bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts, const Point2F *clipDepth )
+//-------------------------------------------------------------------------
+// DecalClipJob
+//-------------------------------------------------------------------------
+
+/// Clips a decal on a worker thread.
+///
+/// The scene geometry around the decal is gathered into a snapshot on the
+/// main thread, since the container and the objects are not thread safe.
+/// The job then clips the snapshot and builds the decal geometry into its
+/// own buffers, which the DecalManager copies to the decal once done.
+class DecalClipJob : public ThreadPool::WorkItem
 {
-   PROFILE_SCOPE( DecalManager_clipDecal );
+   public:
+
+      typedef ThreadPool::WorkItem Parent;
+
+      /// The decal to receive the results.  Only accessed on the main
+      /// thread and set to NULL if the job is cancelled.
+      DecalInstance *mDecal;
+
+      /// The unclipped scene geometry around the decal.
+      ConcretePolyList mGeometry;
+
+      ClippedPolyList mClipper;
+      MatrixF mProjMat;
+      F32 mHalfSize;
+      RectF mTexRect;
+      bool mGenerateNormals;
+
+      Vector<DecalVertex> mVerts;
+      Vector<U16> mIndices;
+      bool mSucceeded;
+
+      DecalClipJob( DecalInstance *decal )
+         : mDecal( decal ),
+           mHalfSize( decal->mSize * 0.5f ),
+           mTexRect( decal->mDataBlock->texRect[decal->mTextureRectIdx] ),
+           mGenerateNormals( !decal->mDataBlock->skipVertexNormals ),
+           mSucceeded( false ),
+           mFinished( 0 )
+      {
+      }
 
-   // Free old verts and indices.
-   _freeBuffers( decal );
+      bool isFinished() { return dAtomicRead( mFinished ) != 0; }
+
+   protected:
+
+      volatile U32 mFinished;
+
+      void execute() override
+      {
+         // Feed the snapshot through the clipper as the scene objects
+         // would have during buildPolyList.
+         for ( U32 i = 0; i < mGeometry.mVertexList.size(); i++ )
+            mClipper.addPoint( mGeometry.mVertexList[i] );
+
+         for ( U32 i = 0; i < mGeometry.mPolyList.size(); i++ )
+         {
+            const ConcretePolyList::Poly &poly = mGeometry.mPolyList[i];
+
+            mClipper.begin( poly.material, poly.surfaceKey );
+            for ( U32 j = 0; j < poly.vertexCount; j++ )
+               mClipper.vertex( mGeometry.mIndexList[poly.vertexStart + j] );
+            mClipper.plane( poly.plane );
+            mClipper.end();
+         }
 
+         if ( DecalManager::_finishClipper( &mClipper, mGenerateNormals ) )
+         {
+            mVerts.setSize( mClipper.mVertexList.size() );
+            mIndices.setSize( mClipper.mIndexList.size() );
+            DecalManager::_generateGeometry( mClipper, mProjMat, mHalfSize, mTexRect, mVerts.address(), mIndices.address() );
+            mSucceeded = true;
+         }
+
+         dCompareAndSwap( mFinished, 0, 1 );
+      }
+
+      void onCancelled() override
+      {
+         mSucceeded = false;
+         dCompareAndSwap( mFinished, 0, 1 );
+      }
+};
+
+void DecalManager::_setupClipper( const DecalInstance *decal, const Point2F *clipDepth, ClippedPolyList *clipper, MatrixF *outProjMat, Box3F *outBox )
+{
    F32 halfSize = decal->mSize * 0.5f;
    
    // Ugly hack for ProjectedShadow!
    F32 halfSizeZ = clipDepth ? clipDepth->x : halfSize;
    F32 negHalfSize = clipDepth ? clipDepth->y : halfSize;
-   Point3F decalHalfSize( halfSize, halfSize, halfSize );
    Point3F decalHalfSizeZ( halfSizeZ, halfSizeZ, halfSizeZ );
 
-   MatrixF projMat( true );
-   decal->getWorldMatrix( &projMat );
+   MatrixF &projMat = *outProjMat;
+   projMat.identity();
+   const_cast<DecalInstance*>( decal )->getWorldMatrix( &projMat );
 
    const VectorF &crossVec = decal->mNormal;
    const Point3F &decalPos = decal->mPosition;
@@ -313,39 +408,34 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    projMat.getColumn( 0, &newRight );
    projMat.getColumn( 1, &newFwd );   
 
-   VectorF objRight( 1.0f, 0, 0 );
-   VectorF objFwd( 0, 1.0f, 0 );
-   VectorF objUp( 0, 0, 1.0f );
-
    // See above re: decalHalfSizeZ hack.
-   mClipper.clear();
-   mClipper.mPlaneList.setSize(6);
-   mClipper.mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
-   mClipper.mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
-   mClipper.mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
-   mClipper.mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
-   mClipper.mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
-   mClipper.mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
+   clipper->clear();
+   clipper->mPlaneList.setSize(6);
+   clipper->mPlaneList[0].set( ( decalPos + ( -newRight * halfSize ) ), -newRight );
+   clipper->mPlaneList[1].set( ( decalPos + ( -newFwd * halfSize ) ), -newFwd );
+   clipper->mPlaneList[2].set( ( decalPos + ( -crossVec * decalHalfSizeZ ) ), -crossVec );
+   clipper->mPlaneList[3].set( ( decalPos + ( newRight * halfSize ) ), newRight );
+   clipper->mPlaneList[4].set( ( decalPos + ( newFwd * halfSize ) ), newFwd );
+   clipper->mPlaneList[5].set( ( decalPos + ( crossVec * negHalfSize ) ), crossVec );
 
-   mClipper.mNormal = decal->mNormal;
+   clipper->mNormal = decal->mNormal;
 
    const DecalData *decalData = decal->mDataBlock;
 
-   mClipper.mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
+   clipper->mNormalTolCosineRadians = mCos( mDegToRad( decalData->clippingAngle ) );
 
-   Box3F box( -decalHalfSizeZ, decalHalfSizeZ );
+   *outBox = Box3F( -decalHalfSizeZ, decalHalfSizeZ );
 
-   projMat.mul( box );
-
-   PROFILE_START( DecalManager_clipDecal_buildPolyList );
-   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, &mClipper );   
-   PROFILE_END();
+   projMat.mul( *outBox );
+}
 
-   mClipper.cullUnusedVerts();
-   mClipper.triangulate();
+bool DecalManager::_finishClipper( ClippedPolyList *clipper, bool generateNormals )
+{
+   clipper->cullUnusedVerts();
+   clipper->triangulate();
    
-   const U32 numVerts = mClipper.mVertexList.size();
-   const U32 numIndices = mClipper.mIndexList.size();
+   const U32 numVerts = clipper->mVertexList.size();
+   const U32 numIndices = clipper->mIndexList.size();
 
    if ( !numVerts || !numIndices )
       return false;
@@ -356,17 +446,19 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
         numIndices > smMaxIndices )
       return false;
 
-   if ( !decalData->skipVertexNormals )
-      mClipper.generateNormals();
-   
-#ifdef DECALMANAGER_DEBUG
-   mDebugPlanes.clear();
-   mDebugPlanes.merge( mClipper.mPlaneList );
-#endif
+   if ( generateNormals )
+      clipper->generateNormals();
+
+   return true;
+}
+
+void DecalManager::_generateGeometry( const ClippedPolyList &clipper, const MatrixF &projMat, F32 halfSize, const RectF &texRect, DecalVertex *outVerts, U16 *outIndices )
+{
+   Point3F decalHalfSize( halfSize, halfSize, halfSize );
+
+   VectorF objRight( 1.0f, 0, 0 );
+   VectorF objFwd( 0, 1.0f, 0 );
 
-   decal->mVertCount = numVerts;
-   decal->mIndxCount = numIndices;
-   
    Vector<Point3F> tmpPoints;
 
    tmpPoints.push_back(( objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
@@ -375,7 +467,8 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    
    Point3F lowerLeft(( -objFwd * decalHalfSize ) + ( objRight * decalHalfSize ));
 
-   projMat.inverse();
+   MatrixF worldToDecal( projMat );
+   worldToDecal.inverse();
 
    _generateWindingOrder( lowerLeft, &tmpPoints );
 
@@ -386,25 +479,17 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
 
    Point2F uv( 0, 0 );
    Point3F vecX(0.0f, 0.0f, 0.0f);
-
-   // Allocate memory for vert and index arrays
-   _allocBuffers( decal );  
-
-   // Mark this so that the color will be assigned on these verts the next
-   // time it renders, since we just threw away the previous verts.
-   decal->mLastAlpha = -1;
-   
    Point3F vertPoint( 0, 0, 0 );
 
-   for ( U32 i = 0; i < mClipper.mVertexList.size(); i++ )
+   for ( U32 i = 0; i < clipper.mVertexList.size(); i++ )
    {
-      const ClippedPolyList::Vertex &vert = mClipper.mVertexList[i];
+      const ClippedPolyList::Vertex &vert = clipper.mVertexList[i];
       vertPoint = vert.point;
 
       // Transform this point to
       // object space to look up the
       // UV coordinate for this vertex.
-      projMat.mulP( vertPoint );
+      worldToDecal.mulP( vertPoint );
 
       // Clamp the point to be within the quad.
       vertPoint.x = mClampF( vertPoint.x, -decalHalfSize.x, decalHalfSize.x );
@@ -413,51 +498,92 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
       // Get our UV.
       uv = quadToSquare.transform( Point2F( vertPoint.x, vertPoint.y ) );
 
-      const RectF &rect = decal->mDataBlock->texRect[decal->mTextureRectIdx];
-
-      uv *= rect.extent;
-      uv += rect.point;      
+      uv *= texRect.extent;
+      uv += texRect.point;      
 
       // Set the world space vertex position.
-      decal->mVerts[i].point = vert.point;
+      outVerts[i].point = vert.point;
       
-      decal->mVerts[i].texCoord.set( uv.x, uv.y );
+      outVerts[i].texCoord.set( uv.x, uv.y );
       
-      if ( mClipper.mNormalList.empty() )
+      if ( clipper.mNormalList.empty() )
          continue;
 
-      decal->mVerts[i].normal = mClipper.mNormalList[i];
-      decal->mVerts[i].normal.normalize();
+      outVerts[i].normal = clipper.mNormalList[i];
+      outVerts[i].normal.normalize();
 
-      if( mFabs( decal->mVerts[i].normal.z ) > 0.8f ) 
-         mCross( decal->mVerts[i].normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.x ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
-      else if ( mFabs( decal->mVerts[i].normal.y ) > 0.8f )
-         mCross( decal->mVerts[i].normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
+      if( mFabs( outVerts[i].normal.z ) > 0.8f ) 
+         mCross( outVerts[i].normal, Point3F( 1.0f, 0.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVerts[i].normal.x ) > 0.8f )
+         mCross( outVerts[i].normal, Point3F( 0.0f, 1.0f, 0.0f ), &vecX );
+      else if ( mFabs( outVerts[i].normal.y ) > 0.8f )
+         mCross( outVerts[i].normal, Point3F( 0.0f, 0.0f, 1.0f ), &vecX );
    
-      decal->mVerts[i].tangent = mCross( decal->mVerts[i].normal, vecX );
+      outVerts[i].tangent = mCross( outVerts[i].normal, vecX );
    }
 
    U32 curIdx = 0;
-   for ( U32 j = 0; j < mClipper.mPolyList.size(); j++ )
+   for ( U32 j = 0; j < clipper.mPolyList.size(); j++ )
    {
       // Write indices for each Poly
-      ClippedPolyList::Poly *poly = &mClipper.mPolyList[j];                  
+      const ClippedPolyList::Poly *poly = &clipper.mPolyList[j];                  
 
       AssertFatal( poly->vertexCount == 3, "Got non-triangle poly!" );
 
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart];         
+      outIndices[curIdx] = clipper.mIndexList[poly->vertexStart];         
       curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 1];            
+      outIndices[curIdx] = clipper.mIndexList[poly->vertexStart + 1];            
       curIdx++;
-      decal->mIndices[curIdx] = mClipper.mIndexList[poly->vertexStart + 2];                
+      outIndices[curIdx] = clipper.mIndexList[poly->vertexStart + 2];                
       curIdx++;
    } 
+}
+
+bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts, const Point2F *clipDepth )
+{
+   PROFILE_SCOPE( DecalManager_clipDecal );
+
+   // Clipping synchronously supersedes any threaded clip in flight.
+   _cancelClipJob( decal );
+
+   // Free old verts and indices.
+   _freeBuffers( decal );
+
+   MatrixF projMat( true );
+   Box3F box;
+   _setupClipper( decal, clipDepth, &mClipper, &projMat, &box );
+
+   const DecalData *decalData = decal->mDataBlock;
+
+   PROFILE_START( DecalManager_clipDecal_buildPolyList );
+   getContainer()->buildPolyList( PLC_Decal, box, decalData->clippingMasks, &mClipper );   
+   PROFILE_END();
+
+   if ( !_finishClipper( &mClipper, !decalData->skipVertexNormals ) )
+      return false;
+   
+#ifdef DECALMANAGER_DEBUG
+   mDebugPlanes.clear();
+   mDebugPlanes.merge( mClipper.mPlaneList );
+#endif
+
+   decal->mVertCount = mClipper.mVertexList.size();
+   decal->mIndxCount = mClipper.mIndexList.size();
+
+   // Allocate memory for vert and index arrays
+   _allocBuffers( decal );  
+
+   // Mark this so that the color will be assigned on these verts the next
+   // time it renders, since we just threw away the previous verts.
+   decal->mLastAlpha = -1;
+
+   _generateGeometry( mClipper, projMat, decal->mSize * 0.5f, decalData->texRect[decal->mTextureRectIdx], decal->mVerts, decal->mIndices );
 
    if ( !edgeVerts )
       return true;
 
+   projMat.inverse();
+
    Point3F tmpHullPt( 0, 0, 0 );
    Vector<Point3F> tmpHullPts;
 
@@ -480,6 +606,125 @@ bool DecalManager::clipDecal( DecalInstance *decal, Vector<Point3F> *edgeVerts,
    return true;
 }
 
+void DecalManager::_queueClipJob( DecalInstance *decal )
+{
+   PROFILE_SCOPE( DecalManager_queueClipJob );
+
+   _cancelClipJob( decal );
+
+   ThreadSafeRef< DecalClipJob > job( new DecalClipJob( decal ) );
+
+   Box3F box;
+   _setupClipper( decal, NULL, &job->mClipper, &job->mProjMat, &box );
+
+   // Gathering the geometry has to happen here on the main thread.  The
+   // clipping itself, which is the expensive part, is left to the job.
+   PROFILE_START( DecalManager_queueClipJob_buildPolyList );
+   getContainer()->buildPolyList( PLC_Decal, box, decal->mDataBlock->clippingMasks, &job->mGeometry );
+   PROFILE_END();
+
+   mClipJobs.push_back( job );
+   ThreadPool::GLOBAL().queueWorkItem( job );
+}
+
+void DecalManager::_commitClipJobs()
+{
+   PROFILE_SCOPE( DecalManager_commitClipJobs );
+
+   for ( U32 i = 0; i < mClipJobs.size(); i++ )
+   {
+      DecalClipJob *job = mClipJobs[i];
+      if ( !job->isFinished() )
+         continue;
+
+      DecalInstance *decal = job->mDecal;
+      if ( decal )
+      {
+         // Drop the fallback quad.
+         _freeBuffers( decal );
+
+         if ( job->mSucceeded )
+         {
+            decal->mVertCount = job->mVerts.size();
+            decal->mIndxCount = job->mIndices.size();
+            _allocBuffers( decal );
+            decal->mLastAlpha = -1;
+
+            dMemcpy( decal->mVerts, job->mVerts.address(), sizeof( DecalVertex ) * decal->mVertCount );
+            dMemcpy( decal->mIndices, job->mIndices.address(), sizeof( U16 ) * decal->mIndxCount );
+         }
+         else if ( !( decal->mFlags & SaveDecal ) )
+         {
+            // As with synchronous clipping, a decal placed at run-time
+            // that got no geometry is deleted.  Editor placed decals are
+            // left without geometry until they are modified again.
+            mClipJobs.erase_fast( i-- );
+            removeDecal( decal );
+            continue;
+         }
+      }
+
+      mClipJobs.erase_fast( i-- );
+   }
+}
+
+void DecalManager::_cancelClipJob( DecalInstance *decal )
+{
+   for ( U32 i = 0; i < mClipJobs.size(); i++ )
+   {
+      if ( mClipJobs[i]->mDecal == decal )
+      {
+         // The job may still be running so it is left to finish and is
+         // only discarded here.
+         mClipJobs[i]->mDecal = NULL;
+         mClipJobs.erase_fast( i );
+         return;
+      }
+   }
+}
+
+void DecalManager::_buildFallbackGeometry( DecalInstance *decal )
+{
+   if ( decal->mVerts )
+      return;
+
+   MatrixF projMat( true );
+   decal->getWorldMatrix( &projMat );
+
+   const F32 halfSize = decal->mSize * 0.5f;
+   const Point3F corners[4] =
+   {
+      Point3F( -halfSize, -halfSize, 0.0f ),
+      Point3F(  halfSize, -halfSize, 0.0f ),
+      Point3F(  halfSize,  halfSize, 0.0f ),
+      Point3F( -halfSize,  halfSize, 0.0f ),
+   };
+
+   // Run a single quad through the normal geometry path so the UVs and
+   // tangents match what the clipped geometry will get.
+   ClippedPolyList quad;
+   quad.mNormal = decal->mNormal;
+   quad.begin( NULL, 0 );
+   for ( U32 i = 0; i < 4; i++ )
+   {
+      Point3F corner( corners[i] );
+      projMat.mulP( corner );
+      quad.vertex( quad.addPoint( corner ) );
+   }
+   quad.plane( PlaneF( decal->mPosition, decal->mNormal ) );
+   quad.end();
+
+   if ( !_finishClipper( &quad, true ) )
+      return;
+
+   decal->mVertCount = quad.mVertexList.size();
+   decal->mIndxCount = quad.mIndexList.size();
+   _allocBuffers( decal );
+   decal->mLastAlpha = -1;
+
+   _generateGeometry( quad, projMat, halfSize, decal->mDataBlock->texRect[decal->mTextureRectIdx], decal->mVerts, decal->mIndices );
+}
+
 DecalInstance* DecalManager::addDecal( const Point3F &pos,
                                        const Point3F &normal,
                                        F32 rotAroundNormal,
@@ -534,6 +779,7 @@ void DecalManager::removeDecal( DecalInstance *inst )
    
    // Release its geometry (if it has any).
 
+   _cancelClipJob( inst );
    _freeBuffers( inst );
    
    // Remove it from the decal file.
@@ -957,6 +1203,10 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    if ( !state->isDiffusePass() )
       return;
 
+   // Pick up the geometry of decals clipped on the thread pool.
+   if ( !mClipJobs.empty() )
+      _commitClipJobs();
+
    PROFILE_START( DecalManager_RenderDecals_SphereTreeCull );
 
    const Frustum& rootFrustum = state->getCameraFrustum();
@@ -1014,6 +1264,7 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
    U32 delta, diff;
    DecalInstance *dinst;
    DecalData *ddata;
+   S32 clipsStarted = 0;
 
    // Loop through DecalQueue once for preRendering work.
    // 1. Update DecalInstance fade (over time)
@@ -1058,7 +1309,21 @@ void DecalManager::prepRenderImage( SceneRenderState* state )
       }
 
       // Build clipped geometry for this decal if needed.
-      if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) )
+      if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) && smAsyncClipping )
+      {
+         // Start clipping on the thread pool if this frame's budget allows,
+         // otherwise leave the flag set to try again next frame.
+         if ( clipsStarted < smMaxClipsPerFrame )
+         {
+            dinst->mFlags = dinst->mFlags & ~ClipDecal;
+            _queueClipJob( dinst );
+            clipsStarted++;
+         }
+
+         // Render a flat quad until the clipped geometry is ready.
+         _buildFallbackGeometry( dinst );
+      }
+      else if ( dinst->mFlags & ClipDecal && !( dinst->mFlags & CustomDecal ) )
       {  
          // Turn off the flag so we don't continually try to clip
          // if it fails.
@@ -1516,6 +1781,11 @@ bool DecalManager::loadDecals( const UTF8 *fileName )
 void DecalManager::clearData()
 {
    mClearDataSignal.trigger();
+
+   // Let any clipping jobs in flight finish on their own.
+   for( U32 i = 0; i < mClipJobs.size(); ++ i )
+      mClipJobs[ i ]->mDecal = NULL;
+   mClipJobs.clear();
    
    // Free all geometry buffers.
    
@@ -59,6 +59,10 @@
 #include "core/util/tSignal.h"
 #endif
 
+#ifndef _THREADSAFEREFCOUNT_H_
+#include "platform/threads/threadSafeRefCount.h"
+#endif
+
 #ifndef _DATACHUNKER_H_
 #include "core/dataChunker.h"
 #endif
@@ -69,6 +73,7 @@
 
 struct ObjectRenderInst;
 class Material;
+class DecalClipJob;
 
 
 enum DecalFlags 
@@ -92,6 +97,8 @@ class DecalManager : public SceneObject
       Vector<DecalInstance *> mDecalInstanceVec;
 
    protected:
+
+      friend class DecalClipJob;
       
       /// The clipper we keep around between decal updates
       /// to avoid excessive memory allocations.
@@ -116,6 +123,10 @@ class DecalManager : public SceneObject
       Vector<PlaneF> mDebugPlanes;
       #endif
 
+      /// Clipping jobs queued on the thread pool whose results have not
+      /// been committed to their decals yet.
+      Vector< ThreadSafeRef< DecalClipJob > > mClipJobs;
+
       bool mDirty;
 
       struct DecalBatch
@@ -139,6 +150,14 @@ class DecalManager : public SceneObject
       static const U32 smMaxVerts;
       static const U32 smMaxIndices;
 
+      /// If true, decals flagged for clipping during rendering are clipped
+      /// on the thread pool against a snapshot of the scene geometry.
+      static bool smAsyncClipping;
+
+      /// The maximum number of decals to start clipping each frame when
+      /// clipping asynchronously.
+      static S32 smMaxClipsPerFrame;
+
       // Assume that a class is already given for the object:
       //    Point with coordinates {float x, y;}
       //===================================================================
@@ -159,7 +178,38 @@ class DecalManager : public SceneObject
       // Rendering
       void prepRenderImage( SceneRenderState *state ) override;
       
-      void _generateWindingOrder( const Point3F &cornerPoint, Vector<Point3F> *sortPoints );
+      static void _generateWindingOrder( const Point3F &cornerPoint, Vector<Point3F> *sortPoints );
+
+      /// @name Clipping
+      /// These helpers are shared by the synchronous and the threaded
+      /// clipping paths and must not touch any manager state.
+      /// @{
+
+      /// Sets up the clipping planes for a decal and returns its
+      /// projection matrix and world space clipping box.
+      static void _setupClipper( const DecalInstance *decal, const Point2F *clipDepth, ClippedPolyList *clipper, MatrixF *outProjMat, Box3F *outBox );
+
+      /// Triangulates the clipped geometry and checks it against the
+      /// buffer limits.  Returns false if there is nothing to render.
+      static bool _finishClipper( ClippedPolyList *clipper, bool generateNormals );
+
+      /// Writes the decal vertices and indices for the clipped geometry.
+      static void _generateGeometry( const ClippedPolyList &clipper, const MatrixF &projMat, F32 halfSize, const RectF &texRect, DecalVertex *outVerts, U16 *outIndices );
+
+      /// Queues a threaded clip of the decal.
+      void _queueClipJob( DecalInstance *decal );
+
+      /// Copies the results of finished clipping jobs to their decals.
+      void _commitClipJobs();
+
+      /// Drops the pending clipping job of the decal, if any.
+      void _cancelClipJob( DecalInstance *decal );
+
+      /// Gives a decal waiting for its clipped geometry a flat quad to
+      /// render in the meantime.
+      void _buildFallbackGeometry( DecalInstance *decal );
+
+      /// @}
 
       // Helpers for creating and deleting the vert and index arrays
       // held by DecalInstance.
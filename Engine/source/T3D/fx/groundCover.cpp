@@ -24,6 +24,7 @@
 #include "T3D/fx/groundCover.h"
 
 #include "core/resourceManager.h"
+#include "core/frameAllocator.h"
 #include "core/stream/bitStream.h"
 #include "console/consoleTypes.h"
 #include "scene/sceneRenderState.h"
@@ -134,6 +135,10 @@ protected:
    /// The instances of shape cover elements in this cell.
    Vector<Placement> mShapes;
 
+   /// The world boxes of mShapes in a form that can be
+   /// frustum culled in a single batch.
+   Box3FBatch mShapeBoxes;
+
    typedef GFXVertexBufferHandle<GCVertex> VBHandle;
    typedef Vector< VBHandle > VBHandleVector;
 
@@ -303,14 +308,18 @@ U32 GroundCoverCell::renderShapes(  const TSRenderState &rdata,
 
    U32 totalRendered = 0;
 
-   Vector<Placement>::const_iterator iter = mShapes.begin();
-   for ( ; iter != mShapes.end(); iter++ )
+   // If we were passed a culler then test all the shape
+   // world boxes against it up front in one batch.
+   FrameTemp<S8> cullResults( culler ? mShapes.size() : 0 );
+   if ( culler )
+      culler->testPotentialIntersectionBatch( mShapeBoxes, cullResults );
+
+   for ( U32 i = 0; i < mShapes.size(); i++ )
    {
       // Grab a reference here once.
-      const Placement& inst = (*iter);
+      const Placement& inst = mShapes[i];
 
-      // If we were pass a culler then us it to test the shape world box.
-      if ( culler && culler->isCulled( inst.worldBox ) )
+      if ( culler && cullResults[i] == GeometryOutside )
          continue;
 
       shape = shapes[ inst.type ];
@@ -1102,6 +1111,8 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
    cell->mBillboards.reserve( placementCount );
    cell->mShapes.clear();
    cell->mShapes.reserve( placementCount );
+   cell->mShapeBoxes.clear();
+   cell->mShapeBoxes.reserve( placementCount );
 
    F32   terrainSquareSize, 
          oneOverTerrainLength, 
@@ -1342,6 +1353,7 @@ GroundCoverCell* GroundCover::_generateCell( const Point2I& index,
             p.worldBox.maxExtents += point;
 
             cell->mShapes.push_back( p );
+            cell->mShapeBoxes.push_back( p.worldBox );
          }
          else
          {
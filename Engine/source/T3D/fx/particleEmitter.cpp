@@ -42,6 +42,9 @@
 #include "T3D/gameBase/gameProcess.h"
 #include "lighting/lightInfo.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
+#include "platform/platformTimer.h"
 
 #if defined(AFX_CAP_PARTICLE_POOLS) 
 #include "afx/util/afxParticlePool.h"
@@ -50,6 +53,10 @@
 Point3F ParticleEmitter::mWindVelocity( 0.0, 0.0, 0.0 );
 const F32 ParticleEmitter::AgedSpinToRadians = (1.0f/1000.0f) * (1.0f/360.0f) * M_PI_F * 2.0f;
 
+bool ParticleEmitter::smParallelUpdate = true;
+S32 ParticleEmitter::smParallelBatchSize = 32;
+Vector<ParticleEmitter*> ParticleEmitter::smPendingUpdates(__FILE__, __LINE__);
+
 IMPLEMENT_CO_DATABLOCK_V1(ParticleEmitterData);
 IMPLEMENT_CONOBJECT(ParticleEmitter);
 
@@ -986,12 +993,15 @@ ParticleEmitter::ParticleEmitter()
    mLifetimeMS = 0;
    mElapsedTimeMS = 0;
 
-   part_store = 0;
-   part_freelist = NULL;
    part_list_head.next = NULL;
    n_part_capacity = 0;
    n_parts = 0;
 
+   mPendingUpdateMS = 0;
+   mPendingUpdateParts = 0;
+   mQueuedForUpdate = false;
+   mBBoxQueued = false;
+
    mThetaOld = 0;
    mPhiOld = 0;
 
@@ -1019,10 +1029,8 @@ ParticleEmitter::ParticleEmitter()
 //-----------------------------------------------------------------------------
 ParticleEmitter::~ParticleEmitter()
 {
-   for( S32 i = 0; i < part_store.size(); i++ )
-   {
-      delete [] part_store[i];
-   }
+   cancelPendingUpdate();
+
    if (db_temp_clone && mDataBlock && mDataBlock->isTempClone())
    {
      for (S32 i = 0; i < mDataBlock->particleDataBlocks.size(); i++)
@@ -1038,6 +1046,23 @@ ParticleEmitter::~ParticleEmitter()
    }
 }
 
+//-----------------------------------------------------------------------------
+// consoleInit
+//-----------------------------------------------------------------------------
+void ParticleEmitter::consoleInit()
+{
+   Parent::consoleInit();
+
+   Con::addVariable( "$pref::Particles::parallelUpdate", TypeBool, &smParallelUpdate,
+      "If true, particle emitters integrate their particles on the global thread pool "
+      "once per frame instead of one by one while the process list advances.\n"
+      "@ingroup FX" );
+   Con::addVariable( "$pref::Particles::parallelBatchSize", TypeS32, &smParallelBatchSize,
+      "The number of particle emitters simulated by each worker job when "
+      "$pref::Particles::parallelUpdate is enabled.\n"
+      "@ingroup FX" );
+}
+
 //-----------------------------------------------------------------------------
 // onAdd
 //-----------------------------------------------------------------------------
@@ -1082,6 +1107,7 @@ void ParticleEmitter::onRemove()
   }
 #endif
 
+   cancelPendingUpdate();
    removeFromScene();
    Parent::onRemove();
 }
@@ -1102,28 +1128,15 @@ bool ParticleEmitter::onNewDataBlock( GameBaseData *dptr, bool reload )
       mLifetimeMS += S32( gRandGen.randI() % (2 * mDataBlock->lifetimeVarianceMS + 1)) - S32(mDataBlock->lifetimeVarianceMS );
    }
 
-   //   Allocate particle structures and init the freelist. Member part_store
-   //   is a Vector so that we can allocate more particles if partListInitSize
-   //   turns out to be too small. 
+   //   Allocate the particle pool. Member part_store is a Vector so that we
+   //   can allocate more particles if partListInitSize turns out to be too
+   //   small.
    //
    if (mDataBlock->partListInitSize > 0)
    {
-      for( S32 i = 0; i < part_store.size(); i++ )
-      {
-         delete [] part_store[i];
-      }
-      part_store.clear();
+      cancelPendingUpdate();
       n_part_capacity = mDataBlock->partListInitSize;
-      Particle* store_block = new Particle[n_part_capacity];
-      part_store.push_back(store_block);
-      part_freelist = store_block;
-      Particle* last_part = part_freelist;
-      Particle* part = last_part+1;
-      for( S32 i = 1; i < n_part_capacity; i++, part++, last_part++ )
-      {
-         last_part->next = part;
-      }
-      store_block[n_part_capacity-1].next = NULL;
+      part_store.setSize(n_part_capacity);
       part_list_head.next = NULL;
       n_parts = 0;
    }
@@ -1142,11 +1155,14 @@ bool ParticleEmitter::onNewDataBlock( GameBaseData *dptr, bool reload )
 //-----------------------------------------------------------------------------
 LinearColorF ParticleEmitter::getCollectiveColor()
 {
+   runPendingUpdate();
+
 	U32 count = 0;
 	LinearColorF color = LinearColorF(0.0f, 0.0f, 0.0f);
 
    count = n_parts;
-   for( Particle* part = part_list_head.next; part != NULL; part = part->next )
+   const Particle* part = part_store.address();
+   for( S32 i = 0; i < n_parts; i++, part++ )
    {
       color += part->color;
    }
@@ -1182,6 +1198,9 @@ void ParticleEmitter::prepRenderImage(SceneRenderState* state)
 
    PROFILE_SCOPE(ParticleEmitter_prepRenderImage);
 
+   // Finish the simulation of every emitter advanced this frame.
+   flushPendingUpdates();
+
    if (  mDead ||
          n_parts == 0 || 
          part_list_head.next == NULL )
@@ -1422,10 +1441,7 @@ void ParticleEmitter::emitParticles(const Point3F& start,
          Particle* last_part = part_list_head.next;
          if (advanceMS > last_part->totalLifetime) 
          {
-           part_list_head.next = last_part->next;
-           n_parts--;
-           last_part->next = part_freelist;
-           part_freelist = last_part;
+           freeNewestParticle();
          } 
          else 
          {
@@ -1459,7 +1475,17 @@ void ParticleEmitter::emitParticles(const Point3F& start,
 
    // DMMFIX: Lame and slow...
    if( particlesAdded == true )
-      updateBBox();
+   {
+      // The particles that were already alive haven't been moved by the
+      // queued update yet, so the box is fitted once they have.
+      if ( mPendingUpdateMS != 0 )
+         mBBoxQueued = true;
+      else
+      {
+         mBBoxQueued = false;
+         updateBBox();
+      }
+   }
 
 
    if( n_parts > 0 && getSceneManager() == NULL )
@@ -1548,18 +1574,30 @@ void ParticleEmitter::updateBBox()
 {
    if (forced_bbox)
      return;
+
+   fitBBox(computeBBox());
+}
+
+Box3F ParticleEmitter::computeBBox() const
+{
    Point3F minPt(1e10,   1e10,  1e10);
    Point3F maxPt(-1e10, -1e10, -1e10);
 
-   for (Particle* part = part_list_head.next; part != NULL; part = part->next)
+   const Particle* part = part_store.address();
+   for (S32 i = 0; i < n_parts; i++, part++)
    {
       Point3F particleSize(part->size * 0.5f);
       F32 motion = getMax((part->vel.len() * part->totalLifetime / 1000.0f), 1.0f);
       minPt.setMin(part->pos - particleSize - Point3F(motion));
       maxPt.setMax(part->pos + particleSize + Point3F(motion));
    }
-   
-   mObjBox = Box3F(minPt, maxPt);
+
+   return Box3F(minPt, maxPt);
+}
+
+void ParticleEmitter::fitBBox( const Box3F &box )
+{
+   mObjBox = box;
    MatrixF temp = getTransform();
    setTransform(temp);
 
@@ -1577,31 +1615,66 @@ void ParticleEmitter::updateBBox()
 }
 
 //-----------------------------------------------------------------------------
-// addParticle
+// allocParticle
 //-----------------------------------------------------------------------------
-void ParticleEmitter::addParticle(const Point3F& pos, const Point3F& axis, const Point3F& vel,
-                                  const Point3F& axisx, const U32 age_offset)
+Particle* ParticleEmitter::allocParticle()
 {
-   n_parts++;
-   if (n_parts > n_part_capacity || n_parts > mDataBlock->partListInitSize)
-   {
-      // In an emergency we allocate additional particles in blocks of 16.
-      // This should happen rarely.
-      Particle* store_block = new Particle[16];
-      part_store.push_back(store_block);
-      n_part_capacity += 16;
-      for (S32 i = 0; i < 16; i++)
-      {
-        store_block[i].next = part_freelist;
-        part_freelist = &store_block[i];
-      }
-      mDataBlock->allocPrimBuffer(n_part_capacity); // allocate larger primitive buffer or will crash 
+   if (n_parts >= n_part_capacity)
+   {
+      // In an emergency we grow the pool. This should happen rarely, but as
+      // the pool is a single block we grow it geometrically to bound the
+      // number of copies.
+      n_part_capacity += getMax(16, n_part_capacity / 2);
+      part_store.setSize(n_part_capacity);
+      relinkParticles();
    }
-   Particle* pNew = part_freelist;
-   part_freelist = pNew->next;
+   if (n_parts >= (S32)mDataBlock->partListInitSize)
+      mDataBlock->allocPrimBuffer(n_part_capacity); // allocate larger primitive buffer or will crash 
+
+   Particle* pNew = &part_store[n_parts++];
    pNew->next = part_list_head.next;
    part_list_head.next = pNew;
 
+   return pNew;
+}
+
+//-----------------------------------------------------------------------------
+// freeNewestParticle
+//-----------------------------------------------------------------------------
+void ParticleEmitter::freeNewestParticle()
+{
+   AssertFatal(n_parts > 0, "ParticleEmitter::freeNewestParticle - no particles to free!");
+
+   n_parts--;
+   part_list_head.next = (n_parts > 0) ? &part_store[n_parts - 1] : NULL;
+}
+
+//-----------------------------------------------------------------------------
+// relinkParticles
+//-----------------------------------------------------------------------------
+void ParticleEmitter::relinkParticles()
+{
+   if (n_parts == 0)
+   {
+      part_list_head.next = NULL;
+      return;
+   }
+
+   Particle* store = part_store.address();
+   store[0].next = NULL;
+   for (S32 i = 1; i < n_parts; i++)
+      store[i].next = &store[i - 1];
+   part_list_head.next = &store[n_parts - 1];
+}
+
+//-----------------------------------------------------------------------------
+// addParticle
+//-----------------------------------------------------------------------------
+void ParticleEmitter::addParticle(const Point3F& pos, const Point3F& axis, const Point3F& vel,
+                                  const Point3F& axisx, const U32 age_offset)
+{
+   Particle* pNew = allocParticle();
+
    // for earlier access to constrain_pos, the ParticleData datablock is chosen here instead
    // of later in the method.
    U32 dBlockIndex = gRandGen.randI() % mDataBlock->particleDataBlocks.size();
@@ -1713,26 +1786,30 @@ void ParticleEmitter::advanceTime(F32 dt)
    U32 numMSToUpdate = (U32)(dt * 1000.0f);
    if( numMSToUpdate == 0 ) return;
 
-   // TODO: Prefetch
+   // an update queued by a previous advance that was never flushed by a
+   // render has to be applied before the particles are aged again
+   runPendingUpdate();
 
-   // remove dead particles
-   Particle* last_part = &part_list_head;
-   for (Particle* part = part_list_head.next; part != NULL; part = part->next)
+   // age the particles and compact out the dead ones, keeping the survivors
+   // in their oldest-to-newest order
+   Particle* store = part_store.address();
+   S32 n_live = 0;
+   for (S32 i = 0; i < n_parts; i++)
    {
+     Particle* part = &store[i];
      part->currentAge += numMSToUpdate;
-     if (part->currentAge > part->totalLifetime)
-     {
-       n_parts--;
-       last_part->next = part->next;
-       part->next = part_freelist;
-       part_freelist = part;
-       part = last_part;
-     }
-     else
+     if (part->currentAge <= part->totalLifetime)
      {
-       last_part = part;
+       if (n_live != i)
+         store[n_live] = *part;
+       n_live++;
      }
    }
+   if (n_live != n_parts)
+   {
+     n_parts = n_live;
+     relinkParticles();
+   }
 
    AssertFatal( n_parts >= 0, "ParticleEmitter: negative part count!" );
 
@@ -1744,8 +1821,176 @@ void ParticleEmitter::advanceTime(F32 dt)
 
    if( numMSToUpdate != 0 && n_parts > 0 )
    {
-      update( numMSToUpdate );
+      if ( smParallelUpdate )
+         queueUpdate( numMSToUpdate );
+      else
+         update( numMSToUpdate );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// queueUpdate
+//-----------------------------------------------------------------------------
+void ParticleEmitter::queueUpdate( U32 ms )
+{
+   // Only the particles alive now are covered.  Particles emitted before the
+   // flush are appended after them and have already been advanced by
+   // emitParticles.
+   mPendingUpdateMS = ms;
+   mPendingUpdateParts = n_parts;
+
+   if ( !mQueuedForUpdate )
+   {
+      mQueuedForUpdate = true;
+      smPendingUpdates.push_back( this );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// runPendingUpdate
+//-----------------------------------------------------------------------------
+void ParticleEmitter::runPendingUpdate()
+{
+   integratePendingUpdate();
+
+   if ( mBBoxQueued )
+   {
+      mBBoxQueued = false;
+      updateBBox();
+   }
+}
+
+//-----------------------------------------------------------------------------
+// integratePendingUpdate
+//-----------------------------------------------------------------------------
+void ParticleEmitter::integratePendingUpdate()
+{
+   if ( mPendingUpdateMS == 0 )
+      return;
+
+   // The particle count can only have dropped if the pool was reset.
+   update( mPendingUpdateMS, getMin( mPendingUpdateParts, n_parts ) );
+   mPendingUpdateMS = 0;
+   mPendingUpdateParts = 0;
+}
+
+//-----------------------------------------------------------------------------
+// fitQueuedBBox
+//-----------------------------------------------------------------------------
+void ParticleEmitter::fitQueuedBBox()
+{
+   if ( !mBBoxQueued )
+      return;
+
+   mBBoxQueued = false;
+   if ( !forced_bbox )
+      fitBBox( mQueuedBBox );
+}
+
+//-----------------------------------------------------------------------------
+// cancelPendingUpdate
+//-----------------------------------------------------------------------------
+void ParticleEmitter::cancelPendingUpdate()
+{
+   mPendingUpdateMS = 0;
+   mPendingUpdateParts = 0;
+   mBBoxQueued = false;
+
+   if ( !mQueuedForUpdate )
+      return;
+
+   mQueuedForUpdate = false;
+   for ( U32 i = 0; i < smPendingUpdates.size(); i++ )
+   {
+      if ( smPendingUpdates[i] == this )
+      {
+         smPendingUpdates.erase_fast( i );
+         break;
+      }
+   }
+}
+
+//-----------------------------------------------------------------------------
+// flushPendingUpdates
+//-----------------------------------------------------------------------------
+
+/// Runs the pending updates of a contiguous range of emitters.
+struct ParticleUpdateWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   ParticleEmitter* const* mEmitters;
+   U32 mCount;
+   Semaphore* mDone;
+
+   ParticleUpdateWorkItem( ParticleEmitter* const* emitters, U32 count, Semaphore* done )
+      : mEmitters( emitters ), mCount( count ), mDone( done ) {}
+
+   static void updateEmitters( ParticleEmitter* const* emitters, U32 count )
+   {
+      for ( U32 i = 0; i < count; i++ )
+      {
+         ParticleEmitter* emitter = emitters[i];
+         emitter->integratePendingUpdate();
+
+         // Fitting the box moves the emitter in the scene, which is left
+         // to the main thread, but the particles can be walked here.
+         if ( emitter->mBBoxQueued && !emitter->forced_bbox )
+            emitter->mQueuedBBox = emitter->computeBBox();
+      }
+   }
+
+protected:
+   void execute() override
+   {
+      updateEmitters( mEmitters, mCount );
+      mDone->release();
+   }
+   void onCancelled() override
+   {
+      // Never leave the main thread waiting on a cancelled batch.
+      updateEmitters( mEmitters, mCount );
+      mDone->release();
+   }
+};
+
+void ParticleEmitter::flushPendingUpdates()
+{
+   if ( smPendingUpdates.empty() )
+      return;
+
+   PROFILE_SCOPE( ParticleEmitter_flushPendingUpdates );
+
+   // Nothing queues or cancels updates while the flush runs, so the queue
+   // itself is handed out to the workers.
+   Vector<ParticleEmitter*>& emitters = smPendingUpdates;
+
+   const U32 numEmitters = emitters.size();
+   const U32 batchSize = getMax( smParallelBatchSize, 1 );
+   const U32 numBatches = ( numEmitters + batchSize - 1 ) / batchSize;
+
+   // Each emitter only touches its own particles, so batches are handed to
+   // the worker threads as is.  The main thread keeps the first batch.
+   Semaphore done( 0 );
+   for ( U32 i = 1; i < numBatches; i++ )
+   {
+      const U32 start = i * batchSize;
+      const U32 count = getMin( batchSize, numEmitters - start );
+      ThreadSafeRef< ParticleUpdateWorkItem > item( new ParticleUpdateWorkItem( emitters.address() + start, count, &done ) );
+      ThreadPool::GLOBAL().queueWorkItem( item );
+   }
+
+   ParticleUpdateWorkItem::updateEmitters( emitters.address(), getMin( batchSize, numEmitters ) );
+
+   for ( U32 i = 1; i < numBatches; i++ )
+      done.acquire();
+
+   for ( U32 i = 0; i < numEmitters; i++ )
+   {
+      emitters[i]->mQueuedForUpdate = false;
+      emitters[i]->fitQueuedBBox();
    }
+   emitters.clear();
 }
 
 //-----------------------------------------------------------------------------
@@ -1821,16 +2066,35 @@ void ParticleEmitter::updateKeyData( Particle *part )
 // Update particles
 //-----------------------------------------------------------------------------
 // AFX CODE BLOCK (enhanced-emitter) <<
-void ParticleEmitter::update( U32 ms )
+void ParticleEmitter::update( U32 ms, S32 numParts )
 {
    F32 t = F32(ms)/1000.0f; // AFX -- moved outside loop, no need to recalculate this for every particle
 
-   for (Particle* part = part_list_head.next; part != NULL; part = part->next)
+   if ( numParts < 0 )
+      numParts = n_parts;
+
+   // Most emitters use a single particle datablock, so the per-datablock
+   // forces are only recomputed when the datablock changes between particles.
+   ParticleData* lastDataBlock = NULL;
+   F32     drag = 0.0f;
+   Point3F force(0.0f, 0.0f, 0.0f);
+   Point3F offset(0.0f, 0.0f, 0.0f);
+
+   Particle* part = part_store.address();
+   Particle* partEnd = part + numParts;
+   for (; part != partEnd; part++)
    {
-      Point3F a = part->acc;
-      a -= part->vel * part->dataBlock->dragCoefficient;
-      a += mWindVelocity * part->dataBlock->windCoefficient;
-      a.z += -9.81f*part->dataBlock->gravityCoefficient; // AFX -- as long as gravity is a constant, this is faster
+      if (part->dataBlock != lastDataBlock)
+      {
+         lastDataBlock = part->dataBlock;
+         drag  = lastDataBlock->dragCoefficient;
+         force = mWindVelocity * lastDataBlock->windCoefficient;
+         force.z += -9.81f*lastDataBlock->gravityCoefficient; // AFX -- as long as gravity is a constant, this is faster
+         offset = lastDataBlock->constrain_pos ? this->pos_pe : Point3F::Zero;
+      }
+
+      Point3F a = part->acc + force;
+      a -= part->vel * drag;
 
       part->vel += a * t;
       part->pos_local += part->vel * t; 
@@ -1838,10 +2102,7 @@ void ParticleEmitter::update( U32 ms )
       // AFX -- allow subclasses to adjust the particle params here
       sub_particleUpdate(part);
 
-      if (part->dataBlock->constrain_pos)
-        part->pos = part->pos_local + this->pos_pe;
-      else
-        part->pos = part->pos_local;
+      part->pos = part->pos_local + offset;
 
       updateKeyData( part );
    }
@@ -1878,21 +2139,26 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
 
    PROFILE_START(ParticleEmitter_copyToVB);
 
+   // The pool holds the particles oldest first; vertices are generated
+   // newest to oldest to match the particle list order.
+   Particle* newest = part_store.address() + (n_parts - 1);
+   const bool sortParticles = mDataBlock->sortParticles && !mDataBlock->ribbonParticles;
+
    PROFILE_START(ParticleEmitter_copyToVB_Sort);
    // build sorted list of particles (far to near)
-   if (mDataBlock->sortParticles)
+   if (sortParticles)
    {
-     orderedVector.clear();
+     orderedVector.setSize(n_parts);
 
      MatrixF modelview = GFX->getWorldMatrix();
      Point3F viewvec; modelview.getRow(1, &viewvec);
 
      // add each particle and a distance based sort key to orderedVector
-     for (Particle* pp = part_list_head.next; pp != NULL; pp = pp->next)
+     SortParticle* sortPtr = orderedVector.address();
+     for (S32 i = 0; i < n_parts; i++, sortPtr++)
      {
-       orderedVector.increment();
-       orderedVector.last().p = pp;
-       orderedVector.last().k = mDot(pp->pos, viewvec);
+       sortPtr->p = newest - i;
+       sortPtr->k = mDot(sortPtr->p->pos, viewvec);
      }
 
      // qsort the list into far to near ordering
@@ -1900,114 +2166,60 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
    }
    PROFILE_END();
 
-   static Vector<ParticleVertexType> tempBuff(2048);
-   tempBuff.reserve( n_parts*4 + 64); // make sure tempBuff is big enough
-   ParticleVertexType *buffPtr = tempBuff.address(); // use direct pointer (faster)
-   
+   // create new VB if emitter size grows
+   if( !mVertBuff || n_parts > mCurBuffSize )
+   {
+      mCurBuffSize = n_parts;
+      mVertBuff.set( GFX, n_parts * 4, GFXBufferTypeDynamic );
+   }
+
+   // The vertices are written straight into the locked vertex buffer in a
+   // single pass instead of being staged in a temporary buffer and copied.
+   PROFILE_START(ParticleEmitter_copyToVB_Lock);
+   ParticleVertexType *buffPtr = mVertBuff.lock();
+   PROFILE_END();
+
+   // reversed emitters fill the buffer back to front
+   S32 buffStep = 4;
+   if (mDataBlock->reverseOrder)
+   {
+      buffPtr += 4*(n_parts-1);
+      buffStep = -4;
+   }
+
+   const SortParticle* sortList = orderedVector.address();
+
    if (mDataBlock->ribbonParticles)
    {
       PROFILE_START(ParticleEmitter_copyToVB_Ribbon);
 
-      if (mDataBlock->reverseOrder)
+      Particle* oldPtr = NULL;
+      Particle* partPtr = newest;
+      for (S32 i = 0; i < n_parts; i++, partPtr--, buffPtr += buffStep)
       {
-            Particle* oldPtr = NULL;
-            for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr -= 4)
-            {
-               setupRibbon(partPtr, partPtr->next, oldPtr, camPos, ambientColor, buffPtr);
-               oldPtr = partPtr;
-            }
-      }
-      else
-      {
-            Particle* oldPtr = NULL;
-            for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr += 4)
-            {
-               setupRibbon(partPtr, partPtr->next, oldPtr, camPos, ambientColor, buffPtr);
-               oldPtr = partPtr;
-            }
+         setupRibbon(partPtr, partPtr->next, oldPtr, camPos, ambientColor, buffPtr);
+         oldPtr = partPtr;
       }
+
       PROFILE_END();
    }
    else if (mDataBlock->orientParticles)
    {
       PROFILE_START(ParticleEmitter_copyToVB_Orient);
 
-      if (mDataBlock->reverseOrder)
-      {
-        buffPtr += 4*(n_parts-1);
-        // do sorted-oriented particles
-        if (mDataBlock->sortParticles)
-        {
-          SortParticle* partPtr = orderedVector.address();
-          for (U32 i = 0; i < n_parts; i++, partPtr++, buffPtr-=4 )
-             setupOriented(partPtr->p, camPos, ambientColor, buffPtr);
-        }
-        // do unsorted-oriented particles
-        else
-        {
-          for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr-=4)
-             setupOriented(partPtr, camPos, ambientColor, buffPtr);
-        }
-      }
-      else
-      {
-        // do sorted-oriented particles
-        if (mDataBlock->sortParticles)
-        {
-          SortParticle* partPtr = orderedVector.address();
-          for (U32 i = 0; i < n_parts; i++, partPtr++, buffPtr+=4 )
-             setupOriented(partPtr->p, camPos, ambientColor, buffPtr);
-        }
-        // do unsorted-oriented particles
-        else
-        {
-          for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr+=4)
-             setupOriented(partPtr, camPos, ambientColor, buffPtr);
-        }
-      }
-	  PROFILE_END();
+      for (S32 i = 0; i < n_parts; i++, buffPtr += buffStep)
+         setupOriented(sortParticles ? sortList[i].p : newest - i, camPos, ambientColor, buffPtr);
+
+      PROFILE_END();
    }
    else if (mDataBlock->alignParticles)
    {
       PROFILE_START(ParticleEmitter_copyToVB_Aligned);
 
-      if (mDataBlock->reverseOrder)
-      {
-         buffPtr += 4*(n_parts-1);
+      for (S32 i = 0; i < n_parts; i++, buffPtr += buffStep)
+         setupAligned(sortParticles ? sortList[i].p : newest - i, ambientColor, buffPtr);
 
-         // do sorted-oriented particles
-         if (mDataBlock->sortParticles)
-         {
-            SortParticle* partPtr = orderedVector.address();
-            for (U32 i = 0; i < n_parts; i++, partPtr++, buffPtr-=4 )
-               setupAligned(partPtr->p, ambientColor, buffPtr);
-         }
-         // do unsorted-oriented particles
-         else
-         {
-            Particle *partPtr = part_list_head.next;
-            for (; partPtr != NULL; partPtr = partPtr->next, buffPtr-=4)
-               setupAligned(partPtr, ambientColor, buffPtr);
-         }
-      }
-      else
-      {
-         // do sorted-oriented particles
-         if (mDataBlock->sortParticles)
-         {
-            SortParticle* partPtr = orderedVector.address();
-            for (U32 i = 0; i < n_parts; i++, partPtr++, buffPtr+=4 )
-               setupAligned(partPtr->p, ambientColor, buffPtr);
-         }
-         // do unsorted-oriented particles
-         else
-         {
-            Particle *partPtr = part_list_head.next;
-            for (; partPtr != NULL; partPtr = partPtr->next, buffPtr+=4)
-               setupAligned(partPtr, ambientColor, buffPtr);
-         }
-      }
-	  PROFILE_END();
+      PROFILE_END();
    }
    else
    {
@@ -2023,55 +2235,13 @@ void ParticleEmitter::copyToVB( const Point3F &camPos, const LinearColorF &ambie
       MatrixF camView = GFX->getWorldMatrix();
       camView.transpose();  // inverse - this gets the particles facing camera
 
-      if (mDataBlock->reverseOrder)
-      {
-        buffPtr += 4*(n_parts-1);
-        // do sorted-billboard particles
-        if (mDataBlock->sortParticles)
-        {
-          SortParticle *partPtr = orderedVector.address();
-          for( U32 i=0; i<n_parts; i++, partPtr++, buffPtr-=4 )
-             setupBillboard( partPtr->p, basePoints, camView, ambientColor, buffPtr );
-        }
-        // do unsorted-billboard particles
-        else
-        {
-          for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr-=4)
-             setupBillboard( partPtr, basePoints, camView, ambientColor, buffPtr );
-        }
-      }
-      else
-      {
-        // do sorted-billboard particles
-        if (mDataBlock->sortParticles)
-        {
-          SortParticle *partPtr = orderedVector.address();
-          for( U32 i=0; i<n_parts; i++, partPtr++, buffPtr+=4 )
-             setupBillboard( partPtr->p, basePoints, camView, ambientColor, buffPtr );
-        }
-        // do unsorted-billboard particles
-        else
-        {
-          for (Particle* partPtr = part_list_head.next; partPtr != NULL; partPtr = partPtr->next, buffPtr+=4)
-             setupBillboard( partPtr, basePoints, camView, ambientColor, buffPtr );
-        }
-      }
+      for (S32 i = 0; i < n_parts; i++, buffPtr += buffStep)
+         setupBillboard(sortParticles ? sortList[i].p : newest - i, basePoints, camView, ambientColor, buffPtr);
 
       PROFILE_END();
    }
 
-   PROFILE_START(ParticleEmitter_copyToVB_LockCopy);
-   // create new VB if emitter size grows
-   if( !mVertBuff || n_parts > mCurBuffSize )
-   {
-      mCurBuffSize = n_parts;
-      mVertBuff.set( GFX, n_parts * 4, GFXBufferTypeDynamic );
-   }
-   // lock and copy tempBuff to video RAM
-   ParticleVertexType *verts = mVertBuff.lock();
-   dMemcpy( verts, tempBuff.address(), n_parts * 4 * sizeof(ParticleVertexType) );
    mVertBuff.unlock();
-   PROFILE_END();
 
    PROFILE_END();
 }
@@ -2621,6 +2791,92 @@ DefineEngineMethod(ParticleEmitterData, reload, void,(),,
 {
    object->reload();
 }
+//-----------------------------------------------------------------------------
+// runSimulationBenchmark
+//-----------------------------------------------------------------------------
+void ParticleEmitter::runSimulationBenchmark( U32 numEmitters, U32 numParticles, U32 numFrames )
+{
+   // A bare datablock pair is enough for the simulation path, which never
+   // touches the scene, the textures or the primitive buffer.
+   ParticleData* partData = new ParticleData;
+   partData->lifetimeMS = S32_MAX / 2;
+   partData->dragCoefficient = 0.5f;
+   partData->gravityCoefficient = 1.0f;
+   partData->windCoefficient = 1.0f;
+
+   ParticleEmitterData* emitterData = new ParticleEmitterData;
+   emitterData->particleDataBlocks.push_back( partData );
+   emitterData->partListInitSize = numParticles;
+
+   Vector<ParticleEmitter*> emitters( __FILE__, __LINE__ );
+   emitters.setSize( numEmitters );
+   for ( U32 i = 0; i < numEmitters; i++ )
+   {
+      ParticleEmitter* emitter = new ParticleEmitter;
+      emitter->mDataBlock = emitterData;
+      emitter->n_part_capacity = numParticles;
+      emitter->part_store.setSize( numParticles );
+
+      for ( U32 j = 0; j < numParticles; j++ )
+      {
+         Particle* part = emitter->allocParticle();
+         part->pos.set( gRandGen.randF( -10.0f, 10.0f ), gRandGen.randF( -10.0f, 10.0f ), gRandGen.randF( 0.0f, 10.0f ) );
+         part->pos_local = part->pos;
+         part->vel.set( gRandGen.randF( -1.0f, 1.0f ), gRandGen.randF( -1.0f, 1.0f ), gRandGen.randF( 0.0f, 5.0f ) );
+         part->orientDir.set( 0.0f, 0.0f, 1.0f );
+         part->currentAge = 0;
+         part->t_last = 0.0f;
+         partData->initializeParticle( part, Point3F::Zero );
+      }
+
+      emitters[i] = emitter;
+   }
+
+   const bool oldParallelUpdate = smParallelUpdate;
+   PlatformTimer* timer = PlatformTimer::create();
+   S32 elapsedMs[2];
+
+   for ( U32 pass = 0; pass < 2; pass++ )
+   {
+      smParallelUpdate = ( pass == 1 );
+      timer->reset();
+
+      for ( U32 frame = 0; frame < numFrames; frame++ )
+      {
+         for ( U32 i = 0; i < numEmitters; i++ )
+            emitters[i]->advanceTime( 0.032f );
+
+         flushPendingUpdates();
+      }
+
+      elapsedMs[pass] = timer->getElapsedMs();
+   }
+
+   smParallelUpdate = oldParallelUpdate;
+   delete timer;
+
+   Con::printf( "Particle simulation: %d emitters x %d particles, %d frames",
+      numEmitters, numParticles, numFrames );
+   Con::printf( "   serial:   %dms (%.3fms per frame)", elapsedMs[0], F32( elapsedMs[0] ) / getMax( numFrames, 1U ) );
+   Con::printf( "   parallel: %dms (%.3fms per frame)", elapsedMs[1], F32( elapsedMs[1] ) / getMax( numFrames, 1U ) );
+
+   for ( U32 i = 0; i < numEmitters; i++ )
+      delete emitters[i];
+   delete emitterData;
+   delete partData;
+}
+
+DefineEngineFunction( benchmarkParticleSimulation, void, ( U32 numEmitters, U32 numParticles, U32 numFrames ), ( 1000, 200, 100 ),
+   "Simulates a set of particle emitters without a scene or graphics device, first "
+   "serially and then on the thread pool, and prints the time taken by each.\n"
+   "@param numEmitters The number of emitters to simulate.\n"
+   "@param numParticles The number of live particles in each emitter.\n"
+   "@param numFrames The number of 32ms frames to advance.\n"
+   "@ingroup FX" )
+{
+   ParticleEmitter::runSimulationBenchmark( numEmitters, numParticles, numFrames );
+}
+
 void ParticleEmitter::emitParticlesExt(const MatrixF& xfm, const Point3F& point, 
                                        const Point3F& velocity, const U32 numMilliseconds)
 {
@@ -156,6 +156,7 @@ public:
 class ParticleEmitter : public GameBase
 {
    typedef GameBase Parent;
+   friend struct ParticleUpdateWorkItem;
 #if defined(AFX_CAP_PARTICLE_POOLS) 
    friend class afxParticlePool;
 #endif 
@@ -169,9 +170,32 @@ class ParticleEmitter : public GameBase
 
    DECLARE_CONOBJECT(ParticleEmitter);
    DECLARE_CATEGORY("UNLISTED");
+   static void consoleInit();
 
    static Point3F mWindVelocity;
    static void setWindVelocity( const Point3F &vel ){ mWindVelocity = vel; }
+
+   /// @name Parallel Simulation
+   /// When enabled, the particle integration done in advanceTime is deferred
+   /// and then run for all the emitters at once on the global thread pool
+   /// before they are rendered.
+   /// @{
+
+   /// Defers particle integration to flushPendingUpdates().
+   static bool smParallelUpdate;
+
+   /// The number of emitters handed to each worker job.
+   static S32 smParallelBatchSize;
+
+   /// Runs the deferred particle integration of every emitter that has
+   /// been advanced since the last flush.  Returns once all of them are done.
+   static void flushPendingUpdates();
+
+   /// Simulates the given number of emitters and particles without a scene
+   /// or graphics device and reports the serial and parallel update times.
+   static void runSimulationBenchmark( U32 numEmitters, U32 numParticles, U32 numFrames );
+
+   /// @}
    
    LinearColorF getCollectiveColor();
 
@@ -257,6 +281,12 @@ class ParticleEmitter : public GameBase
    /// Updates the bounding box for the particle system
    void updateBBox();
 
+   /// Returns a box around the particles and how far they may move.
+   Box3F computeBBox() const;
+
+   /// Makes @a box the bounding box of the particle system.
+   void fitBBox( const Box3F &box );
+
    /// @}
   protected:
    bool onAdd() override;
@@ -277,7 +307,32 @@ class ParticleEmitter : public GameBase
    // ParticleEmitter which are normally declared with private scope. In this section,
    // protected and private scope statements have been inserted inline with the original
    // code to expose the necessary members and methods.
-   void update( U32 ms );
+   void update( U32 ms, S32 numParts = -1 );
+
+   /// Queues the integration of the current particles for the next
+   /// flushPendingUpdates().
+   void queueUpdate( U32 ms );
+
+   /// Runs a queued update immediately.
+   void runPendingUpdate();
+
+   /// Integrates the particles for a queued update.  Safe to call from a
+   /// worker thread, so it doesn't touch the bounding box.
+   void integratePendingUpdate();
+
+   /// Fits the bounding box computed during the flush.
+   void fitQueuedBBox();
+
+   /// Drops this emitter from the queue of pending updates.
+   void cancelPendingUpdate();
+
+   U32  mPendingUpdateMS;      ///< Milliseconds of integration queued, 0 if none
+   S32  mPendingUpdateParts;   ///< Number of particles the queued update covers
+   bool mQueuedForUpdate;      ///< Whether this emitter is in smPendingUpdates
+   bool mBBoxQueued;           ///< Whether the box waits for the queued update
+   Box3F mQueuedBBox;          ///< Box computed after the queued update
+
+   static Vector<ParticleEmitter*> smPendingUpdates;
 protected:
     void updateKeyData( Particle *part );
  
@@ -317,16 +372,29 @@ private:
    GFXVertexBufferHandle<ParticleVertexType> mVertBuff;
 
 protected:
-   //   These members are for implementing a link-list of the active emitter 
-   //   particles. Member part_store contains blocks of particles that can be
-   //   chained in a link-list. Usually the first part_store block is large
-   //   enough to contain all the particles but it can be expanded in emergency
-   //   circumstances.
-   Vector <Particle*> part_store;
-   Particle*  part_freelist;
+   //   These members implement the pool of active emitter particles. Member
+   //   part_store is one contiguous block holding the live particles, oldest
+   //   first, so the per-frame update and vertex passes stream through memory
+   //   rather than chasing pointers. Dead particles are removed by an order
+   //   preserving compaction since ribbons and unsorted draw order depend on
+   //   particle age. The next links are still threaded newest-to-oldest through
+   //   the block, starting at part_list_head.next, for code that walks the list.
+   //   Usually the initial block is large enough to contain all the particles
+   //   but it can be expanded in emergency circumstances.
+   Vector<Particle> part_store;
    Particle   part_list_head;
    S32        n_part_capacity;
    S32        n_parts;
+
+   /// Appends a particle to the pool, growing it if needed, and makes it the
+   /// head of the particle list.
+   Particle* allocParticle();
+
+   /// Removes the most recently allocated particle.
+   void freeNewestParticle();
+
+   /// Rebuilds the next links after the pool was compacted or reallocated.
+   void relinkParticles();
 private:    
    S32       mCurBuffSize;
 
@@ -65,9 +65,11 @@ ConsoleDocClass( OcclusionVolume,
 
 OcclusionVolume::OcclusionVolume()
    : mTransformDirty( true ),
+     mOccluderMeshDirty( true ),
      mSilhouetteExtractor( mPolyhedron )
 {
    VECTOR_SET_ASSOCIATION( mWSPoints );
+   VECTOR_SET_ASSOCIATION( mOccluderTriangles );
 
    mObjectFlags.set( VisualOccluderFlag );
    
@@ -122,6 +124,28 @@ void OcclusionVolume::setTransform( const MatrixF& mat )
 {
    Parent::setTransform( mat );
    mTransformDirty = true;
+   mOccluderMeshDirty = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void OcclusionVolume::_updateWorldSpacePoints()
+{
+   if( !mTransformDirty )
+      return;
+
+   const U32 numPolyPoints = mPolyhedron.getNumPoints();
+   const PolyhedronType::PointType* points = getPolyhedron().getPoints();
+
+   mWSPoints.setSize(numPolyPoints);
+   for( U32 i = 0; i < numPolyPoints; ++ i )
+   {
+      Point3F p = points[ i ];
+      p.convolve( getScale() );
+      getTransform().mulP( p, &mWSPoints[ i ] );
+   }
+
+   mTransformDirty = false;
 }
 
 //-----------------------------------------------------------------------------
@@ -165,25 +189,48 @@ void OcclusionVolume::buildSilhouette( const SceneCameraState& cameraState, Vect
    // If we haven't yet, transform the polyhedron's points
    // to world space.
 
-   if( mTransformDirty )
+   _updateWorldSpacePoints();
+
+   // Now store the points.
+
+   outPoints.setSize( numPoints );
+   for( U32 i = 0; i < numPoints; ++ i )
+      outPoints[ i ] = mWSPoints[ indices[ i ] ];
+}
+
+//-----------------------------------------------------------------------------
+
+bool OcclusionVolume::getOccluderMesh( MatrixF* outTransform, const Vector< Point3F >** outTriangles )
+{
+   if( mOccluderMeshDirty )
    {
+      _updateWorldSpacePoints();
+
+      // Fan-triangulate each of the polyhedron's faces.  Winding
+      // doesn't matter as the occlusion buffer is double-sided.
+
+      mOccluderTriangles.clear();
+
       const U32 numPolyPoints = mPolyhedron.getNumPoints();
-      const PolyhedronType::PointType* points = getPolyhedron().getPoints();
+      TempAlloc< U32 > indices( numPolyPoints );
 
-      mWSPoints.setSize(numPolyPoints);
-      for( U32 i = 0; i < numPolyPoints; ++ i )
+      const U32 numPlanes = mPolyhedron.getNumPlanes();
+      for( U32 plane = 0; plane < numPlanes; ++ plane )
       {
-         Point3F p = points[ i ];
-         p.convolve( getScale() );
-         getTransform().mulP( p, &mWSPoints[ i ] );
+         const U32 numIndices = mPolyhedron.extractFace( plane, ( U32* ) indices, numPolyPoints );
+         for( U32 i = 2; i < numIndices; ++ i )
+         {
+            mOccluderTriangles.push_back( mWSPoints[ indices[ 0 ] ] );
+            mOccluderTriangles.push_back( mWSPoints[ indices[ i - 1 ] ] );
+            mOccluderTriangles.push_back( mWSPoints[ indices[ i ] ] );
+         }
       }
 
-      mTransformDirty = false;
+      mOccluderMeshDirty = false;
    }
 
-   // Now store the points.
+   outTransform->identity();
+   *outTriangles = &mOccluderTriangles;
 
-   outPoints.setSize( numPoints );
-   for( U32 i = 0; i < numPoints; ++ i )
-      outPoints[ i ] = mWSPoints[ indices[ i ] ];
+   return !mOccluderTriangles.empty();
 }
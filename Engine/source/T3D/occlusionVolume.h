@@ -48,12 +48,22 @@ class OcclusionVolume : public ScenePolyhedralSpace
       /// transform-based data.
       bool mTransformDirty;
 
+      /// Whether mOccluderTriangles needs to be rebuilt.
+      bool mOccluderMeshDirty;
+
       /// World-space points of the volume's polyhedron.
       Vector< Point3F > mWSPoints;
 
+      /// World-space triangulation of the volume's faces for the
+      /// software occlusion buffer.
+      Vector< Point3F > mOccluderTriangles;
+
       /// Silhouette extractor when using perspective projections.
       SilhouetteExtractorType mSilhouetteExtractor;
       
+      /// Transform the polyhedron's points to world space if the transform has changed.
+      void _updateWorldSpacePoints();
+
       // SceneSpace.
       void _renderObject( ObjectRenderInst* ri, SceneRenderState* state, BaseMatInstance* overrideMat ) override;
 
@@ -72,6 +82,7 @@ class OcclusionVolume : public ScenePolyhedralSpace
 
       // SceneObject.
       void buildSilhouette( const SceneCameraState& cameraState, Vector< Point3F >& outPoints ) override;
+      bool getOccluderMesh( MatrixF* outTransform, const Vector< Point3F >** outTriangles ) override;
       void setTransform( const MatrixF& mat ) override;
 };
 
@@ -103,6 +103,8 @@ Point3F BtPlayer::move( const VectorF &disp, CollisionList &outCol )
 {
    AssertFatal( mGhostObject, "BtPlayer::move - The controller is null!" );
 
+   mWorld->waitForStep();
+
    if (!mWorld->isEnabled())
    {
       btTransform currentTrans = mGhostObject->getWorldTransform();
@@ -420,6 +422,8 @@ void BtPlayer::findContact(   SceneObject **contactObject,
 {
    AssertFatal( mGhostObject, "BtPlayer::findContact - The controller is null!" );
 
+   mWorld->waitForStep();
+
    VectorF normal;
    F32 maxDot = -1.0f;
 
@@ -498,6 +502,8 @@ void BtPlayer::setTransform( const MatrixF &transform )
 {
    AssertFatal( mGhostObject, "BtPlayer::setTransform - The ghost object is null!" );
 
+   mWorld->waitForStep();
+
    btTransform xfm = btCast<btTransform>( transform );
    xfm.getOrigin()[2] += mOriginOffset;
 
@@ -508,6 +514,8 @@ MatrixF& BtPlayer::getTransform( MatrixF *outMatrix )
 {
    AssertFatal( mGhostObject, "BtPlayer::getTransform - The ghost object is null!" );
 
+   mWorld->waitForStep();
+
    *outMatrix = btCast<MatrixF>( mGhostObject->getWorldTransform() );
    *outMatrix[11] -= mOriginOffset;
 
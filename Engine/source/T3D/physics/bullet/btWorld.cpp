@@ -25,18 +25,52 @@
 
 #include "T3D/physics/bullet/btPlugin.h"
 #include "T3D/physics/bullet/btCasts.h"
+#include "T3D/physics/bullet/btBody.h"
+#include "T3D/physics/bullet/btCollision.h"
 #include "T3D/physics/physicsUserData.h"
 #include "core/stream/bitStream.h"
 #include "platform/profiler.h"
 #include "sim/netConnection.h"
 #include "console/console.h"
 #include "console/consoleTypes.h"
+#include "console/engineAPI.h"
 #include "scene/sceneRenderState.h"
+#include "scene/sceneObject.h"
 #include "T3D/gameBase/gameProcess.h"
+#include "platform/threads/threadPool.h"
+
+
+/// Steps a BtWorld on a worker thread.
+struct BtStepWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   BtWorld* mWorld;
+   F32 mElapsedSec;
+
+   BtStepWorkItem( BtWorld* world, F32 elapsedSec )
+      :  mWorld( world ),
+         mElapsedSec( elapsedSec ) {}
+
+protected:
+   void execute() override
+   {
+      mWorld->_stepSimulation( mElapsedSec );
+      mWorld->mStepDone.release();
+   }
+   void onCancelled() override
+   {
+      // The main thread will wait for this step, so it must happen.
+      execute();
+   }
+};
+
 
 BtWorld::BtWorld() :
    mProcessList( NULL ),
    mIsSimulating( false ),
+   mStepPending( false ),
+   mStepDone( 0 ),
    mErrorReport( false ),
    mTickCount( 0 ),
    mIsEnabled( false ),
@@ -87,6 +121,9 @@ bool BtWorld::initWorld( bool isServer, ProcessList *processList )
 
 void BtWorld::_destroy()
 {
+   // Don't pull the world out from under the worker thread.
+   waitForStep();
+
    // Release the tick processing signals.
    if ( mProcessList )
    {
@@ -123,8 +160,21 @@ void BtWorld::tickPhysics( U32 elapsedMs )
    // Convert it to seconds.
    const F32 elapsedSec = (F32)elapsedMs * 0.001f;
 
-   // Simulate
-   mDynamicsWorld->stepSimulation( elapsedSec * mEditorTimeScale, smPhysicsMaxSubSteps, smPhysicsStepTime);
+   // With threads to spare, the step runs on the thread pool overlapped with
+   // the rest of the tick and rendering.  Everything that touches the world
+   // before getPhysicsResults picks the step up waits for it to finish.
+   //
+   // Note that the Bullet version we ship has no parallel solver, so the
+   // thread count only decides whether the step leaves the main thread.
+   if ( PhysicsPlugin::getThreadCount() > 0 )
+   {
+      mStepPending = true;
+
+      ThreadSafeRef< BtStepWorkItem > item( new BtStepWorkItem( this, elapsedSec * mEditorTimeScale ) );
+      ThreadPool::GLOBAL().queueWorkItem( item );
+   }
+   else
+      _stepSimulation( elapsedSec * mEditorTimeScale );
 
    mIsSimulating = true;
 
@@ -139,11 +189,26 @@ void BtWorld::getPhysicsResults()
    PROFILE_SCOPE(BtWorld_GetPhysicsResults);
 
    // Get results from scene.
-  // mScene->fetchResults( NX_RIGID_BODY_FINISHED, true );
+   waitForStep();
    mIsSimulating = false;
    mTickCount++;
 }
 
+void BtWorld::_stepSimulation( F32 elapsedSec )
+{
+   PROFILE_SCOPE(BtWorld_StepSimulation);
+
+   mDynamicsWorld->stepSimulation( elapsedSec, smPhysicsMaxSubSteps, smPhysicsStepTime );
+}
+
+void BtWorld::_waitForStep()
+{
+   PROFILE_SCOPE(BtWorld_WaitForStep);
+
+   mStepDone.acquire();
+   mStepPending = false;
+}
+
 void BtWorld::setEnabled( bool enabled )
 {
    mIsEnabled = enabled;
@@ -159,6 +224,8 @@ void BtWorld::destroyWorld()
 
 bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *ri, const Point3F &impulse )
 {
+   waitForStep();
+
    btCollisionWorld::ClosestRayResultCallback result( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ) );
    mDynamicsWorld->rayTest( btCast<btVector3>( startPnt ), btCast<btVector3>( endPnt ), result );
 
@@ -200,6 +267,8 @@ bool BtWorld::castRay( const Point3F &startPnt, const Point3F &endPnt, RayInfo *
 
 PhysicsBody* BtWorld::castRay( const Point3F &start, const Point3F &end, U32 bodyTypes )
 {
+   waitForStep();
+
    btVector3 startPt = btCast<btVector3>( start );
    btVector3 endPt = btCast<btVector3>( end );
 
@@ -253,6 +322,8 @@ void BtWorld::explosion( const Point3F &pos, F32 radius, F32 forceMagnitude )
 
 void BtWorld::onDebugDraw( const SceneRenderState *state )
 {
+   waitForStep();
+
    mDebugDraw.setCuller( &state->getCullingFrustum() );
 
    mDynamicsWorld->setDebugDrawer( &mDebugDraw );
@@ -267,6 +338,8 @@ void BtWorld::reset()
    if ( !mDynamicsWorld )
       return;
 
+   waitForStep();
+
     ///create a copy of the array, not a reference!
     btCollisionObjectArray copyArray = mDynamicsWorld->getCollisionObjectArray();
 
@@ -345,4 +418,100 @@ ConsoleFunction( castForceRay, const char*, 4, 4, "( Point3F startPnt, Point3F e
    else 
       return NULL;
 }
-*/
\ No newline at end of file
+*/
+DefineEngineFunction( benchmarkBulletStepping, void, ( S32 bodyCount, S32 ticks, S32 frameWorkMs ), ( 2000, 200, 10 ),
+   "@brief Step a headless Bullet world full of dynamic boxes, first on the main thread and then "
+   "on the thread pool, and print how much main thread time physics takes in each case.\n\n"
+   "Between ticks the main thread spins for @a frameWorkMs as a stand-in for the rest of the tick "
+   "and rendering, which is what the background step overlaps with.\n"
+   "@param bodyCount Number of dynamic bodies dropped onto the ground.\n"
+   "@param ticks Number of ticks to simulate.\n"
+   "@param frameWorkMs Milliseconds of other work done on the main thread each tick.\n"
+   "@see $pref::Physics::threadCount\n"
+   "@ingroup Physics\n"
+   "@internal" )
+{
+   bodyCount = getMax( bodyCount, 1 );
+   ticks = getMax( ticks, 1 );
+   frameWorkMs = getMax( frameWorkMs, 0 );
+
+   const U32 threadCount = PhysicsPlugin::smThreadCount;
+
+   StrongRefPtr< BtCollision > groundShape = new BtCollision();
+   groundShape->addBox( Point3F( 500.0f, 500.0f, 1.0f ), MatrixF::Identity );
+   StrongRefPtr< BtCollision > boxShape = new BtCollision();
+   boxShape->addBox( Point3F( 0.5f, 0.5f, 0.5f ), MatrixF::Identity );
+
+   // The bodies need an object to report, but nothing looks at it.
+   SceneObject* userObject = new SceneObject();
+
+   // Drop the boxes in stacked layers so they keep colliding.
+   const U32 side = getMax( (U32)mSqrt( (F32)bodyCount / 4.0f ), 1U );
+
+   Con::printf( "benchmarkBulletStepping: %d bodies, %d ticks, %d ms of other work per tick", bodyCount, ticks, frameWorkMs );
+
+   for ( U32 pass = 0; pass < 2; pass++ )
+   {
+      PhysicsPlugin::smThreadCount = ( pass == 0 ) ? 0 : getMax( threadCount, 1U );
+
+      ProcessList processList;
+      BtWorld* world = new BtWorld();
+      world->initWorld( true, &processList );
+      world->setEnabled( true );
+
+      MatrixF xfm( true );
+
+      BtBody* ground = new BtBody();
+      ground->init( groundShape, 0.0f, 0, userObject, world );
+      xfm.setPosition( Point3F( 0.0f, 0.0f, -1.0f ) );
+      ground->setTransform( xfm );
+
+      Vector< BtBody* > bodies;
+      bodies.reserve( bodyCount );
+      for ( U32 i = 0; i < bodyCount; i++ )
+      {
+         const U32 layer = i / ( side * side );
+         const U32 row = ( i / side ) % side;
+         const U32 column = i % side;
+
+         BtBody* body = new BtBody();
+         body->init( boxShape, 1.0f, 0, userObject, world );
+         xfm.setPosition( Point3F( column * 1.1f + ( layer & 1 ) * 0.5f, row * 1.1f, 0.6f + layer * 1.2f ) );
+         body->setTransform( xfm );
+         bodies.push_back( body );
+      }
+
+      U32 workMs = 0;
+      const U32 start = Platform::getRealMilliseconds();
+
+      for ( U32 t = 0; t < ticks; t++ )
+      {
+         world->getPhysicsResults();
+
+         const U32 workStart = Platform::getRealMilliseconds();
+         while ( Platform::getRealMilliseconds() - workStart < frameWorkMs )
+            ;
+         workMs += Platform::getRealMilliseconds() - workStart;
+
+         world->tickPhysics( TickMs );
+      }
+      world->getPhysicsResults();
+
+      const U32 totalMs = Platform::getRealMilliseconds() - start;
+
+      Con::printf( "   %s: %.2f ms of physics per tick on the main thread, %.2f ms per tick in total",
+         pass == 0 ? "main thread" : "thread pool",
+         F32( totalMs - getMin( workMs, totalMs ) ) / ticks,
+         F32( totalMs ) / ticks );
+
+      for ( U32 i = 0; i < bodies.size(); i++ )
+         delete bodies[i];
+      delete ground;
+
+      world->destroyWorld();
+      delete world;
+   }
+
+   PhysicsPlugin::smThreadCount = threadCount;
+   delete userObject;
+}
@@ -35,6 +35,9 @@
 #ifndef _TVECTOR_H_
 #include "core/util/tVector.h"
 #endif
+#ifndef _PLATFORM_THREADS_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
 
 class ProcessList;
 class PhysicsBody;
@@ -60,12 +63,28 @@ protected:
 
    bool mIsSimulating;
 
+   /// Set while a step queued by tickPhysics is running
+   /// on a worker thread.
+   bool mStepPending;
+
+   /// Released by the worker thread once the step is done.
+   Semaphore mStepDone;
+
    U32 mTickCount;
 
    ProcessList *mProcessList;
 
    void _destroy();
 
+   /// Block until the step on the worker thread has finished.
+   void _waitForStep();
+
+   /// Advance the Bullet world.  Called directly from tickPhysics
+   /// or from a worker thread.
+   void _stepSimulation( F32 elapsedSec );
+
+   friend struct BtStepWorkItem;
+
 public:
 
    BtWorld();
@@ -81,7 +100,15 @@ public:
    virtual void reset();
    virtual bool isEnabled() const { return mIsEnabled; }
 
-   btDynamicsWorld* getDynamicsWorld() const { return mDynamicsWorld; }
+   /// Return the Bullet world, first waiting for any step
+   /// still running on a worker thread.
+   btDynamicsWorld* getDynamicsWorld() { waitForStep(); return mDynamicsWorld; }
+
+   /// When stepping asynchronously the Bullet world is owned by a
+   /// worker thread between tickPhysics and getPhysicsResults.  Anything
+   /// that reads or writes bodies in the world from the main thread in
+   /// that window must call this first.
+   void waitForStep() { if ( mStepPending ) _waitForStep(); }
 
    void tickPhysics( U32 elapsedMs );
    void getPhysicsResults();
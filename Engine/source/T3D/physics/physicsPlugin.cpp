@@ -56,6 +56,8 @@ AFTER_MODULE_INIT( Sim )
       "@ingroup Physics\n");
    Con::addVariable( "$pref::Physics::threadCount", TypeS32, &PhysicsPlugin::smThreadCount, 
       "@brief Number of threads to use in a single pass of the physics engine.\n\n"
+      "With Bullet, any non-zero count steps the world on the thread pool overlapped with the rest "
+      "of the tick and rendering, while 0 steps it on the main thread.\n\n"
       "Defaults to 2 if not set.\n\n"
 	   "@ingroup Physics\n");
 }
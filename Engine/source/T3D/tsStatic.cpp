@@ -44,6 +44,7 @@
 #include "gfx/gfxTransformSaver.h"
 #include "ts/tsRenderState.h"
 #include "collision/boxConvex.h"
+#include "collision/concretePolyList.h"
 #include "T3D/physics/physicsPlugin.h"
 #include "T3D/physics/physicsBody.h"
 #include "T3D/physics/physicsCollision.h"
@@ -129,6 +130,8 @@ TSStatic::TSStatic()
 
    mMeshCulling = false;
    mUseOriginSort = false;
+   mOccluder = false;
+   mOccluderMeshDirty = true;
 
    mUseAlphaFade = false;
    mAlphaFadeStart = 100.0f;
@@ -155,6 +158,8 @@ TSStatic::TSStatic()
 
 TSStatic::~TSStatic()
 {
+   // The convexes must go before the cache they're registered in.
+   mConvexList->nukeList();
    delete mConvexList;
    mConvexList = NULL;
 }
@@ -230,6 +235,11 @@ void TSStatic::initPersistFields()
       "with large complex shapes like buildings which contain many submeshes.");
    addField("originSort", TypeBool, Offset(mUseOriginSort, TSStatic),
       "Enables translucent sorting of the TSStatic by its origin instead of the bounds.");
+   addField("occluder", TypeBool, Offset(mOccluder, TSStatic),
+      "Rasterizes the collision geometry of the shape into the software occlusion buffer so "
+      "that objects hidden behind it are culled. Should only be used with large, solid shapes "
+      "like buildings and rocks whose collision meshes lie inside the visible geometry.\n"
+      "@see $Scene::softwareOcclusion");
    endGroup("Rendering");
 
    addGroup("Reflection");
@@ -310,6 +320,7 @@ void TSStatic::inspectPostApply()
       prepCollision();
    }
 
+   _updateOccluderFlag();
    _updateShouldTick();
 }
 
@@ -358,6 +369,7 @@ bool TSStatic::onAdd()
    // Register for the resource change signal.
    //ResourceManager::get().getChangedSignal().notify(this, &TSStatic::_onResourceChanged);
 
+   _updateOccluderFlag();
    addToScene();
 
    if (isClientObject())
@@ -524,6 +536,8 @@ void TSStatic::prepCollision()
 
    // Cleanup any old collision data
    mCollisionDetails.clear();
+   mOccluderTriangles.clear();
+   mOccluderMeshDirty = true;
    mDecalDetails.clear();
    mDecalDetailsPtr = 0;
    mLOSDetails.clear();
@@ -961,6 +975,7 @@ U32 TSStatic::packUpdate(NetConnection* con, U32 mask, BitStream* stream)
       stream->writeFlag(mAllowPlayerStep);
       stream->writeFlag(mMeshCulling);
       stream->writeFlag(mUseOriginSort);
+      stream->writeFlag(mOccluder);
 
       stream->write(mRenderNormalScalar);
 
@@ -1076,6 +1091,8 @@ void TSStatic::unpackUpdate(NetConnection* con, BitStream* stream)
       mAllowPlayerStep = stream->readFlag();
       mMeshCulling = stream->readFlag();
       mUseOriginSort = stream->readFlag();
+      mOccluder = stream->readFlag();
+      _updateOccluderFlag();
 
       stream->read(&mRenderNormalScalar);
 
@@ -1406,21 +1423,84 @@ void TSStatic::buildConvex(const Box3F& box, Convex* convex)
    else  // CollisionMesh || VisibleMesh
    {
       TSStaticPolysoupConvex::smCurObject = this;
+      TSStaticPolysoupConvex::smCurCache = &mPolysoupCache;
 
       for (U32 i = 0; i < mCollisionDetails.size(); i++)
          mShapeInstance->buildConvexOpcode(mObjToWorld, mObjScale, mCollisionDetails[i], box, convex, mConvexList);
 
       TSStaticPolysoupConvex::smCurObject = NULL;
+      TSStaticPolysoupConvex::smCurCache = NULL;
+   }
+}
+
+bool TSStatic::getOccluderMesh(MatrixF* outTransform, const Vector<Point3F>** outTriangles)
+{
+   if (!mOccluder || !mShapeInstance)
+      return false;
+
+   if (mOccluderMeshDirty)
+   {
+      PROFILE_SCOPE(TSStatic_buildOccluderMesh);
+
+      mOccluderMeshDirty = false;
+      mOccluderTriangles.clear();
+
+      // Gather the collision geometry in object space.
+      ConcretePolyList polyList;
+      for (U32 i = 0; i < mCollisionDetails.size(); i++)
+         mShapeInstance->buildPolyListOpcode(mCollisionDetails[i], &polyList, mObjBox);
+
+      // And fan-triangulate the polygons.
+      for (U32 i = 0; i < polyList.mPolyList.size(); i++)
+      {
+         const ConcretePolyList::Poly& poly = polyList.mPolyList[i];
+         const U32* indices = &polyList.mIndexList[poly.vertexStart];
+
+         for (U32 n = 2; n < poly.vertexCount; n++)
+         {
+            mOccluderTriangles.push_back(polyList.mVertexList[indices[0]]);
+            mOccluderTriangles.push_back(polyList.mVertexList[indices[n - 1]]);
+            mOccluderTriangles.push_back(polyList.mVertexList[indices[n]]);
+         }
+      }
    }
+
+   if (mOccluderTriangles.empty())
+      return false;
+
+   *outTransform = getRenderTransform();
+   outTransform->scale(getScale());
+   *outTriangles = &mOccluderTriangles;
+
+   return true;
+}
+
+void TSStatic::_updateOccluderFlag()
+{
+   if (isVisualOccluder() == mOccluder)
+      return;
+
+   // Zone spaces only pick up occluders as objects are added
+   // to them, so take us out of the scene while changing the flag.
+   const bool inScene = getSceneManager() != NULL;
+   if (inScene)
+      removeFromScene();
+
+   mObjectFlags.set(VisualOccluderFlag, mOccluder);
+
+   if (inScene)
+      addToScene();
 }
 
 SceneObject* TSStaticPolysoupConvex::smCurObject = NULL;
+TSStaticPolysoupConvex::Cache* TSStaticPolysoupConvex::smCurCache = NULL;
 
 TSStaticPolysoupConvex::TSStaticPolysoupConvex()
    : box(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f),
    normal(0.0f, 0.0f, 0.0f, 0.0f),
    idx(0),
-   mesh(NULL)
+   mesh(NULL),
+   mCache(NULL)
 {
    mType = TSPolysoupConvexType;
 
@@ -1430,6 +1510,12 @@ TSStaticPolysoupConvex::TSStaticPolysoupConvex()
    }
 }
 
+TSStaticPolysoupConvex::~TSStaticPolysoupConvex()
+{
+   if (mCache)
+      mCache->erase(CacheKey(mesh, idx));
+}
+
 Point3F TSStaticPolysoupConvex::support(const VectorF& vec) const
 {
    F32 bestDot = mDot(verts[0], vec);
@@ -43,6 +43,9 @@
 #ifndef _TSSHAPE_H_
 #include "ts/tsShape.h"
 #endif
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
 
 #ifndef _REFLECTOR_H_
 #include "scene/reflector.h"
@@ -72,8 +75,15 @@ class TSStaticPolysoupConvex : public Convex
    friend class TSMesh;
 
 public:
+   /// Lookup of the live triangle convexes of a single TSStatic keyed
+   /// by mesh and triangle index.  This lets every object colliding with
+   /// the shape share one convex per triangle instead of extracting and
+   /// allocating its own copy each time the triangle enters its working list.
+   typedef CompoundKey< const TSMesh*, U32 > CacheKey;
+   typedef HashTable< CacheKey, TSStaticPolysoupConvex* > Cache;
+
    TSStaticPolysoupConvex();
-   ~TSStaticPolysoupConvex() {};
+   ~TSStaticPolysoupConvex();
 
 public:
    Box3F                box;
@@ -82,7 +92,11 @@ public:
    S32                  idx;
    TSMesh* mesh;
 
+   /// The cache this convex is registered in, if any.
+   Cache* mCache;
+
    static SceneObject* smCurObject;
+   static Cache* smCurCache;
 
 public:
 
@@ -162,9 +176,13 @@ protected:
    bool buildPolyList(PolyListContext context, AbstractPolyList* polyList, const Box3F& box, const SphereF& sphere) override;
    bool buildExportPolyList(ColladaUtils::ExportData* exportData, const Box3F& box, const SphereF&) override;
    void buildConvex(const Box3F& box, Convex* convex) override;
+   bool getOccluderMesh(MatrixF* outTransform, const Vector<Point3F>** outTriangles) override;
 
    bool _createShape();
 
+   /// Sync the VisualOccluderFlag with mOccluder.
+   void _updateOccluderFlag();
+
    void _updatePhysics();
 
    void _renderNormals(ObjectRenderInst* ri, SceneRenderState* state, BaseMatInstance* overrideMat);
@@ -190,6 +208,9 @@ protected:
 
    Convex* mConvexList;
 
+   /// Triangle convexes currently alive in mConvexList.
+   TSStaticPolysoupConvex::Cache mPolysoupCache;
+
    DECLARE_SHAPEASSET(TSStatic, Shape, onShapeChanged);
    DECLARE_ASSET_NET_SETGET(TSStatic, Shape, AdvancedStaticOptionsMask);
 
@@ -221,6 +242,17 @@ protected:
    /// model instead of the nearest point of the bounds.
    bool mUseOriginSort;
 
+   /// If true the collision geometry of the shape is rasterized
+   /// into the software occlusion buffer to hide objects behind it.
+   bool mOccluder;
+
+   /// Object space triangle list built from the collision
+   /// geometry for the software occlusion buffer.
+   Vector<Point3F> mOccluderTriangles;
+
+   /// True if mOccluderTriangles needs to be rebuilt.
+   bool mOccluderMeshDirty;
+
    PhysicsBody* mPhysicsRep;
 
    LinearColorF mOverrideColor;
@@ -617,15 +617,12 @@ void TurretShape::processTick(const Move* move)
    if (mAtRest)
    {
       // At rest so we're static
-      mTypeMask &= ~DynamicShapeObjectType;
-      mTypeMask |= StaticObjectType | StaticShapeObjectType;
+      setTypeMask((mTypeMask & ~DynamicShapeObjectType) | StaticObjectType | StaticShapeObjectType);
    }
    else
    {
       // Not at rest so we're dynamic
-      mTypeMask &= ~StaticObjectType;
-      mTypeMask &= ~StaticShapeObjectType;
-      mTypeMask |= DynamicShapeObjectType;
+      setTypeMask((mTypeMask & ~(StaticObjectType | StaticShapeObjectType)) | DynamicShapeObjectType);
    }
 
    if (!isGhost())
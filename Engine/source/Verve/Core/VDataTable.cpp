@@ -229,7 +229,7 @@ bool VDataTable::getValue( SimObject *pObject, const String &pFieldName, String
         case VDataTable::k_TypeExpression :
             {
                 // Evaluate.
-                pValue = Con::evaluate( fieldValue, false ).value.getString();
+                pValue = Con::getReturnBuffer( Con::evaluate( fieldValue, false ).value.getString() );
 
             } break;
 
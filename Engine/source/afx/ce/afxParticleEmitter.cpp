@@ -969,10 +969,7 @@ void afxParticleEmitter::afx_emitParticles(const Point3F& start, const Point3F&
            {
              if (advanceMS > last_part->totalLifetime) 
              {
-               part_list_head.next = last_part->next;
-               n_parts--;
-               last_part->next = part_freelist;
-               part_freelist = last_part;
+               freeNewestParticle();
              } 
              else 
              {
@@ -1025,28 +1022,7 @@ void afxParticleEmitter::afx_emitParticles(const Point3F& start, const Point3F&
 
 Particle* afxParticleEmitter::alloc_particle()
 {
-  n_parts++;
-
-  // this should happen rarely
-  if (n_parts > n_part_capacity)
-  {
-    Particle* store_block = new Particle[16];
-    part_store.push_back(store_block);
-    n_part_capacity += 16;
-    for (S32 i = 0; i < 16; i++)
-    {
-      store_block[i].next = part_freelist;
-      part_freelist = &store_block[i];
-    }
-    mDataBlock->allocPrimBuffer(n_part_capacity);
-  }
-
-  Particle* pNew = part_freelist;
-  part_freelist = pNew->next;
-  pNew->next = part_list_head.next;
-  part_list_head.next = pNew;
-
-  return pNew;
+  return allocParticle();
 }
 
 ParticleData* afxParticleEmitter::pick_particle_type()
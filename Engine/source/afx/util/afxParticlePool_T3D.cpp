@@ -35,6 +35,9 @@
 
 void afxParticlePool::prepRenderImage(SceneRenderState* state)
 { 
+  // the pooled emitters may still have their simulation queued
+  ParticleEmitter::flushPendingUpdates();
+
   const LightInfo *sunlight = LIGHTMGR->getSpecialLight( LightManager::slSunLightType );
   pool_prepBatchRender(state->getRenderPass(), state->getCameraPosition(), sunlight->getAmbient());
 };
@@ -637,6 +637,7 @@ bool StandardMainLoop::doMainLoop()
          keepRunning = false;
 
       ThreadPool::processMainThreadWorkItems();
+      Con::processLog();
       Sampler::endFrame();
       ConsoleValue::resetConversionBuffer();
       PROFILE_END_NAMED(MainLoop);
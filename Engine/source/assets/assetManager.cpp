@@ -58,6 +58,30 @@
 #include "assets/autoloadAssets.h"
 #endif
 
+#ifndef _TAML_XMLPARSER_H_
+#include "persistence/taml/xml/tamlXmlParser.h"
+#endif
+
+#ifndef _FSTINYXML_H_
+#include "persistence/taml/fsTinyXml.h"
+#endif
+
+#ifndef _FILESTREAM_H_
+#include "core/stream/fileStream.h"
+#endif
+
+#ifndef _THREADPOOL_H_
+#include "platform/threads/threadPool.h"
+#endif
+
+#ifndef _PLATFORM_THREAD_SEMAPHORE_H_
+#include "platform/threads/semaphore.h"
+#endif
+
+#ifndef _PLATFORM_PLATFORMTIMER_H_
+#include "platform/platformTimer.h"
+#endif
+
 #ifndef GUI_ASSET_H
 #include "T3D/assets/GUIAsset.h"
 #endif
@@ -84,7 +108,28 @@ AssetManager AssetDatabase;
 
 //-----------------------------------------------------------------------------
 
+bool AssetManager::smParallelAssetScan = true;
+StringTableEntry AssetManager::smManifestCacheFile = NULL;
+
+/// Declared asset manifest cache file signature and version.
+static const U32 sManifestCacheSignature = makeFourCCTag( 'T', 'A', 'M', 'C' );
+static const U32 sManifestCacheVersion = 1;
+
+/// The number of asset files loaded by each declared asset load work item.
+static const U32 sAssetLoadBatchSize = 32;
+
+/// The maximum number of declared asset load work items in flight at once.
+/// This bounds the number of loaded documents waiting to be visited.
+static const U32 sMaxAssetLoadBatchesInFlight = 64;
+
+//-----------------------------------------------------------------------------
+
 AssetManager::AssetManager() :
+    mManifestCacheLoaded( false ),
+    mManifestCacheDirty( false ),
+    mScannedAssetFileCount( 0 ),
+    mCachedAssetFileCount( 0 ),
+    mAssetScanTime( 0 ),
     mLoadedInternalAssetsCount( 0 ),
     mLoadedExternalAssetsCount( 0 ),
     mLoadedPrivateAssetsCount( 0 ),
@@ -119,6 +164,10 @@ void AssetManager::onRemove()
         mAssetTagsManifest->deleteObject();
     }
 
+    // Persist the declared asset manifest for the next run.
+    saveManifestCache();
+    clearManifestCache();
+
     // Call parent.
     Parent::onRemove();
 }
@@ -137,6 +186,23 @@ void AssetManager::initPersistFields()
 
 //-----------------------------------------------------------------------------
 
+void AssetManager::consoleInit()
+{
+    // Call parent.
+    Parent::consoleInit();
+
+    Con::addVariable( "$AssetManager::parallelScan", TypeBool, &smParallelAssetScan,
+        "Whether asset files that need parsing during a declared asset scan are loaded on the thread pool or not.\n" );
+
+    Con::addVariable( "$AssetManager::manifestCacheFile", TypeString, &smManifestCacheFile,
+        "The file the declared asset manifest cache is kept in.  The cache records the declarations of each asset file "
+        "so that unchanged asset files are not parsed again on the next run.  An empty value disables the cache.\n" );
+
+    smManifestCacheFile = StringTable->insert( "data/cache/assetManifest.cache" );
+}
+
+//-----------------------------------------------------------------------------
+
 bool AssetManager::compileReferencedAssets( ModuleDefinition* pModuleDefinition )
 {
     // Debug Profiling.
@@ -1623,6 +1689,91 @@ void AssetManager::dumpDeclaredAssets( void ) const
     Con::printBlankLine();
 }
 
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::dumpDeclaredAssetScanStats( void ) const
+{
+    // Info.
+    Con::printSeparator();
+    Con::printf( "Asset Manager: Declared asset scans found %d asset file(s) in %dms.", mScannedAssetFileCount, mAssetScanTime );
+    Con::printf( "Asset Manager: > %d asset file(s) were taken from the manifest cache and %d were parsed.",
+        mCachedAssetFileCount, mScannedAssetFileCount - mCachedAssetFileCount );
+    Con::printf( "Asset Manager: > Manifest cache '%s' holds %d asset file(s).",
+        smManifestCacheFile != NULL ? smManifestCacheFile : "", mManifestCache.size() );
+    Con::printSeparator();
+    Con::printBlankLine();
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::benchmarkDeclaredAssetScan( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_BenchmarkDeclaredAssetScan);
+
+    // Fetch the asset files of the declared assets.
+    Vector<StringTableEntry> assetFiles;
+    for( typeDeclaredAssetsHash::iterator assetItr = mDeclaredAssets.begin(); assetItr != mDeclaredAssets.end(); ++assetItr )
+    {
+        // Skip private assets as they have no asset file.
+        if ( assetItr->value->mAssetPrivate )
+            continue;
+
+        assetFiles.push_back( assetItr->value->mAssetBaseFilePath );
+    }
+
+    // Finish if there's nothing to scan.
+    if ( assetFiles.empty() )
+    {
+        // Warn.
+        Con::warnf( "AssetManager::benchmarkDeclaredAssetScan() - No declared assets to scan." );
+        return;
+    }
+
+    PlatformTimer* pTimer = PlatformTimer::create();
+    Vector<DeclaredAssetManifestEntry*> manifestEntries;
+
+    // Parse every asset file on the main thread.
+    pTimer->reset();
+    gatherDeclaredAssets( assetFiles, false, false, manifestEntries );
+    const S32 serialTime = pTimer->getElapsedMs();
+    for ( U32 i = 0; i < (U32)manifestEntries.size(); ++i )
+        delete manifestEntries[i];
+
+    // Parse every asset file with the loading on the thread pool.
+    pTimer->reset();
+    gatherDeclaredAssets( assetFiles, false, true, manifestEntries );
+    const S32 parallelTime = pTimer->getElapsedMs();
+    for ( U32 i = 0; i < (U32)manifestEntries.size(); ++i )
+        delete manifestEntries[i];
+
+    // Scan using the manifest cache, warming it up first.
+    const bool useCache = smManifestCacheFile != NULL && *smManifestCacheFile != 0;
+    S32 cachedTime = -1;
+    if ( useCache )
+    {
+        gatherDeclaredAssets( assetFiles, true, true, manifestEntries );
+        pTimer->reset();
+        gatherDeclaredAssets( assetFiles, true, true, manifestEntries );
+        cachedTime = pTimer->getElapsedMs();
+    }
+
+    delete pTimer;
+
+    // Info.
+    Con::printSeparator();
+    Con::printf( "Asset Manager: Scanned %d declared asset file(s):", assetFiles.size() );
+    Con::printf( "Asset Manager: > Serial parse: %dms", serialTime );
+    Con::printf( "Asset Manager: > Parallel parse: %dms", parallelTime );
+    if ( useCache )
+        Con::printf( "Asset Manager: > Manifest cache: %dms", cachedTime );
+    else
+        Con::printf( "Asset Manager: > Manifest cache: disabled" );
+    Con::printSeparator();
+    Con::printBlankLine();
+}
+
 //-----------------------------------------------------------------------------
 
 S32 AssetManager::findAllAssets( AssetQuery* pAssetQuery, const bool ignoreInternal, const bool ignorePrivate )
@@ -2393,6 +2544,9 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
     // Debug Profiling.
     PROFILE_SCOPE(AssetManager_ScanDeclaredAssets);
 
+    // Note the start time for the scan statistics.
+    const U32 scanStartTime = Platform::getRealMilliseconds();
+
     // Sanity!
     AssertFatal( pPath != NULL, "Cannot scan declared assets with NULL path." );
     AssertFatal( pExtension != NULL, "Cannot scan declared assets with NULL extension." );
@@ -2433,146 +2587,584 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
         Con::printf( "Asset Manager: Scanning for declared assets in path '%s' for files with extension '%s'...", relativePath.c_str(), pExtension );
     }
 
-    // Fetch module assets.
-    ModuleDefinition::typeModuleAssetsVector& moduleAssets = pModuleDefinition->getModuleAssets();
-
-    TamlAssetDeclaredVisitor assetDeclaredVisitor;
-
-    // Iterate files.
+    // Format the full asset file-paths, expanded as the parser would.
+    Vector<StringTableEntry> assetFiles;
+    assetFiles.reserve( numAssets );
     for (S32 i = 0; i < numAssets; ++i)
     {
         Torque::Path assetPath = files[i];
 
-        // Clear declared assets.
-        assetDeclaredVisitor.clear();
-
         // Format full file-path.
         char assetFileBuffer[1024];
         dSprintf( assetFileBuffer, sizeof(assetFileBuffer), "%s/%s", assetPath.getPath().c_str(), assetPath.getFullFileName().c_str());
 
-        // Parse the filename.
-        if ( !mTaml.parse( assetFileBuffer, assetDeclaredVisitor ) )
-        {
-            // Warn.
-            Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFileBuffer );
+        // Expand the file-path.
+        char expandedFileBuffer[1024];
+        Con::expandScriptFilename( expandedFileBuffer, sizeof(expandedFileBuffer), assetFileBuffer );
+
+        assetFiles.push_back( StringTable->insert( expandedFileBuffer ) );
+    }
+
+    // Fetch the asset declarations, either from the manifest cache or by parsing the asset files.
+    const bool useCache = smManifestCacheFile != NULL && *smManifestCacheFile != 0;
+    Vector<DeclaredAssetManifestEntry*> manifestEntries;
+    const U32 cachedCount = gatherDeclaredAssets( assetFiles, useCache, smParallelAssetScan, manifestEntries );
+
+    // Iterate asset declarations.
+    for ( U32 i = 0; i < (U32)manifestEntries.size(); ++i )
+    {
+        // Skip if the asset file did not declare an asset.
+        if ( manifestEntries[i] == NULL )
             continue;
+
+        // Add the declared asset.
+        addDeclaredAssetEntry( *manifestEntries[i], pModuleDefinition );
+
+        // Delete the declaration unless the manifest cache owns it.
+        if ( !useCache )
+            delete manifestEntries[i];
+    }
+
+    // Update statistics.
+    mScannedAssetFileCount += numAssets;
+    mCachedAssetFileCount += cachedCount;
+    mAssetScanTime += Platform::getRealMilliseconds() - scanStartTime;
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printSeparator();
+        Con::printf( "Asset Manager: ... Finished scanning for declared assets in path '%s' for files with extension '%s'.", relativePath.c_str(), pExtension );
+        Con::printSeparator();
+        Con::printBlankLine();
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+/// Loads a batch of TAML XML asset files into documents on a worker thread.
+///
+/// Only the file reading and XML parsing happen here.  Visiting the documents
+/// is left to the main thread as the visitors and the string table are not
+/// thread-safe.
+class DeclaredAssetLoadWorkItem : public ThreadPool::WorkItem
+{
+public:
+    typedef ThreadPool::WorkItem Parent;
+
+    struct AssetFile
+    {
+        StringTableEntry    mFilename;
+        U32                 mIndex;
+        VfsXMLDocument*     mDocument;
+        bool                mLoaded;
+    };
+
+    Vector<AssetFile> mAssetFiles;
+
+    DeclaredAssetLoadWorkItem( Semaphore* pCompletion ) :
+        mCompletion( pCompletion ),
+        mFinished( 0 )
+    {
+    }
+
+    virtual ~DeclaredAssetLoadWorkItem()
+    {
+        freeDocuments();
+    }
+
+    bool isFinished() { return dAtomicRead( mFinished ) != 0; }
+
+    void freeDocuments()
+    {
+        for ( U32 i = 0; i < (U32)mAssetFiles.size(); ++i )
+        {
+            delete mAssetFiles[i].mDocument;
+            mAssetFiles[i].mDocument = NULL;
         }
+    }
 
-        // Fetch asset definition.
-        AssetDefinition& foundAssetDefinition = assetDeclaredVisitor.getAssetDefinition();
+protected:
+    Semaphore* mCompletion;
+    volatile U32 mFinished;
 
-        // Did we get an asset name?
-        if ( foundAssetDefinition.mAssetName == StringTable->EmptyString() )
+    void execute() override
+    {
+        for ( U32 i = 0; i < (U32)mAssetFiles.size(); ++i )
         {
-            // No, so warn.
-            Con::warnf( "Asset Manager: Parsed file '%s' but did not encounter an asset.", assetFileBuffer );
-            continue;
+            AssetFile& assetFile = mAssetFiles[i];
+
+            // Non XML files are left for the main thread.
+            if ( assetFile.mFilename == NULL )
+                continue;
+
+            FileStream stream;
+            if ( !stream.open( assetFile.mFilename, Torque::FS::File::Read ) )
+                continue;
+
+            assetFile.mDocument = new VfsXMLDocument();
+            assetFile.mLoaded = assetFile.mDocument->LoadFile( stream );
+            stream.close();
         }
 
-        // Set module definition.
-        foundAssetDefinition.mpModuleDefinition = pModuleDefinition;
+        finish();
+    }
+
+    void onCancelled() override
+    {
+        // Files that were not loaded get parsed on the main thread.
+        finish();
+    }
+
+    void finish()
+    {
+        dCompareAndSwap( mFinished, 0, 1 );
+        mCompletion->release();
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+U32 AssetManager::gatherDeclaredAssets( const Vector<StringTableEntry>& assetFiles, const bool useCache, const bool parallel, Vector<DeclaredAssetManifestEntry*>& manifestEntries )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_GatherDeclaredAssets);
+
+    // Load the manifest cache if it's not been loaded yet.
+    if ( useCache && !mManifestCacheLoaded )
+        loadManifestCache();
 
-        // Format asset Id.
-        char assetIdBuffer[1024];
-        dSprintf(assetIdBuffer, sizeof(assetIdBuffer), "%s%s%s",
-            pModuleDefinition->getModuleId(),
-            ASSET_SCOPE_TOKEN,
-            foundAssetDefinition.mAssetName );
+    const U32 assetFileCount = assetFiles.size();
 
-        // Set asset Id.
-        foundAssetDefinition.mAssetId = StringTable->insert( assetIdBuffer );
+    manifestEntries.setSize( assetFileCount );
 
-        // Does this asset already exist?
-        if ( mDeclaredAssets.contains( foundAssetDefinition.mAssetId ) )
+    Vector<U64> fileSizes;
+    Vector<U64> modifiedTimes;
+    fileSizes.setSize( assetFileCount );
+    modifiedTimes.setSize( assetFileCount );
+
+    Vector<U32> parseIndices;
+    U32 cachedCount = 0;
+
+    // Iterate asset files.
+    for ( U32 i = 0; i < assetFileCount; ++i )
+    {
+        manifestEntries[i] = NULL;
+        fileSizes[i] = 0;
+        modifiedTimes[i] = 0;
+
+        if ( useCache )
         {
-            // Yes, so warn.
-            Con::warnf( "Asset Manager: Encountered asset Id '%s' in asset file '%s' but it conflicts with existing asset Id in asset file '%s'.",
-                foundAssetDefinition.mAssetId,
-                foundAssetDefinition.mAssetBaseFilePath,
-                mDeclaredAssets.find( foundAssetDefinition.mAssetId )->value->mAssetBaseFilePath );
+            // Fetch the file size and modification time.
+            Torque::FS::FileNodeRef fileNode = Torque::FS::GetFileNode( assetFiles[i] );
+            Torque::FS::FileNode::Attributes attributes;
+            if ( fileNode != NULL && fileNode->getAttributes( &attributes ) )
+            {
+                fileSizes[i] = attributes.size;
+                modifiedTimes[i] = (U64)attributes.mtime.getInternalRepresentation();
+            }
 
-            continue;
+            // Use the cached declaration if the file has not changed since it was cached.
+            typeManifestCacheHash::iterator cacheItr = mManifestCache.find( assetFiles[i] );
+            if ( cacheItr != mManifestCache.end() &&
+                 cacheItr->value->mFileSize == fileSizes[i] &&
+                 cacheItr->value->mModifiedTime == modifiedTimes[i] )
+            {
+                manifestEntries[i] = cacheItr->value;
+                cachedCount++;
+                continue;
+            }
         }
 
-        // Create new asset definition.
-        AssetDefinition* pAssetDefinition = new AssetDefinition( foundAssetDefinition );
+        // Note as needing a parse.
+        parseIndices.push_back( i );
+    }
 
-        // Store in declared assets.
-        mDeclaredAssets.insert( pAssetDefinition->mAssetId, pAssetDefinition );
+    TamlAssetDeclaredVisitor assetDeclaredVisitor;
+    TamlXmlParser xmlParser;
 
-        // Store in module assets.
-        moduleAssets.push_back( pAssetDefinition );
-        
-        // Info.
-        if ( mEchoInfo )
+    // Are we loading the asset files in parallel?
+    if ( parallel && parseIndices.size() > 1 )
+    {
+        // Yes, so batch the asset files the XML parser can handle.
+        Semaphore completion( 0 );
+        Vector< ThreadSafeRef<DeclaredAssetLoadWorkItem> > loadBatches;
+        for ( U32 i = 0; i < (U32)parseIndices.size(); ++i )
         {
-            Con::printSeparator();
-            Con::printf( "Asset Manager: Adding Asset Id '%s' of type '%s' in asset file '%s'.",
-                pAssetDefinition->mAssetId,
-                pAssetDefinition->mAssetType,
-                pAssetDefinition->mAssetBaseFilePath );
-        }
+            if ( loadBatches.empty() || loadBatches.last()->mAssetFiles.size() == sAssetLoadBatchSize )
+                loadBatches.push_back( new DeclaredAssetLoadWorkItem( &completion ) );
 
-        // Fetch asset Id.
-        StringTableEntry assetId = pAssetDefinition->mAssetId;
+            DeclaredAssetLoadWorkItem::AssetFile assetFile;
+            assetFile.mFilename = assetFiles[parseIndices[i]];
+            assetFile.mIndex = parseIndices[i];
+            assetFile.mDocument = NULL;
+            assetFile.mLoaded = false;
 
-        // Fetch asset dependencies.
-        TamlAssetDeclaredVisitor::typeAssetIdVector& assetDependencies = assetDeclaredVisitor.getAssetDependencies();
+            // Only XML asset files are loaded by the batch.
+            if ( mTaml.getFileAutoFormatMode( assetFile.mFilename ) != Taml::XmlFormat )
+                assetFile.mFilename = NULL;
 
-        // Are there any asset dependencies?
-        if ( assetDependencies.size() > 0 )
+            loadBatches.last()->mAssetFiles.push_back( assetFile );
+        }
+
+        const U32 batchCount = loadBatches.size();
+        U32 queuedCount = 0;
+        U32 completedCount = 0;
+
+        // Visit the batches in order as they're loaded, keeping a bounded number in flight.
+        for ( U32 batchIndex = 0; batchIndex < batchCount; ++batchIndex )
         {
-            // Yes, so iterate dependencies.
-            for( TamlAssetDeclaredVisitor::typeAssetIdVector::iterator assetDependencyItr = assetDependencies.begin(); assetDependencyItr != assetDependencies.end(); ++assetDependencyItr )
+            while ( queuedCount < batchCount && queuedCount - batchIndex < sMaxAssetLoadBatchesInFlight )
+                ThreadPool::GLOBAL().queueWorkItem( loadBatches[queuedCount++] );
+
+            DeclaredAssetLoadWorkItem* pLoadBatch = loadBatches[batchIndex];
+
+            // Wait for the batch to be loaded.
+            while ( !pLoadBatch->isFinished() )
             {
-                // Fetch asset Ids.
-                StringTableEntry dependencyAssetId = *assetDependencyItr;
+                completion.acquire();
+                completedCount++;
+            }
 
-                // Insert depends-on.
-                mAssetDependsOn.insertEqual( assetId, dependencyAssetId );
+            // Iterate the batch asset files.
+            for ( U32 i = 0; i < (U32)pLoadBatch->mAssetFiles.size(); ++i )
+            {
+                const DeclaredAssetLoadWorkItem::AssetFile& assetFile = pLoadBatch->mAssetFiles[i];
+                StringTableEntry assetFilename = assetFiles[assetFile.mIndex];
 
-                // Insert is-depended-on.
-                mAssetIsDependedOn.insertEqual( dependencyAssetId, assetId );
+                // Clear declared assets.
+                assetDeclaredVisitor.clear();
 
-                // Info.
-                if ( mEchoInfo )
+                // Visit the loaded document, or parse the file here if it couldn't be loaded.
+                const bool parsed = assetFile.mLoaded ?
+                    xmlParser.accept( assetFilename, *assetFile.mDocument, assetDeclaredVisitor ) :
+                    mTaml.parse( assetFilename, assetDeclaredVisitor );
+
+                if ( !parsed )
                 {
-                    Con::printf( "Asset Manager: Asset Id '%s' has dependency of Asset Id '%s'", assetId, dependencyAssetId );
+                    // Warn.
+                    Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFilename );
+                    continue;
                 }
+
+                manifestEntries[assetFile.mIndex] = createManifestEntry( assetDeclaredVisitor, assetFilename );
             }
-        }
 
-        // Fetch asset loose files.
-        TamlAssetDeclaredVisitor::typeLooseFileVector& assetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
+            // Release the batch documents.
+            pLoadBatch->freeDocuments();
+            loadBatches[batchIndex] = NULL;
+        }
 
-        // Are there any loose files?
-        if ( assetLooseFiles.size() > 0 )
+        // Consume the outstanding completions so no worker is left using the semaphore.
+        while ( completedCount < batchCount )
         {
-            // Yes, so iterate loose files.
-            for( TamlAssetDeclaredVisitor::typeLooseFileVector::iterator assetLooseFileItr = assetLooseFiles.begin(); assetLooseFileItr != assetLooseFiles.end(); ++assetLooseFileItr )
-            {
-                // Fetch loose file.
-                StringTableEntry looseFile = *assetLooseFileItr;
+            completion.acquire();
+            completedCount++;
+        }
+    }
+    else
+    {
+        // No, so iterate the asset files to parse.
+        for ( U32 i = 0; i < (U32)parseIndices.size(); ++i )
+        {
+            StringTableEntry assetFilename = assetFiles[parseIndices[i]];
 
-                // Info.
-                if ( mEchoInfo )
-                {
-                    Con::printf( "Asset Manager: Asset Id '%s' has loose file '%s'.", assetId, looseFile );
-                }
+            // Clear declared assets.
+            assetDeclaredVisitor.clear();
 
-                // Store loose file.
-                pAssetDefinition->mAssetLooseFiles.push_back( looseFile );
+            // Parse the filename.
+            if ( !mTaml.parse( assetFilename, assetDeclaredVisitor ) )
+            {
+                // Warn.
+                Con::warnf( "Asset Manager: Failed to parse file containing asset declaration: '%s'.", assetFilename );
+                continue;
             }
+
+            manifestEntries[parseIndices[i]] = createManifestEntry( assetDeclaredVisitor, assetFilename );
         }
     }
 
+    // Finish if we're not caching.
+    if ( !useCache )
+        return cachedCount;
+
+    // Update the manifest cache with the parsed asset files.
+    for ( U32 i = 0; i < (U32)parseIndices.size(); ++i )
+    {
+        const U32 index = parseIndices[i];
+        StringTableEntry assetFilename = assetFiles[index];
+
+        // Remove any stale declaration.
+        typeManifestCacheHash::iterator cacheItr = mManifestCache.find( assetFilename );
+        if ( cacheItr != mManifestCache.end() )
+        {
+            delete cacheItr->value;
+            mManifestCache.erase( cacheItr );
+        }
+
+        mManifestCacheDirty = true;
+
+        // Skip if the asset file did not declare an asset.
+        DeclaredAssetManifestEntry* pManifestEntry = manifestEntries[index];
+        if ( pManifestEntry == NULL )
+            continue;
+
+        pManifestEntry->mFileSize = fileSizes[index];
+        pManifestEntry->mModifiedTime = modifiedTimes[index];
+        mManifestCache.insert( assetFilename, pManifestEntry );
+    }
+
+    return cachedCount;
+}
+
+//-----------------------------------------------------------------------------
+
+AssetManager::DeclaredAssetManifestEntry* AssetManager::createManifestEntry( TamlAssetDeclaredVisitor& assetDeclaredVisitor, const char* pAssetFile )
+{
+    // Fetch asset definition.
+    AssetDefinition& foundAssetDefinition = assetDeclaredVisitor.getAssetDefinition();
+
+    // Did we get an asset name?
+    if ( foundAssetDefinition.mAssetName == StringTable->EmptyString() )
+    {
+        // No, so warn.
+        Con::warnf( "Asset Manager: Parsed file '%s' but did not encounter an asset.", pAssetFile );
+        return NULL;
+    }
+
+    // Create the asset declaration.
+    DeclaredAssetManifestEntry* pManifestEntry = new DeclaredAssetManifestEntry();
+    pManifestEntry->mFileSize = 0;
+    pManifestEntry->mModifiedTime = 0;
+    pManifestEntry->mAssetDefinition = foundAssetDefinition;
+    pManifestEntry->mAssetDependencies = assetDeclaredVisitor.getAssetDependencies();
+    pManifestEntry->mAssetLooseFiles = assetDeclaredVisitor.getAssetLooseFiles();
+
+    return pManifestEntry;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::addDeclaredAssetEntry( const DeclaredAssetManifestEntry& manifestEntry, ModuleDefinition* pModuleDefinition )
+{
+    // Fetch module assets.
+    ModuleDefinition::typeModuleAssetsVector& moduleAssets = pModuleDefinition->getModuleAssets();
+
+    // Fetch asset definition.
+    AssetDefinition foundAssetDefinition( manifestEntry.mAssetDefinition );
+
+    // Set module definition.
+    foundAssetDefinition.mpModuleDefinition = pModuleDefinition;
+
+    // Format asset Id.
+    char assetIdBuffer[1024];
+    dSprintf(assetIdBuffer, sizeof(assetIdBuffer), "%s%s%s",
+        pModuleDefinition->getModuleId(),
+        ASSET_SCOPE_TOKEN,
+        foundAssetDefinition.mAssetName );
+
+    // Set asset Id.
+    foundAssetDefinition.mAssetId = StringTable->insert( assetIdBuffer );
+
+    // Does this asset already exist?
+    if ( mDeclaredAssets.contains( foundAssetDefinition.mAssetId ) )
+    {
+        // Yes, so warn.
+        Con::warnf( "Asset Manager: Encountered asset Id '%s' in asset file '%s' but it conflicts with existing asset Id in asset file '%s'.",
+            foundAssetDefinition.mAssetId,
+            foundAssetDefinition.mAssetBaseFilePath,
+            mDeclaredAssets.find( foundAssetDefinition.mAssetId )->value->mAssetBaseFilePath );
+
+        return;
+    }
+
+    // Create new asset definition.
+    AssetDefinition* pAssetDefinition = new AssetDefinition( foundAssetDefinition );
+
+    // Store in declared assets.
+    mDeclaredAssets.insert( pAssetDefinition->mAssetId, pAssetDefinition );
+
+    // Store in module assets.
+    moduleAssets.push_back( pAssetDefinition );
+    
     // Info.
     if ( mEchoInfo )
     {
         Con::printSeparator();
-        Con::printf( "Asset Manager: ... Finished scanning for declared assets in path '%s' for files with extension '%s'.", relativePath.c_str(), pExtension );
-        Con::printSeparator();
-        Con::printBlankLine();
+        Con::printf( "Asset Manager: Adding Asset Id '%s' of type '%s' in asset file '%s'.",
+            pAssetDefinition->mAssetId,
+            pAssetDefinition->mAssetType,
+            pAssetDefinition->mAssetBaseFilePath );
+    }
+
+    // Fetch asset Id.
+    StringTableEntry assetId = pAssetDefinition->mAssetId;
+
+    // Iterate asset dependencies.
+    for( Vector<typeAssetId>::const_iterator assetDependencyItr = manifestEntry.mAssetDependencies.begin(); assetDependencyItr != manifestEntry.mAssetDependencies.end(); ++assetDependencyItr )
+    {
+        // Fetch asset Ids.
+        StringTableEntry dependencyAssetId = *assetDependencyItr;
+
+        // Insert depends-on.
+        mAssetDependsOn.insertEqual( assetId, dependencyAssetId );
+
+        // Insert is-depended-on.
+        mAssetIsDependedOn.insertEqual( dependencyAssetId, assetId );
+
+        // Info.
+        if ( mEchoInfo )
+        {
+            Con::printf( "Asset Manager: Asset Id '%s' has dependency of Asset Id '%s'", assetId, dependencyAssetId );
+        }
+    }
+
+    // Iterate asset loose files.
+    for( Vector<StringTableEntry>::const_iterator assetLooseFileItr = manifestEntry.mAssetLooseFiles.begin(); assetLooseFileItr != manifestEntry.mAssetLooseFiles.end(); ++assetLooseFileItr )
+    {
+        // Fetch loose file.
+        StringTableEntry looseFile = *assetLooseFileItr;
+
+        // Info.
+        if ( mEchoInfo )
+        {
+            Con::printf( "Asset Manager: Asset Id '%s' has loose file '%s'.", assetId, looseFile );
+        }
+
+        // Store loose file.
+        pAssetDefinition->mAssetLooseFiles.push_back( looseFile );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+static void writeManifestString( Stream& stream, const char* pString )
+{
+    const U32 length = dStrlen( pString );
+    stream.write( length );
+    stream.write( length, pString );
+}
+
+static bool readManifestString( Stream& stream, Vector<char>& buffer, StringTableEntry& string )
+{
+    U32 length;
+    if ( !stream.read( &length ) || length > 65535 )
+        return false;
+
+    buffer.setSize( length + 1 );
+    if ( length > 0 && !stream.read( length, buffer.address() ) )
+        return false;
+
+    buffer[length] = 0;
+    string = StringTable->insert( buffer.address() );
+    return true;
+}
+
+static bool readManifestStrings( Stream& stream, Vector<char>& buffer, Vector<StringTableEntry>& strings )
+{
+    U32 count;
+    if ( !stream.read( &count ) || count > 65535 )
+        return false;
+
+    strings.setSize( count );
+    for ( U32 i = 0; i < count; ++i )
+    {
+        if ( !readManifestString( stream, buffer, strings[i] ) )
+            return false;
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+bool AssetManager::loadManifestCache( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_LoadManifestCache);
+
+    // Flag as loaded so we only try once.
+    mManifestCacheLoaded = true;
+
+    // Finish if the cache is disabled.
+    if ( smManifestCacheFile == NULL || *smManifestCacheFile == 0 )
+        return false;
+
+    // Expand the cache file-path.
+    char cacheFileBuffer[1024];
+    Con::expandScriptFilename( cacheFileBuffer, sizeof(cacheFileBuffer), smManifestCacheFile );
+
+    // Finish if there's no cache yet.
+    if ( !Torque::FS::IsFile( cacheFileBuffer ) )
+        return false;
+
+    FileStream stream;
+    if ( !stream.open( cacheFileBuffer, Torque::FS::File::Read ) )
+    {
+        // Warn.
+        Con::warnf( "Asset Manager: Could not open declared asset manifest cache '%s'.", cacheFileBuffer );
+        return false;
+    }
+
+    // Check the header.
+    U32 signature, version, entryCount;
+    if ( !stream.read( &signature ) || signature != sManifestCacheSignature ||
+         !stream.read( &version ) || version != sManifestCacheVersion ||
+         !stream.read( &entryCount ) )
+    {
+        // Warn.
+        Con::warnf( "Asset Manager: Ignoring declared asset manifest cache '%s' as it is not a supported version.", cacheFileBuffer );
+        return false;
+    }
+
+    Vector<char> buffer;
+
+    // Iterate entries.
+    for ( U32 i = 0; i < entryCount; ++i )
+    {
+        DeclaredAssetManifestEntry* pManifestEntry = new DeclaredAssetManifestEntry();
+        AssetDefinition& assetDefinition = pManifestEntry->mAssetDefinition;
+
+        StringTableEntry assetFile;
+        if ( !readManifestString( stream, buffer, assetFile ) ||
+             !stream.read( &pManifestEntry->mFileSize ) ||
+             !stream.read( &pManifestEntry->mModifiedTime ) ||
+             !readManifestString( stream, buffer, assetDefinition.mAssetBaseFilePath ) ||
+             !readManifestString( stream, buffer, assetDefinition.mAssetName ) ||
+             !readManifestString( stream, buffer, assetDefinition.mAssetDescription ) ||
+             !readManifestString( stream, buffer, assetDefinition.mAssetCategory ) ||
+             !readManifestString( stream, buffer, assetDefinition.mAssetType ) ||
+             !stream.read( &assetDefinition.mAssetAutoUnload ) ||
+             !stream.read( &assetDefinition.mAssetInternal ) ||
+             !readManifestStrings( stream, buffer, pManifestEntry->mAssetDependencies ) ||
+             !readManifestStrings( stream, buffer, pManifestEntry->mAssetLooseFiles ) )
+        {
+            // Warn.
+            Con::warnf( "Asset Manager: Ignoring declared asset manifest cache '%s' as it is corrupt.", cacheFileBuffer );
+            delete pManifestEntry;
+            clearManifestCache();
+            return false;
+        }
+
+        // Store the entry, replacing any duplicate.
+        typeManifestCacheHash::iterator cacheItr = mManifestCache.find( assetFile );
+        if ( cacheItr != mManifestCache.end() )
+        {
+            delete cacheItr->value;
+            cacheItr->value = pManifestEntry;
+        }
+        else
+        {
+            mManifestCache.insert( assetFile, pManifestEntry );
+        }
+    }
+
+    // Info.
+    if ( mEchoInfo )
+    {
+        Con::printf( "Asset Manager: Loaded %d declared asset(s) from manifest cache '%s'.", mManifestCache.size(), cacheFileBuffer );
     }
 
     return true;
@@ -2580,6 +3172,79 @@ bool AssetManager::scanDeclaredAssets( const char* pPath, const char* pExtension
 
 //-----------------------------------------------------------------------------
 
+bool AssetManager::saveManifestCache( void )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(AssetManager_SaveManifestCache);
+
+    // Finish if nothing has changed or the cache is disabled.
+    if ( !mManifestCacheDirty || smManifestCacheFile == NULL || *smManifestCacheFile == 0 )
+        return false;
+
+    // Expand the cache file-path.
+    char cacheFileBuffer[1024];
+    Con::expandScriptFilename( cacheFileBuffer, sizeof(cacheFileBuffer), smManifestCacheFile );
+
+    FileStream stream;
+    if ( !Torque::FS::CreatePath( cacheFileBuffer ) || !stream.open( cacheFileBuffer, Torque::FS::File::Write ) )
+    {
+        // Warn.
+        Con::warnf( "Asset Manager: Could not open declared asset manifest cache '%s' for write.", cacheFileBuffer );
+        return false;
+    }
+
+    // Write the header.
+    stream.write( sManifestCacheSignature );
+    stream.write( sManifestCacheVersion );
+    stream.write( (U32)mManifestCache.size() );
+
+    // Iterate entries.
+    for( typeManifestCacheHash::iterator cacheItr = mManifestCache.begin(); cacheItr != mManifestCache.end(); ++cacheItr )
+    {
+        const DeclaredAssetManifestEntry* pManifestEntry = cacheItr->value;
+        const AssetDefinition& assetDefinition = pManifestEntry->mAssetDefinition;
+
+        writeManifestString( stream, cacheItr->key );
+        stream.write( pManifestEntry->mFileSize );
+        stream.write( pManifestEntry->mModifiedTime );
+        writeManifestString( stream, assetDefinition.mAssetBaseFilePath );
+        writeManifestString( stream, assetDefinition.mAssetName );
+        writeManifestString( stream, assetDefinition.mAssetDescription );
+        writeManifestString( stream, assetDefinition.mAssetCategory );
+        writeManifestString( stream, assetDefinition.mAssetType );
+        stream.write( assetDefinition.mAssetAutoUnload );
+        stream.write( assetDefinition.mAssetInternal );
+
+        stream.write( (U32)pManifestEntry->mAssetDependencies.size() );
+        for ( U32 i = 0; i < (U32)pManifestEntry->mAssetDependencies.size(); ++i )
+            writeManifestString( stream, pManifestEntry->mAssetDependencies[i] );
+
+        stream.write( (U32)pManifestEntry->mAssetLooseFiles.size() );
+        for ( U32 i = 0; i < (U32)pManifestEntry->mAssetLooseFiles.size(); ++i )
+            writeManifestString( stream, pManifestEntry->mAssetLooseFiles[i] );
+    }
+
+    stream.close();
+
+    mManifestCacheDirty = false;
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void AssetManager::clearManifestCache( void )
+{
+    // Delete the entries.
+    for( typeManifestCacheHash::iterator cacheItr = mManifestCache.begin(); cacheItr != mManifestCache.end(); ++cacheItr )
+        delete cacheItr->value;
+
+    mManifestCache.clear();
+    mManifestCacheDirty = false;
+}
+
+//-----------------------------------------------------------------------------
+
 bool AssetManager::scanReferencedAssets( const char* pPath, const char* pExtension, const bool recurse )
 {
     // Debug Profiling.
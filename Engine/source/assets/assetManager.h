@@ -66,6 +66,7 @@
 
 class AssetPtrCallback;
 class AssetPtrBase;
+class TamlAssetDeclaredVisitor;
 
 //-----------------------------------------------------------------------------
 
@@ -84,6 +85,19 @@ public:
    typedef HashTable<typeAssetId, typeAssetId> typeAssetIsDependedOnHash;
    typedef HashMap<AssetPtrBase*, AssetPtrCallback*> typeAssetPtrRefreshHash;
 
+   /// A declared asset file as found by parsing it.  These are kept in the
+   /// manifest cache, keyed on the asset file-path, so that asset files which
+   /// have not changed since the last scan need not be parsed again.
+   struct DeclaredAssetManifestEntry
+   {
+      U64                               mFileSize;
+      U64                               mModifiedTime;
+      AssetDefinition                   mAssetDefinition;
+      Vector<typeAssetId>               mAssetDependencies;
+      Vector<StringTableEntry>          mAssetLooseFiles;
+   };
+   typedef HashMap<StringTableEntry, DeclaredAssetManifestEntry*> typeManifestCacheHash;
+
 private:
     /// Declared assets.
     typeDeclaredAssetsHash              mDeclaredAssets;
@@ -102,6 +116,16 @@ private:
     /// Asset pointer refresh notifications.
     typeAssetPtrRefreshHash             mAssetPtrRefreshNotifications;
 
+    /// Declared asset manifest cache.
+    typeManifestCacheHash               mManifestCache;
+    bool                                mManifestCacheLoaded;
+    bool                                mManifestCacheDirty;
+
+    /// Declared asset scan statistics.
+    U32                                 mScannedAssetFileCount;
+    U32                                 mCachedAssetFileCount;
+    U32                                 mAssetScanTime;
+
     /// Miscellaneous.
     bool                                mEchoInfo;
     bool                                mIgnoreAutoUnload;
@@ -114,6 +138,13 @@ private:
     U32                                 mMaxLoadedPrivateAssetsCount;
     Taml                                mTaml;
 
+public:
+    /// Whether changed asset files are parsed on the thread pool during declared asset scans.
+    static bool                         smParallelAssetScan;
+
+    /// The file the declared asset manifest cache is kept in.  Empty disables the cache.
+    static StringTableEntry             smManifestCacheFile;
+
 public:
     AssetManager();
     virtual ~AssetManager() {}
@@ -122,6 +153,7 @@ public:
     bool onAdd() override;
     void onRemove() override;
     static void initPersistFields();
+    static void consoleInit();
 
     /// Declared assets.
     bool addModuleDeclaredAssets( ModuleDefinition* pModuleDefinition );
@@ -351,6 +383,13 @@ public:
     inline U32 getMaxLoadedExternalAssetCount( void ) const { return mMaxLoadedExternalAssetsCount; }
     inline U32 getMaxLoadedPrivateAssetCount( void ) const { return mMaxLoadedPrivateAssetsCount; }
     void dumpDeclaredAssets( void ) const;
+    void dumpDeclaredAssetScanStats( void ) const;
+    void benchmarkDeclaredAssetScan( void );
+
+    /// Declared asset manifest cache.
+    bool loadManifestCache( void );
+    bool saveManifestCache( void );
+    void clearManifestCache( void );
 
     /// Total acquired asset references.
     inline void acquireAcquiredReferenceCount( void ) { mAcquiredReferenceCount++; }
@@ -378,6 +417,9 @@ public:
 
 private:
     bool scanDeclaredAssets( const char* pPath, const char* pExtension, const bool recurse, ModuleDefinition* pModuleDefinition );
+    U32 gatherDeclaredAssets( const Vector<StringTableEntry>& assetFiles, const bool useCache, const bool parallel, Vector<DeclaredAssetManifestEntry*>& manifestEntries );
+    DeclaredAssetManifestEntry* createManifestEntry( TamlAssetDeclaredVisitor& assetDeclaredVisitor, const char* pAssetFile );
+    void addDeclaredAssetEntry( const DeclaredAssetManifestEntry& manifestEntry, ModuleDefinition* pModuleDefinition );
     bool scanReferencedAssets( const char* pPath, const char* pExtension, const bool recurse );
     AssetDefinition* findAsset( const char* pAssetId );
     void addReferencedAsset( StringTableEntry assetId, StringTableEntry referenceFilePath );
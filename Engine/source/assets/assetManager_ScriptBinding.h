@@ -809,3 +809,30 @@ DefineEngineMethod(AssetManager, dumpDeclaredAssets, void, (), ,
 {
     return object->dumpDeclaredAssets();
 }
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod(AssetManager, dumpDeclaredAssetScanStats, void, (), ,
+   "Dumps the time spent scanning for declared assets and how many asset files were taken from the manifest cache.\n"
+   "@return No return value.\n")
+{
+    return object->dumpDeclaredAssetScanStats();
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod(AssetManager, benchmarkDeclaredAssetScan, void, (), ,
+   "Times scanning the asset files of all declared assets serially, in parallel and using the manifest cache.\n"
+   "@return No return value.\n")
+{
+    return object->benchmarkDeclaredAssetScan();
+}
+
+//-----------------------------------------------------------------------------
+
+DefineEngineMethod(AssetManager, saveManifestCache, bool, (), ,
+   "Saves the declared asset manifest cache if it has changed.  This is done automatically on shutdown.\n"
+   "@return Whether the manifest cache was saved or not.\n")
+{
+    return object->saveManifestCache();
+}
@@ -459,6 +459,7 @@ void Convex::addToWorkingList(Convex* ptr)
    cl->wLinkAfter(&mWorking);
    cl->rLinkAfter(&ptr->mReference);
    cl->mConvex = ptr;
+   ptr->mTag = sTag;
 };
 
 
@@ -470,14 +471,17 @@ void Convex::updateWorkingList(const Box3F& box, const U32 colMask)
 
    sTag++;
 
-   // Clear objects off the working list that are no longer intersecting
+   // Clear objects off the working list that are no longer intersecting.
+   // Only the survivors get tagged so buildConvex() can tell which convexes
+   // are still on the list with isOnCurrentWorkingList().
    for (CollisionWorkingList* itr = mWorking.wLink.mNext; itr != &mWorking; itr = itr->wLink.mNext) {
-      itr->mConvex->mTag = sTag;
       if ((!box.isOverlapped(itr->mConvex->getBoundingBox())) || (!itr->mConvex->getObject()->isCollisionEnabled())) {
          CollisionWorkingList* cl = itr;
          itr = itr->wLink.mPrev;
          cl->free();
       }
+      else
+         itr->mConvex->mTag = sTag;
    }
 
    // Special processing for the terrain and interiors...
@@ -224,6 +224,12 @@ public:
    /// Returns the list of objects currently inside the bounds of this Convex
    CollisionWorkingList& getWorkingList() { return mWorking; }
 
+   /// Returns true if this Convex is already on the working list currently
+   /// being rebuilt by updateWorkingList().  This is only meaningful from
+   /// within SceneObject::buildConvex(), where it replaces a walk over the
+   /// whole working list to find out if a convex needs to be added.
+   bool isOnCurrentWorkingList() const { return mTag == sTag; }
+
    /// Finds the closest
    CollisionState* findClosestState(const MatrixF& mat, const Point3F& scale, const F32 dontCareDist = 1);
 
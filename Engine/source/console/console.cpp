@@ -41,11 +41,193 @@
 #include "platform/threads/mutex.h"
 #include "core/util/journal/journal.h"
 #include "console/consoleValueStack.h"
+#include "console/consoleLogQueue.h"
+#include "platform/threads/semaphore.h"
 
 extern StringStack STR;
 extern ConsoleValueStack<4096> gCallStack;
 
 DataChunker ConsoleValue::sConversionAllocator;
+bool ConsoleValue::smPooledStrings = true;
+thread_local ConsoleValue::StringStats ConsoleValue::smStringStats;
+
+namespace
+{
+   /// Free lists of string blocks per size class.  Each thread keeps its
+   /// own lists so no locking is needed.  A block freed on another thread
+   /// than the one that allocated it simply moves over to that thread.
+   struct ConsoleStringPool
+   {
+      enum
+      {
+         /// Most blocks kept around per size class.  Anything beyond
+         /// this goes back to the heap.
+         MaxFreeBlocks = 256
+      };
+
+      char* mFreeBlocks[ConsoleValue::PooledStringClasses][MaxFreeBlocks];
+      U32 mNumFreeBlocks[ConsoleValue::PooledStringClasses];
+
+      ConsoleStringPool()
+      {
+         dMemset(mNumFreeBlocks, 0, sizeof(mNumFreeBlocks));
+      }
+
+      ~ConsoleStringPool()
+      {
+         for (U32 i = 0; i < ConsoleValue::PooledStringClasses; i++)
+            for (U32 n = 0; n < mNumFreeBlocks[i]; n++)
+               dFree(mFreeBlocks[i][n]);
+      }
+   };
+
+   thread_local ConsoleStringPool sStringPool;
+}
+
+char* ConsoleValue::_allocString(dsize_t size, U8& outStorage)
+{
+   if (smPooledStrings && size <= (PooledStringMinSize << (PooledStringClasses - 1)))
+   {
+      U32 sizeClass = 0;
+      while ((dsize_t)(PooledStringMinSize << sizeClass) < size)
+         sizeClass++;
+
+      outStorage = StringPooled + sizeClass;
+
+      ConsoleStringPool& pool = sStringPool;
+      if (pool.mNumFreeBlocks[sizeClass])
+      {
+         ++smStringStats.poolHits;
+         return pool.mFreeBlocks[sizeClass][--pool.mNumFreeBlocks[sizeClass]];
+      }
+
+      ++smStringStats.mallocs;
+      return (char*)dMalloc(PooledStringMinSize << sizeClass);
+   }
+
+   outStorage = StringHeap;
+   ++smStringStats.mallocs;
+   return (char*)dMalloc(size);
+}
+
+void ConsoleValue::_freeString(char* buffer, U8 storage)
+{
+   if (storage >= StringPooled)
+   {
+      ConsoleStringPool& pool = sStringPool;
+      const U32 sizeClass = storage - StringPooled;
+      if (pool.mNumFreeBlocks[sizeClass] < ConsoleStringPool::MaxFreeBlocks)
+      {
+         pool.mFreeBlocks[sizeClass][pool.mNumFreeBlocks[sizeClass]++] = buffer;
+         return;
+      }
+   }
+
+   dFree(buffer);
+}
+
+dsize_t ConsoleValue::_getStringCapacity(U8 storage)
+{
+   if (storage == StringInline)
+      return InlineStringSize;
+   if (storage >= StringPooled)
+      return PooledStringMinSize << (storage - StringPooled);
+
+   // Heap blocks are sized exactly.
+   return 0;
+}
+
+void ConsoleValue::_setString(const char* val, S32 len)
+{
+   // Copy the string before releasing our old storage
+   // as it may well be where the string lives.
+
+   if (smPooledStrings && len < InlineStringSize)
+   {
+      char buffer[InlineStringSize];
+      dMemcpy(buffer, val, len);
+      buffer[len] = '\0';
+
+      cleanupData();
+      type = ConsoleValueType::cvString;
+      storage = StringInline;
+      dMemcpy(sInline, buffer, len + 1);
+
+      ++smStringStats.inlineStores;
+      return;
+   }
+
+   U8 newStorage;
+   char* buffer = _allocString(static_cast<dsize_t>(len) + 1, newStorage);
+   dMemcpy(buffer, val, len);
+   buffer[len] = '\0';
+
+   cleanupData();
+   type = ConsoleValueType::cvString;
+   storage = newStorage;
+   s = buffer;
+}
+
+void ConsoleValue::appendString(const char* str, S32 len)
+{
+   // If we own the string and there's room left, append in place.
+
+   if (type == ConsoleValueType::cvString)
+   {
+      char* buffer = storage == StringInline ? sInline : s;
+      const dsize_t curLen = dStrlen(buffer);
+
+      if (curLen + len + 1 <= _getStringCapacity(storage))
+      {
+         dMemmove(buffer + curLen, str, len);
+         buffer[curLen + len] = '\0';
+
+         if (storage == StringInline)
+            ++smStringStats.inlineStores;
+         return;
+      }
+   }
+
+   const char* cur = getString();
+   const S32 curLen = dStrlen(cur);
+   const S32 newLen = curLen + len;
+
+   if (newLen == 0)
+   {
+      setEmptyString();
+      return;
+   }
+
+   if (smPooledStrings && newLen < InlineStringSize)
+   {
+      char buffer[InlineStringSize];
+      dMemcpy(buffer, cur, curLen);
+      dMemcpy(buffer + curLen, str, len);
+      buffer[newLen] = '\0';
+
+      cleanupData();
+      type = ConsoleValueType::cvString;
+      storage = StringInline;
+      dMemcpy(sInline, buffer, newLen + 1);
+
+      ++smStringStats.inlineStores;
+      return;
+   }
+
+   // Strings being built up usually keep growing.  As the pooled
+   // size classes double, the next appends will mostly fit in place.
+
+   U8 newStorage;
+   char* buffer = _allocString(static_cast<dsize_t>(newLen) + 1, newStorage);
+   dMemcpy(buffer, cur, curLen);
+   dMemcpy(buffer + curLen, str, len);
+   buffer[newLen] = '\0';
+
+   cleanupData();
+   type = ConsoleValueType::cvString;
+   storage = newStorage;
+   s = buffer;
+}
 
 void ConsoleValue::init()
 {
@@ -54,11 +236,29 @@ void ConsoleValue::init()
 
 void ConsoleValue::resetConversionBuffer()
 {
+   ++smStringStats.frames;
    sConversionAllocator.freeBlocks();
 }
 
 char* ConsoleValue::convertToBuffer() const
 {
+   ++smStringStats.conversions;
+
+   if (type == ConsoleValueType::cvVector)
+   {
+      // Same formatting as the TypePoint2F/3F/4F console types.
+      static const U32 bufSize = 64;
+      char* buffer = static_cast<char*>(sConversionAllocator.alloc(bufSize));
+      switch (storage)
+      {
+         case 1:  dSprintf(buffer, bufSize, "%g", fVec[0]); break;
+         case 2:  dSprintf(buffer, bufSize, "%g %g", fVec[0], fVec[1]); break;
+         case 3:  dSprintf(buffer, bufSize, "%g %g %g", fVec[0], fVec[1], fVec[2]); break;
+         default: dSprintf(buffer, bufSize, "%g %g %g %g", fVec[0], fVec[1], fVec[2], fVec[3]); break;
+      }
+      return buffer;
+   }
+
    char* buffer = static_cast<char*>(sConversionAllocator.alloc(32));
    
    if (type == ConsoleValueType::cvFloat)
@@ -69,6 +269,32 @@ char* ConsoleValue::convertToBuffer() const
    return buffer;
 }
 
+void ConsoleValue::getVector(F32* out, U32 count) const
+{
+   dMemset(out, 0, count * sizeof(F32));
+
+   if (type == ConsoleValueType::cvVector)
+   {
+      dMemcpy(out, fVec, getMin(count, (U32)storage) * sizeof(F32));
+      return;
+   }
+
+   if (isNumberType())
+   {
+      out[0] = getFloat();
+      return;
+   }
+
+   const char* str = getString();
+   switch (count)
+   {
+      case 1:  out[0] = dAtof(str); break;
+      case 2:  dSscanf(str, "%g %g", &out[0], &out[1]); break;
+      case 3:  dSscanf(str, "%g %g %g", &out[0], &out[1], &out[2]); break;
+      default: dSscanf(str, "%g %g %g %g", &out[0], &out[1], &out[2], &out[3]); break;
+   }
+}
+
 const char* ConsoleValue::getConsoleData() const
 {
    return Con::getData(ct->consoleType, ct->dataPtr, 0, ct->enumTable);
@@ -117,7 +343,7 @@ void ConsoleConstructor::init( const char *cName, const char *fName, const char
    mFuncName = fName;
    mUsage = usg;
    mClassName = cName;
-   mSC = 0; mFC = 0; mVC = 0; mBC = 0; mIC = 0;
+   mSC = 0; mFC = 0; mVC = 0; mBC = 0; mIC = 0; mValC = 0;
    mCallback = mGroup = false;
    mNext = mFirst;
    mNS = false;
@@ -144,6 +370,8 @@ void ConsoleConstructor::setup()
          Con::addCommand( walk->mClassName, walk->mFuncName, walk->mVC, walk->mUsage, walk->mMina, walk->mMaxa, walk->mToolOnly, walk->mHeader);
       else if( walk->mBC )
          Con::addCommand( walk->mClassName, walk->mFuncName, walk->mBC, walk->mUsage, walk->mMina, walk->mMaxa, walk->mToolOnly, walk->mHeader);
+      else if( walk->mValC )
+         Con::addCommand( walk->mClassName, walk->mFuncName, walk->mValC, walk->mUsage, walk->mMina, walk->mMaxa, walk->mToolOnly, walk->mHeader);
       else if( walk->mGroup )
          Con::markCommandGroup( walk->mClassName, walk->mFuncName, walk->mUsage);
       else if( walk->mClassName)
@@ -191,6 +419,12 @@ ConsoleConstructor::ConsoleConstructor(const char *className, const char *funcNa
    mBC = bfunc;
 }
 
+ConsoleConstructor::ConsoleConstructor(const char *className, const char *funcName, ValueCallback cvfunc, const char *usage, S32 minArgs, S32 maxArgs, bool isToolOnly, ConsoleFunctionHeader* header )
+{
+   init( className, funcName, usage, minArgs, maxArgs, isToolOnly, header );
+   mValC = cvfunc;
+}
+
 ConsoleConstructor::ConsoleConstructor(const char* className, const char* groupName, const char* aUsage)
 {
    init(className, groupName, mUsage, -1, -2);
@@ -265,10 +499,18 @@ namespace Con
 {
 
 static Vector<ConsumerCallback> gConsumers(__FILE__, __LINE__);
+static Vector<ConsumerCallback> gAsyncConsumers(__FILE__, __LINE__);
 static Vector< String > sInstantGroupStack( __FILE__, __LINE__ );
-static DataChunker consoleLogChunker;
 static Vector<ConsoleLogEntry> consoleLog(__FILE__, __LINE__);
 static bool consoleLogLocked;
+
+/// The strings of the log history.  When the history gets trimmed the
+/// entries that are kept are copied over into the other chunker so the
+/// old one can be freed as a whole.
+static DataChunker consoleLogChunkers[2];
+static U32 consoleLogChunkerIndex;
+static U32 consoleLogTrimCount;
+static S32 logHistorySize = 25000;
 bool scriptWarningsAsAsserts = true;
 static bool logBufferEnabled=true;
 static S32 printLevel = 10;
@@ -279,6 +521,36 @@ static bool active = false;
 static bool newLogFile;
 static const char *logFileName;
 
+/// Guards consoleLogFile, consoleLogMode and newLogFile which are used by
+/// the log writer thread.
+static Mutex consoleLogFileMutex;
+
+/// Guards gAsyncConsumers.
+static Mutex asyncConsumersMutex;
+
+/// If true, console.log and the async consumers are written to from the
+/// log writer thread.
+static bool asyncLog = true;
+
+/// If true, console.log lines get prefixed with frame, thread and subsystem.
+static bool logStructured = false;
+
+/// Maximum number of lines a single printf callsite may print per second.
+static S32 logRateLimit = 0;
+
+/// Frame number stamped into log entries.  Advanced by processLog().
+static volatile U32 logFrame;
+
+/// Number of threads other than the main one that have printed something.
+static volatile U32 logThreadCount;
+
+/// Set while a thread is in _printf, so anything printed from inside a
+/// consumer or allocation hook is dropped instead of recursing.
+static thread_local bool inPrintf = false;
+
+static void _stopLogWriter();
+static void _discardMainThreadLog();
+
 static const S32 MaxCompletionBufferSize = 4096;
 static char completionBuffer[MaxCompletionBufferSize];
 static char tabBuffer[MaxCompletionBufferSize] = {0};
@@ -314,8 +586,10 @@ DefineEngineFunction( cls, void, (), , "()"
 {
    if(consoleLogLocked)
       return;
-   consoleLogChunker.freeBlocks();
+   consoleLogChunkers[0].freeBlocks();
+   consoleLogChunkers[1].freeBlocks();
    consoleLog.setSize(0);
+   consoleLogTrimCount++;
 };
 
 DefineEngineFunction( getClipboard, const char*, (), , "()"
@@ -391,6 +665,21 @@ void init()
       "failures based on a missing copy object and does not report an error..\n"
       "@ingroup Console\n");
    addVariable("Con::scriptWarningsAsAsserts", TypeBool, &scriptWarningsAsAsserts, "If true, script warnings (outside of syntax errors) will be treated as fatal asserts.");
+   addVariable("Con::asyncLog", TypeBool, &asyncLog, "If true, console.log and ConsoleLogger files are written from a background thread "
+      "so printing doesn't wait on the disk. Takes effect on the next frame.\n"
+      "@ingroup Console\n");
+   addVariable("Con::logHistorySize", TypeS32, &logHistorySize, "Number of lines kept in the in-memory log history shown by the console. "
+      "Zero keeps everything.\n"
+      "@ingroup Console\n");
+   addVariable("Con::logRateLimit", TypeS32, &logRateLimit, "If greater than zero, the maximum number of lines printed per second from any one "
+      "place in the code. Anything beyond that is dropped and summarized once the second is up. "
+      "Script output such as echo() is never dropped.\n"
+      "@ingroup Console\n");
+   addVariable("Con::logStructured", TypeBool, &logStructured, "If true, every line in console.log is prefixed with [frame:thread:subsystem].\n"
+      "@ingroup Console\n");
+   addVariable("Con::pooledStrings", TypeBool, &ConsoleValue::smPooledStrings, "If true, short script strings are stored inside their values and longer ones "
+      "are recycled through size class pools instead of going through the heap every time.\n"
+      "@ingroup Console\n");
 
    // Current script file name and root
    addVariable( "Con::File", TypeString, &gCurrentFile, "The currently executing script file.\n"
@@ -432,6 +721,10 @@ void init()
 void shutdown()
 {
    AssertFatal(active == true, "Con::shutdown should only be called once.");
+   // Get everything still queued into console.log before closing it.
+   _stopLogWriter();
+   _discardMainThreadLog();
+
    active = false;
 
    smConsoleInput.remove(postConsoleInput);
@@ -471,6 +764,11 @@ void unlockLog()
    consoleLogLocked = false;
 }
 
+U32 getLogTrimCount()
+{
+   return consoleLogTrimCount;
+}
+
 U32 tabComplete(char* inputBuffer, U32 cursorPos, U32 maxResultLength, bool forwardTab)
 {
    // Check for null input.
@@ -591,7 +889,176 @@ U32 tabComplete(char* inputBuffer, U32 cursorPos, U32 maxResultLength, bool forw
 }
 
 //------------------------------------------------------------------------------
-static void log(const char *string)
+// Every line printed goes two ways:
+//
+//   - To the consumers and the log history.  These belong to the main thread;
+//     lines printed on other threads are posted to gMainThreadLog and handed
+//     over by processLog() at the end of the frame.
+//   - To console.log and the async consumers.  With $Con::asyncLog on these
+//     are written by the log writer thread so the printing thread never waits
+//     on the disk.
+//------------------------------------------------------------------------------
+
+static const char* logTypeNames[ConsoleLogEntry::NUM_TYPE] =
+{
+   "General", "Assert", "Script", "GUI", "Network", "GGConnect"
+};
+
+/// Lines printed on threads other than the main one, waiting for processLog().
+static ConsoleLogQueue<1024> gMainThreadLog;
+
+/// Lines that didn't fit into gMainThreadLog since the last processLog().
+static volatile U32 gMainThreadLogDropped;
+
+/// Per callsite state for $Con::logRateLimit.  Callsites are told apart by
+/// the return address of the printf call and share slots by hash, so two
+/// callsites landing in the same slot just keep resetting each other's count.
+struct LogRateSlot
+{
+   const void* volatile mCallsite;
+   volatile U32 mWindowStart;
+   volatile U32 mCount;
+   volatile U32 mSuppressed;
+};
+
+static const U32 LogRateSlotCount = 256;
+static LogRateSlot logRateSlots[LogRateSlotCount];
+
+static char* _copyLogString(const char* string)
+{
+   const dsize_t size = dStrlen(string) + 1;
+   char* copy = (char*)dMalloc(size);
+   dMemcpy(copy, string, size);
+   return copy;
+}
+
+static void _replaceLogTabs(char* string)
+{
+   for (char* pos = string; *pos; pos++)
+   {
+      if (*pos == '\t')
+         *pos = '^';
+   }
+}
+
+static U32 _getLogThreadIndex()
+{
+   if (isMainThread())
+      return 0;
+
+   static thread_local U32 index = 0;
+   if (!index)
+   {
+      U32 count;
+      do
+      {
+         count = dAtomicRead(logThreadCount);
+      }
+      while (!dCompareAndSwap(logThreadCount, count, count + 1));
+      index = count + 1;
+   }
+   return index;
+}
+
+/// Returns false if @a callsite is over $Con::logRateLimit and the line
+/// should be dropped.  When a callsite starts a new one second window,
+/// outSuppressed is set to what it lost in the previous one.
+static bool _checkLogRate(const void* callsite, const char* fmt, U32& outSuppressed)
+{
+   outSuppressed = 0;
+   if (logRateLimit <= 0)
+      return true;
+
+   // Lines that are passed through as they are, like script echo(), all come
+   // from a handful of forwarding callsites, so there is nothing to tell their
+   // sources apart by.
+   if (fmt[0] == '%' && fmt[1] == 's' && fmt[2] == 0)
+      return true;
+
+   const uintptr_t hash = uintptr_t(callsite) ^ (uintptr_t(callsite) >> 8);
+   LogRateSlot& slot = logRateSlots[(hash >> 2) & (LogRateSlotCount - 1)];
+   const U32 now = Platform::getRealMilliseconds();
+
+   if (slot.mCallsite != callsite)
+   {
+      // Take the slot over.  Racing takeovers only restart the window, which
+      // at worst lets a few extra lines through.
+      slot.mCallsite = callsite;
+      slot.mWindowStart = now;
+      slot.mCount = 0;
+      slot.mSuppressed = 0;
+   }
+
+   const U32 windowStart = dAtomicRead(slot.mWindowStart);
+   if (now - windowStart >= 1000 && dCompareAndSwap(slot.mWindowStart, windowStart, now))
+   {
+      U32 suppressed;
+      do
+      {
+         suppressed = dAtomicRead(slot.mSuppressed);
+      }
+      while (!dCompareAndSwap(slot.mSuppressed, suppressed, 0));
+
+      outSuppressed = suppressed;
+      slot.mCount = 0;
+   }
+
+   U32 count;
+   do
+   {
+      count = dAtomicRead(slot.mCount);
+   }
+   while (!dCompareAndSwap(slot.mCount, count, count + 1));
+
+   if (count < U32(logRateLimit))
+      return true;
+
+   dFetchAndAdd(slot.mSuppressed, 1);
+   return false;
+}
+
+//------------------------------------------------------------------------------
+
+static void _writeLogHeader()
+{
+   // Make a header.
+   Platform::LocalTime lt;
+   Platform::getLocalTime(lt);
+   char buffer[128];
+   dSprintf(buffer, sizeof(buffer), "//-------------------------- %d/%d/%d -- %02d:%02d:%02d -----\r\n",
+         lt.month + 1,
+         lt.monthday,
+         lt.year + 1900,
+         lt.hour,
+         lt.min,
+         lt.sec);
+   consoleLogFile.write(dStrlen(buffer), buffer);
+   newLogFile = false;
+
+   if (consoleLogMode & 0x4) 
+   {
+      consoleLogMode -= 0x4;
+
+      // Dump anything that has been printed to the console so far.  The
+      // history belongs to the main thread, so setLogMode() takes care of
+      // this before the log writer thread ever gets here.
+      if (isMainThread())
+      {
+         U32 size, line;
+         ConsoleLogEntry *log;
+         getLockLog(log, size);
+         for (line = 0; line < size; line++) 
+         {
+            consoleLogFile.write(dStrlen(log[line].mString), log[line].mString);
+            consoleLogFile.write(2, "\r\n");
+         }
+         unlockLog();
+      }
+   }
+}
+
+/// Write one line to console.log.  consoleLogFileMutex must be held.
+static void log(const char *string, U32 length, const ConsoleLogRecord& record)
 {
    // Bail if we ain't logging.
    if (!consoleLogMode) 
@@ -611,37 +1078,17 @@ static void log(const char *string)
       consoleLogFile.setPosition(consoleLogFile.getStreamSize());
       // If this is the first write...
       if (newLogFile) 
+         _writeLogHeader();
+
+      if (logStructured)
       {
-         // Make a header.
-         Platform::LocalTime lt;
-         Platform::getLocalTime(lt);
-         char buffer[128];
-         dSprintf(buffer, sizeof(buffer), "//-------------------------- %d/%d/%d -- %02d:%02d:%02d -----\r\n",
-               lt.month + 1,
-               lt.monthday,
-               lt.year + 1900,
-               lt.hour,
-               lt.min,
-               lt.sec);
-         consoleLogFile.write(dStrlen(buffer), buffer);
-         newLogFile = false;
-         if (consoleLogMode & 0x4) 
-         {
-            // Dump anything that has been printed to the console so far.
-            consoleLogMode -= 0x4;
-            U32 size, line;
-            ConsoleLogEntry *log;
-            getLockLog(log, size);
-            for (line = 0; line < size; line++) 
-            {
-               consoleLogFile.write(dStrlen(log[line].mString), log[line].mString);
-               consoleLogFile.write(2, "\r\n");
-            }
-            unlockLog();
-         }
+         char prefix[64];
+         dSprintf(prefix, sizeof(prefix), "[%u:%u:%s] ", record.mFrame, record.mThread, logTypeNames[record.mType]);
+         consoleLogFile.write(dStrlen(prefix), prefix);
       }
+
       // Now write what we came here to write.
-      consoleLogFile.write(dStrlen(string), string);
+      consoleLogFile.write(length, string);
       consoleLogFile.write(2, "\r\n");
    }
 
@@ -651,13 +1098,246 @@ static void log(const char *string)
    }
 }
 
+/// Pass a printed string to the async consumers and console.log.  Called
+/// on the log writer thread, or on the printing thread if there is none.
+/// The string gets its tabs replaced.
+static void _writeLogRecord(const ConsoleLogRecord& record, char* string)
+{
+   {
+      MutexHandle consumersLock;
+      consumersLock.lock(&asyncConsumersMutex, true);
+      for (S32 i = 0; i < gAsyncConsumers.size(); i++)
+         gAsyncConsumers[i](record.mLevel, string);
+   }
+
+   MutexHandle fileLock;
+   fileLock.lock(&consoleLogFileMutex, true);
+   if (!consoleLogMode)
+      return;
+
+   _replaceLogTabs(string);
+   for (const char* pos = string;;)
+   {
+      const char* eolPos = dStrchr(pos, '\n');
+      log(pos, eolPos ? U32(eolPos - pos) : dStrlen(pos), record);
+      if (!eolPos)
+         break;
+      pos = eolPos + 1;
+   }
+}
+
+/// Pass a printed string to the regular consumers.  Main thread only.
+static void _callLogConsumers(const ConsoleLogRecord& record, const char* string)
+{
+   for (S32 i = 0; i < gConsumers.size(); i++)
+      gConsumers[i](record.mLevel, string);
+}
+
+/// Add a printed string to the log history, one entry per line.  Main
+/// thread only.  The string gets its tabs replaced and is split up in place.
+static void _appendLogHistory(const ConsoleLogRecord& record, char* string)
+{
+#ifndef TORQUE_SHIPPING // this is equivalent to a memory leak, turn it off in ship build
+   if (!logBufferEnabled || consoleLogLocked)
+      return;
+
+   _replaceLogTabs(string);
+   for (char* pos = string;;)
+   {
+      char* eolPos = dStrchr(pos, '\n');
+      if (eolPos)
+         *eolPos = 0;
+
+      ConsoleLogEntry entry;
+      entry.mLevel  = record.mLevel;
+      entry.mType   = record.mType;
+      entry.mThread = record.mThread;
+      entry.mFrame  = record.mFrame;
+
+      U64 logStringLen = dStrlen(pos) + 1;
+      entry.mString = (const char *)consoleLogChunkers[consoleLogChunkerIndex].alloc(logStringLen);
+      dStrcpy(const_cast<char*>(entry.mString), pos, logStringLen);
+
+      // Anything printed while the history grows (e.g. with LOG_PAGE_ALLOCS
+      // defined) is dropped by the inPrintf check rather than recursing.
+      consoleLog.push_back(entry);
+
+      if (!eolPos)
+         break;
+      pos = eolPos + 1;
+   }
+#endif
+}
+
+/// Drop the oldest history entries once there are more than
+/// $Con::logHistorySize of them.  Only done between frames, so entries
+/// the GuiConsole took from getLockLog() stay valid through the frame.
+static void _trimLogHistory()
+{
+   if (logHistorySize <= 0 || consoleLogLocked)
+      return;
+
+   // Let the history run a quarter over before trimming, so the copying
+   // only happens every so often.
+   const U32 limit = logHistorySize;
+   if (consoleLog.size() <= limit + limit / 4)
+      return;
+
+   const U32 first = consoleLog.size() - limit;
+   DataChunker& chunker = consoleLogChunkers[!consoleLogChunkerIndex];
+   for (U32 i = 0; i < limit; i++)
+   {
+      ConsoleLogEntry entry = consoleLog[first + i];
+      const U64 logStringLen = dStrlen(entry.mString) + 1;
+      char* string = (char*)chunker.alloc(logStringLen);
+      dMemcpy(string, entry.mString, logStringLen);
+      entry.mString = string;
+      consoleLog[i] = entry;
+   }
+   consoleLog.setSize(limit);
+
+   consoleLogChunkers[consoleLogChunkerIndex].freeBlocks();
+   consoleLogChunkerIndex = !consoleLogChunkerIndex;
+   consoleLogTrimCount++;
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef TORQUE_MULTITHREAD
+
+/// Thread writing console.log and feeding the async consumers, so that
+/// printing a line only costs formatting it and a push onto a queue.
+class ConsoleLogWriter : public Thread
+{
+public:
+
+   ConsoleLogQueue<4096> mQueue;
+
+   /// Released to wake the writer up when it is waiting for work.
+   Semaphore mWakeUp;
+
+   /// 1 while the writer is (about to be) waiting on mWakeUp.
+   volatile U32 mSleeping;
+
+   ConsoleLogWriter()
+      : mWakeUp(0),
+        mSleeping(0)
+   {
+   }
+
+   /// Queue a record for writing.  If the writer has fallen that far behind
+   /// the caller waits for it to catch up rather than losing lines.
+   void post(const ConsoleLogRecord& record)
+   {
+      while (!mQueue.tryPush(record))
+      {
+         wakeUp();
+         Platform::sleep(1);
+      }
+      wakeUp();
+   }
+
+   void wakeUp()
+   {
+      if (dCompareAndSwap(mSleeping, 1, 0))
+         mWakeUp.release();
+   }
+
+   /// Wait for everything posted so far to have been written.
+   void flush()
+   {
+      const U32 ticket = mQueue.getTicket();
+      while (!mQueue.isProcessed(ticket))
+      {
+         wakeUp();
+         Platform::sleep(1);
+      }
+   }
+
+   /// Write out whatever is left and stop the thread.
+   void shutdown()
+   {
+      stop();
+      mWakeUp.release();
+      join();
+   }
+
+   void run(void* arg) override
+   {
+      _setName("ConsoleLogWriter");
+
+      // Anything our consumers print would end up back in our own queue.
+      inPrintf = true;
+
+      while (!checkForStop())
+      {
+         _drain();
+
+         // Wait for more.  A producer that pushes after the isEmpty() check
+         // sees mSleeping set and wakes us up; spurious wake ups are harmless.
+         dCompareAndSwap(mSleeping, 0, 1);
+         if (mQueue.isEmpty())
+            mWakeUp.acquire(true, 100);
+         dCompareAndSwap(mSleeping, 1, 0);
+      }
+
+      _drain();
+   }
+
+protected:
+
+   void _drain()
+   {
+      ConsoleLogRecord record;
+      while (mQueue.tryPop(record))
+      {
+         _writeLogRecord(record, record.mString);
+         dFree(record.mString);
+         mQueue.markProcessed();
+      }
+   }
+};
+
+/// Created the first time $Con::asyncLog is seen on and kept until shutdown,
+/// so printing threads never see it go away under them.
+static ConsoleLogWriter* volatile gLogWriter = NULL;
+
+#endif // TORQUE_MULTITHREAD
+
+static void _stopLogWriter()
+{
+#ifdef TORQUE_MULTITHREAD
+   if (!gLogWriter)
+      return;
+
+   ConsoleLogWriter* writer = gLogWriter;
+   gLogWriter = NULL;
+   writer->shutdown();
+   delete writer;
+#endif
+}
+
 //------------------------------------------------------------------------------
 
-static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, const char* fmt, va_list argptr)
+/// The code calling printf(), warnf() or errorf(), to tell callsites apart
+/// for $Con::logRateLimit.
+#ifdef TORQUE_COMPILER_VISUALC
+#include <intrin.h>
+#define LOG_CALLSITE() _ReturnAddress()
+#else
+#define LOG_CALLSITE() __builtin_return_address(0)
+#endif
+
+static void _printf(const void* callsite, ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, const char* fmt, va_list argptr)
 {
-   if (!active)
+   if (!active || inPrintf)
+      return;
+
+   U32 suppressed;
+   if (!_checkLogRate(callsite, fmt, suppressed))
       return;
-   Con::active = false;
+
+   inPrintf = true;
 
    char buffer[8192] = {};
    U32 offset = 0;
@@ -688,55 +1368,122 @@ static void _printf(ConsoleLogEntry::Level level, ConsoleLogEntry::Type type, co
 
    dVsprintf(buffer + offset, sizeof(buffer) - offset, fmt, argptr);
 
-   for(S32 i = 0; i < gConsumers.size(); i++)
-      gConsumers[i](level, buffer);
+   if (suppressed)
+   {
+      const U32 length = dStrlen(buffer);
+      dSprintf(buffer + length, sizeof(buffer) - length, "\n(%u more lines from here were dropped by $Con::logRateLimit)", suppressed);
+   }
+
+   ConsoleLogRecord record;
+   record.mLevel = level;
+   record.mType = type;
+   record.mThread = _getLogThreadIndex();
+   record.mFrame = dAtomicRead(logFrame);
+   record.mString = NULL;
 
-   if(logBufferEnabled || consoleLogMode)
+   const bool mainThread = (record.mThread == 0);
+   if (mainThread)
+      _callLogConsumers(record, buffer);
+   else
    {
-      char *pos = buffer;
-      while(*pos)
+      // Leave the consumers and the history to the main thread.  If it has
+      // too much to catch up on the line only goes to the log file.
+      ConsoleLogRecord post = record;
+      post.mString = _copyLogString(buffer);
+      if (!gMainThreadLog.tryPush(post))
       {
-         if(*pos == '\t')
-            *pos = '^';
-         pos++;
+         dFree(post.mString);
+         dFetchAndAdd(gMainThreadLogDropped, 1);
       }
-      pos = buffer;
+   }
 
-      for(;;)
+   if (consoleLogMode || !gAsyncConsumers.empty())
+   {
+#ifdef TORQUE_MULTITHREAD
+      ConsoleLogWriter* writer = gLogWriter;
+      if (writer && asyncLog)
       {
-         char *eofPos = dStrchr(pos, '\n');
-         if(eofPos)
-            *eofPos = 0;
+         record.mString = _copyLogString(buffer);
+         writer->post(record);
+      }
+      else
+#endif
+         _writeLogRecord(record, buffer);
+   }
 
-         log(pos);
-         if(logBufferEnabled && !consoleLogLocked)
-         {
-            ConsoleLogEntry entry;
-            entry.mLevel  = level;
-            entry.mType   = type;
-#ifndef TORQUE_SHIPPING // this is equivalent to a memory leak, turn it off in ship build            
-            U64 logStringLen = dStrlen(pos) + 1;
-            entry.mString = (const char *)consoleLogChunker.alloc(logStringLen);
-            dStrcpy(const_cast<char*>(entry.mString), pos, logStringLen);
-            
-            // This prevents infinite recursion if the console itself needs to
-            // re-allocate memory to accommodate the new console log entry, and 
-            // LOG_PAGE_ALLOCS is defined. It is kind of a dirty hack, but the
-            // uses for LOG_PAGE_ALLOCS are limited, and it is not worth writing
-            // a lot of special case code to support this situation. -patw
-            const bool save = Con::active;
-            Con::active = false;
-            consoleLog.push_back(entry);
-            Con::active = save;
+   if (mainThread)
+      _appendLogHistory(record, buffer);
+
+   inPrintf = false;
+}
+
+//------------------------------------------------------------------------------
+
+static void _discardMainThreadLog()
+{
+   ConsoleLogRecord record;
+   while (gMainThreadLog.tryPop(record))
+   {
+      dFree(record.mString);
+      gMainThreadLog.markProcessed();
+   }
+}
+
+void processLog()
+{
+   AssertFatal(isMainThread(), "Con::processLog - Must be called on the main thread.");
+
+#ifdef TORQUE_MULTITHREAD
+   if (asyncLog && !gLogWriter)
+   {
+      ConsoleLogWriter* writer = new ConsoleLogWriter;
+      writer->start();
+      gLogWriter = writer;
+   }
+   else if (!asyncLog && gLogWriter)
+   {
+      // Printing goes straight to the file again; make sure what's still
+      // queued gets there first.
+      gLogWriter->flush();
+   }
 #endif
-         }
-         if(!eofPos)
-            break;
-         pos = eofPos + 1;
-      }
+
+   inPrintf = true;
+   ConsoleLogRecord record;
+   while (gMainThreadLog.tryPop(record))
+   {
+      _callLogConsumers(record, record.mString);
+      _appendLogHistory(record, record.mString);
+      dFree(record.mString);
+      gMainThreadLog.markProcessed();
    }
+   inPrintf = false;
+
+   U32 dropped;
+   do
+   {
+      dropped = dAtomicRead(gMainThreadLogDropped);
+   }
+   while (dropped && !dCompareAndSwap(gMainThreadLogDropped, dropped, 0));
+
+   if (dropped)
+      warnf("Con::processLog - %u lines printed on other threads were left out of the console, only console.log has them.", dropped);
 
-   Con::active = true;
+   _trimLogHistory();
+   dFetchAndAdd(logFrame, 1);
+}
+
+void flushLog()
+{
+#ifdef TORQUE_MULTITHREAD
+   // Consumers run on the writer thread and can't wait for themselves.
+   if (inPrintf)
+      return;
+
+   ConsoleLogWriter* writer = gLogWriter;
+   if (writer)
+      writer->flush();
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -744,7 +1491,7 @@ void printf(const char* fmt,...)
 {
    va_list argptr;
    va_start(argptr, fmt);
-   _printf(ConsoleLogEntry::Normal, ConsoleLogEntry::General, fmt, argptr);
+   _printf(LOG_CALLSITE(), ConsoleLogEntry::Normal, ConsoleLogEntry::General, fmt, argptr);
    va_end(argptr);
 }
 
@@ -752,7 +1499,7 @@ void warnf(ConsoleLogEntry::Type type, const char* fmt,...)
 {
    va_list argptr;
    va_start(argptr, fmt);
-   _printf(ConsoleLogEntry::Warning, type, fmt, argptr);
+   _printf(LOG_CALLSITE(), ConsoleLogEntry::Warning, type, fmt, argptr);
    va_end(argptr);
 }
 
@@ -760,7 +1507,7 @@ void errorf(ConsoleLogEntry::Type type, const char* fmt,...)
 {
    va_list argptr;
    va_start(argptr, fmt);
-   _printf(ConsoleLogEntry::Error, type, fmt, argptr);
+   _printf(LOG_CALLSITE(), ConsoleLogEntry::Error, type, fmt, argptr);
    va_end(argptr);
 }
 
@@ -768,7 +1515,7 @@ void warnf(const char* fmt,...)
 {
    va_list argptr;
    va_start(argptr, fmt);
-   _printf(ConsoleLogEntry::Warning, ConsoleLogEntry::General, fmt, argptr);
+   _printf(LOG_CALLSITE(), ConsoleLogEntry::Warning, ConsoleLogEntry::General, fmt, argptr);
    va_end(argptr);
 }
 
@@ -776,7 +1523,7 @@ void errorf(const char* fmt,...)
 {
    va_list argptr;
    va_start(argptr, fmt);
-   _printf(ConsoleLogEntry::Error, ConsoleLogEntry::General, fmt, argptr);
+   _printf(LOG_CALLSITE(), ConsoleLogEntry::Error, ConsoleLogEntry::General, fmt, argptr);
    va_end(argptr);
 }
 
@@ -940,6 +1687,27 @@ void removeConsumer(ConsumerCallback consumer)
    }
 }
 
+void addAsyncConsumer(ConsumerCallback consumer)
+{
+   MutexHandle consumersLock;
+   consumersLock.lock(&asyncConsumersMutex, true);
+   gAsyncConsumers.push_back(consumer);
+}
+
+void removeAsyncConsumer(ConsumerCallback consumer)
+{
+   MutexHandle consumersLock;
+   consumersLock.lock(&asyncConsumersMutex, true);
+   for(S32 i = 0; i < gAsyncConsumers.size(); i++)
+   {
+      if (gAsyncConsumers[i] == consumer)
+      {
+         gAsyncConsumers.erase(i);
+         break;
+      }
+   }
+}
+
 void stripColorChars(char* line)
 {
    char* c = line;
@@ -1139,6 +1907,12 @@ void addCommand( const char *nsName, const char *name,BoolCallback cb, const cha
    ns->addCommand( StringTable->insert(name), cb, usage, minArgs, maxArgs, isToolOnly, header );
 }
 
+void addCommand( const char *nsName, const char *name,ValueCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool isToolOnly, ConsoleFunctionHeader* header )
+{
+   Namespace *ns = lookupNamespace(nsName);
+   ns->addCommand( StringTable->insert(name), cb, usage, minArgs, maxArgs, isToolOnly, header );
+}
+
 void noteScriptCallback( const char *className, const char *funcName, const char *usage, ConsoleFunctionHeader* header )
 {
    Namespace *ns = lookupNamespace(className);
@@ -1186,6 +1960,11 @@ void addCommand( const char *name,BoolCallback cb,const char *usage, S32 minArgs
    Namespace::global()->addCommand( StringTable->insert(name), cb, usage, minArgs, maxArgs, isToolOnly, header );
 }
 
+void addCommand( const char *name,ValueCallback cb,const char *usage, S32 minArgs, S32 maxArgs, bool isToolOnly, ConsoleFunctionHeader* header )
+{
+   Namespace::global()->addCommand( StringTable->insert(name), cb, usage, minArgs, maxArgs, isToolOnly, header );
+}
+
 //------------------------------------------------------------------------------
 
 // Internal execute for global function which does not save the stack
@@ -1367,6 +2146,12 @@ bool isFunction(const char *fn)
 
 void setLogMode(S32 newMode)
 {
+   // Anything still queued goes out under the old mode.
+   flushLog();
+
+   MutexHandle fileLock;
+   fileLock.lock(&consoleLogFileMutex, true);
+
    if ((newMode & 0x3) != (consoleLogMode & 0x3)) {
       if (newMode && !consoleLogMode) {
          // Enabling logging when it was previously disabled.
@@ -1386,6 +2171,19 @@ void setLogMode(S32 newMode)
          consoleLogFile.open(defLogFileName, Torque::FS::File::Write);
       }
       consoleLogMode = newMode;
+
+      // The history can only be dumped from the main thread, so start the
+      // file here instead of on the first write.
+      if ((consoleLogMode & 0x4) && newLogFile) {
+         if ((consoleLogMode & 0x3) == 1)
+            consoleLogFile.open(defLogFileName, Torque::FS::File::ReadWrite);
+         if ((consoleLogFile.getStatus() == Stream::Ok) || (consoleLogFile.getStatus() == Stream::EOS)) {
+            consoleLogFile.setPosition(consoleLogFile.getStreamSize());
+            _writeLogHeader();
+         }
+         if ((consoleLogMode & 0x3) == 1)
+            consoleLogFile.close();
+      }
    }
 }
 
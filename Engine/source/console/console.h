@@ -113,12 +113,20 @@ struct ConsoleLogEntry
    /// to be used to locate a bug, it can be done as painlessly as
    /// possible.
    const char *mString;
+
+   /// Index of the thread that printed the entry.  The main thread is 0,
+   /// other threads are numbered in the order they first print something.
+   U32 mThread;
+
+   /// Number of the frame the entry was printed in.
+   U32 mFrame;
 };
 
 typedef const char *StringTableEntry;
 
 enum ConsoleValueType
 {
+   cvVector = -5,
    cvInteger = -4,
    cvFloat = -3,
    cvString = -2,
@@ -135,6 +143,51 @@ struct ConsoleValueConsoleType
 
 class ConsoleValue
 {
+public:
+   enum
+   {
+      /// Strings shorter than this are stored inside the value itself.
+      InlineStringSize = 16,
+
+      /// Number of pooled string size classes.  Class N holds strings of
+      /// up to (PooledStringMinSize << N) bytes including the terminator.
+      PooledStringClasses = 6,
+
+      PooledStringMinSize = 32,
+
+      /// Maximum number of float components of a cvVector value.
+      MaxVectorSize = 4,
+   };
+
+   /// Counters for the string storage of the values on the calling thread.
+   /// @see dumpConsoleValueStats
+   struct StringStats
+   {
+      /// Strings stored inside the value.
+      U32 inlineStores;
+
+      /// StringTableEntries referenced without a copy.
+      U32 steStores;
+
+      /// Strings served from the pooled size classes without allocating.
+      U32 poolHits;
+
+      /// Calls to dMalloc for string storage.
+      U32 mallocs;
+
+      /// Numbers converted to strings in the conversion buffer.
+      U32 conversions;
+
+      /// Frames run since the counters were reset.  Only counted
+      /// on the main thread.
+      U32 frames;
+   };
+
+   /// If false, all strings go through dMalloc as they used to.
+   /// Exposed as $Con::pooledStrings.
+   static bool smPooledStrings;
+
+private:
    union
    {
       F64   f;
@@ -142,17 +195,53 @@ class ConsoleValue
       char* s;
       void* data;
       ConsoleValueConsoleType* ct;
+      char  sInline[InlineStringSize];
+      F32   fVec[MaxVectorSize];
    };
 
    S32 type;
 
+   /// Where the characters of a cvString value live.  For cvVector
+   /// values this holds the number of components instead.
+   enum StringStorage : U8
+   {
+      /// Exactly sized dMalloc block.
+      StringHeap,
+
+      /// In sInline.
+      StringInline,
+
+      /// Pooled block of size class (storage - StringPooled).
+      StringPooled,
+   };
+
+   U8 storage;
+
    static DataChunker sConversionAllocator;
 
+   static thread_local StringStats smStringStats;
+
    char* convertToBuffer() const;
 
+   /// Allocate a block for a string of @a size bytes including the terminator.
+   static char* _allocString(dsize_t size, U8& outStorage);
+
+   /// Release a block returned by _allocString.
+   static void _freeString(char* buffer, U8 storage);
+
+   /// Return the number of usable bytes in a block, or 0 if unknown.
+   static dsize_t _getStringCapacity(U8 storage);
+
+   TORQUE_FORCEINLINE const char* _getStringData() const
+   {
+      return storage == StringInline ? sInline : s;
+   }
+
    TORQUE_FORCEINLINE bool hasAllocatedData() const
    {
-      return (type == ConsoleValueType::cvString || isConsoleType()) && data != NULL;
+      if (type == ConsoleValueType::cvString)
+         return storage != StringInline && s != NULL;
+      return isConsoleType() && data != NULL;
    }
 
    const char* getConsoleData() const;
@@ -161,7 +250,10 @@ class ConsoleValue
    {
       if (hasAllocatedData())
       {
-         dFree(data);
+         if (type == ConsoleValueType::cvString)
+            _freeString(s, storage);
+         else
+            dFree(data);
          data = NULL;
       }
    }
@@ -169,6 +261,7 @@ class ConsoleValue
    TORQUE_FORCEINLINE void _move(ConsoleValue&& ref) noexcept
    {
       type = ref.type;
+      storage = ref.storage;
 
       switch (ref.type)
       {
@@ -179,23 +272,36 @@ class ConsoleValue
          f = ref.f;
          break;
       case cvSTEntry:
-         TORQUE_CASE_FALLTHROUGH;
-      case cvString:
          s = ref.s;
          break;
+      case cvString:
+         if (ref.storage == StringInline)
+            dMemcpy(sInline, ref.sInline, InlineStringSize);
+         else
+            s = ref.s;
+         break;
+      case cvVector:
+         dMemcpy(fVec, ref.fVec, sizeof(fVec));
+         break;
       default:
          data = ref.data;
          break;
       }
 
-      ref.data = NULL;
-      ref.setEmptyString();
+      // Hand off ownership without freeing anything.
+      ref.type = ConsoleValueType::cvSTEntry;
+      ref.storage = StringHeap;
+      ref.s = const_cast<char*>(StringTable->EmptyString());
    }
 
+   /// Store a copy of the given string, which may point into this value.
+   void _setString(const char* val, S32 len);
+
 public:
    ConsoleValue()
    {
       type = ConsoleValueType::cvSTEntry;
+      storage = StringHeap;
       s = const_cast<char*>(StringTable->EmptyString());
    }
 
@@ -206,7 +312,11 @@ public:
 
    TORQUE_FORCEINLINE ConsoleValue& operator=(ConsoleValue&& ref) noexcept
    {
-      _move(std::move(ref));
+      if (this != &ref)
+      {
+         cleanupData();
+         _move(std::move(ref));
+      }
       return *this;
    }
 
@@ -232,7 +342,9 @@ public:
       if (type == ConsoleValueType::cvSTEntry)
          return s == StringTable->EmptyString() ? 0.0f : dAtof(s);
       if (type == ConsoleValueType::cvString)
-         return dStrcmp(s, "") == 0 ? 0.0f : dAtof(s);
+         return _getStringData()[0] == '\0' ? 0.0f : dAtof(_getStringData());
+      if (type == ConsoleValueType::cvVector)
+         return fVec[0];
       return dAtof(getConsoleData());
    }
 
@@ -245,16 +357,22 @@ public:
       if (type == ConsoleValueType::cvSTEntry)
          return s == StringTable->EmptyString() ? 0 : dAtoi(s);
       if (type == ConsoleValueType::cvString)
-         return dStrcmp(s, "") == 0 ? 0 : dAtoi(s);
+         return _getStringData()[0] == '\0' ? 0 : dAtoi(_getStringData());
+      if (type == ConsoleValueType::cvVector)
+         return (S64)fVec[0];
 
       return dAtoi(getConsoleData());
    }
 
+   /// Return the value as a string.
+   ///
+   /// @note Short strings are stored inside the value, so the returned pointer
+   ///   is only valid for as long as the value is neither changed, moved nor destroyed.
    TORQUE_FORCEINLINE const char* getString() const
    {
       if (isStringType())
-         return s;
-      if (isNumberType())
+         return _getStringData();
+      if (isNumberType() || type == ConsoleValueType::cvVector)
          return convertToBuffer();
       return getConsoleData();
    }
@@ -273,7 +391,9 @@ public:
       if (type == ConsoleValueType::cvSTEntry)
          return s == StringTable->EmptyString() ? false : dAtob(s);
       if (type == ConsoleValueType::cvString)
-         return dStrcmp(s, "") == 0 ? false : dAtob(s);
+         return _getStringData()[0] == '\0' ? false : dAtob(_getStringData());
+      if (type == ConsoleValueType::cvVector)
+         return fVec[0] != 0.0f;
       return dAtob(getConsoleData());
    }
 
@@ -304,22 +424,46 @@ public:
          return;
       }
 
-      cleanupData();
-
-      type = ConsoleValueType::cvString;
-
-      s = (char*)dMalloc(static_cast<dsize_t>(len) + 1);
-      s[len] = '\0';
-      dStrcpy(s, val, static_cast<dsize_t>(len) + 1);
+      _setString(val, len);
    }
 
+   /// Take ownership of a dMalloc'd string.
    TORQUE_FORCEINLINE void setStringRef(const char* ref, S32 len)
    {
       cleanupData();
       type = ConsoleValueType::cvString;
+      storage = StringHeap;
       s = const_cast<char*>(ref);
    }
 
+   /// Append @a len characters of @a str to the string value of this value.
+   /// Pooled and inline strings are extended in place where they have room.
+   void appendString(const char* str, S32 len);
+
+   /// Store @a count float components in binary form.  Engine methods that
+   /// take or return vectors exchange them this way without going through
+   /// a string; the text form ("x y z") is only produced when a script
+   /// actually reads the value as a string.
+   TORQUE_FORCEINLINE void setVector(const F32* val, U32 count)
+   {
+      AssertFatal(count > 0 && count <= MaxVectorSize, "ConsoleValue::setVector - Bad component count!");
+      cleanupData();
+      type = ConsoleValueType::cvVector;
+      storage = (U8)count;
+      dMemcpy(fVec, val, count * sizeof(F32));
+   }
+
+   /// Read @a count float components into @a out.  Vector values are copied
+   /// directly, anything else is parsed like TypePoint3F and friends would.
+   /// Components that are not present are set to zero.
+   void getVector(F32* out, U32 count) const;
+
+   /// Return the number of components of a cvVector value, or 0.
+   TORQUE_FORCEINLINE U32 getVectorSize() const
+   {
+      return type == ConsoleValueType::cvVector ? storage : 0;
+   }
+
    TORQUE_FORCEINLINE void setBool(const bool val)
    {
       cleanupData();
@@ -327,16 +471,20 @@ public:
       i = (int)val;
    }
 
+   /// Reference the given StringTableEntry without copying it.
    TORQUE_FORCEINLINE void setStringTableEntry(StringTableEntry val)
    {
       cleanupData();
       type = ConsoleValueType::cvSTEntry;
       s = const_cast<char*>(val);
+      ++smStringStats.steStores;
    }
 
    TORQUE_FORCEINLINE void setEmptyString()
    {
-      setStringTableEntry(StringTable->EmptyString());
+      cleanupData();
+      type = ConsoleValueType::cvSTEntry;
+      s = const_cast<char*>(StringTable->EmptyString());
    }
 
    TORQUE_FORCEINLINE void setConsoleData(S32 consoleType, void* dataPtr, const EnumTable* enumTable)
@@ -402,6 +550,12 @@ public:
 
    static void init();
    static void resetConversionBuffer();
+
+   /// Return the string storage counters of the calling thread.
+   static const StringStats& getStringStats() { return smStringStats; }
+
+   /// Zero the string storage counters of the calling thread.
+   static void resetStringStats() { dMemset(&smStringStats, 0, sizeof(smStringStats)); }
 };
 
 // Transparently converts ConsoleValue[] to const char**
@@ -442,6 +596,9 @@ public:
 /// function exposed to the scripting language. StringCallback,
 /// IntCallback, FloatCallback, VoidCallback, and BoolCallback all
 /// represent exposed script functions returning different types.
+/// ValueCallback functions hand back a ConsoleValue directly, which
+/// lets engine functions return strings and vectors without going
+/// through the return buffer.
 ///
 /// ConsumerCallback is used with the function Con::addConsumer; functions
 /// registered with Con::addConsumer are called whenever something is outputted
@@ -459,6 +616,7 @@ typedef S32(*IntCallback)(SimObject *obj, S32 argc, ConsoleValue argv[]);
 typedef F32(*FloatCallback)(SimObject *obj, S32 argc, ConsoleValue argv[]);
 typedef void(*VoidCallback)(SimObject *obj, S32 argc, ConsoleValue argv[]); // We have it return a value so things don't break..
 typedef bool(*BoolCallback)(SimObject *obj, S32 argc, ConsoleValue argv[]);
+typedef ConsoleValue(*ValueCallback)(SimObject *obj, S32 argc, ConsoleValue argv[]);
 
 typedef void(*ConsumerCallback)(U32 level, const char *consoleLine);
 /// @}
@@ -581,6 +739,19 @@ namespace Con
    void addConsumer(ConsumerCallback cb);
    void removeConsumer(ConsumerCallback cb);
 
+   /// Add a consumer that is called from the console log writer thread
+   /// instead of from the thread doing the printing.
+   ///
+   /// Regular consumers are always called on the main thread; lines
+   /// printed on other threads are handed to them by processLog().  Async
+   /// consumers see every line in order right after it has been written to
+   /// console.log, but must be thread safe.  With $Con::asyncLog off they
+   /// are called directly by the printing thread.
+   ///
+   /// @see ConsoleLogger
+   void addAsyncConsumer(ConsumerCallback cb);
+   void removeAsyncConsumer(ConsumerCallback cb);
+
    typedef JournaledSignal<void(RawData)> ConsoleInputEvent;
 
    /// Called from the native consoles to provide lines of console input
@@ -804,6 +975,7 @@ namespace Con
    void addCommand(const char* name, FloatCallback  cb, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
    void addCommand(const char* name, VoidCallback   cb, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
    void addCommand(const char* name, BoolCallback   cb, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
+   void addCommand(const char* name, ValueCallback  cb, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
 
                                                                                                                                                                    /// @}
 
@@ -827,6 +999,7 @@ namespace Con
    void addCommand(const char *nameSpace, const char *name, FloatCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char*, const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
    void addCommand(const char *nameSpace, const char *name, VoidCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char*, const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
    void addCommand(const char *nameSpace, const char *name, BoolCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char*, const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
+   void addCommand(const char *nameSpace, const char *name, ValueCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL); ///< @copydoc addCommand( const char*, const char *, StringCallback, const char *, S32, S32, bool, ConsoleFunctionHeader* )
 
                                                                                                                                                                                         /// @}
 
@@ -978,6 +1151,20 @@ namespace Con
    void unlockLog(void);
    void setLogMode(S32 mode);
 
+   /// Returns how many times old entries have been dropped from the log
+   /// history.  Entries (and their strings) obtained from getLockLog()
+   /// are only valid as long as this doesn't change.
+   U32 getLogTrimCount();
+
+   /// Hands lines printed on other threads to the consumers and the
+   /// log history and starts or stops the log writer thread as
+   /// $Con::asyncLog says.  Called by the main loop once per frame.
+   void processLog();
+
+   /// Blocks until everything printed so far has been written to
+   /// console.log and passed to the async consumers.
+   void flushLog();
+
    /// @}
 
    /// @name Instant Group
@@ -1081,6 +1268,7 @@ public:
    FloatCallback mFC;    ///< A function/method that returns a float.
    VoidCallback mVC;     ///< A function/method that returns nothing.
    BoolCallback mBC;     ///< A function/method that returns a bool.
+   ValueCallback mValC;  ///< A function/method that returns a ConsoleValue.
    bool mGroup;          ///< Indicates that this is a group marker.
    bool mNS;             ///< Indicates that this is a namespace marker.
                         ///  @deprecated Unused.
@@ -1190,6 +1378,7 @@ public:
    ConsoleConstructor(const char* className, const char* funcName, FloatCallback  ffunc, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
    ConsoleConstructor(const char* className, const char* funcName, VoidCallback   vfunc, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
    ConsoleConstructor(const char* className, const char* funcName, BoolCallback   bfunc, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
+   ConsoleConstructor(const char* className, const char* funcName, ValueCallback  cvfunc, const char* usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
 
    /// @}
 
@@ -2358,6 +2358,154 @@ DefineEngineFunction( eval, const char*, ( const char* consoleString ), , "eval(
    return Con::getReturnBuffer(returnValue.value.getString());
 }
 
+//-----------------------------------------------------------------------------
+
+static void printConsoleValueStats( const char* label, U32 iterations )
+{
+   const ConsoleValue::StringStats& stats = ConsoleValue::getStringStats();
+   const F32 perIteration = iterations ? 1.0f / iterations : 1.0f;
+
+   Con::printf( "   %s: %u mallocs (%.2f per %s), %u pool hits, %u inline, %u string table refs, %u number conversions",
+      label,
+      stats.mallocs, stats.mallocs * perIteration, iterations ? "iteration" : "frame",
+      stats.poolHits, stats.inlineStores, stats.steStores, stats.conversions );
+}
+
+DefineEngineFunction( dumpConsoleValueStats, void, ( bool reset ), ( false ),
+   "@brief Print how script strings were stored since the counters were last reset.\n\n"
+   "Lists the heap allocations made for string values alongside the strings that were served "
+   "from the string pools, stored inline or referenced from the string table.\n"
+   "@param reset If true, zero the counters afterwards.\n"
+   "@see $Con::pooledStrings\n"
+   "@ingroup Console" )
+{
+   const ConsoleValue::StringStats& stats = ConsoleValue::getStringStats();
+
+   Con::printf( "Console value strings over %u frames:", stats.frames );
+   printConsoleValueStats( "total", stats.frames );
+
+   if ( reset )
+      ConsoleValue::resetStringStats();
+}
+
+DefineEngineFunction( benchmarkConsoleStrings, void, ( S32 iterations ), ( 10000 ),
+   "@brief Run a string heavy script loop with and without pooled string storage and print "
+   "the heap allocations and time taken by each.\n\n"
+   "@param iterations Number of times the script loop runs.\n"
+   "@see $Con::pooledStrings\n"
+   "@ingroup Console\n"
+   "@internal" )
+{
+   // Builds strings, reads and writes locals, globals and fields and calls
+   // script and engine functions, which is where string churn comes from.
+   static const char* sBenchmarkScript =
+      "function __benchmarkConsoleStrings(%count)\n"
+      "{\n"
+      "   %obj = new ScriptObject();\n"
+      "   for (%i = 0; %i < %count; %i++)\n"
+      "   {\n"
+      "      %name = \"item\" @ %i;\n"
+      "      %pos = %i SPC %i * 2 SPC \"0\";\n"
+      "      %obj.label = %name @ \": \" @ %pos;\n"
+      "      $benchmarkConsoleStrings::last = getWord(%pos, 1) @ \"/\" @ strlen(%obj.label);\n"
+      "      %long = %obj.label @ \" - \" @ %obj.label @ \" - \" @ %obj.label;\n"
+      "   }\n"
+      "   %obj.delete();\n"
+      "   return %long;\n"
+      "}\n";
+
+   iterations = getMax( iterations, 1 );
+   Con::evaluate( sBenchmarkScript, false, NULL );
+
+   const bool pooledStrings = ConsoleValue::smPooledStrings;
+
+   Con::printf( "benchmarkConsoleStrings: %d iterations", iterations );
+   for ( U32 pass = 0; pass < 2; pass++ )
+   {
+      ConsoleValue::smPooledStrings = ( pass == 1 );
+      ConsoleValue::resetStringStats();
+
+      const U32 start = Platform::getRealMilliseconds();
+      Con::executef( "__benchmarkConsoleStrings", iterations );
+      const U32 elapsed = Platform::getRealMilliseconds() - start;
+
+      printConsoleValueStats( ConsoleValue::smPooledStrings ? "pooled" : "heap  ", iterations );
+      Con::printf( "      %u ms", elapsed );
+   }
+
+   ConsoleValue::smPooledStrings = pooledStrings;
+   ConsoleValue::resetStringStats();
+}
+
+DefineEngineFunction( benchmarkEngineCalls, void, ( S32 iterations ), ( 100000 ),
+   "@brief Time script calls into a set of representative engine functions and methods and print "
+   "the cost of each call along with the number of values that had to be converted to strings.\n\n"
+   "@param iterations Number of calls made to each function.\n"
+   "@ingroup Console\n"
+   "@internal" )
+{
+   struct BenchmarkCall
+   {
+      const char* label;
+      const char* statement;
+   };
+
+   // The first entry is the bare loop, which is subtracted from the others.
+   static const BenchmarkCall sCalls[] =
+   {
+      { "loop only",              "%r = %i;" },
+      { "mFloor(F32) -> S32",     "%r = mFloor(%f);" },
+      { "mClamp(F32 x3) -> F32",  "%r = mClamp(%f, 0, 1);" },
+      { "obj.getId() -> S32",     "%r = %obj.getId();" },
+      { "obj.isField(str) -> bool", "%r = %obj.isField(\"label\");" },
+      { "obj.getClassName() -> str", "%r = %obj.getClassName();" },
+      { "VectorLen(vec) -> F32",  "%r = VectorLen(%a);" },
+      { "VectorAdd(vec, vec) -> vec", "%r = VectorAdd(%a, %b);" },
+      { "VectorLen(VectorAdd())", "%r = VectorLen(VectorAdd(%a, %b));" },
+   };
+
+   iterations = getMax( iterations, 1 );
+
+   SimObject* obj = new SimObject();
+   obj->registerObject();
+
+   Con::printf( "benchmarkEngineCalls: %d iterations", iterations );
+
+   F32 baseline = 0.0f;
+   for ( U32 i = 0; i < sizeof( sCalls ) / sizeof( sCalls[ 0 ] ); i++ )
+   {
+      char script[ 512 ];
+      dSprintf( script, sizeof( script ),
+         "function __benchmarkEngineCalls(%%count, %%obj)\n"
+         "{\n"
+         "   %%f = 0.25;\n"
+         "   %%a = \"1 2 3\";\n"
+         "   %%b = VectorScale(%%a, 2);\n"
+         "   for (%%i = 0; %%i < %%count; %%i++)\n"
+         "      %s\n"
+         "   return %%r;\n"
+         "}\n", sCalls[ i ].statement );
+      Con::evaluate( script, false, NULL );
+
+      ConsoleValue::resetStringStats();
+
+      const U32 start = Platform::getRealMilliseconds();
+      Con::executef( "__benchmarkEngineCalls", iterations, obj->getId() );
+      const U32 elapsed = Platform::getRealMilliseconds() - start;
+
+      const F32 nsPerCall = elapsed * 1000000.0f / iterations;
+      if ( i == 0 )
+         baseline = nsPerCall;
+
+      Con::printf( "   %-28s %6.1f ns/call, %u string conversions",
+         sCalls[ i ].label, i == 0 ? nsPerCall : getMax( nsPerCall - baseline, 0.0f ),
+         ConsoleValue::getStringStats().conversions );
+   }
+
+   obj->deleteObject();
+   ConsoleValue::resetStringStats();
+}
+
 DefineEngineFunction( getVariable, const char*, ( const char* varName ), , "(string varName)\n"
    "@brief Returns the value of the named variable or an empty string if not found.\n\n"
    "@varName Name of the variable to search for\n"
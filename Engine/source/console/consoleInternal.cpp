@@ -1100,6 +1100,21 @@ void Namespace::addCommand(StringTableEntry name, BoolCallback cb, const char *u
    ent->cb.mBoolCallbackFunc = cb;
 }
 
+void Namespace::addCommand(StringTableEntry name, ValueCallback cb, const char *usage, S32 minArgs, S32 maxArgs, bool isToolOnly, ConsoleFunctionHeader* header)
+{
+   Entry *ent = createLocalEntry(name);
+   trashCache();
+
+   ent->mUsage = usage;
+   ent->mHeader = header;
+   ent->mMinArgs = minArgs;
+   ent->mMaxArgs = maxArgs;
+   ent->mToolOnly = isToolOnly;
+
+   ent->mType = Entry::ValueCallbackType;
+   ent->cb.mValueCallbackFunc = cb;
+}
+
 void Namespace::addScriptCallback(const char *funcName, const char *usage, ConsoleFunctionHeader* header)
 {
    static U32 uid = 0;
@@ -1199,6 +1214,9 @@ ConsoleValue Namespace::Entry::execute(S32 argc, ConsoleValue *argv, SimObject *
       case BoolCallbackType:
          result.setBool(cb.mBoolCallbackFunc(thisObj, argc, argv));
          break;
+      case ValueCallbackType:
+         result = cb.mValueCallbackFunc(thisObj, argc, argv);
+         break;
    }
 
    return result;
@@ -1540,6 +1558,10 @@ String Namespace::Entry::getPrototypeString() const
             str.append("bool ");
             break;
 
+         case ValueCallbackType:
+            str.append("string ");
+            break;
+
          case ScriptCallbackType:
             break;
       }
@@ -90,7 +90,8 @@ public:
          IntCallbackType,
          FloatCallbackType,
          VoidCallbackType,
-         BoolCallbackType
+         BoolCallbackType,
+         ValueCallbackType
       };
 
       /// Link back to the namespace to which the entry belongs.
@@ -140,6 +141,7 @@ public:
          VoidCallback mVoidCallbackFunc;
          FloatCallback mFloatCallbackFunc;
          BoolCallback mBoolCallbackFunc;
+         ValueCallback mValueCallbackFunc;
          const char *mGroupName;
          const char *mCallbackName;
       } cb;
@@ -187,6 +189,7 @@ public:
    void addCommand(StringTableEntry name, FloatCallback, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
    void addCommand(StringTableEntry name, VoidCallback, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
    void addCommand(StringTableEntry name, BoolCallback, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
+   void addCommand(StringTableEntry name, ValueCallback, const char *usage, S32 minArgs, S32 maxArgs, bool toolOnly = false, ConsoleFunctionHeader* header = NULL);
 
    void addScriptCallback(const char *funcName, const char *usage, ConsoleFunctionHeader* header = NULL);
 
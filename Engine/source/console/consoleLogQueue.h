@@ -0,0 +1,161 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _CONSOLELOGQUEUE_H_
+#define _CONSOLELOGQUEUE_H_
+
+#ifndef _CONSOLE_H_
+   #include "console/console.h"
+#endif
+#ifndef _PLATFORMINTRINSICS_H_
+   #include "platform/platformIntrinsics.h"
+#endif
+
+
+/// A console line on its way from the thread that printed it to
+/// whoever consumes it.
+struct ConsoleLogRecord
+{
+   ConsoleLogEntry::Level mLevel;
+   ConsoleLogEntry::Type mType;
+
+   /// Index of the printing thread.  The main thread is always 0.
+   U32 mThread;
+
+   /// Number of the frame the line was printed in.
+   U32 mFrame;
+
+   /// The text as passed to the consumers.  Allocated with dMalloc and
+   /// owned by whoever holds the record.
+   char* mString;
+};
+
+/// Fixed size ring of ConsoleLogRecords that any number of threads can
+/// push to without taking a lock and exactly one thread pops from.
+///
+/// Every slot carries a sequence number that tells producers whether the
+/// slot is free for the current lap around the ring and tells the consumer
+/// whether the record in it is complete.  Producers claim a position by
+/// advancing the enqueue counter with a compare and swap, so a producer
+/// that is preempted while filling its slot only holds up the consumer,
+/// never the other producers.
+///
+/// @param SIZE Number of slots, must be a power of two.
+template< U32 SIZE >
+class ConsoleLogQueue
+{
+   protected:
+
+      struct Slot
+      {
+         volatile U32 mSequence;
+         ConsoleLogRecord mRecord;
+      };
+
+      Slot mSlots[ SIZE ];
+
+      /// Position the next push goes to.
+      volatile U32 mEnqueuePos;
+
+      /// Position the next pop comes from.  Only touched by the consumer.
+      U32 mDequeuePos;
+
+      /// Number of records the consumer has finished with.  Lets
+      /// producers wait for everything they pushed to be handled.
+      volatile U32 mNumProcessed;
+
+   public:
+
+      ConsoleLogQueue()
+         : mEnqueuePos( 0 ),
+           mDequeuePos( 0 ),
+           mNumProcessed( 0 )
+      {
+         for( U32 i = 0; i < SIZE; ++ i )
+            mSlots[ i ].mSequence = i;
+      }
+
+      /// Add a record to the queue.  Returns false if the queue is full.
+      bool tryPush( const ConsoleLogRecord& record )
+      {
+         Slot* slot;
+         U32 pos;
+         for( ;; )
+         {
+            pos = dAtomicRead( mEnqueuePos );
+            slot = &mSlots[ pos & ( SIZE - 1 ) ];
+            const S32 diff = S32( dAtomicRead( slot->mSequence ) - pos );
+
+            if( diff == 0 )
+            {
+               if( dCompareAndSwap( mEnqueuePos, pos, pos + 1 ) )
+                  break;
+            }
+            else if( diff < 0 )
+               return false; // The consumer hasn't freed this slot yet.
+
+            // Otherwise another producer took this position; try the next one.
+         }
+
+         slot->mRecord = record;
+
+         // Publish the record.  We own the slot so the swap always succeeds;
+         // it's only here for the barrier.
+         dCompareAndSwap( slot->mSequence, pos, pos + 1 );
+         return true;
+      }
+
+      /// Take the oldest record off the queue.  Returns false if there is
+      /// nothing to take or the oldest record is still being written.
+      /// Consumer thread only.
+      bool tryPop( ConsoleLogRecord& outRecord )
+      {
+         Slot* slot = &mSlots[ mDequeuePos & ( SIZE - 1 ) ];
+         if( dAtomicRead( slot->mSequence ) != mDequeuePos + 1 )
+            return false;
+
+         outRecord = slot->mRecord;
+
+         // Hand the slot back to the producers for the next lap.
+         dCompareAndSwap( slot->mSequence, mDequeuePos + 1, mDequeuePos + SIZE );
+         ++ mDequeuePos;
+         return true;
+      }
+
+      /// Mark a popped record as fully handled.  Consumer thread only.
+      void markProcessed()
+      {
+         dFetchAndAdd( mNumProcessed, 1 );
+      }
+
+      /// Return a ticket for everything pushed so far to pass to isProcessed().
+      U32 getTicket() { return dAtomicRead( mEnqueuePos ); }
+
+      /// Return true if the consumer has handled everything that had been
+      /// pushed when @a ticket was taken.
+      bool isProcessed( U32 ticket ) { return S32( dAtomicRead( mNumProcessed ) - ticket ) >= 0; }
+
+      /// Return true if there is nothing waiting in the queue.
+      bool isEmpty() { return dAtomicRead( mEnqueuePos ) == mDequeuePos; }
+};
+
+#endif // _CONSOLELOGQUEUE_H_
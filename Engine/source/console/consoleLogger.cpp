@@ -24,6 +24,7 @@
 #include "console/engineAPI.h"
 
 Vector<ConsoleLogger *> ConsoleLogger::mActiveLoggers;
+Mutex ConsoleLogger::smActiveLoggersMutex;
 bool ConsoleLogger::smInitialized = false;
 
 IMPLEMENT_CONOBJECT( ConsoleLogger );
@@ -116,7 +117,7 @@ bool ConsoleLogger::init()
    if( smInitialized )
       return true;
 
-   Con::addConsumer( ConsoleLogger::logCallback );
+   Con::addAsyncConsumer( ConsoleLogger::logCallback );
    smInitialized = true;
 
    return true;
@@ -145,6 +146,10 @@ bool ConsoleLogger::attach()
    if( mLogging )
       return false;
 
+   // The log writer thread may be writing to the other loggers
+   MutexHandle loggersLock;
+   loggersLock.lock( &smActiveLoggersMutex, true );
+
    // Open the filestream
    mStream.open( mFilename, ( mAppend ? Torque::FS::File::WriteAppend : Torque::FS::File::Write ) );
 
@@ -172,6 +177,12 @@ bool ConsoleLogger::detach()
    if( !mLogging )
       return false;
 
+   // Let lines printed while we were attached reach the file, then wait
+   // for the log writer thread to be done with us
+   Con::flushLog();
+   MutexHandle loggersLock;
+   loggersLock.lock( &smActiveLoggersMutex, true );
+
    // Close filestream
    mStream.close();
 
@@ -196,6 +207,9 @@ void ConsoleLogger::logCallback( U32 level, const char *consoleLine )
 
    ConsoleLogger *curr;
 
+   MutexHandle loggersLock;
+   loggersLock.lock( &smActiveLoggersMutex, true );
+
    // Loop through active consumers and send them the message
    for( int i = 0; i < mActiveLoggers.size(); i++ ) 
    {
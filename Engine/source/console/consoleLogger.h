@@ -32,6 +32,9 @@
 #ifndef _FILESTREAM_H_
    #include "core/stream/fileStream.h"
 #endif
+#ifndef _PLATFORM_THREADS_MUTEX_H_
+   #include "platform/threads/mutex.h"
+#endif
 
 
 /// @ingroup console_system Console System
@@ -57,6 +60,10 @@ class ConsoleLogger : public SimObject
       /// List of active ConsoleLoggers to send log messages to
       static Vector<ConsoleLogger *> mActiveLoggers;
 
+      /// Guards mActiveLoggers and the loggers' streams, as lines are
+      /// logged from the console log writer thread.
+      static Mutex smActiveLoggersMutex;
+
       /// The log function called by the consumer callback
       /// @param   consoleLine   Line of text to log
       void log( const char *consoleLine );
@@ -116,8 +123,9 @@ class ConsoleLogger : public SimObject
 
       /// The callback for the console consumer
       ///
-      /// @note This is a global callback, not executed per-instance.
-      /// @see Con::addConsumer
+      /// @note This is a global callback, not executed per-instance.  It
+      ///       is called on the console log writer thread.
+      /// @see Con::addAsyncConsumer
       static void logCallback( U32 level, const char *consoleLine );
 };
 
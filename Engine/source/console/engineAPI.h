@@ -59,6 +59,9 @@
 #ifndef _ENGINESTRUCTS_H_
    #include "console/engineStructs.h"
 #endif
+#ifndef _MPOINT4_H_
+   #include "math/mPoint4.h"
+#endif
 
 // Needed for the executef macros. Blame GCC.
 #ifndef _SIMEVENTS_H_
@@ -177,6 +180,18 @@ inline void EngineMarshallData( char* arg, S32& argc, ConsoleValue *argv )
 {
    argv[ argc++ ].setString(arg);
 }
+inline void EngineMarshallData( const Point2F& arg, S32& argc, ConsoleValue *argv )
+{
+   argv[ argc++ ].setVector( arg, 2 );
+}
+inline void EngineMarshallData( const Point3F& arg, S32& argc, ConsoleValue *argv )
+{
+   argv[ argc++ ].setVector( arg, 3 );
+}
+inline void EngineMarshallData( const Point4F& arg, S32& argc, ConsoleValue *argv )
+{
+   argv[ argc++ ].setVector( arg, 4 );
+}
 
 template< typename T >
 inline void EngineMarshallData( T* object, S32& argc, ConsoleValue *argv )
@@ -256,6 +271,83 @@ struct EngineUnmarshallData< U8 >
    }
 };
 template<>
+struct EngineUnmarshallData< bool >
+{
+   bool operator()( ConsoleValue &ref ) const
+   {
+      return ref.getBool();
+   }
+
+   bool operator()( const char* str ) const
+   {
+      return dAtob( str );
+   }
+};
+template<>
+struct EngineUnmarshallData< String >
+{
+   String operator()( ConsoleValue &ref ) const
+   {
+      return String( ref.getString() );
+   }
+
+   String operator()( const char* str ) const
+   {
+      return String( str );
+   }
+};
+template<>
+struct EngineUnmarshallData< Point2F >
+{
+   Point2F operator()( ConsoleValue &ref ) const
+   {
+      Point2F value;
+      ref.getVector( value, 2 );
+      return value;
+   }
+
+   Point2F operator()( const char* str ) const
+   {
+      Point2F value( 0.0f, 0.0f );
+      dSscanf( str, "%g %g", &value.x, &value.y );
+      return value;
+   }
+};
+template<>
+struct EngineUnmarshallData< Point3F >
+{
+   Point3F operator()( ConsoleValue &ref ) const
+   {
+      Point3F value;
+      ref.getVector( value, 3 );
+      return value;
+   }
+
+   Point3F operator()( const char* str ) const
+   {
+      Point3F value( 0.0f, 0.0f, 0.0f );
+      dSscanf( str, "%g %g %g", &value.x, &value.y, &value.z );
+      return value;
+   }
+};
+template<>
+struct EngineUnmarshallData< Point4F >
+{
+   Point4F operator()( ConsoleValue &ref ) const
+   {
+      Point4F value;
+      ref.getVector( value, 4 );
+      return value;
+   }
+
+   Point4F operator()( const char* str ) const
+   {
+      Point4F value( 0.0f, 0.0f, 0.0f, 0.0f );
+      dSscanf( str, "%g %g %g %g", &value.x, &value.y, &value.z, &value.w );
+      return value;
+   }
+};
+template<>
 struct EngineUnmarshallData< const char* >
 {
    const char* operator()( ConsoleValue &ref ) const
@@ -439,13 +531,40 @@ inline S32 _EngineConsoleThunkReturnValue( S32 value )
 {
    return value;
 }
+inline U32 _EngineConsoleThunkReturnValue( U32 value )
+{
+   return value;
+}
 inline F32 _EngineConsoleThunkReturnValue( F32 value )
 {
    return value;
 }
-inline const char* _EngineConsoleThunkReturnValue( const String& str )
+
+// Strings and vectors are handed back in a ConsoleValue so they are
+// neither formatted nor copied through the return buffer.
+inline ConsoleValue _EngineConsoleThunkReturnValue( const String& str )
 {
-   return Con::getReturnBuffer( str );
+   ConsoleValue value;
+   value.setString( str.c_str(), str.length() );
+   return value;
+}
+inline ConsoleValue _EngineConsoleThunkReturnValue( const Point2F& pt )
+{
+   ConsoleValue value;
+   value.setVector( pt, 2 );
+   return value;
+}
+inline ConsoleValue _EngineConsoleThunkReturnValue( const Point3F& pt )
+{
+   ConsoleValue value;
+   value.setVector( pt, 3 );
+   return value;
+}
+inline ConsoleValue _EngineConsoleThunkReturnValue( const Point4F& pt )
+{
+   ConsoleValue value;
+   value.setVector( pt, 4 );
+   return value;
 }
 inline const char* _EngineConsoleThunkReturnValue( const char* value )
 {
@@ -496,6 +615,30 @@ struct _EngineConsoleThunkType< bool >
    typedef BoolCallback CallbackType;
 };
 template<>
+struct _EngineConsoleThunkType< String >
+{
+   typedef ConsoleValue ReturnType;
+   typedef ValueCallback CallbackType;
+};
+template<>
+struct _EngineConsoleThunkType< Point2F >
+{
+   typedef ConsoleValue ReturnType;
+   typedef ValueCallback CallbackType;
+};
+template<>
+struct _EngineConsoleThunkType< Point3F >
+{
+   typedef ConsoleValue ReturnType;
+   typedef ValueCallback CallbackType;
+};
+template<>
+struct _EngineConsoleThunkType< Point4F >
+{
+   typedef ConsoleValue ReturnType;
+   typedef ValueCallback CallbackType;
+};
+template<>
 struct _EngineConsoleThunkType< void >
 {
    typedef void ReturnType;
@@ -30,6 +30,8 @@
 
 #include "console/console.h"
 #include "console/consoleInternal.h"
+#include "console/engineAPI.h"
+#include "console/simSet.h"
 #include "core/frameAllocator.h"
 
 SimFieldDictionary::Entry *SimFieldDictionary::smFreeList = NULL;
@@ -38,70 +40,206 @@ static Chunker<SimFieldDictionary::Entry> fieldChunker;
 
 U32 SimFieldDictionary::getHashValue(StringTableEntry slotName)
 {
-   return HashPointer(slotName) % HashTableSize;
+   // String table entries are aligned, so scramble the pointer bits before
+   // the table size masks off all but the lowest ones.
+   U32 hash = HashPointer(slotName) * 2654435761U;
+   return hash ^ (hash >> 16);
 }
 
-U32 SimFieldDictionary::getHashValue(const String& fieldName)
-{
-   return getHashValue(StringTable->insert(fieldName));
-}
-
-SimFieldDictionary::Entry *SimFieldDictionary::addEntry(U32 bucket, StringTableEntry slotName, ConsoleBaseType* type, char* value)
+SimFieldDictionary::Entry *SimFieldDictionary::allocEntry(StringTableEntry slotName, ConsoleBaseType* type)
 {
    Entry* ret;
    if (smFreeList)
    {
       ret = smFreeList;
-      smFreeList = ret->next;
+      smFreeList = *(Entry**)ret;
    }
    else
       ret = fieldChunker.alloc();
 
-   ret->next = mHashTable[bucket];
    ret->slotName = slotName;
    ret->type = type;
-   ret->value = value;
-
-   mHashTable[bucket] = ret;
-   mNumFields++;
-   mVersion++;
+   ret->value = NULL;
 
    return ret;
 }
 
 void SimFieldDictionary::freeEntry(SimFieldDictionary::Entry *ent)
 {
-   ent->next = smFreeList;
+   freeEntryValue(ent);
+
+   // The free list is linked through the first word of the entry.
+   *(Entry**)ent = smFreeList;
    smFreeList = ent;
+}
+
+void SimFieldDictionary::setEntryValue(Entry *entry, const char *value)
+{
+   if (value == entry->value)
+      return;
+
+   if (!value)
+   {
+      freeEntryValue(entry);
+      return;
+   }
+
+   // The new value may be part of the old one, so copy before freeing.
+   char *oldValue = entry->isValueInline() ? NULL : entry->value;
+
+   const dsize_t size = dStrlen(value) + 1;
+   if (size <= Entry::InlineValueSize)
+   {
+      dMemmove(entry->inlineValue, value, size);
+      entry->value = entry->inlineValue;
+   }
+   else
+      entry->value = dStrdup(value);
+
+   if (oldValue)
+      dFree(oldValue);
+}
+
+void SimFieldDictionary::freeEntryValue(Entry *entry)
+{
+   if (entry->value && !entry->isValueInline())
+      dFree(entry->value);
+
+   entry->value = NULL;
+}
+
+SimFieldDictionary::Entry *SimFieldDictionary::addEntry(StringTableEntry slotName, ConsoleBaseType* type, const char* value)
+{
+   // Keep the table at most 3/4 full so probe sequences stay short.
+   if ((mNumFields + 1) * 4 > mTableSize * 3)
+      resizeTable(getMax((U32)MinTableSize, mTableSize * 2));
+
+   Entry *ret = allocEntry(slotName, type);
+   if (value)
+      setEntryValue(ret, value);
+
+   const U32 mask = mTableSize - 1;
+   U32 index = getHashValue(slotName) & mask;
+   while (mTable[index].entry)
+      index = (index + 1) & mask;
+
+   mTable[index].slotName = slotName;
+   mTable[index].entry = ret;
+
+   mNumFields++;
+   mVersion++;
+
+   return ret;
+}
 
+void SimFieldDictionary::removeSlot(U32 index)
+{
+   freeEntry(mTable[index].entry);
    mNumFields--;
+   mVersion++;
+
+   // Move later entries of the same probe sequence back into the gap, so
+   // that lookups never have to step over removed slots.
+   const U32 mask = mTableSize - 1;
+   U32 hole = index;
+   for (U32 i = (index + 1) & mask; mTable[i].entry; i = (i + 1) & mask)
+   {
+      const U32 home = getHashValue(mTable[i].slotName) & mask;
+
+      // The entry can move to the hole unless its home slot lies
+      // cyclically in (hole, i].
+      const bool canMove = (hole <= i) ? (home <= hole || home > i) : (home <= hole && home > i);
+      if (canMove)
+      {
+         mTable[hole] = mTable[i];
+         hole = i;
+      }
+   }
+
+   mTable[hole].slotName = NULL;
+   mTable[hole].entry = NULL;
+}
+
+S32 SimFieldDictionary::findSlot(StringTableEntry slotName) const
+{
+   if (!mTable)
+      return -1;
+
+   const U32 mask = mTableSize - 1;
+   for (U32 index = getHashValue(slotName) & mask; mTable[index].entry; index = (index + 1) & mask)
+   {
+      if (mTable[index].slotName == slotName)
+         return index;
+   }
+
+   return -1;
+}
+
+void SimFieldDictionary::resizeTable(U32 numSlots)
+{
+   AssertFatal(isPow2(numSlots), "SimFieldDictionary::resizeTable - table size must be a power of two");
+
+   Slot *oldTable = mTable;
+   const U32 oldSize = mTableSize;
+
+   mTable = new Slot[numSlots];
+   mTableSize = numSlots;
+   dMemset(mTable, 0, sizeof(Slot) * numSlots);
+
+   const U32 mask = mTableSize - 1;
+   for (U32 i = 0; i < oldSize; i++)
+   {
+      if (!oldTable[i].entry)
+         continue;
+
+      U32 index = getHashValue(oldTable[i].slotName) & mask;
+      while (mTable[index].entry)
+         index = (index + 1) & mask;
+
+      mTable[index] = oldTable[i];
+   }
+
+   delete [] oldTable;
 }
 
 SimFieldDictionary::SimFieldDictionary()
-   : mNumFields(0),
+   : mTable(NULL),
+   mTableSize(0),
+   mNumFields(0),
    mVersion(0)
 {
-   dMemset(mHashTable, 0, sizeof(mHashTable));
 }
 
 SimFieldDictionary::~SimFieldDictionary()
 {
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < mTableSize; i++)
    {
-      for (Entry *walk = mHashTable[i]; walk;)
+      if (mTable[i].entry)
       {
-         Entry *temp = walk;
-         walk = temp->next;
-
-         if (temp->value)
-            dFree(temp->value);
-         freeEntry(temp);
+         freeEntry(mTable[i].entry);
+         mNumFields--;
       }
    }
 
+   delete [] mTable;
+
    AssertFatal(mNumFields == 0, "Incorrect count on field dictionary");
 }
 
+U32 SimFieldDictionary::getMemoryUsage() const
+{
+   U32 size = sizeof(SimFieldDictionary) + mTableSize * sizeof(Slot) + mNumFields * sizeof(Entry);
+
+   for (U32 i = 0; i < mTableSize; i++)
+   {
+      const Entry *entry = mTable[i].entry;
+      if (entry && entry->value && !entry->isValueInline())
+         size += dStrlen(entry->value) + 1;
+   }
+
+   return size;
+}
+
 void SimFieldDictionary::setFieldType(StringTableEntry slotName, const char *typeString)
 {
    ConsoleBaseType *cbt = ConsoleBaseType::getTypeByName(typeString);
@@ -117,115 +255,75 @@ void SimFieldDictionary::setFieldType(StringTableEntry slotName, const U32 typeI
 void SimFieldDictionary::setFieldType(StringTableEntry slotName, ConsoleBaseType *type)
 {
    // If the field exists on the object, set the type
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
+   const S32 index = findSlot(slotName);
+   if (index != -1)
    {
-      if (walk->slotName == slotName)
-      {
-         // Found and type assigned, let's bail
-         walk->type = type;
-         return;
-      }
+      // Found and type assigned, let's bail
+      mTable[index].entry->type = type;
+      return;
    }
 
    // Otherwise create the field, and set the type. Assign a null value.
-   addEntry(bucket, slotName, type);
+   addEntry(slotName, type);
 }
 
 U32 SimFieldDictionary::getFieldType(StringTableEntry slotName) const
 {
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-      if (walk->slotName == slotName)
-         return walk->type ? walk->type->getTypeID() : TypeString;
+   const S32 index = findSlot(slotName);
+   if (index != -1 && mTable[index].entry->type)
+      return mTable[index].entry->type->getTypeID();
 
    return TypeString;
 }
 
 SimFieldDictionary::Entry  *SimFieldDictionary::findDynamicField(const String &fieldName) const
 {
-   U32 bucket = getHashValue(fieldName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-   {
-      if (fieldName.equal(walk->slotName, String::NoCase))
-         return walk;
-   }
-
-   return NULL;
+   // Field names are inserted into the string table without regard to
+   // case, so this matches any spelling of the name.  A name that isn't
+   // in the table can't be a field, and isn't worth adding.
+   StringTableEntry name = StringTable->lookup(fieldName, false);
+   return name ? findDynamicField(name) : NULL;
 }
 
 SimFieldDictionary::Entry *SimFieldDictionary::findDynamicField(StringTableEntry fieldName) const
 {
-   U32 bucket = getHashValue(fieldName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-   {
-      if (walk->slotName == fieldName)
-      {
-         return walk;
-      }
-   }
-
-   return NULL;
+   const S32 index = findSlot(fieldName);
+   return index != -1 ? mTable[index].entry : NULL;
 }
 
 
 void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *value)
 {
-   U32 bucket = getHashValue(slotName);
-   Entry **walk = &mHashTable[bucket];
-   while (*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
+   const S32 index = findSlot(slotName);
 
-   Entry *field = *walk;
    if (!value || !*value)
    {
-      if (field)
-      {
-         mVersion++;
-
-         if (field->value)
-            dFree(field->value);
-
-         *walk = field->next;
-         freeEntry(field);
-      }
+      if (index != -1)
+         removeSlot(index);
    }
    else
    {
-      if (field)
-      {
-         if (field->value)
-            dFree(field->value);
-
-         field->value = dStrdup(value);
-      }
+      if (index != -1)
+         setEntryValue(mTable[index].entry, value);
       else
-         addEntry(bucket, slotName, 0, dStrdup(value));
+         addEntry(slotName, 0, value);
    }
 }
 
 const char *SimFieldDictionary::getFieldValue(StringTableEntry slotName)
 {
-   U32 bucket = getHashValue(slotName);
-
-   for (Entry *walk = mHashTable[bucket]; walk; walk = walk->next)
-      if (walk->slotName == slotName)
-         return walk->value;
-
-   return NULL;
+   const S32 index = findSlot(slotName);
+   return index != -1 ? mTable[index].entry->value : NULL;
 }
 
 void SimFieldDictionary::assignFrom(SimFieldDictionary *dict)
 {
    mVersion++;
 
-   for (U32 i = 0; i < HashTableSize; i++)
+   for (U32 i = 0; i < dict->mTableSize; i++)
    {
-      for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
+      Entry *walk = dict->mTable[i].entry;
+      if (walk)
       {
          setFieldValue(walk->slotName, walk->value);
          setFieldType(walk->slotName, walk->type);
@@ -245,25 +343,26 @@ void SimFieldDictionary::writeFields(SimObject *obj, Stream &stream, U32 tabStop
    const AbstractClassRep::FieldList &list = obj->getFieldList();
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for (U32 curEntry = 0; curEntry < HashTableSize; curEntry++)
+   for (U32 curEntry = 0; curEntry < mTableSize; curEntry++)
    {
-      for (Entry *walk = mHashTable[curEntry]; walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 curField;
-         for (curField = 0; curField < list.size(); curField++)
-            if (list[curField].pFieldname == walk->slotName)
-               break;
+      Entry *walk = mTable[curEntry].entry;
+      if (!walk)
+         continue;
 
-         if (curField != list.size())
-            continue;
+      // make sure we haven't written this out yet:
+      U32 curField;
+      for (curField = 0; curField < list.size(); curField++)
+         if (list[curField].pFieldname == walk->slotName)
+            break;
 
+      if (curField != list.size())
+         continue;
 
-         if (!obj->writeField(walk->slotName, walk->value))
-            continue;
 
-         flist.push_back(walk);
-      }
+      if (!obj->writeField(walk->slotName, walk->value))
+         continue;
+
+      flist.push_back(walk);
    }
 
    // Sort Entries to prevent version control conflicts
@@ -293,21 +392,22 @@ void SimFieldDictionary::printFields(SimObject *obj)
    char expandedBuffer[4096];
    Vector<Entry *> flist(__FILE__, __LINE__);
 
-   for (U32 curEntry = 0; curEntry < HashTableSize; curEntry++)
+   for (U32 curEntry = 0; curEntry < mTableSize; curEntry++)
    {
-      for (Entry *walk = mHashTable[curEntry]; walk; walk = walk->next)
-      {
-         // make sure we haven't written this out yet:
-         U32 curField;
-         for (curField = 0; curField < list.size(); curField++)
-            if (list[curField].pFieldname == walk->slotName)
-               break;
+      Entry *walk = mTable[curEntry].entry;
+      if (!walk)
+         continue;
 
-         if (curField != list.size())
-            continue;
+      // make sure we haven't written this out yet:
+      U32 curField;
+      for (curField = 0; curField < list.size(); curField++)
+         if (list[curField].pFieldname == walk->slotName)
+            break;
 
-         flist.push_back(walk);
-      }
+      if (curField != list.size())
+         continue;
+
+      flist.push_back(walk);
    }
    dQsort(flist.address(), flist.size(), sizeof(Entry *), compareEntries);
 
@@ -353,11 +453,10 @@ SimFieldDictionary::Entry* SimFieldDictionaryIterator::operator++()
    if (!mDictionary)
       return(mEntry);
 
-   if (mEntry)
-      mEntry = mEntry->next;
+   mEntry = NULL;
 
-   while (!mEntry && (mHashIndex < (SimFieldDictionary::HashTableSize - 1)))
-      mEntry = mDictionary->mHashTable[++mHashIndex];
+   while (!mEntry && (mHashIndex < S32(mDictionary->mTableSize) - 1))
+      mEntry = mDictionary->mTable[++mHashIndex].entry;
 
    return(mEntry);
 }
@@ -384,16 +483,10 @@ void SimFieldDictionary::setFieldValue(StringTableEntry slotName, const char *va
    if (!value || !*value)
       return;
 
-   U32 bucket = getHashValue(slotName);
-   Entry **walk = &mHashTable[bucket];
-   while (*walk && (*walk)->slotName != slotName)
-      walk = &((*walk)->next);
-
-   Entry *field = *walk;
-   if (field)
+   if (findSlot(slotName) != -1)
       return;
 
-   addEntry(bucket, slotName, type, dStrdup(value));
+   addEntry(slotName, type, value);
 }
 // A variation of the stock SimFieldDictionary::assignFrom(), this method adds <no_replace>
 // and <filter> arguments. When true, <no_replace> prohibits the replacement of fields that already
@@ -410,17 +503,143 @@ void SimFieldDictionary::assignFrom(SimFieldDictionary *dict, const char* filter
 
    mVersion++;
 
-   if (filter_len == 0)
+   for (U32 i = 0; i < dict->mTableSize; i++)
    {
-      for (U32 i = 0; i < HashTableSize; i++)
-         for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
-            setFieldValue(walk->slotName, walk->value, walk->type, no_replace);
+      Entry *walk = dict->mTable[i].entry;
+      if (!walk)
+         continue;
+
+      if (filter_len == 0 || dStrncmp(walk->slotName, filter, filter_len) == 0)
+         setFieldValue(walk->slotName, walk->value, walk->type, no_replace);
    }
-   else
+}
+
+//------------------------------------------------------------------------------
+// Statistics.
+//------------------------------------------------------------------------------
+
+/// Bytes the same fields took up when every dictionary had 19 chained
+/// buckets and every value was a separate allocation, for comparison.
+static U32 _getChainedMemoryUsage(SimFieldDictionary *dict)
+{
+   const U32 entrySize = 4 * sizeof(void*);
+   U32 size = 19 * sizeof(void*) + 2 * sizeof(U32) + dict->getNumFields() * entrySize;
+
+   for (SimFieldDictionaryIterator itr(dict); *itr; ++itr)
+   {
+      if ((*itr)->value)
+         size += dStrlen((*itr)->value) + 1;
+   }
+
+   return size;
+}
+
+DefineEngineFunction( dumpFieldDictionaryStats, void, (),,
+   "@brief Prints how many dynamic fields the objects in the RootGroup have and how much "
+   "memory they take up.\n\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   U32 numObjects = 0;
+   U32 numDictionaries = 0;
+   U32 numFields = 0;
+   U32 numInline = 0;
+   U32 maxFields = 0;
+   U32 bytes = 0;
+   U32 chainedBytes = 0;
+
+   for (SimGroupIterator itr(Sim::getRootGroup()); *itr; ++itr)
+   {
+      numObjects++;
+
+      SimFieldDictionary *dict = (*itr)->getFieldDictionary();
+      if (!dict)
+         continue;
+
+      numDictionaries++;
+      numFields += dict->getNumFields();
+      maxFields = getMax(maxFields, dict->getNumFields());
+      bytes += dict->getMemoryUsage();
+      chainedBytes += _getChainedMemoryUsage(dict);
+
+      for (SimFieldDictionaryIterator fieldItr(dict); *fieldItr; ++fieldItr)
+      {
+         if ((*fieldItr)->isValueInline())
+            numInline++;
+      }
+   }
+
+   Con::printf("Dynamic fields: %d objects, %d with a field dictionary", numObjects, numDictionaries);
+   Con::printf("   %d fields, %.1f per dictionary, at most %d", numFields, numDictionaries ? F32(numFields) / numDictionaries : 0.0f, maxFields);
+   Con::printf("   %d values stored inline, %d allocated", numInline, numFields - numInline);
+   Con::printf("   %d bytes, %.1f per dictionary (chained buckets: %d bytes)", bytes, numDictionaries ? F32(bytes) / numDictionaries : 0.0f, chainedBytes);
+}
+
+DefineEngineFunction( benchmarkFieldDictionary, void, ( S32 numDictionaries, S32 numFields, S32 iterations ), ( 10000, 16, 20 ),
+   "@brief Fills field dictionaries the way datablocks and mission objects use them, then "
+   "times looking fields up and prints how much memory they take up.\n\n"
+   "@param numDictionaries Number of dictionaries to create.\n"
+   "@param numFields Number of fields to set on each.\n"
+   "@param iterations Number of times to look up every field.\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   const U32 numDicts = getMax(numDictionaries, 1);
+   const U32 fieldCount = getMax(numFields, 1);
+
+   // Half of the lookups are for fields that aren't there, as with the
+   // checks for optional fields.
+   Vector<StringTableEntry> names;
+   for (U32 i = 0; i < fieldCount * 2; i++)
+      names.push_back(StringTable->insert(avar("benchField%d", i)));
+
+   static const char *values[] =
+   {
+      "1",
+      "0.5 0.5 0.5 1",
+      "DefaultPlayerData",
+      "data/shapes/environment/rocks/boulder_large_01.dae",
+   };
+
+   Vector<SimFieldDictionary*> dicts;
+   dicts.setSize(numDicts);
+
+   U32 start = Platform::getRealMilliseconds();
+   for (U32 i = 0; i < numDicts; i++)
+   {
+      dicts[i] = new SimFieldDictionary;
+      for (U32 j = 0; j < fieldCount; j++)
+         dicts[i]->setFieldValue(names[j], values[(i + j) % 4]);
+   }
+   const U32 fillTime = Platform::getRealMilliseconds() - start;
+
+   U32 found = 0;
+   start = Platform::getRealMilliseconds();
+   for (U32 n = 0; n < iterations; n++)
    {
-      for (U32 i = 0; i < HashTableSize; i++)
-         for (Entry *walk = dict->mHashTable[i]; walk; walk = walk->next)
-            if (dStrncmp(walk->slotName, filter, filter_len) == 0)
-               setFieldValue(walk->slotName, walk->value, walk->type, no_replace);
+      for (U32 i = 0; i < numDicts; i++)
+      {
+         for (U32 j = 0; j < names.size(); j++)
+         {
+            if (dicts[i]->getFieldValue(names[j]))
+               found++;
+         }
+      }
    }
-}
\ No newline at end of file
+   const U32 lookupTime = Platform::getRealMilliseconds() - start;
+
+   U32 bytes = 0;
+   U32 chainedBytes = 0;
+   for (U32 i = 0; i < numDicts; i++)
+   {
+      bytes += dicts[i]->getMemoryUsage();
+      chainedBytes += _getChainedMemoryUsage(dicts[i]);
+      delete dicts[i];
+   }
+
+   const F64 numLookups = F64(iterations) * numDicts * names.size();
+   Con::printf("benchmarkFieldDictionary: %d dictionaries with %d fields", numDicts, fieldCount);
+   Con::printf("   fill    %6dms", fillTime);
+   Con::printf("   lookup  %6dms   %.1fns per lookup, %d found", lookupTime, numLookups > 0 ? lookupTime * 1000000.0 / numLookups : 0.0, found);
+   Con::printf("   memory  %d bytes per dictionary (chained buckets: %d)", bytes / numDicts, chainedBytes / numDicts);
+}
@@ -40,6 +40,16 @@ class SimObject;
 #endif
 
 /// Dictionary to keep track of dynamic fields on SimObject.
+///
+/// Fields are found through an open-addressed, linearly probed table of
+/// slots that hold the field name next to a pointer to its entry, so a
+/// lookup compares StringTableEntry pointers in one contiguous array and
+/// only touches the entry it finds.  The table is allocated with the first
+/// field and doubled as it fills up.
+///
+/// Entries themselves never move once added, since the editors hold on to
+/// them.  Values short enough to fit in the entry are stored in it rather
+/// than in a separate allocation.
 class SimFieldDictionary
 {
    friend class SimFieldDictionaryIterator;
@@ -47,28 +57,66 @@ class SimFieldDictionary
 public:
    struct Entry
    {
-      Entry() : slotName(StringTable->EmptyString()), value(NULL), next(NULL), type(NULL) {};
+      Entry() : slotName(StringTable->EmptyString()), value(NULL), type(NULL) {};
+
+      enum
+      {
+         /// Values up to this long, including the terminator, are stored
+         /// in inlineValue.
+         InlineValueSize = 24
+      };
 
       StringTableEntry slotName;
+
+      /// The value, which points either at inlineValue or at a heap copy.
       char *value;
-      Entry *next;
+
       ConsoleBaseType *type;
+
+      char inlineValue[InlineValueSize];
+
+      /// Returns true if the value doesn't have an allocation of its own.
+      bool isValueInline() const { return value == inlineValue; }
    };
+
    enum
    {
-      HashTableSize = 19
+      /// Size of the slot table when the first field is added.
+      MinTableSize = 8
    };
-   Entry *mHashTable[HashTableSize];
 
 private:
+   /// A slot in the table; empty if entry is NULL.
+   struct Slot
+   {
+      StringTableEntry slotName;
+      Entry *entry;
+   };
+
    static Entry   *smFreeList;
 
+   Entry*         allocEntry(StringTableEntry slotName, ConsoleBaseType* type);
    void           freeEntry(Entry *entry);
-   Entry*         addEntry(U32 bucket, StringTableEntry slotName, ConsoleBaseType* type, char* value = 0);
+
+   /// Add a field that isn't in the dictionary yet.
+   Entry*         addEntry(StringTableEntry slotName, ConsoleBaseType* type, const char* value = 0);
+
+   /// Remove the field in the given slot and close the gap it leaves.
+   void           removeSlot(U32 index);
+
+   /// Returns the index of the slot the field is in, or -1.
+   S32            findSlot(StringTableEntry slotName) const;
+
+   /// Rebuild the table with the given number of slots.
+   void           resizeTable(U32 numSlots);
+
+   static void    setEntryValue(Entry *entry, const char *value);
+   static void    freeEntryValue(Entry *entry);
 
    static U32     getHashValue(StringTableEntry slotName);
-   static U32     getHashValue(const String& fieldName);
 
+   Slot  *mTable;
+   U32   mTableSize;
    U32   mNumFields;
 
    /// In order to efficiently detect when a dynamic field has been
@@ -94,6 +142,10 @@ public:
    void assignFrom(SimFieldDictionary *dict);
    U32   getNumFields() const { return mNumFields; }
 
+   /// Returns the number of bytes the dictionary, its entries and their
+   /// values take up.
+   U32   getMemoryUsage() const;
+
    Entry  *operator[](U32 index);
    void setFieldValue(StringTableEntry slotName, const char *value, ConsoleBaseType *type, bool no_replace);
    void assignFrom(SimFieldDictionary *dict, const char* filter, bool no_replace);
@@ -2846,6 +2846,7 @@ namespace {
             switch( entry->mType )
             {
                case Namespace::Entry::StringCallbackType:
+               case Namespace::Entry::ValueCallbackType:
                   mReturnType = "string";
                   mPadding[ 0 ] = ' ';
                   mPadding[ 1 ] = ' ';
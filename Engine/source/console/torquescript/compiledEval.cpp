@@ -117,23 +117,6 @@ char *getReturnBuffer(U32 bufferSize)
    return retBuffer.getBuffer(bufferSize);
 }
 
-const char* tsconcat(const char* strA, const char* strB, S32& outputLen)
-{
-   S32 lenA = dStrlen(strA);
-   S32 lenB = dStrlen(strB);
-
-   S32 len = lenA + lenB + 1;
-
-   char* concatBuffer = (char*)dMalloc(len);
-
-   concatBuffer[len - 1] = '\0';
-   memcpy(concatBuffer, strA, lenA);
-   memcpy(concatBuffer + lenA, strB, lenB);
-
-   outputLen = lenA + lenB;
-   return concatBuffer;
-}
-
 namespace Con
 {
    // Current script file name and root, these are registered as
@@ -1758,7 +1741,7 @@ Con::EvalResult CodeBlock::exec(U32 ip, const char* functionName, Namespace* thi
       break;
 
       case OP_LOADIMMED_IDENT:
-         stack[_STK + 1].setString(CodeToSTE(code, ip));
+         stack[_STK + 1].setStringTableEntry(CodeToSTE(code, ip));
          _STK++;
          ip += 2;
          break;
@@ -2003,6 +1986,22 @@ Con::EvalResult CodeBlock::exec(U32 ip, const char* functionName, Namespace* thi
 
                   break;
                }
+               case Namespace::Entry::ValueCallbackType:
+               {
+                  ConsoleValue result = nsEntry->cb.mValueCallbackFunc(thisObject, callArgc, callArgv);
+                  gCallStack.popFrame();
+
+                  if (code[ip] == OP_POP_STK)
+                  {
+                     ip++;
+                     break;
+                  }
+
+                  stack[_STK + 1] = std::move(result);
+                  _STK++;
+
+                  break;
+               }
                }
             }
          }
@@ -2015,10 +2014,7 @@ Con::EvalResult CodeBlock::exec(U32 ip, const char* functionName, Namespace* thi
          buff[0] = (char)code[ip++];
          buff[1] = '\0';
 
-         S32 len;
-         const char* concat = tsconcat(stack[_STK].getString(), buff, len);
-
-         stack[_STK].setStringRef(concat, len);
+         stack[_STK].appendString(buff, 1);
          break;
       }
 
@@ -2026,10 +2022,8 @@ Con::EvalResult CodeBlock::exec(U32 ip, const char* functionName, Namespace* thi
          TORQUE_CASE_FALLTHROUGH;
       case OP_TERMINATE_REWIND_STR:
       {
-         S32 len;
-         const char* concat = tsconcat(stack[_STK - 1].getString(), stack[_STK].getString(), len);
-
-         stack[_STK - 1].setStringRef(concat, len);
+         const char* str = stack[_STK].getString();
+         stack[_STK - 1].appendString(str, dStrlen(str));
          _STK--;
          break;
       }
@@ -28,6 +28,7 @@
 #include "console/consoleObject.h"
 #include "platform/platformNet.h"
 #include "core/bitVector.h"
+#include "console/engineAPI.h"
 
 
 static BitStream gPacketStream(NULL, 0);
@@ -223,6 +224,89 @@ S32 BitStream::readClassId(U32 classType, U32 classGroup)
    return ret;
 }
 
+// The stream stores bit n in bit (n & 7) of byte (n >> 3), which is the
+// order of the bits in a little endian word.  So the bits at any position
+// can be moved with one unaligned 64 bit load and store and a shift, which
+// is what _writeWord() and _readWord() do.  They fall back to going byte by
+// byte within the last 8 bytes of the buffer so they never touch memory
+// outside of it.
+
+void BitStream::_writeWord(U64 value, S32 bitCount)
+{
+   AssertFatal(bitCount > 0 && bitCount <= 64, "BitStream::_writeWord - Bad bit count!");
+
+   const U64 mask = bitCount < 64 ? ((U64)1 << bitCount) - 1 : ~(U64)0;
+   value &= mask;
+
+   const S32 shift = bitNum & 0x7;
+   U8 *dst = mDataPtr + (bitNum >> 3);
+   const U8 *end = mDataPtr + (maxWriteBitNum >> 3);
+
+   const U64 lo = value << shift;
+   const U64 loMask = mask << shift;
+
+   if(end - dst >= 8)
+   {
+      U64 word;
+      dMemcpy(&word, dst, 8);
+      word = convertLEndianToHost(word);
+      word = (word & ~loMask) | lo;
+      word = convertHostToLEndian(word);
+      dMemcpy(dst, &word, 8);
+   }
+   else
+   {
+      const S32 byteCount = getMin((S32)((shift + bitCount + 7) >> 3), 8);
+      for(S32 i = 0; i < byteCount; i++)
+      {
+         const U8 byteMask = U8(loMask >> (i << 3));
+         dst[i] = (dst[i] & ~byteMask) | U8(lo >> (i << 3));
+      }
+   }
+
+   // A full word that doesn't start on a byte spills into a ninth byte.
+   if(shift + bitCount > 64)
+   {
+      const U8 byteMask = U8(mask >> (64 - shift));
+      dst[8] = (dst[8] & ~byteMask) | U8(value >> (64 - shift));
+   }
+
+   bitNum += bitCount;
+}
+
+U64 BitStream::_readWord(S32 bitCount)
+{
+   AssertFatal(bitCount > 0 && bitCount <= 64, "BitStream::_readWord - Bad bit count!");
+
+   const S32 shift = bitNum & 0x7;
+   const U8 *src = mDataPtr + (bitNum >> 3);
+   const U8 *end = mDataPtr + bufSize;
+
+   U64 value;
+   if(end - src >= 8)
+   {
+      dMemcpy(&value, src, 8);
+      value = convertLEndianToHost(value) >> shift;
+
+      if(shift + bitCount > 64 && end - src > 8)
+         value |= (U64)src[8] << (64 - shift);
+   }
+   else
+   {
+      // Anything past the end of the buffer reads as zero.
+      value = 0;
+      for(S32 i = 0; i < end - src; i++)
+         value |= (U64)src[i] << (i << 3);
+      value >>= shift;
+   }
+
+   bitNum += bitCount;
+
+   if(bitCount < 64)
+      value &= ((U64)1 << bitCount) - 1;
+   return value;
+}
+
 void BitStream::writeBits(S32 bitCount, const void *bitPtr)
 {
    if(!bitCount)
@@ -235,17 +319,30 @@ void BitStream::writeBits(S32 bitCount, const void *bitPtr)
       return;
    }
 
-   // [tom, 8/17/2006] This is probably a lot lamer then it needs to be. However,
-   // at least it doesnt clobber data or overrun the buffer like the old code did.
    const U8 *ptr = (U8 *)bitPtr;
 
-   for(S32 srcBitNum = 0;srcBitNum < bitCount;srcBitNum++)
+   // Whole bytes at a byte boundary are just copied.
+   if((bitNum & 0x7) == 0 && bitCount >= 8)
+   {
+      const S32 byteCount = bitCount >> 3;
+      dMemcpy(mDataPtr + (bitNum >> 3), ptr, byteCount);
+      bitNum += byteCount << 3;
+      ptr += byteCount;
+      bitCount &= 0x7;
+   }
+
+   U64 word;
+   for(; bitCount >= 64; bitCount -= 64, ptr += 8)
+   {
+      dMemcpy(&word, ptr, 8);
+      _writeWord(convertLEndianToHost(word), 64);
+   }
+
+   if(bitCount)
    {
-      if((*(ptr + (srcBitNum >> 3)) & (1 << (srcBitNum & 0x7))) != 0)
-         *(mDataPtr + (bitNum >> 3)) |= (1 << (bitNum & 0x7));
-      else
-         *(mDataPtr + (bitNum >> 3)) &= ~(1 << (bitNum & 0x7));
-      bitNum++;
+      word = 0;
+      dMemcpy(&word, ptr, (bitCount + 7) >> 3);
+      _writeWord(convertLEndianToHost(word), bitCount);
    }
 }
 
@@ -289,25 +386,33 @@ void BitStream::readBits(S32 bitCount, void *bitPtr)
       AssertWarn(false, "Out of range read");
       return;
    }
-   U8 *stPtr = mDataPtr + (bitNum >> 3);
-   S32 byteCount = (bitCount + 7) >> 3;
 
    U8 *ptr = (U8 *) bitPtr;
 
-   S32 downShift = bitNum & 0x7;
-   S32 upShift = 8 - downShift;
+   // Whole bytes at a byte boundary are just copied.
+   if((bitNum & 0x7) == 0 && bitCount >= 8)
+   {
+      const U8 *src = mDataPtr + (bitNum >> 3);
+      const S32 byteCount = getMin(bitCount >> 3, (S32)(mDataPtr + bufSize - src));
+      dMemcpy(ptr, src, byteCount);
+      bitNum += byteCount << 3;
+      ptr += byteCount;
+      bitCount -= byteCount << 3;
+   }
 
-   U8 curB = *stPtr;
-   const U8 *stEnd = mDataPtr + bufSize;
-   while(byteCount--)
+   U64 word;
+   for(; bitCount >= 64; bitCount -= 64, ptr += 8)
    {
-      stPtr++;
-      U8 nextB = stPtr < stEnd ? *stPtr : 0;
-      *ptr++ = (curB >> downShift) | (nextB << upShift);
-      curB = nextB;
+      word = convertHostToLEndian(_readWord(64));
+      dMemcpy(ptr, &word, 8);
    }
 
-   bitNum += bitCount;
+   // The unused bits of the last byte are cleared.
+   if(bitCount)
+   {
+      word = convertHostToLEndian(_readWord(bitCount));
+      dMemcpy(ptr, &word, (bitCount + 7) >> 3);
+   }
 }
 
 bool BitStream::_read(U32 size, void *dataPtr)
@@ -717,6 +822,80 @@ void InfiniteBitStream::writeToStream(Stream &s)
 
 //------------------------------------------------------------------------------
 
+DefineEngineFunction( benchmarkBitStream, void, ( S32 numUpdates, S32 iterations ), ( 10000, 100 ),
+   "@brief Packs and unpacks fields the way ghost updates do and prints how long it took.\n\n"
+   "Each update is a flag, a few integers and floats, a compressed point, a normal and a "
+   "block of raw bytes, most of which don't start at a byte boundary.\n"
+   "@param numUpdates Number of updates to pack into the stream.\n"
+   "@param iterations Number of times to pack and unpack the stream.\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   const U32 n = getMax( numUpdates, 1 );
+   const U32 passes = getMax( iterations, 1 );
+
+   // An update takes less than 64 bytes.
+   const U32 bufSize = n * 64;
+   U8 *buffer = (U8*)dMalloc( bufSize );
+   dMemset( buffer, 0, bufSize );
+   BitStream stream( buffer, bufSize );
+
+   U8 block[24];
+   for ( U32 i = 0; i < sizeof( block ); i++ )
+      block[i] = U8( i * 37 );
+
+   const Point3F normal( 0.267f, 0.535f, 0.802f );
+
+   U32 start = Platform::getRealMilliseconds();
+   for ( U32 pass = 0; pass < passes; pass++ )
+   {
+      stream.setBuffer( buffer, bufSize );
+      for ( U32 i = 0; i < n; i++ )
+      {
+         stream.writeFlag( i & 1 );
+         stream.writeInt( i & 0x3FF, 10 );
+         stream.writeRangedU32( i % 100, 0, 99 );
+         stream.writeFloat( 0.5f, 7 );
+         stream.writeSignedFloat( -0.25f, 9 );
+         stream.writeCompressedPoint( Point3F( F32( i % 64 ), 0.5f * ( i % 32 ), 10.0f ) );
+         stream.writeNormalVector( normal, 8 );
+         stream.write( sizeof( block ), block );
+      }
+   }
+   const U32 writeTime = Platform::getRealMilliseconds() - start;
+   const U32 bytes = stream.getPosition();
+
+   U32 checksum = 0;
+   Point3F p;
+   start = Platform::getRealMilliseconds();
+   for ( U32 pass = 0; pass < passes; pass++ )
+   {
+      stream.setBuffer( buffer, bufSize );
+      for ( U32 i = 0; i < n; i++ )
+      {
+         checksum += stream.readFlag();
+         checksum += stream.readInt( 10 );
+         checksum += stream.readRangedU32( 0, 99 );
+         checksum += U32( stream.readFloat( 7 ) * 100.0f );
+         checksum += U32( stream.readSignedFloat( 9 ) * -100.0f );
+         stream.readCompressedPoint( &p );
+         checksum += U32( p.x );
+         stream.readNormalVector( &p, 8 );
+         checksum += U32( p.z * 100.0f );
+         stream.read( sizeof( block ), block );
+         checksum += block[i % sizeof( block )];
+      }
+   }
+   const U32 readTime = Platform::getRealMilliseconds() - start;
+
+   dFree( buffer );
+
+   const F64 megabytes = F64( bytes ) * passes / ( 1024.0 * 1024.0 );
+   Con::printf( "benchmarkBitStream: %d updates, %d bytes per pass, %d passes (checksum %u)", n, bytes, passes, checksum );
+   Con::printf( "   write %6dms   %8.1f MB/s", writeTime, writeTime ? megabytes * 1000.0 / writeTime : 0.0 );
+   Con::printf( "   read  %6dms   %8.1f MB/s", readTime, readTime ? megabytes * 1000.0 / readTime : 0.0 );
+}
+
 void BitStream::readString(char buf[256])
 {
    if(stringBuffer)
@@ -62,6 +62,15 @@ protected:
    char *stringBuffer;
    Point3F mCompressPoint;
 
+   /// Write the low @a bitCount bits of @a value, 1 to 64 of them, at the
+   /// current position without changing the bits around them.  There's no
+   /// range check; that's up to the caller.
+   void _writeWord(U64 value, S32 bitCount);
+
+   /// Read 1 to 64 bits from the current position.  There's no range check;
+   /// bits past the end of the buffer read as zero.
+   U64 _readWord(S32 bitCount);
+
    friend class HuffmanProcessor;
 public:
    static BitStream *getPacketStream(U32 writeSize = 0);
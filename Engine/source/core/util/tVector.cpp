@@ -24,6 +24,9 @@
 #include "core/util/tVector.h"
 
 #include "platform/profiler.h"
+#include "console/engineAPI.h"
+#include "console/simObject.h"
+#include "console/simBase.h"
 
 
 #ifdef TORQUE_DEBUG_GUARD
@@ -99,3 +102,88 @@ bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 el
 }
 
 #endif
+
+//-----------------------------------------------------------------------------
+// Benchmark.
+//-----------------------------------------------------------------------------
+
+/// Wraps a vector element to count how often it is copied and moved.  It
+/// relocates just like the type it wraps.
+template< class T >
+struct VectorBenchElement
+{
+   static U32 smCopies;
+   static U32 smMoves;
+
+   T mValue;
+
+   VectorBenchElement() {}
+   VectorBenchElement( const VectorBenchElement& e ) : mValue( e.mValue ) { smCopies ++; }
+   VectorBenchElement( VectorBenchElement&& e ) : mValue( std::move( e.mValue ) ) { smMoves ++; }
+   VectorBenchElement& operator=( const VectorBenchElement& e ) { mValue = e.mValue; smCopies ++; return *this; }
+   VectorBenchElement& operator=( VectorBenchElement&& e ) { mValue = std::move( e.mValue ); smMoves ++; return *this; }
+};
+
+template< class T > U32 VectorBenchElement< T >::smCopies;
+template< class T > U32 VectorBenchElement< T >::smMoves;
+
+template< class T >
+struct VectorRelocatable< VectorBenchElement< T > > { static const bool value = VectorRelocatable< T >::value; };
+
+/// Appends @a count elements one at a time, then inserts and erases a few in
+/// the middle, and prints what that cost.
+template< class T, class Fill >
+static void _benchVector( const char* name, U32 count, Fill fill )
+{
+   typedef VectorBenchElement< T > Element;
+   Element::smCopies = 0;
+   Element::smMoves = 0;
+
+   const U32 start = Platform::getRealMilliseconds();
+   U32 allocs = 0;
+   {
+      Vector< Element > v;
+      U32 capacity = v.capacity();
+      for( U32 i = 0; i < count; i ++ )
+      {
+         fill( v.emplace_back().mValue, i );
+         if( v.capacity() != capacity )
+         {
+            capacity = v.capacity();
+            allocs ++;
+         }
+      }
+
+      for( U32 i = 0; i < 100; i ++ )
+      {
+         v.erase( count / 2 );
+         Element element;
+         fill( element.mValue, i );
+         v.insert( v.begin() + count / 3, std::move( element ) );
+      }
+   }
+   const U32 elapsed = Platform::getRealMilliseconds() - start;
+
+   Con::printf( "   %-16s %6dms   %6d allocations   %8d copies   %8d moves   relocatable: %s",
+      name, elapsed, allocs, Element::smCopies, Element::smMoves,
+      VectorRelocatable< T >::value ? "yes" : "no" );
+}
+
+DefineEngineFunction( benchmarkVector, void, ( S32 count ), ( 100000 ),
+   "@brief Fills Vectors of typical engine element types and prints how long it took and how "
+   "many times the elements were copied, moved and reallocated.\n\n"
+   "Each vector is appended @a count elements one at a time, then has elements erased and "
+   "inserted in the middle.\n"
+   "@param count Number of elements to append.\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   const U32 n = getMax( count, 1000 );
+   Con::printf( "benchmarkVector: %d elements, 16 element growth would need %d allocations", n, ( n + VectorBlockSize - 1 ) / VectorBlockSize );
+
+   _benchVector< S32 >( "S32", n, []( S32& e, U32 i ) { e = i; } );
+   _benchVector< String >( "String", n, []( String& e, U32 i ) { e = String::ToString( "element %d", i ); } );
+   _benchVector< ConsoleValue >( "ConsoleValue", n, []( ConsoleValue& e, U32 ) { e.setString( "a console value long enough to be on the heap" ); } );
+   _benchVector< SimObjectPtr< SimObject > >( "SimObjectPtr", n, []( SimObjectPtr< SimObject >& e, U32 ) { e = Sim::getRootGroup(); } );
+   _benchVector< Vector< S32 > >( "Vector<S32>", n, []( Vector< S32 >& e, U32 ) { e.setSize( 4 ); } );
+}
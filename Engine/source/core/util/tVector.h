@@ -29,6 +29,8 @@
 #include "platform/platform.h"
 #endif
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 #include "console/engineTypes.h"
 #include "console/engineTypeInfo.h"
 
@@ -45,6 +47,33 @@ extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount,
 extern bool VectorResize(U32 *aSize, U32 *aCount, void **arrayPtr, U32 newCount, U32 elemSize);
 #endif
 
+/// Returns the number of elements to allocate when a vector holding
+/// @a arraySize elements needs room for @a newCount.  Grows by half the
+/// current size at least so that appending is amortized constant time.
+inline U32 VectorGrowSize(U32 arraySize, U32 newCount)
+{
+   U32 size = arraySize + arraySize / 2;
+   if (size < newCount)
+      size = newCount;
+   return (size + VectorBlockSize - 1) / VectorBlockSize * VectorBlockSize;
+}
+
+/// Tells Vector whether its elements may be moved around in memory with
+/// realloc and memmove rather than by move constructing them into their new
+/// place and destructing the old ones.
+///
+/// Vector has always relocated its elements bytewise and lots of code relies
+/// on it, like structs owning raw pointers with only the implicit shallow
+/// copy constructor, which a move followed by a destruct would free out from
+/// under the new copy.  So this stays the default.  Specialize it to false
+/// for audited types that can't be moved bytewise, like ones pointing into
+/// themselves; they must be nothrow move constructible.
+template<class T>
+struct VectorRelocatable
+{
+   static const bool value = true;
+};
+
 /// Use the following macro to bind a vector to a particular line
 ///  of the owning class for memory tracking purposes
 #ifdef TORQUE_DEBUG_GUARD
@@ -80,11 +109,28 @@ class Vector
    void  destroy(U32 start, U32 end);   ///< Destructs elements from <i>start</i> to <i>end-1</i>
    void  construct(U32 start, U32 end); ///< Constructs elements from <i>start</i> to <i>end-1</i>
    void  construct(U32 start, U32 end, const T* array);
+
+   /// Reallocates the array to hold @a arraySize elements, keeping the
+   /// elements below the smaller of the element count and @a arraySize.
+   /// Elements beyond that must have been destructed by the caller.
+   /// Doesn't change the element count.
+   void  reallocate(U32 arraySize);
+
+   /// Makes room for @a count more elements, growing the array geometrically.
+   void  grow(U32 count);
+
+   /// Adds an element at @a index, leaving raw memory there to construct into.
+   void  openGap(U32 index);
+
+   /// Closes the gap of @a count destructed elements at @a index.
+   void  closeGap(U32 index, U32 count);
+
   public:
    Vector(const U32 initialSize = 0);
    Vector(const U32 initialSize, const char* fileName, const U32 lineNum);
    Vector(const char* fileName, const U32 lineNum);
    Vector(const Vector&);
+   Vector(Vector&&);
    ~Vector();
 
 #ifdef TORQUE_DEBUG_GUARD
@@ -106,6 +152,7 @@ class Vector
    typedef difference_type (QSORT_CALLBACK *compare_func)(const T *a, const T *b);
 
    Vector<T>& operator=(const Vector<T>& p);
+   Vector<T>& operator=(Vector<T>&& p);
 
    iterator       begin();
    const_iterator begin() const;
@@ -117,6 +164,7 @@ class Vector
    bool contains(const T&) const;
 
    void insert(iterator, const T&);
+   void insert(iterator, T&&);
    void erase(iterator);
 
    T&       front();
@@ -126,6 +174,13 @@ class Vector
 
    void push_front(const T&);
    void push_back(const T&);
+   void push_back(T&&);
+
+   /// Constructs an element in place at the end of the vector.
+   template<class... Args> T& emplace_back(Args&&... args);
+
+   /// Constructs an element in place before @a where.
+   template<class... Args> iterator emplace(iterator where, Args&&... args);
    U32 push_front_unique(const T&);
    U32 push_back_unique(const T&);
    S32 find_next( const T&, U32 start = 0 ) const;
@@ -276,11 +331,29 @@ template<class T> inline Vector<T>::Vector(const Vector& p)
    mLineAssociation = p.mLineAssociation;
 #endif
 
-   mArray = 0;
+   mArray        = 0;
+   mElementCount = 0;
+   mArraySize    = 0;
    resize(p.mElementCount);
    construct(0, p.mElementCount, p.mArray);
 }
 
+template<class T> inline Vector<T>::Vector(Vector&& p)
+{
+#ifdef TORQUE_DEBUG_GUARD
+   mFileAssociation = p.mFileAssociation;
+   mLineAssociation = p.mLineAssociation;
+#endif
+
+   mArray        = p.mArray;
+   mElementCount = p.mElementCount;
+   mArraySize    = p.mArraySize;
+
+   p.mArray        = 0;
+   p.mElementCount = 0;
+   p.mArraySize    = 0;
+}
+
 
 #ifdef TORQUE_DEBUG_GUARD
 template<class T> inline void Vector<T>::setFileAssociation(const char* file,
@@ -337,7 +410,7 @@ template<class T> inline U32 Vector<T>::setSize(U32 size)
    if(size > mElementCount)
    {
       if (size > mArraySize)
-         resize(size);
+         reallocate(size);
 
       // Set count first so we are in a valid state for construct.
       mElementCount = size;
@@ -354,10 +427,7 @@ template<class T> inline U32 Vector<T>::setSize(U32 size)
 
 template<class T> inline void Vector<T>::increment()
 {
-   if(mElementCount == mArraySize)
-      resize(mElementCount + 1);
-   else
-      mElementCount++;
+   grow(1);
    constructInPlace(&mArray[mElementCount - 1]);
 }
 
@@ -371,8 +441,7 @@ template<class T> inline void Vector<T>::decrement()
 template<class T> inline void Vector<T>::increment(U32 delta)
 {
    U32 count = mElementCount;
-   if ((mElementCount += delta) > mArraySize)
-      resize(mElementCount);
+   grow(delta);
    construct(count, mElementCount);
 }
 
@@ -400,22 +469,13 @@ template<class T> inline void Vector<T>::insert(U32 index)
 {
    AssertFatal(index <= mElementCount, "Vector<T>::insert - out of bounds index.");
 
-   if(mElementCount == mArraySize)
-      resize(mElementCount + 1);
-   else
-      mElementCount++;
-
-   dMemmove(&mArray[index + 1],
-                    &mArray[index],
-                    (mElementCount - index - 1) * sizeof(value_type));
-   
+   openGap(index);
    constructInPlace(&mArray[index]);
 }
 
 template<class T> inline void Vector<T>::insert(U32 index,const T& x)
 {
-   insert(index);
-   mArray[index] = x;
+   emplace(begin() + index, x);
 }
 
 template<class T> inline void Vector<T>::erase(U32 index)
@@ -423,15 +483,7 @@ template<class T> inline void Vector<T>::erase(U32 index)
    AssertFatal(index < mElementCount, "Vector<T>::erase - out of bounds index!");
 
    destructInPlace(&mArray[index]);
-
-   if (index < (mElementCount - 1))
-   {
-      dMemmove(&mArray[index],
-         &mArray[index + 1],
-         (mElementCount - index - 1) * sizeof(value_type));
-   }
-
-   mElementCount--;
+   closeGap(index, 1);
 }
 
 template<class T> inline bool Vector<T>::remove( const T& x )
@@ -458,12 +510,7 @@ template<class T> inline void Vector<T>::erase(U32 index, U32 count)
    AssertFatal(index+count <= mElementCount, "Vector<T>::erase - out of bounds count!");
 
    destroy( index, index+count );
-
-   dMemmove(   &mArray[index],
-               &mArray[index + count],
-               (mElementCount - index - count) * sizeof(value_type));
-
-   mElementCount -= count;
+   closeGap( index, count );
 }
 
 template<class T> inline void Vector<T>::erase_fast(U32 index)
@@ -475,7 +522,15 @@ template<class T> inline void Vector<T>::erase_fast(U32 index)
    //   size of the vector.
    destructInPlace(&mArray[index]);
    if (index < (mElementCount - 1))
-      dMemmove(&mArray[index], &mArray[mElementCount - 1], sizeof(value_type));
+   {
+      if constexpr (VectorRelocatable<T>::value)
+         dMemmove(&mArray[index], &mArray[mElementCount - 1], sizeof(value_type));
+      else
+      {
+         new (&mArray[index]) T(std::move(mArray[mElementCount - 1]));
+         destructInPlace(&mArray[mElementCount - 1]);
+      }
+   }
    mElementCount--;
 }
 
@@ -566,6 +621,24 @@ template<class T> inline Vector<T>& Vector<T>::operator=(const Vector<T>& p)
    return *this;
 }
 
+template<class T> inline Vector<T>& Vector<T>::operator=(Vector<T>&& p)
+{
+   if (this != &p)
+   {
+      clear();
+      dFree(mArray);
+
+      mArray        = p.mArray;
+      mElementCount = p.mElementCount;
+      mArraySize    = p.mArraySize;
+
+      p.mArray        = 0;
+      p.mElementCount = 0;
+      p.mArraySize    = 0;
+   }
+   return *this;
+}
+
 template<class T> inline typename Vector<T>::iterator Vector<T>::begin()
 {
    return mArray;
@@ -598,9 +671,12 @@ template<class T> inline bool Vector<T>::empty() const
 
 template<class T> inline void Vector<T>::insert(iterator p,const T& x)
 {
-   U32 index = (U32) (p - mArray);
-   insert(index);
-   mArray[index] = x;
+   emplace(p, x);
+}
+
+template<class T> inline void Vector<T>::insert(iterator p,T&& x)
+{
+   emplace(p, std::move(x));
 }
 
 template<class T> inline void Vector<T>::erase(iterator q)
@@ -637,14 +713,53 @@ template<class T> inline const T& Vector<T>::back() const
 
 template<class T> inline void Vector<T>::push_front(const T& x)
 {
-   insert(0);
-   mArray[0] = x;
+   emplace(begin(), x);
 }
 
 template<class T> inline void Vector<T>::push_back(const T& x)
 {
-   increment();
-   mArray[mElementCount - 1] = x;
+   emplace_back(x);
+}
+
+template<class T> inline void Vector<T>::push_back(T&& x)
+{
+   emplace_back(std::move(x));
+}
+
+template<class T> template<class... Args> inline T& Vector<T>::emplace_back(Args&&... args)
+{
+   if (mElementCount < mArraySize)
+   {
+      new (&mArray[mElementCount]) T(std::forward<Args>(args)...);
+      mElementCount++;
+   }
+   else
+   {
+      // The arguments may refer to our own elements, so build the new one
+      // before they move.
+      T element(std::forward<Args>(args)...);
+      grow(1);
+      new (&mArray[mElementCount - 1]) T(std::move(element));
+   }
+   return mArray[mElementCount - 1];
+}
+
+template<class T> template<class... Args> inline typename Vector<T>::iterator Vector<T>::emplace(iterator where, Args&&... args)
+{
+   const U32 index = U32(where - mArray);
+   AssertFatal(index <= mElementCount, "Vector<T>::emplace - out of bounds index.");
+
+   if (index == mElementCount)
+   {
+      emplace_back(std::forward<Args>(args)...);
+      return mArray + index;
+   }
+
+   // Same as in emplace_back(), and shifting the elements moves them too.
+   T element(std::forward<Args>(args)...);
+   openGap(index);
+   new (&mArray[index]) T(std::move(element));
+   return mArray + index;
 }
 
 template<class T> inline U32 Vector<T>::push_front_unique(const T& x)
@@ -750,12 +865,109 @@ template<class T> inline void Vector<T>::set(void * addr, U32 sz)
 
 template<class T> inline bool Vector<T>::resize(U32 ecount)
 {
+   // Anything past the new count has already been destructed.
+   if (ecount < mElementCount)
+      mElementCount = ecount;
+
+   reallocate((ecount + VectorBlockSize - 1) / VectorBlockSize * VectorBlockSize);
+   mElementCount = ecount;
+   return true;
+}
+
+template<class T> inline void Vector<T>::reallocate(U32 arraySize)
+{
+   if constexpr (VectorRelocatable<T>::value)
+   {
+      U32 count = mElementCount;
 #ifdef TORQUE_DEBUG_GUARD
-   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T),
-                       mFileAssociation, mLineAssociation);
+      VectorResize(&mArraySize, &count, (void**) &mArray, arraySize, sizeof(T),
+                   mFileAssociation, mLineAssociation);
 #else
-   return VectorResize(&mArraySize, &mElementCount, (void**) &mArray, ecount, sizeof(T));
+      VectorResize(&mArraySize, &count, (void**) &mArray, arraySize, sizeof(T));
 #endif
+   }
+   else
+   {
+      static_assert(std::is_nothrow_move_constructible<T>::value,
+                    "Vector<T> - Types that aren't VectorRelocatable must be nothrow move constructible.");
+
+      if (arraySize == mArraySize)
+         return;
+
+      // Elements that need to know where they live get move constructed
+      // into a new block rather than realloc'd.
+      T* newArray = NULL;
+      if (arraySize)
+      {
+#ifdef TORQUE_DEBUG_GUARD
+         newArray = (T*) dMalloc_r(arraySize * sizeof(T),
+                                   mFileAssociation ? mFileAssociation : __FILE__,
+                                   mFileAssociation ? mLineAssociation : __LINE__);
+#else
+         newArray = (T*) dMalloc(arraySize * sizeof(T));
+#endif
+         AssertFatal(newArray, "Vector<T>::reallocate - Allocation failed.");
+      }
+
+      const U32 count = getMin(mElementCount, arraySize);
+      for (U32 i = 0; i < count; i++)
+      {
+         new (&newArray[i]) T(std::move(mArray[i]));
+         destructInPlace(&mArray[i]);
+      }
+
+      dFree(mArray);
+      mArray     = newArray;
+      mArraySize = arraySize;
+   }
+}
+
+template<class T> inline void Vector<T>::grow(U32 count)
+{
+   const U32 newCount = mElementCount + count;
+   if (newCount > mArraySize)
+      reallocate(VectorGrowSize(mArraySize, newCount));
+   mElementCount = newCount;
+}
+
+template<class T> inline void Vector<T>::openGap(U32 index)
+{
+   grow(1);
+
+   const U32 last = mElementCount - 1;
+   if (index == last)
+      return;
+
+   if constexpr (VectorRelocatable<T>::value)
+      dMemmove(&mArray[index + 1], &mArray[index], (last - index) * sizeof(value_type));
+   else
+   {
+      new (&mArray[last]) T(std::move(mArray[last - 1]));
+      for (U32 i = last - 1; i > index; i--)
+         mArray[i] = std::move(mArray[i - 1]);
+      destructInPlace(&mArray[index]);
+   }
+}
+
+template<class T> inline void Vector<T>::closeGap(U32 index, U32 count)
+{
+   const U32 tail = mElementCount - index - count;
+
+   if constexpr (VectorRelocatable<T>::value)
+   {
+      if (tail)
+         dMemmove(&mArray[index], &mArray[index + count], tail * sizeof(value_type));
+   }
+   else
+   {
+      for (U32 i = index; i < index + tail; i++)
+      {
+         new (&mArray[i]) T(std::move(mArray[i + count]));
+         destructInPlace(&mArray[i + count]);
+      }
+   }
+
+   mElementCount -= count;
 }
 
 template<class T> inline void Vector<T>::merge( const Vector &p )
@@ -766,7 +978,7 @@ template<class T> inline void Vector<T>::merge( const Vector &p )
    const U32 oldSize = mElementCount;
    const U32 newSize = oldSize + p.size();
    if ( newSize > mArraySize )
-      resize( newSize );
+      reallocate( VectorGrowSize( mArraySize, newSize ) );
 
    T *dest = mArray + oldSize;
    const T *src = p.mArray;
@@ -781,7 +993,7 @@ template<class T> inline void Vector<T>::merge( const T *addr, U32 count )
    const U32 oldSize = mElementCount;
    const U32 newSize = oldSize + count;
    if ( newSize > mArraySize )
-      resize( newSize );
+      reallocate( VectorGrowSize( mArraySize, newSize ) );
 
    T *dest = mArray + oldSize;
    while ( dest < mArray + newSize )
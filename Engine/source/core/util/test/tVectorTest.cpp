@@ -23,6 +23,8 @@
 #ifdef TORQUE_TESTS_ENABLED
 #include "testing/unitTesting.h"
 #include "core/util/tVector.h"
+#include "core/util/str.h"
+#include "core/strings/stringFunctions.h"
 
 // Define some test data used below.
 FIXTURE(Vector)
@@ -39,6 +41,68 @@ public:
       }
    };
 
+   /// Counts how it gets copied and moved around.
+   struct Counted
+   {
+      static U32 smCopies;
+      static U32 smMoves;
+      static S32 smAlive;
+
+      S32 value;
+
+      Counted(S32 v = 0) : value(v) { smAlive++; }
+      Counted(const Counted& c) : value(c.value) { smCopies++; smAlive++; }
+      Counted(Counted&& c) noexcept : value(c.value) { c.value = -1; smMoves++; smAlive++; }
+      ~Counted() { smAlive--; }
+      Counted& operator=(const Counted& c) { value = c.value; smCopies++; return *this; }
+      Counted& operator=(Counted&& c) { value = c.value; c.value = -1; smMoves++; return *this; }
+
+      static void reset() { smCopies = smMoves = 0; smAlive = 0; }
+   };
+
+   /// Can be moved but not copied.
+   struct MoveOnly
+   {
+      S32* ptr;
+
+      MoveOnly(S32 v) : ptr(new S32(v)) {}
+      MoveOnly(MoveOnly&& m) : ptr(m.ptr) { m.ptr = NULL; }
+      MoveOnly& operator=(MoveOnly&& m) { delete ptr; ptr = m.ptr; m.ptr = NULL; return *this; }
+      MoveOnly(const MoveOnly&) = delete;
+      MoveOnly& operator=(const MoveOnly&) = delete;
+      ~MoveOnly() { delete ptr; }
+   };
+
+   /// Points into itself, so it breaks if moved around bytewise.
+   struct SelfRef
+   {
+      S32 value;
+      S32* self;
+
+      SelfRef(S32 v = 0) : value(v), self(&value) {}
+      SelfRef(const SelfRef& s) noexcept : value(s.value), self(&value) {}
+      SelfRef& operator=(const SelfRef& s) { value = s.value; return *this; }
+
+      bool isValid() const { return self == &value; }
+   };
+
+   /// Owns a string but only has the implicit shallow copy constructor,
+   /// like lots of older engine structs.  Vector must move it bytewise.
+   struct OwnsString
+   {
+      char* str;
+
+      OwnsString() : str(NULL) {}
+      ~OwnsString() { dFree(str); }
+
+      void set(S32 v)
+      {
+         dFree(str);
+         str = (char*) dMalloc(16);
+         dSprintf(str, 16, "%d", v);
+      }
+   };
+
    static const S32 ints[];
    static const U32 length;
    static S32 QSORT_CALLBACK sortInts(const S32* a, const S32* b)
@@ -57,6 +121,12 @@ public:
 
 const S32 VectorFixture::ints[] = {0, 10, 2, 3, 14, 4, 12, 6, 16, 7, 8, 1, 11, 5, 13, 9, 15};
 const U32 VectorFixture::length = sizeof(VectorFixture::ints) / sizeof(S32);
+template<> struct VectorRelocatable<VectorFixture::Counted> { static const bool value = false; };
+template<> struct VectorRelocatable<VectorFixture::SelfRef> { static const bool value = false; };
+
+U32 VectorFixture::Counted::smCopies = 0;
+U32 VectorFixture::Counted::smMoves = 0;
+S32 VectorFixture::Counted::smAlive = 0;
 
 TEST_FIX(Vector, Allocation)
 {
@@ -122,4 +192,139 @@ TEST_FIX(Vector, Sorting)
          << "Element " << i << " was not in sorted order";
 }
 
-#endif
\ No newline at end of file
+TEST_FIX(Vector, Relocatable)
+{
+   EXPECT_TRUE(VectorRelocatable<S32>::value);
+   EXPECT_TRUE(VectorRelocatable<String>::value);
+   EXPECT_TRUE(VectorRelocatable< Vector<String> >::value);
+   EXPECT_TRUE(VectorRelocatable<OwnsString>::value);
+   EXPECT_FALSE(VectorRelocatable<Counted>::value);
+   EXPECT_FALSE(VectorRelocatable<SelfRef>::value);
+}
+
+TEST_FIX(Vector, Growth)
+{
+   // Appending should reallocate a logarithmic number of times.
+   Vector<S32> v;
+   U32 reallocs = 0;
+   U32 capacity = v.capacity();
+   for (S32 i = 0; i < 100000; i++)
+   {
+      v.push_back(i);
+      if (v.capacity() != capacity)
+      {
+         capacity = v.capacity();
+         reallocs++;
+      }
+   }
+
+   EXPECT_LT(reallocs, 30) << "Vector isn't growing geometrically";
+   for (S32 i = 0; i < 100000; i++)
+      EXPECT_EQ(v[i], i);
+}
+
+TEST_FIX(Vector, MoveNotCopy)
+{
+   Counted::reset();
+   {
+      Vector<Counted> v;
+      for (S32 i = 0; i < 1000; i++)
+         v.push_back(Counted(i));
+
+      v.insert(v.begin() + 10, Counted(-2));
+      v.erase(U32(5));
+      v.erase_fast(U32(20));
+
+      EXPECT_EQ(Counted::smCopies, 0) << "Growing and shifting elements shouldn't copy them";
+      EXPECT_EQ(Counted::smAlive, 999);
+      EXPECT_EQ(v[9].value, -2);
+      EXPECT_EQ(v[20].value, 999);
+
+      Vector<Counted> moved(std::move(v));
+      EXPECT_EQ(v.size(), 0);
+      EXPECT_EQ(moved.size(), 999);
+      EXPECT_EQ(Counted::smCopies, 0);
+
+      Vector<Counted> copied(moved);
+      EXPECT_EQ(Counted::smCopies, 999);
+      EXPECT_EQ(Counted::smAlive, 1998);
+   }
+   EXPECT_EQ(Counted::smAlive, 0) << "Not all elements were destructed";
+}
+
+TEST_FIX(Vector, MoveOnly)
+{
+   Vector<MoveOnly> v;
+   for (S32 i = 0; i < 100; i++)
+      v.push_back(MoveOnly(i));
+   v.emplace(v.begin(), -1);
+   v.erase(U32(50));
+
+   EXPECT_EQ(v.size(), 100);
+   EXPECT_EQ(*v[0].ptr, -1);
+   EXPECT_EQ(*v[49].ptr, 48);
+   EXPECT_EQ(*v[50].ptr, 50);
+   EXPECT_EQ(*v.last().ptr, 99);
+}
+
+TEST_FIX(Vector, SelfReferencing)
+{
+   Vector<SelfRef> v;
+   for (S32 i = 0; i < 100; i++)
+      v.push_back(SelfRef(i));
+   v.insert(v.begin(), SelfRef(-1));
+   v.erase(U32(10));
+   v.erase_fast(U32(0));
+   v.compact();
+
+   for (U32 i = 0; i < v.size(); i++)
+      EXPECT_TRUE(v[i].isValid()) << "Element " << i << " was moved bytewise";
+}
+
+TEST_FIX(Vector, Emplace)
+{
+   Vector<String> v;
+   v.emplace_back("first");
+   v.emplace_back("xxxyyy", 3);
+   v.emplace(v.begin() + 1, "second");
+
+   // Appending one of our own elements while growing must not read it
+   // after it has moved.
+   while (v.size() < v.capacity())
+      v.push_back(v[0]);
+   v.push_back(v[0]);
+   v.emplace_back(v[1]);
+
+   EXPECT_STREQ(v[0].c_str(), "first");
+   EXPECT_STREQ(v[1].c_str(), "second");
+   EXPECT_STREQ(v[2].c_str(), "xxx");
+   EXPECT_STREQ(v[v.size() - 2].c_str(), "first");
+   EXPECT_STREQ(v.last().c_str(), "second");
+}
+
+TEST_FIX(Vector, OwningPointers)
+{
+   // The strings are set once the elements are in the vector, as the server
+   // list does, so only growing and shifting the vector moves them around.
+   Vector<OwnsString> v;
+   for (S32 i = 0; i < 100; i++)
+   {
+      v.increment();
+      v.last().set(i);
+   }
+
+   v.erase(U32(10));
+   v.erase_fast(U32(0));
+   v.increment();
+   v.last().set(-1);
+   v.compact();
+
+   EXPECT_EQ(v.size(), 99);
+   EXPECT_STREQ(v[0].str, "99");
+   EXPECT_STREQ(v[9].str, "9");
+   EXPECT_STREQ(v[10].str, "11");
+   EXPECT_STREQ(v[97].str, "98");
+   EXPECT_STREQ(v.last().str, "-1");
+}
+
+#endif
@@ -728,7 +728,7 @@ void ZipArchive::closeFile(Stream *stream)
 
 //-----------------------------------------------------------------------------
 
-Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
+Stream *ZipArchive::openFileForRead(const CentralDir *fileCD, Stream *zipStream)
 {
    if(mMode != Read && mMode != ReadWrite)
       return NULL;
@@ -736,7 +736,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    if((fileCD->mInternalFlags & (CDFileDeleted | CDFileOpen)) != 0)
       return NULL;
 
-   Stream *stream = mStream;
+   Stream *stream = zipStream;
 
    if(fileCD->mInternalFlags & CDFileDirty)
    {
@@ -758,7 +758,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
          }
       }
 
-      if(stream == mStream)
+      if(stream == zipStream)
       {
          if(isVerbose())
             Con::errorf("ZipArchive::openFile - %s: %s is dirty, but no temporary file found?", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
@@ -768,7 +768,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
    else
    {
       // Read from the zip file directly
-      if(! mStream->setPosition(fileCD->mLocalHeadOffset))
+      if(! zipStream->setPosition(fileCD->mLocalHeadOffset))
       {
          if(isVerbose())
             Con::errorf("ZipArchive::openFile - %s: Could not locate local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
@@ -776,7 +776,7 @@ Stream *ZipArchive::openFileForRead(const CentralDir *fileCD)
       }
 
       FileHeader fh;
-      if(! fh.read(mStream))
+      if(! fh.read(zipStream))
       {
          if(isVerbose())
             Con::errorf("ZipArchive::openFile - %s: Could not read local header for file %s", mFilename ? mFilename : "<no filename>", fileCD->mFilename.c_str());
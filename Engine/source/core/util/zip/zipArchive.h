@@ -493,7 +493,26 @@ public:
    /// @return Pointer to stream or NULL for failure
    /// @see ZipArchive::openFile(const char *, AccessMode), ZipArchive::closeFile()
    //-----------------------------------------------------------------------------
-   Stream *openFileForRead(const CentralDir *fileCD);
+   Stream *openFileForRead(const CentralDir *fileCD) { return openFileForRead(fileCD, mStream); }
+
+   //-----------------------------------------------------------------------------
+   /// @brief Open a file within the zip file for read from a given stream
+   ///
+   /// The stream must contain the same bytes as the archive's own stream,
+   /// for example a separate stream over a memory mapped copy of the zip.
+   /// Since the file is then read without touching the position of the
+   /// archive's stream, any number of files can be read this way
+   /// concurrently, each through its own stream.
+   ///
+   /// The returned stream is closed with closeFile() as usual, which does
+   /// not free zipStream.
+   ///
+   /// @param fileCD Pointer to central directory of the file to open
+   /// @param zipStream Stream to read the file data from
+   /// @return Pointer to stream or NULL for failure
+   /// @see ZipArchive::openFileForRead(const CentralDir *)
+   //-----------------------------------------------------------------------------
+   Stream *openFileForRead(const CentralDir *fileCD, Stream *zipStream);
    // @}
 
    /// @name Archiver Style File Access Methods
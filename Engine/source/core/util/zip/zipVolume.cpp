@@ -25,7 +25,10 @@
 
 #include "core/util/zip/zipSubStream.h"
 #include "core/util/noncopyable.h"
+#include "core/stream/memStream.h"
 #include "console/console.h"
+#include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
 
 namespace Torque
 {
@@ -40,9 +43,16 @@ class ZipFileNode : public Torque::FS::File, public Noncopyable
    // ZipFileNode class (Internal)
    //--------------------------------------------------------------------------
 public:
-   ZipFileNode(StrongRefPtr<ZipArchive>& archive, String zipFilename, Stream* zipStream, ZipArchive::ZipEntry* ze) 
+   /// @param sourceStream If not NULL, the stream zipStream reads the archive
+   ///   through.  It belongs to this node and is deleted when the node is closed.
+   /// @param mappedFile The mapped archive sourceStream reads from, which must
+   ///   stay mapped for as long as this node is open.
+   ZipFileNode(StrongRefPtr<ZipArchive>& archive, String zipFilename, Stream* zipStream, ZipArchive::ZipEntry* ze,
+               Stream* sourceStream = NULL, const Platform::FS::MappedFileRef& mappedFile = NULL) 
    {
       mZipStream = zipStream;
+      mSourceStream = sourceStream;
+      mMappedFile = mappedFile;
       mArchive = archive;
       mZipFilename = zipFilename;
       mByteCount = dynamic_cast<IStreamByteCount*>(mZipStream);
@@ -128,6 +138,8 @@ public:
          mZipStream = NULL;
          mByteCount = NULL;
       }
+      SAFE_DELETE(mSourceStream);
+      mMappedFile = NULL;
       return true;
    }
 
@@ -155,6 +167,8 @@ public:
       };
 
       Stream* mZipStream;
+      Stream* mSourceStream;
+      Platform::FS::MappedFileRef mMappedFile;
       StrongRefPtr<ZipArchive> mArchive;
       ZipArchive::ZipEntry* mZipEntry;
       String mZipFilename;
@@ -370,8 +384,17 @@ ZipFileSystem::ZipFileSystem(String& zipFilename, bool zipNameIsDir /* = false *
    // open the file now but don't read it yet, since we want construction to be lightweight
    // we open the file now so that whatever filesystems are mounted right now (which may be temporary)
    // can be umounted without affecting this file system.
-   mZipArchiveStream = new FileStream();
-   mZipArchiveStream->open(mZipFilename, Torque::FS::File::Read);
+   //
+   // If the zip is on disk we map it into memory instead.  Mapping costs no more than opening
+   // the file and lets every file in the zip be read without seeking a shared stream.
+   mMappedStream = NULL;
+   mZipArchiveStream = NULL;
+   mMappedFile = Platform::FS::MapFile(mZipFilename);
+   if (mMappedFile.isNull())
+   {
+      mZipArchiveStream = new FileStream();
+      mZipArchiveStream->open(mZipFilename, Torque::FS::File::Read);
+   }
    
    // As far as the mount system is concerned, ZFSes are read only write now (even though 
    // ZipArchive technically support read-write, we don't expose this to the mount system because we 
@@ -387,6 +410,8 @@ ZipFileSystem::~ZipFileSystem()
       delete mZipArchiveStream;
    }
    mZipArchive = NULL;
+   SAFE_DELETE(mMappedStream);
+   mMappedFile = NULL;
 }
 
 FileNodeRef ZipFileSystem::resolve(const Path& path)
@@ -442,7 +467,7 @@ FileNodeRef ZipFileSystem::resolve(const Path& path)
       return zdn;
    }
 
-   ZipArchive::ZipEntry* ze = mZipArchive->findZipEntry(name);
+   ZipArchive::ZipEntry* ze = _findEntry(name);
    if (ze == NULL)
       return NULL;
 
@@ -452,13 +477,7 @@ FileNodeRef ZipFileSystem::resolve(const Path& path)
       return zdn;
    }
 
-   // pass in the zip entry so that openFile() doesn't need to look it up again.
-   Stream* stream = mZipArchive->openFile(name, ze, ZipArchive::Read);
-   if (stream == NULL)
-      return NULL;
-
-   ZipFileNode* zfn = new ZipFileNode(mZipArchive, name, stream, ze);
-   return zfn;
+   return _openFile(name, ze);
 }
 
 FileNodeRef ZipFileSystem::resolveLoose(const Path& path)
@@ -522,7 +541,7 @@ FileNodeRef ZipFileSystem::resolveLoose(const Path& path)
       return zdn;
    }
 
-   ZipArchive::ZipEntry* ze = mZipArchive->findZipEntry(name);
+   ZipArchive::ZipEntry* ze = _findEntry(name);
    if (ze == NULL)
       return NULL;
 
@@ -532,13 +551,7 @@ FileNodeRef ZipFileSystem::resolveLoose(const Path& path)
       return zdn;
    }
 
-   // pass in the zip entry so that openFile() doesn't need to look it up again.
-   Stream* stream = mZipArchive->openFile(name, ze, ZipArchive::Read);
-   if (stream == NULL)
-      return NULL;
-
-   ZipFileNode* zfn = new ZipFileNode(mZipArchive, name, stream, ze);
-   return zfn;
+   return _openFile(name, ze);
 }
 
 void ZipFileSystem::_init()
@@ -549,23 +562,223 @@ void ZipFileSystem::_init()
 
    if (!mZipArchive.isNull())
       return;
-   if (mZipArchiveStream->getStatus() != Stream::Ok)
-      return;
 
-   mZipArchive = new ZipArchive();
-   if (!mZipArchive->openArchive(mZipArchiveStream, ZipArchive::Read))
+   if (!mMappedFile.isNull())
    {
-      Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
-      return;
+      mZipArchive = new ZipArchive();
+      mMappedStream = new MemStream(mMappedFile->getSize(), (void*)mMappedFile->getData(), true, false);
+      if (!mZipArchive->openArchive(mMappedStream, ZipArchive::Read))
+      {
+         Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
+         return;
+      }
    }
+   else
+   {
+      if (mZipArchiveStream->getStatus() != Stream::Ok)
+         return;
 
-   // tell the archive that it owns the zipStream now
-   mZipArchive->setDiskStream(mZipArchiveStream);
-   // and null it out because we don't own it anymore
-   mZipArchiveStream = NULL;
+      mZipArchive = new ZipArchive();
+      if (!mZipArchive->openArchive(mZipArchiveStream, ZipArchive::Read))
+      {
+         Con::errorf("ZipFileSystem: failed to open zip archive %s", mZipFilename.c_str());
+         return;
+      }
+
+      // tell the archive that it owns the zipStream now
+      mZipArchive->setDiskStream(mZipArchiveStream);
+      // and null it out because we don't own it anymore
+      mZipArchiveStream = NULL;
+   }
+
+   _indexEntries(mZipArchive->getRoot(), String());
 
    // for debugging
    //mZipArchive->dumpCentralDirectory();
 }
 
+void ZipFileSystem::_indexEntries(ZipArchive::ZipEntry* entry, const String& path)
+{
+   for (Map<String,ZipArchive::ZipEntry*>::Iterator iter = entry->mChildren.begin();
+      iter != entry->mChildren.end();
+      ++iter)
+   {
+      ZipArchive::ZipEntry* child = (*iter).value;
+      String childPath = path.isEmpty() ? child->mName : path + "/" + child->mName;
+
+      mEntryIndex.insertUnique(childPath, child);
+      if (child->mIsDirectory)
+         _indexEntries(child, childPath);
+   }
+}
+
+ZipArchive::ZipEntry* ZipFileSystem::_findEntry(const String& name)
+{
+   ZipArchive::ZipEntry* ze = NULL;
+   if (!mEntryIndex.find(name, ze))
+      return NULL;
+   return ze;
+}
+
+FileNodeRef ZipFileSystem::_openFile(const String& name, ZipArchive::ZipEntry* ze)
+{
+   if (mMappedFile.isNull())
+   {
+      // pass in the zip entry so that openFile() doesn't need to look it up again.
+      Stream* stream = mZipArchive->openFile(name, ze, ZipArchive::Read);
+      if (stream == NULL)
+         return NULL;
+
+      ZipFileNode* zfn = new ZipFileNode(mZipArchive, name, stream, ze);
+      return zfn;
+   }
+
+   // Each file gets its own stream over the mapped archive, so no two files share
+   // a read position and they can be read and inflated on different threads at
+   // the same time.  Stored files are copied straight out of the mapping.
+   MemStream* source = new MemStream(mMappedFile->getSize(), (void*)mMappedFile->getData(), true, false);
+   Stream* stream = mZipArchive->openFileForRead(&ze->mCD, source);
+   if (stream == NULL)
+   {
+      delete source;
+      return NULL;
+   }
+
+   ZipFileNode* zfn = new ZipFileNode(mZipArchive, name, stream, ze, source, mMappedFile);
+   return zfn;
+}
+
 };
+
+//-----------------------------------------------------------------------------
+// Benchmark
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   /// Reads a file node from start to end the way ReadFile() does.
+   U32 _readWholeFile(Torque::FS::FileNode* node)
+   {
+      Torque::FS::File* file = dynamic_cast<Torque::FS::File*>(node);
+      if (!file || !file->open(Torque::FS::File::Read))
+         return 0;
+
+      const U32 size = (U32)file->getSize();
+      U8* buffer = new U8[size + 1];
+      const U32 bytesRead = file->read(buffer, size);
+      file->close();
+      delete [] buffer;
+
+      return bytesRead;
+   }
+
+   struct ZipBenchWorkItem : public ThreadPool::WorkItem
+   {
+      Torque::FS::FileNode* mNode;
+
+      ZipBenchWorkItem(Torque::FS::FileNode* node)
+         : mNode(node) {}
+
+   protected:
+      void execute() override
+      {
+         _readWholeFile(mNode);
+      }
+   };
+
+   /// Reads all nodes, either one after the other or spread over the thread pool.
+   /// The nodes are resolved up front since the volume system itself isn't thread safe.
+   void _readAllFiles(Vector<Torque::FS::FileNodeRef>& nodes, bool threaded)
+   {
+      if (!threaded)
+      {
+         for (U32 i = 0; i < nodes.size(); i++)
+            _readWholeFile(nodes[i]);
+         return;
+      }
+
+      for (U32 i = 0; i < nodes.size(); i++)
+      {
+         ThreadSafeRef<ZipBenchWorkItem> item(new ZipBenchWorkItem(nodes[i]));
+         ThreadPool::GLOBAL().queueWorkItem(item);
+      }
+      ThreadPool::GLOBAL().waitForAllItems();
+   }
+}
+
+DefineEngineFunction(benchmarkZipLoading, void, (const char* zipFile, const char* loosePath, S32 iterations), (10),
+   "@brief Read every file in a zip and the same files from a loose directory and print how long each takes.\n\n"
+   "The files are read one after the other and then spread over the thread pool.  The zip is read "
+   "through its own ZipFileSystem so it doesn't need to be mounted, and the loose files are resolved "
+   "through the regular volume system.\n"
+   "@param zipFile Path of the zip, for example a packed level.\n"
+   "@param loosePath Directory holding the unpacked contents of the zip.\n"
+   "@param iterations Number of times all files are read.\n"
+   "@ingroup FileSystem\n"
+   "@internal")
+{
+   iterations = getMax(iterations, 1);
+
+   String zipName(zipFile);
+   Torque::ZipFileSystem zipFS(zipName);
+
+   // Resolving the root makes the file system read the central directory.
+   if (zipFS.resolve(Torque::Path("/")) == NULL || zipFS.getArchive().isNull())
+   {
+      Con::errorf("benchmarkZipLoading - Could not open %s", zipFile);
+      return;
+   }
+
+   Vector<String> files;
+   U64 totalBytes = 0;
+   StrongRefPtr<Zip::ZipArchive> archive = zipFS.getArchive();
+   for (U32 i = 0; i < archive->numEntries(); i++)
+   {
+      const Zip::CentralDir& cd = (*archive)[i];
+      if (cd.mFilename.isEmpty() || cd.mFilename[cd.mFilename.length() - 1] == '/')
+         continue;
+
+      files.push_back(cd.mFilename);
+      totalBytes += cd.mUncompressedSize;
+   }
+
+   Con::printf("benchmarkZipLoading: %d files, %.1f MB, %s, %d iterations", files.size(), F64(totalBytes) / (1024.0 * 1024.0),
+      zipFS.isMapped() ? "memory mapped" : "not memory mapped", iterations);
+
+   for (U32 pass = 0; pass < 4; pass++)
+   {
+      const bool packed = (pass & 1) == 0;
+      const bool threaded = pass >= 2;
+
+      U32 totalMs = 0;
+
+      // Run once more than asked and ignore the first run which only warms the OS file cache.
+      for (S32 iter = 0; iter <= iterations; iter++)
+      {
+         const U32 start = Platform::getRealMilliseconds();
+
+         Vector<Torque::FS::FileNodeRef> nodes;
+         nodes.reserve(files.size());
+         for (U32 i = 0; i < files.size(); i++)
+         {
+            Torque::FS::FileNodeRef node;
+            if (packed)
+               node = zipFS.resolve(Torque::Path(files[i]));
+            else
+               node = Torque::FS::GetFileNode(Torque::Path::Join(loosePath, '/', files[i]));
+
+            if (node != NULL)
+               nodes.push_back(node);
+         }
+
+         _readAllFiles(nodes, threaded);
+         nodes.clear();
+
+         if (iter > 0)
+            totalMs += Platform::getRealMilliseconds() - start;
+      }
+
+      Con::printf("   %-6s %-8s %8.2fms per iteration", packed ? "zip" : "loose", threaded ? "threaded" : "serial",
+         F32(totalMs) / F32(iterations));
+   }
+}
@@ -26,6 +26,10 @@
 #include "core/util/str.h"
 #include "core/util/zip/zipArchive.h"
 #include "core/util/autoPtr.h"
+#include "core/util/tDictionary.h"
+#include "platform/platformVolume.h"
+
+class MemStream;
 
 namespace Torque
 {
@@ -62,8 +66,15 @@ public:
    /// Private interface for use by unit test only. 
    StrongRefPtr<ZipArchive> getArchive() { return mZipArchive; }
 
+   /// Returns true if the archive is memory mapped rather than read
+   /// through a file stream.
+   bool isMapped() const { return !mMappedFile.isNull(); }
+
 private:
    void _init();
+   void _indexEntries(ZipArchive::ZipEntry* entry, const String& path);
+   ZipArchive::ZipEntry* _findEntry(const String& name);
+   FileNodeRef _openFile(const String& name, ZipArchive::ZipEntry* ze);
 
    bool mInitted;
    bool mZipNameIsDir;
@@ -71,6 +82,18 @@ private:
    String mFakeRoot;
    FileStream* mZipArchiveStream;
    StrongRefPtr<ZipArchive> mZipArchive;
+
+   /// The whole archive mapped into memory.  If the zip can't be mapped
+   /// this is NULL and everything is read through mZipArchiveStream.
+   Platform::FS::MappedFileRef mMappedFile;
+
+   /// Stream over mMappedFile the central directory is read from.  Files
+   /// each get a stream of their own so they can be read concurrently.
+   MemStream* mMappedStream;
+
+   /// Every entry in the archive by its full path, so lookups don't have
+   /// to walk the directory tree one path component at a time.
+   HashTable<String, ZipArchive::ZipEntry*> mEntryIndex;
 };
 
 }
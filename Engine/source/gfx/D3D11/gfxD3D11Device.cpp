@@ -697,6 +697,8 @@ void GFXD3D11Device::setupGenericShaders(GenericShaderType type)
 {
    AssertFatal(type != GSTargetRestore, ""); //not used
 
+   flushDrawList();
+
    if(mGenericShader[GSColor] == NULL)
    {
       ShaderData *shaderData;
@@ -816,6 +818,8 @@ void GFXD3D11Device::copyResource(GFXTextureObject *pDst, GFXCubemap *pSrc, cons
 
 void GFXD3D11Device::clear(U32 flags, const LinearColorF& color, F32 z, U32 stencil)
 {
+   flushDrawList();
+
    // Make sure we have flushed our render target state.
    _updateRenderTargets();
 
@@ -854,6 +858,8 @@ void GFXD3D11Device::clear(U32 flags, const LinearColorF& color, F32 z, U32 sten
 
 void GFXD3D11Device::clearColorAttachment(const U32 attachment, const LinearColorF& color)
 {
+   flushDrawList();
+
    GFXD3D11TextureTarget *pTarget = static_cast<GFXD3D11TextureTarget*>(mCurrentRT.getPointer());
    ID3D11RenderTargetView* rtView = NULL;
 
@@ -1239,6 +1245,8 @@ GFXShader* GFXD3D11Device::createShader()
 //-----------------------------------------------------------------------------
 void GFXD3D11Device::setShader(GFXShader *shader, bool force)
 {
+   flushDrawList();
+
    if(shader)
    {
       GFXD3D11Shader *d3dShader = static_cast<GFXD3D11Shader*>(shader);
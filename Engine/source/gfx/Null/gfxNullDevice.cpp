@@ -314,6 +314,31 @@ GFXNullDevice::~GFXNullDevice()
 {
 }
 
+void GFXNullDevice::setClipRect( const RectI &inRect )
+{
+   // Nothing gets drawn, but set up the matrices and viewport the same
+   // way the other devices do so code that looks at them sees the same.
+   clip = inRect;
+   if ( mCurrentRT.isValid() )
+      clip.intersect( RectI( Point2I::Zero, mCurrentRT->getSize() ) );
+
+   const F32 l = F32( clip.point.x );
+   const F32 r = F32( clip.point.x + clip.extent.x );
+   const F32 b = F32( clip.point.y + clip.extent.y );
+   const F32 t = F32( clip.point.y );
+
+   MatrixF proj( true );
+   proj.setColumn( 0, Point4F( 2.0f / ( r - l ), 0.0f, 0.0f, 0.0f ) );
+   proj.setColumn( 1, Point4F( 0.0f, 2.0f / ( t - b ), 0.0f, 0.0f ) );
+   proj.setColumn( 2, Point4F( 0.0f, 0.0f, 1.0f, 0.0f ) );
+   proj.setColumn( 3, Point4F( ( l + r ) / ( l - r ), ( t + b ) / ( b - t ), 1.0f, 1.0f ) );
+   setProjectionMatrix( proj );
+
+   setViewMatrix( MatrixF::Identity );
+   setWorldMatrix( MatrixF::Identity );
+   setViewport( clip );
+}
+
 GFXVertexBuffer *GFXNullDevice::allocVertexBuffer( U32 numVerts, 
                                                    const GFXVertexFormat *vertexFormat,
                                                    U32 vertSize, 
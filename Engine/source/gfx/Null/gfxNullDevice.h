@@ -152,15 +152,23 @@ public:
    bool beginSceneInternal() override { return true; };
    void endSceneInternal() override { };
 
-   void drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount ) override { };
+   void drawPrimitive( GFXPrimitiveType primType, U32 vertexStart, U32 primitiveCount ) override
+   {
+      mDeviceStatistics.mDrawCalls++;
+      mDeviceStatistics.mPolyCount += primitiveCount;
+   };
    void drawIndexedPrimitive(  GFXPrimitiveType primType, 
                                        U32 startVertex, 
                                        U32 minIndex, 
                                        U32 numVerts, 
                                        U32 startIndex, 
-                                       U32 primitiveCount ) override { };
+                                       U32 primitiveCount ) override
+   {
+      mDeviceStatistics.mDrawCalls++;
+      mDeviceStatistics.mPolyCount += primitiveCount;
+   };
 
-   void setClipRect( const RectI &rect ) override { };
+   void setClipRect( const RectI &rect ) override;
    const RectI &getClipRect() const override { return clip; };
 
    void preDestroy() override { Parent::preDestroy(); };
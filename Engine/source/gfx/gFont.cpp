@@ -33,6 +33,8 @@
 #include "console/console.h"
 #include "console/engineAPI.h"
 #include "platform/threads/mutex.h"
+#include "platform/threads/threadPool.h"
+#include "platform/profiler.h"
 #include "zlib/zlib.h"
 
 
@@ -74,7 +76,118 @@ static S32 QSORT_CALLBACK GlyphMapCompare(const void *a, const void *b)
 }
 
 
-const U32 GFont::csm_fileVersion = 3;
+/// Version 4 stores the free space on each sheet in place of the row
+/// packer position of version 3.  Version 3 files are still read.
+const U32 GFont::csm_fileVersion = 4;
+
+//-----------------------------------------------------------------------------
+
+/// Rasterizes a range of characters for GFont::queueRasterRange().
+///
+/// The job holds a reference to the font so a preloaded font that nothing
+/// else uses yet doesn't go away under it.  Resources aren't thread safe, so
+/// once the glyphs are done the job is queued again on the main thread,
+/// which adds them to the sheets and lets go of the font.
+struct GFont::RasterJob : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   RasterJob( const Resource<GFont> &font, const Vector<UTF16> &chars )
+      : mFontRes( font ),
+        mFont( mFontRes ),
+        mChars( chars ),
+        mRasterized( false ),
+        mCancelled( false )
+   {
+      dFetchAndAdd( mFont->mNumRasterJobs, 1 );
+   }
+
+   bool isCancellationRequested() override
+   {
+      return !mRasterized && mFont->mCancelRasterJobs;
+   }
+
+protected:
+
+   void onCancelled() override
+   {
+      // The font is waiting for us on the main thread, so stop counting
+      // right away and only release the font over there.
+      mCancelled = true;
+      dFetchAndAdd( mFont->mNumRasterJobs, ( U32 ) -1 );
+      _finishOnMainThread();
+   }
+
+   void execute() override
+   {
+      if ( mRasterized )
+      {
+         // Back on the main thread.
+         if ( !mCancelled )
+         {
+            mFont->processRasterizedGlyphs();
+            dFetchAndAdd( mFont->mNumRasterJobs, ( U32 ) -1 );
+         }
+
+         // This may delete the font.
+         mFont = NULL;
+         mFontRes = NULL;
+         return;
+      }
+
+      for ( U32 i = 0; i < mChars.size(); i++ )
+      {
+         if ( cancellationPoint() )
+            return;
+
+         RasterizedGlyph glyph;
+         glyph.ch = mChars[i];
+
+         {
+            MutexHandle rasterLock;
+            rasterLock.lock( GFont::getRasterMutex(), true );
+
+            if ( !mFont->mPlatformFont->isValidChar( glyph.ch ) )
+               continue;
+
+            // The CharInfo is static data, but the bitmap is allocated for
+            // every call, so copying it hands the bitmap over to us.
+            glyph.charInfo = mFont->mPlatformFont->getCharInfo( glyph.ch );
+         }
+
+         MutexHandle lock;
+         lock.lock( mFont->mMutex, true );
+         mFont->mRasterizedGlyphs.push_back( glyph );
+         mFont->mNumRasterizedGlyphs = mFont->mRasterizedGlyphs.size();
+      }
+
+      _finishOnMainThread();
+   }
+
+   void _finishOnMainThread()
+   {
+      mRasterized = true;
+      ThreadPool::queueWorkItemOnMainThread( this );
+   }
+
+   /// Keeps the font alive; only touched on the main thread.
+   Resource<GFont> mFontRes;
+
+   GFont *mFont;
+   Vector<UTF16> mChars;
+
+   /// Set once the job has been handed back to the main thread.
+   bool mRasterized;
+
+   /// Set if the font cancelled the job before it finished.
+   bool mCancelled;
+};
+
+void* GFont::getRasterMutex()
+{
+   static Mutex sRasterMutex;
+   return &sRasterMutex;
+}
 
 String GFont::getFontCacheFilename(const String &faceName, U32 size)
 {
@@ -200,7 +313,9 @@ GFont::GFont()
 
    std::fill_n(mRemapTable, Font_Table_MAX,-1);
 
-   mCurX = mCurY = mCurSheet = -1;
+   VECTOR_SET_ASSOCIATION(mSheetPackers);
+   VECTOR_SET_ASSOCIATION(mSheetDirty);
+   VECTOR_SET_ASSOCIATION(mRasterizedGlyphs);
 
    mPlatformFont = NULL;
    mSize = 0;
@@ -212,10 +327,17 @@ GFont::GFont()
    mNeedSave = false;
    
    mMutex = Mutex::createMutex();
+   mNumRasterizedGlyphs = 0;
+   mNumRasterJobs = 0;
+   mCancelRasterJobs = false;
 }
 
 GFont::~GFont()
 {
+   // The device may already be gone, so glyphs that haven't been added
+   // to a sheet yet are dropped rather than saved.
+   cancelRasterJobs();
+
    if(mNeedSave)
    {
       AssertFatal( mGFTFile.getFullPath().isNotEmpty(), "GFont::~GFont - path not set" );
@@ -268,6 +390,86 @@ void GFont::dumpInfo() const
    else
       Con::printf("      - No mapped codepoints.");
    Con::printf("      - Platform font is %s.", (mPlatformFont ? "present" : "not present") );
+
+   for(U32 i=0; i<mSheetPackers.size(); i++)
+      Con::printf("      - Sheet %d is %.1f%% full.", i, mSheetPackers[i].getOccupancy() * 100.0f);
+
+   if(isRasterPending())
+      Con::printf("      - %d glyph(s) waiting to be added, %d raster job(s) running.", mNumRasterizedGlyphs, mNumRasterJobs);
+}
+
+void GFont::queueRasterRange(Resource<GFont> &font, UTF16 rangeStart, UTF16 rangeEnd)
+{
+   if(font == NULL || !font->mPlatformFont || rangeStart > rangeEnd)
+      return;
+
+   Vector<UTF16> chars;
+   for(U32 i = rangeStart ? rangeStart : 1; i <= rangeEnd; i++)
+   {
+      if(font->mRemapTable[i] == -1)
+         chars.push_back(i);
+   }
+
+   if(chars.empty())
+      return;
+
+   ThreadSafeRef<RasterJob> job(new RasterJob(font, chars));
+   ThreadPool::GLOBAL().queueWorkItem(job);
+}
+
+bool GFont::isRasterPending() const
+{
+   return mNumRasterJobs != 0 || mNumRasterizedGlyphs != 0;
+}
+
+void GFont::processRasterizedGlyphs()
+{
+   if(!dAtomicRead(mNumRasterizedGlyphs))
+      return;
+
+   PROFILE_SCOPE(GFont_processRasterizedGlyphs);
+
+   Vector<RasterizedGlyph> glyphs;
+   {
+      MutexHandle lock;
+      lock.lock(mMutex, true);
+      glyphs = std::move(mRasterizedGlyphs);
+      mNumRasterizedGlyphs = 0;
+   }
+
+   for(U32 i = 0; i < glyphs.size(); i++)
+   {
+      PlatformFont::CharInfo &ci = glyphs[i].charInfo;
+
+      // It may have been rasterized on this thread in the meantime.
+      if(mRemapTable[glyphs[i].ch] != -1)
+      {
+         SAFE_DELETE_ARRAY(ci.bitmapData);
+         continue;
+      }
+
+      if(ci.bitmapData)
+         addBitmap(ci);
+
+      mCharInfoList.push_back(ci);
+      mRemapTable[glyphs[i].ch] = mCharInfoList.size() - 1;
+      mNeedSave = true;
+   }
+}
+
+void GFont::cancelRasterJobs()
+{
+   mCancelRasterJobs = true;
+
+   while(dAtomicRead(mNumRasterJobs))
+      Platform::sleep(1);
+
+   mCancelRasterJobs = false;
+
+   for(S32 i=0; i<mRasterizedGlyphs.size(); i++)
+      SAFE_DELETE_ARRAY(mRasterizedGlyphs[i].charInfo.bitmapData);
+   mRasterizedGlyphs.clear();
+   mNumRasterizedGlyphs = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -281,8 +483,15 @@ bool GFont::loadCharInfo(const UTF16 ch)
 
     if(mPlatformFont && mPlatformFont->isValidChar(ch))
     {
-        Mutex::lockMutex(mMutex); // the CharInfo returned by mPlatformFont is static data, must protect from changes.
-        PlatformFont::CharInfo &ci = mPlatformFont->getCharInfo(ch);
+        // The CharInfo returned by mPlatformFont is static data, and a raster
+        // job may be using it, so copy it while we hold the lock.
+        PlatformFont::CharInfo ci;
+        {
+            MutexHandle rasterLock;
+            rasterLock.lock(getRasterMutex(), true);
+            ci = mPlatformFont->getCharInfo(ch);
+        }
+
         if(ci.bitmapData)
             addBitmap(ci);
 
@@ -290,8 +499,6 @@ bool GFont::loadCharInfo(const UTF16 ch)
         mRemapTable[ch] = mCharInfoList.size() - 1;
         
         mNeedSave = true;
-        
-        Mutex::unlockMutex(mMutex);
         return true;
     }
 
@@ -300,53 +507,37 @@ bool GFont::loadCharInfo(const UTF16 ch)
 
 void GFont::addBitmap(PlatformFont::CharInfo &charInfo)
 {
-   U32 nextCurX = U32(mCurX + charInfo.width ); /*7) & ~0x3;*/
-   U32 nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
-
-   // These are here for postmortem debugging.
-   bool routeA = false, routeB = false;
-
-   if(mCurSheet == -1 || nextCurY >= TextureSheetSize)
-   {
-      routeA = true;
-      addSheet();
-
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
-   }
-
-   if( nextCurX >= TextureSheetSize)
+   const U32 packWidth = charInfo.width + GlyphPadding;
+   const U32 packHeight = charInfo.height + GlyphPadding;
+
+   // Glyphs are small next to a sheet, so it's worth going back to older
+   // sheets for the gaps a taller glyph left.
+   Point2I pos;
+   S32 sheet;
+   for(sheet = 0; sheet < mSheetPackers.size(); sheet++)
    {
-      routeB = true;
-      mCurX = 0;
-      mCurY = nextCurY;
-
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+      if(mSheetPackers[sheet].pack(packWidth, packHeight, &pos))
+         break;
    }
 
-   // Check the Y once more - sometimes we advance to a new row and run off
-   // the end.
-   if(nextCurY >= TextureSheetSize)
+   if(sheet == mSheetPackers.size())
    {
-      routeA = true;
       addSheet();
-
-      // Recalc our nexts.
-      nextCurX = U32(mCurX + charInfo.width); // + 7) & ~0x3;
-      nextCurY = U32(mCurY + mPlatformFont->getFontHeight()); // + 7) & ~0x3;
+      if(!mSheetPackers.last().pack(packWidth, packHeight, &pos))
+      {
+         Con::errorf("GFont::addBitmap - %dx%d glyph doesn't fit on a %dx%d sheet!", charInfo.width, charInfo.height, (S32)TextureSheetSize, (S32)TextureSheetSize);
+         charInfo.bitmapIndex = -1;
+         charInfo.width = charInfo.height = 0;
+         return;
+      }
    }
 
-    charInfo.bitmapIndex = mCurSheet;
-    charInfo.xOffset = mCurX;
-    charInfo.yOffset = mCurY;
-
-   mCurX = nextCurX;
+   charInfo.bitmapIndex = sheet;
+   charInfo.xOffset = pos.x;
+   charInfo.yOffset = pos.y;
 
    S32 x, y;
-   GBitmap *bmp = mTextureSheets[mCurSheet].getBitmap();
+   GBitmap *bmp = mTextureSheets[sheet].getBitmap();
 
    AssertFatal(bmp->getFormat() == GFXFormatA8, "GFont::addBitmap - cannot added characters to non-greyscale textures!");
 
@@ -354,7 +545,9 @@ void GFont::addBitmap(PlatformFont::CharInfo &charInfo)
       for(x = 0;x < charInfo.width;x++)
          *bmp->getAddress(x + charInfo.xOffset, y + charInfo.yOffset) = charInfo.bitmapData[y * charInfo.width + x];
 
-   mTextureSheets[mCurSheet].refresh();
+   // Uploaded when the sheet is next used, so a string full of new
+   // characters only costs one upload per sheet.
+   mSheetDirty[sheet] = true;
 }
 
 void GFont::addSheet()
@@ -369,9 +562,22 @@ void GFont::addSheet()
     mTextureSheets.increment();
     mTextureSheets.last() = handle;
 
-    mCurX = 0;
-    mCurY = 0;
-    mCurSheet = mTextureSheets.size() - 1;
+    mSheetPackers.increment();
+    mSheetPackers.last().reset(TextureSheetSize, TextureSheetSize);
+    mSheetDirty.push_back(false);
+}
+
+GFXTexHandle GFont::getTextureHandle(S32 index)
+{
+   if(mSheetDirty[index])
+   {
+      PROFILE_SCOPE(GFont_refreshSheet);
+
+      mTextureSheets[index].refresh();
+      mSheetDirty[index] = false;
+   }
+
+   return mTextureSheets[index];
 }
 
 //-----------------------------------------------------------------------------
@@ -382,6 +588,8 @@ const PlatformFont::CharInfo &GFont::getCharInfo(const UTF16 in_charIndex)
 
     AssertFatal(in_charIndex, "GFont::getCharInfo - can't get info for char 0!");
 
+    processRasterizedGlyphs();
+
     if(mRemapTable[in_charIndex] == -1)
         loadCharInfo(in_charIndex);
 
@@ -660,7 +868,7 @@ bool GFont::read(Stream& io_rStream)
     // Handle versioning
     U32 version;
     io_rStream.read(&version);
-    if(version != csm_fileVersion)
+    if(version != csm_fileVersion && version != 3)
         return false;
 
     char buf[256];
@@ -714,15 +922,41 @@ bool GFont::read(Stream& io_rStream)
           return false;
        }
 
+       mSheetPackers.increment();
+       mSheetPackers.last().reset(bmp->getWidth(), bmp->getHeight());
+
        GFXTexHandle handle = GFXTexHandle(bmp, &GFXFontTextureProfile, true, avar("%s() - Read Font Sheet for %s %d (line %d)", __FUNCTION__, mFaceName.c_str(), mSize, __LINE__));
        //handle.setFilterNearest();
        mTextureSheets.push_back(handle);
+       mSheetDirty.push_back(false);
    }
    
-   // Read last position info
-   io_rStream.read(&mCurX);
-   io_rStream.read(&mCurY);
-   io_rStream.read(&mCurSheet);
+   if(version >= 4)
+   {
+      // Read the free space on each sheet.
+      for(i = 0; i < numSheets; i++)
+      {
+         if(!mSheetPackers[i].read(io_rStream))
+            return false;
+      }
+   }
+   else
+   {
+      // Version 3 packed glyphs in rows of the font height and only kept
+      // the position on the last sheet, so the others are treated as full.
+      S32 curX, curY, curSheet;
+      io_rStream.read(&curX);
+      io_rStream.read(&curY);
+      io_rStream.read(&curSheet);
+
+      for(i = 0; i < numSheets; i++)
+      {
+         if(S32(i) == curSheet)
+            mSheetPackers[i].setFromRow(curX, curY, mHeight);
+         else
+            mSheetPackers[i].close();
+      }
+   }
 
    // Read the remap table.
    U32 minGlyph, maxGlyph;
@@ -755,6 +989,9 @@ bool GFont::read(Stream& io_rStream)
 
 bool GFont::write(Stream& stream)
 {
+    // Include whatever the raster jobs have finished.
+    processRasterizedGlyphs();
+
     // Handle versioning
     stream.write(csm_fileVersion);
 
@@ -793,9 +1030,8 @@ bool GFont::write(Stream& stream)
       mTextureSheets[i].getBitmap()->writeBitmapStream("png", stream);
    }
 
-   stream.write(mCurX);
-   stream.write(mCurY);
-   stream.write(mCurSheet);
+   for (i = 0; i < mSheetPackers.size(); i++)
+      mSheetPackers[i].write(stream);
 
    // Get the min/max we have values for, and only write that range out.
    S32 minGlyph = S32_MAX, maxGlyph = 0;
@@ -898,9 +1134,14 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    // Also deal with kerning.
    // Also, we may have to load RGBA instead of RGB.
 
+   // Glyphs rasterized in the background were meant for the old sheets
+   // and aren't in the strip.
+   cancelRasterJobs();
+
    // Wipe our texture sheets.
-   mCurSheet = mCurX = mCurY = 0;
    mTextureSheets.clear();
+   mSheetPackers.clear();
+   mSheetDirty.clear();
 
    //  Now, load the font strip.
    Resource<GBitmap> strip = GBitmap::load(fileName);
@@ -951,60 +1192,42 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    // Ok, we have a big list of glyphmaps now. So let's sort them, then pack them.
    dQsort(glyphList.address(), glyphList.size(), sizeof(GlyphMap), GlyphMapCompare);
 
-   // They're sorted by height, so now we can do some sort of awesome packing.
-   Point2I curSheetSize(256, 256);
-   Vector<U32> sheetSizes;
-
-   S32 curY = 0;
-   S32 curX = 0;
-   S32 curLnHeight = 0;
-   S32 maxHeight = 0;
+   // They're sorted by height, which is the order the skyline packer does
+   // best with.
    for(U32 i = 0; i < glyphList.size(); i++)
    {
       PlatformFont::CharInfo *ci = &mCharInfoList[glyphList[i].charId];
-      
-      if(ci->height > maxHeight)
-         maxHeight = ci->height;
+      const U32 packWidth = ci->width + GlyphPadding;
+      const U32 packHeight = ci->height + GlyphPadding;
 
-      if(curX + ci->width > curSheetSize.x)
+      Point2I pos;
+      S32 sheet;
+      for(sheet = 0; sheet < mSheetPackers.size(); sheet++)
       {
-         curY += curLnHeight;
-         curX = 0;
-         curLnHeight = 0;
+         if(mSheetPackers[sheet].pack(packWidth, packHeight, &pos))
+            break;
       }
 
-      if(curY + ci->height > curSheetSize.y)
+      if(sheet == mSheetPackers.size())
       {
-         sheetSizes.push_back(curSheetSize.y);
-         curX = 0;
-         curY = 0;
-         curLnHeight = 0;
+         mSheetPackers.increment();
+         mSheetPackers.last().reset(TextureSheetSize, TextureSheetSize);
+         if(!mSheetPackers.last().pack(packWidth, packHeight, &pos))
+         {
+            Con::errorf("GFont::importStrip - glyph %d is too big for a texture sheet!", glyphList[i].charId);
+            mSheetPackers.pop_back();
+            ci->bitmapIndex = -1;
+            continue;
+         }
       }
 
-      if(ci->height > curLnHeight)
-         curLnHeight = ci->height;
-      
-      ci->bitmapIndex = sheetSizes.size();
-      ci->xOffset = curX;
-      ci->yOffset = curY;
-      curX += ci->width;
+      ci->bitmapIndex = sheet;
+      ci->xOffset = pos.x;
+      ci->yOffset = pos.y;
    }
 
-   // Terminate the packing loop calculations.
-   curY += curLnHeight;
-
-   if(curY < 64)
-      curSheetSize.y = 64;
-   else if(curY < 128)
-      curSheetSize.y = 128;
-
-   sheetSizes.push_back(curSheetSize.y);
-
-   if(getHeight() + padding * 2 > maxHeight)
-      maxHeight = getHeight() + padding * 2;
-
    // Allocate texture pages.
-   for(S32 i=0; i<sheetSizes.size(); i++)
+   for(S32 i=0; i<mSheetPackers.size(); i++)
    {
       GBitmap *bitmap = new GBitmap(TextureSheetSize, TextureSheetSize, false, strip->getFormat());
 
@@ -1015,6 +1238,7 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
       GFXTexHandle handle = GFXTexHandle( bitmap, &GFXFontTextureProfile, true, avar("%s() - Font Sheet for %s (line %d)", __FUNCTION__, fileName, __LINE__) );
       mTextureSheets.increment();
       mTextureSheets.last() = handle;
+      mSheetDirty.push_back(false);
    }
 
    // Alright, we're ready to copy bits!
@@ -1022,12 +1246,15 @@ void GFont::importStrip(const char *fileName, U32 padding, U32 kerning)
    {
       // Copy each glyph into the appropriate place.
       PlatformFont::CharInfo *ci = &mCharInfoList[glyphList[i].charId];
+      if(ci->bitmapIndex == -1)
+         continue;
+
       U32 bi = ci->bitmapIndex;
       mTextureSheets[bi]->getBitmap()->copyRect(glyphList[i].bitmap, RectI(0,0, glyphList[i].bitmap->getWidth(),glyphList[i].bitmap->getHeight()), Point2I(ci->xOffset, ci->yOffset));
    }
 
    // Ok, all done! Just refresh some textures and we're set.
-   for(S32 i=0; i<sheetSizes.size(); i++)
+   for(S32 i=0; i<mTextureSheets.size(); i++)
       mTextureSheets[i].refresh();
 }
 
@@ -1098,6 +1325,41 @@ DefineEngineFunction( populateFontCacheRange, void, ( const char *faceName, S32
    // All done!
 }
 
+DefineEngineFunction( preloadFontCacheRange, void, ( const char *faceName, S32 fontSize, U32 rangeStart, U32 rangeEnd ),,
+   "Rasterize the Unicode code points in the specified range for the specified font on a "
+   "worker thread.  Unlike populateFontCacheRange() this returns right away; the characters "
+   "are added to the font as they become ready, so text using them later doesn't stall "
+   "while they are generated.  Use writeFontCache() afterwards to keep them for the next run.\n"
+   "@param faceName The name of the font face.\n"
+   "@param fontSize The size of the font in pixels.\n"
+   "@param rangeStart The first Unicode point.\n"
+   "@param rangeEnd The last Unicode point.\n"
+   "@note We only support BMP-0, so code points range from 0 to 65535.\n"
+   "@ingroup Font\n" )
+{
+   Resource<GFont> f = GFont::create(faceName, fontSize, Con::getVariable("$GUI::fontCacheDirectory"));
+
+   if(f == NULL)
+   {
+      Con::errorf("preloadFontCacheRange - could not load font '%s %d'", faceName, fontSize);
+      return;
+   }
+
+   if(rangeStart > rangeEnd || rangeEnd >= Font_Table_MAX)
+   {
+      Con::errorf("preloadFontCacheRange - invalid range 0x%x to 0x%x", rangeStart, rangeEnd);
+      return;
+   }
+
+   if(!f->hasPlatformFont())
+   {
+      Con::errorf("preloadFontCacheRange - font '%s %d' has no platform font. Cannot generate more characters.", faceName, fontSize);
+      return;
+   }
+
+   GFont::queueRasterRange(f, rangeStart, rangeEnd);
+}
+
 DefineEngineFunction( dumpFontCacheStatus, void, (),,
    "Dumps to the console a full description of all cached fonts, along with "
    "info on the codepoints each contains.\n"
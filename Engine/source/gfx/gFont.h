@@ -39,6 +39,9 @@
 #ifndef _GFXTEXTUREHANDLE_H_
 #include "gfx/gfxTextureHandle.h"
 #endif
+#ifndef _SKYLINE_PACKER_H_
+#include "gfx/util/skylinePacker.h"
+#endif
 
 
 GFX_DeclareTextureProfile(GFXFontTextureProfile);
@@ -50,7 +53,11 @@ public:
    enum Constants 
    {
       TabWidthInSpaces = 3,
-      TextureSheetSize = 256,
+      TextureSheetSize = 512,
+
+      /// Empty pixels left to the right of and below every glyph so that
+      /// filtering doesn't pick up its neighbours.
+      GlyphPadding = 1,
    };
 
 public:
@@ -59,7 +66,9 @@ public:
    
    static Resource<GFont> create(const String &faceName, U32 size, const char *cacheDirectory = 0, U32 charset = TGE_ANSI_CHARSET);
 
-   GFXTexHandle getTextureHandle(S32 index) const { return mTextureSheets[index]; }
+   /// Returns the texture of a sheet, first uploading any glyphs that have
+   /// been added to it since it was last used.
+   GFXTexHandle getTextureHandle(S32 index);
 
    const PlatformFont::CharInfo& getCharInfo(const UTF16 in_charIndex);
    static const PlatformFont::CharInfo& getDefaultCharInfo();
@@ -91,6 +100,18 @@ public:
    /// Dump information about this font to the console.
    void dumpInfo() const;
 
+   /// Rasterize all valid characters in the range on a worker thread.  The
+   /// glyphs are added to the texture sheets the next time the font is used
+   /// on the main thread, so text that needs them later won't stall on the
+   /// platform font.  Characters that are requested before their glyph is
+   /// ready are still rasterized right away.  The jobs keep the font loaded
+   /// until their glyphs have been added.
+   static void queueRasterRange(Resource<GFont> &font, UTF16 rangeStart, UTF16 rangeEnd);
+
+   /// Returns true while glyphs queued with queueRasterRange() are still
+   /// being rasterized or are waiting to be added to the sheets.
+   bool isRasterPending() const;
+
    /// Export to an image strip for image processing.
    void exportStrip(const char *fileName, U32 padding, U32 kerning);
 
@@ -127,22 +148,60 @@ public:
    static GFont* load( const Torque::Path& path );
 
 protected:
+   struct RasterJob;
+
+   /// A glyph a RasterJob rasterized that hasn't been added to the sheets yet.
+   struct RasterizedGlyph
+   {
+      UTF16 ch;
+      PlatformFont::CharInfo charInfo;
+   };
+
    bool loadCharInfo(const UTF16 ch);
    void addBitmap(PlatformFont::CharInfo &charInfo);
    void addSheet(void);
    void assignSheet(S32 sheetNum, GBitmap *bmp);
 
+   /// Add the glyphs the raster jobs finished to the sheets.
+   void processRasterizedGlyphs();
+
+   /// Wait for all raster jobs to finish, skipping the glyphs they haven't
+   /// got to yet, and throw away the glyphs that haven't been added.
+   void cancelRasterJobs();
+
+   /// Protects mRasterizedGlyphs.
    void *mMutex;
 
+   /// Glyphs rasterized by RasterJobs, waiting for the main thread.
+   Vector<RasterizedGlyph> mRasterizedGlyphs;
+
+   /// Number of entries in mRasterizedGlyphs.  Only changed with the mutex
+   /// held, but the main thread checks it without taking the mutex.
+   volatile U32 mNumRasterizedGlyphs;
+
+   /// Number of RasterJobs whose glyphs haven't been added yet.
+   volatile U32 mNumRasterJobs;
+
+   /// Set to make the raster jobs skip the rest of their range.
+   bool mCancelRasterJobs;
+
+   /// The platform fonts share their rasterizing state (the static CharInfo
+   /// returned by getCharInfo() and, on some platforms, the device context
+   /// it is drawn with), so only one thread at a time may rasterize with
+   /// any of them.
+   static void* getRasterMutex();
+
 private:
    static const U32 csm_fileVersion;
 
    PlatformFont *mPlatformFont;
    Vector<GFXTexHandle>mTextureSheets;
 
-   S32 mCurX;
-   S32 mCurY;
-   S32 mCurSheet;
+   /// Free space on each sheet.  New glyphs go on the first sheet they fit on.
+   Vector<GFXUtil::SkylinePacker> mSheetPackers;
+
+   /// Sheets that have had glyphs added since they were last uploaded.
+   Vector<bool> mSheetDirty;
 
    bool mNeedSave;
    Torque::Path mGFTFile;
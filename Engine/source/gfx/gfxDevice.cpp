@@ -27,6 +27,7 @@
 #include "gfx/gfxCubemap.h"
 #include "gfx/primBuilder.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxDrawList2D.h"
 #include "gfx/gfxFence.h"
 #include "gfx/gfxFontRenderBatcher.h"
 #include "gfx/gfxPrimitiveBuffer.h"
@@ -81,6 +82,8 @@ void GFXDevice::initConsole()
       "shader model supported by the active device.  Use 0 for fixed function.\n"
       "@note The graphics device must be reset for the change to take affect.\n"
       "@ingroup GFX\n" );
+
+   GFXDrawList2D::consoleInit();
 }
 
 GFXDevice::DeviceEventSignal& GFXDevice::getDeviceEventSignal()
@@ -162,6 +165,7 @@ GFXDevice::GFXDevice()
 
    // Initialize our drawing utility.
    mDrawer = NULL;
+   mDrawListPending = false;
    mFrameTime = PlatformTimer::create();
    // Add a few system wide shader macros.
    GFXShader::addGlobalMacro( "TORQUE", "1" );
@@ -187,6 +191,11 @@ GFXDrawUtil* GFXDevice::getDrawUtil()
    return mDrawer;
 }
 
+void GFXDevice::_flushDrawList()
+{
+   getDrawUtil()->getDrawList()->flush();
+}
+
 void GFXDevice::deviceInited()
 {
    getDeviceEventSignal().trigger(deInit);
@@ -306,6 +315,8 @@ void GFXDevice::setStateBlock(GFXStateBlock* block)
    AssertFatal(block, "NULL state block!");
    AssertFatal(block->getOwningDevice() == this, "This state doesn't apply to this device!");
 
+   flushDrawList();
+
    if (block != mCurrentStateBlock)
    {
       mStateDirty = true;
@@ -326,6 +337,7 @@ void GFXDevice::setStateBlockByDesc( const GFXStateBlockDesc &desc )
 
 void GFXDevice::setShaderConstBuffer(GFXShaderConstBuffer* buffer)
 {
+   flushDrawList();
    mCurrentShaderConstBuffer = buffer;
 }
 
@@ -533,6 +545,8 @@ void GFXDevice::clearTextureStateImmediate(U32 stage)
 
 void GFXDevice::setPrimitiveBuffer( GFXPrimitiveBuffer *buffer )
 {
+   flushDrawList();
+
    if( buffer == mCurrentPrimitiveBuffer )
       return;
    
@@ -677,6 +691,8 @@ void GFXDevice::setTexture( U32 stage, GFXTextureObject *texture )
 {
    AssertFatal(stage < getNumSamplers(), "GFXDevice::setTexture - out of range stage!");
 
+   flushDrawList();
+
    if (  mTexType[stage] == GFXTDT_Normal &&
          (  ( mTextureDirty[stage] && mNewTexture[stage].getPointer() == texture ) ||
             ( !mTextureDirty[stage] && mCurrentTexture[stage].getPointer() == texture ) ) )
@@ -705,6 +721,8 @@ void GFXDevice::setCubeTexture( U32 stage, GFXCubemap *cubemap )
 {
    AssertFatal(stage < getNumSamplers(), "GFXDevice::setTexture - out of range stage!");
 
+   flushDrawList();
+
    if (  mTexType[stage] == GFXTDT_Cube &&
          (  ( mTextureDirty[stage] && mNewCubemap[stage].getPointer() == cubemap) ||
             ( !mTextureDirty[stage] && mCurrentCubemap[stage].getPointer() == cubemap) ) )
@@ -733,6 +751,8 @@ void GFXDevice::setCubeArrayTexture(U32 stage, GFXCubemapArray *cubemapArray)
 {
    AssertFatal(stage < getNumSamplers(), avar("GFXDevice::setTexture - out of range stage! %i>%i", stage, getNumSamplers()));
 
+   flushDrawList();
+
    if (mTexType[stage] == GFXTDT_CubeArray &&
       ((mTextureDirty[stage] && mNewCubemapArray[stage].getPointer() == cubemapArray) ||
       (!mTextureDirty[stage] && mCurrentCubemapArray[stage].getPointer() == cubemapArray)))
@@ -761,6 +781,8 @@ void GFXDevice::setTextureArray(U32 stage, GFXTextureArray *textureArray)
 {
    AssertFatal(stage < getNumSamplers(), avar("GFXDevice::setTextureArray - out of range stage! %i>%i", stage, getNumSamplers()));
 
+   flushDrawList();
+
    if (mTexType[stage] == GFXTDT_TextureArray &&
       ((mTextureDirty[stage] && mNewTextureArray[stage].getPointer() == textureArray) ||
       (!mTextureDirty[stage] && mCurrentTextureArray[stage].getPointer() == textureArray)))
@@ -799,6 +821,8 @@ inline bool GFXDevice::beginScene()
 inline void GFXDevice::endScene()
 {
    AssertFatal( mCanCurrentlyRender == true, "GFXDevice::endScene() - The scene has already ended!" );
+
+   flushDrawList();
    
    // End frame signal
    getDeviceEventSignal().trigger( GFXDevice::deEndOfFrame );
@@ -826,10 +850,9 @@ inline void GFXDevice::endField()
 void GFXDevice::setViewport( const RectI &inRect ) 
 {
    // Clip the rect against the renderable size.
-   Point2I size = mCurrentRT->getSize();
-   RectI maxRect(Point2I(0,0), size);
    RectI rect = inRect;
-   rect.intersect(maxRect);
+   if ( mCurrentRT.isValid() )
+      rect.intersect( RectI( Point2I::Zero, mCurrentRT->getSize() ) );
 
    if ( mViewport != rect )
    {
@@ -860,6 +883,8 @@ void GFXDevice::setActiveRenderTarget( GFXTarget *target, bool updateViewport )
 
    if ( target == mCurrentRT )
       return;
+
+   flushDrawList();
    
    // If we're not dirty then store the 
    // current RT for deactivation later.
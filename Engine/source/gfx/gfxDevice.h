@@ -1042,6 +1042,23 @@ public:
    /// Get access to this device's drawing utility class.
    GFXDrawUtil *getDrawUtil();
 
+   /// @name 2D draw list
+   /// GFXDrawUtil can collect GUI drawing in a GFXDrawList2D rather than
+   /// drawing it right away.  Anything that changes device state or draws
+   /// calls flushDrawList() first, so whatever was collected is drawn
+   /// before it, in the order it was drawn in.
+   /// @{
+
+   /// Draw whatever the draw list has collected, if anything.
+   inline void flushDrawList() { if ( mDrawListPending ) _flushDrawList(); }
+
+   /// Called by the draw list when it has, or no longer has, something to draw.
+   void setDrawListPending( bool pending ) { mDrawListPending = pending; }
+
+   bool getDrawListPending() const { return mDrawListPending; }
+
+   /// @}
+
 #ifndef TORQUE_SHIPPING
    /// This is a method designed for debugging. It will allow you to dump the states
    /// in the render manager out to a file so that it can be diffed and examined.
@@ -1051,6 +1068,11 @@ public:
 #endif
    protected:
       GFXDrawUtil *mDrawer;
+
+      /// Set while the draw list has something to draw.
+      bool mDrawListPending;
+
+      void _flushDrawList();
 }; 
 
 //-----------------------------------------------------------------------------
@@ -1102,6 +1124,8 @@ inline void GFXDevice::setVertexBuffer( GFXVertexBuffer *buffer, U32 stream, U32
 {
    AssertFatal( stream < VERTEX_STREAM_COUNT, "GFXDevice::setVertexBuffer - Bad stream index!" );
 
+   flushDrawList();
+
    if ( buffer && stream == 0 )
       setVertexFormat( &buffer->mVertexFormat );
 
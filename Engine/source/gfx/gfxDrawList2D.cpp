@@ -0,0 +1,374 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/gfxDrawList2D.h"
+
+#include "gfx/gfxTransformSaver.h"
+#include "console/consoleTypes.h"
+#include "platform/profiler.h"
+
+
+bool GFXDrawList2D::smEnabled = true;
+
+
+void GFXDrawList2D::consoleInit()
+{
+   Con::addVariable( "$GFX::batch2D", TypeBool, &smEnabled,
+      "If true, GUI rectangles, bitmaps, lines and text are collected for the "
+      "whole canvas and drawn with as few draw calls as possible.\n"
+      "@ingroup GFX\n" );
+}
+
+GFXDrawList2D::GFXDrawList2D( GFXDevice *device )
+   :  mDevice( device ),
+      mActive( false ),
+      mFlushing( false ),
+      mBounds( 0, 0, 0, 0 ),
+      mNumCommands( 0 ),
+      mNumDrawCalls( 0 ),
+      mLastNumCommands( 0 ),
+      mLastNumDrawCalls( 0 )
+{
+   VECTOR_SET_ASSOCIATION( mVerts );
+   VECTOR_SET_ASSOCIATION( mRuns );
+}
+
+GFXDrawList2D::~GFXDrawList2D()
+{
+   if ( mDevice->getDrawListPending() )
+      mDevice->setDrawListPending( false );
+}
+
+void GFXDrawList2D::begin()
+{
+   AssertFatal( !mActive, "GFXDrawList2D::begin - Already active!" );
+
+   mActive = true;
+   mNumCommands = 0;
+   mNumDrawCalls = 0;
+}
+
+void GFXDrawList2D::end()
+{
+   AssertFatal( mActive, "GFXDrawList2D::end - Not active!" );
+
+   flush();
+   mActive = false;
+
+   mLastNumCommands = mNumCommands;
+   mLastNumDrawCalls = mNumDrawCalls;
+}
+
+bool GFXDrawList2D::canRecord()
+{
+   if ( !mActive || mFlushing || !smEnabled )
+      return false;
+
+   if (  !mDevice->getWorldMatrix().isIdentity() ||
+         !mDevice->getViewMatrix().isIdentity() )
+      return false;
+
+   // The viewport and projection have to map the clip rect straight onto
+   // the screen, like setClipRect() sets them up.  Anything else, like the
+   // perspective a GuiTSCtrl renders with, is drawn immediately.
+   const RectI &clip = mDevice->getClipRect();
+   if ( !clip.isValidRect() || mDevice->getViewport() != clip )
+      return false;
+
+   const F32 l = F32( clip.point.x );
+   const F32 t = F32( clip.point.y );
+   const F32 r = F32( clip.point.x + clip.extent.x );
+   const F32 b = F32( clip.point.y + clip.extent.y );
+
+   Point4F ul( l, t, 0.0f, 1.0f );
+   Point4F lr( r, b, 0.0f, 1.0f );
+   Point4F ll( l, b, 0.0f, 1.0f );
+   const MatrixF &proj = mDevice->getProjectionMatrix();
+   proj.mul( ul );
+   proj.mul( lr );
+   proj.mul( ll );
+
+   const F32 eps = 0.001f;
+   return   mIsEqual( ul.x, -1.0f, eps ) && mIsEqual( ul.y,  1.0f, eps ) && mIsEqual( ul.w, 1.0f, eps ) &&
+            mIsEqual( lr.x,  1.0f, eps ) && mIsEqual( lr.y, -1.0f, eps ) && mIsEqual( lr.w, 1.0f, eps ) &&
+            mIsEqual( ll.x, -1.0f, eps ) && mIsEqual( ll.y, -1.0f, eps );
+}
+
+GFXDrawList2D::Run& GFXDrawList2D::_getRun(  GFXPrimitiveType primType,
+                                             GFXTextureObject *texture,
+                                             GFXStateBlock *stateBlock,
+                                             GFXDevice::GenericShaderType shader )
+{
+   if ( !mRuns.empty() )
+   {
+      Run &last = mRuns.last();
+      if (  last.mPrimType == primType &&
+            last.mTexture.getPointer() == texture &&
+            last.mStateBlock.getPointer() == stateBlock &&
+            last.mShader == shader )
+         return last;
+   }
+
+   Run &run = mRuns.emplace_back();
+   run.mPrimType = primType;
+   run.mTexture = texture;
+   run.mStateBlock = stateBlock;
+   run.mShader = shader;
+   run.mStart = mVerts.size();
+   run.mCount = 0;
+   return run;
+}
+
+void GFXDrawList2D::_markPending( const RectI &clip )
+{
+   if ( mBounds.isValidRect() )
+      mBounds.unionRects( clip );
+   else
+      mBounds = clip;
+
+   mDevice->setDrawListPending( true );
+}
+
+void GFXDrawList2D::addQuad(  GFXTextureObject *texture,
+                              GFXStateBlock *stateBlock,
+                              GFXDevice::GenericShaderType shader,
+                              const RectF &rect,
+                              const RectF &texRect,
+                              const GFXVertexColor &color )
+{
+   mNumCommands++;
+
+   const RectI &clip = mDevice->getClipRect();
+
+   F32 x0 = rect.point.x;
+   F32 y0 = rect.point.y;
+   F32 x1 = rect.point.x + rect.extent.x;
+   F32 y1 = rect.point.y + rect.extent.y;
+   F32 u0 = texRect.point.x;
+   F32 v0 = texRect.point.y;
+   F32 u1 = texRect.point.x + texRect.extent.x;
+   F32 v1 = texRect.point.y + texRect.extent.y;
+
+   const F32 l = F32( clip.point.x );
+   const F32 t = F32( clip.point.y );
+   const F32 r = F32( clip.point.x + clip.extent.x );
+   const F32 b = F32( clip.point.y + clip.extent.y );
+
+   if ( x1 <= l || x0 >= r || y1 <= t || y0 >= b || x1 <= x0 || y1 <= y0 )
+      return;
+
+   // Clip against the clip rect, moving the texture coordinates along with
+   // the edges so the visible part of the texture stays where it was.
+   if ( x0 < l )
+   {
+      u0 += ( u1 - u0 ) * ( l - x0 ) / ( x1 - x0 );
+      x0 = l;
+   }
+   if ( x1 > r )
+   {
+      u1 -= ( u1 - u0 ) * ( x1 - r ) / ( x1 - x0 );
+      x1 = r;
+   }
+   if ( y0 < t )
+   {
+      v0 += ( v1 - v0 ) * ( t - y0 ) / ( y1 - y0 );
+      y0 = t;
+   }
+   if ( y1 > b )
+   {
+      v1 -= ( v1 - v0 ) * ( y1 - b ) / ( y1 - y0 );
+      y1 = b;
+   }
+
+   Run &run = _getRun( GFXTriangleList, texture, stateBlock, shader );
+   run.mCount += 6;
+
+   mVerts.increment( 6 );
+   GFXVertexPCT *verts = mVerts.end() - 6;
+
+   verts[0].point.set( x0, y0, 0.0f );
+   verts[0].texCoord.set( u0, v0 );
+   verts[1].point.set( x1, y0, 0.0f );
+   verts[1].texCoord.set( u1, v0 );
+   verts[2].point.set( x0, y1, 0.0f );
+   verts[2].texCoord.set( u0, v1 );
+   verts[3] = verts[1];
+   verts[4].point.set( x1, y1, 0.0f );
+   verts[4].texCoord.set( u1, v1 );
+   verts[5] = verts[2];
+
+   for ( U32 i = 0; i < 6; i++ )
+      verts[i].color = color;
+
+   _markPending( clip );
+}
+
+void GFXDrawList2D::addLine( const Point2F &start, const Point2F &end, const GFXVertexColor &color, GFXStateBlock *stateBlock )
+{
+   mNumCommands++;
+
+   const RectI &clip = mDevice->getClipRect();
+
+   const F32 l = F32( clip.point.x );
+   const F32 t = F32( clip.point.y );
+   const F32 r = F32( clip.point.x + clip.extent.x );
+   const F32 b = F32( clip.point.y + clip.extent.y );
+
+   // Liang-Barsky clip against the clip rect.
+   const Point2F delta = end - start;
+   const F32 p[4] = { -delta.x, delta.x, -delta.y, delta.y };
+   const F32 q[4] = { start.x - l, r - start.x, start.y - t, b - start.y };
+
+   F32 tMin = 0.0f;
+   F32 tMax = 1.0f;
+   for ( U32 i = 0; i < 4; i++ )
+   {
+      if ( p[i] == 0.0f )
+      {
+         if ( q[i] < 0.0f )
+            return;
+         continue;
+      }
+
+      const F32 s = q[i] / p[i];
+      if ( p[i] < 0.0f )
+         tMin = getMax( tMin, s );
+      else
+         tMax = getMin( tMax, s );
+   }
+
+   if ( tMin > tMax )
+      return;
+
+   Run &run = _getRun( GFXLineList, NULL, stateBlock, GFXDevice::GSColor );
+   run.mCount += 2;
+
+   mVerts.increment( 2 );
+   GFXVertexPCT *verts = mVerts.end() - 2;
+
+   verts[0].point.set( start.x + delta.x * tMin, start.y + delta.y * tMin, 0.0f );
+   verts[1].point.set( start.x + delta.x * tMax, start.y + delta.y * tMax, 0.0f );
+   verts[0].texCoord.set( 0.0f, 0.0f );
+   verts[1].texCoord.set( 0.0f, 0.0f );
+   verts[0].color = color;
+   verts[1].color = color;
+
+   _markPending( clip );
+}
+
+void GFXDrawList2D::flush()
+{
+   mDevice->setDrawListPending( false );
+
+   if ( mVerts.empty() )
+   {
+      mRuns.clear();
+      return;
+   }
+
+   PROFILE_SCOPE( GFXDrawList2D_flush );
+
+   mFlushing = true;
+
+   // Draw everything in screen space over the area all the commands were
+   // clipped to, the same way setClipRect() would set it up.
+   GFXTransformSaver saver;
+
+   const F32 l = F32( mBounds.point.x );
+   const F32 t = F32( mBounds.point.y );
+   const F32 r = F32( mBounds.point.x + mBounds.extent.x );
+   const F32 b = F32( mBounds.point.y + mBounds.extent.y );
+
+   MatrixF proj( true );
+   proj.setColumn( 0, Point4F( 2.0f / ( r - l ), 0.0f, 0.0f, 0.0f ) );
+   proj.setColumn( 1, Point4F( 0.0f, 2.0f / ( t - b ), 0.0f, 0.0f ) );
+   proj.setColumn( 2, Point4F( 0.0f, 0.0f, 1.0f, 0.0f ) );
+   proj.setColumn( 3, Point4F( ( l + r ) / ( l - r ), ( t + b ) / ( b - t ), 1.0f, 1.0f ) );
+
+   mDevice->setViewport( mBounds );
+   mDevice->setProjectionMatrix( proj );
+   mDevice->setViewMatrix( MatrixF::Identity );
+   mDevice->setWorldMatrix( MatrixF::Identity );
+
+   for ( U32 i = 1; i < mDevice->getNumSamplers(); i++ )
+      mDevice->setTexture( i, NULL );
+
+   // Whole quads and lines only, so a run that doesn't fit in one buffer
+   // can be split anywhere on a multiple of 6 vertices.
+   const U32 maxVerts = getMin( mDevice->getMaxDynamicVerts(), U32( 0xFFFF ) ) / 6 * 6;
+
+   U32 pos = 0;
+   S32 run = 0;
+   while ( pos < mVerts.size() )
+   {
+      // Work out how many of the remaining vertices go in this buffer.
+      const U32 bufStart = pos;
+      U32 bufEnd = bufStart;
+      for ( S32 i = run; i < mRuns.size(); i++ )
+      {
+         const U32 runEnd = mRuns[i].mStart + mRuns[i].mCount;
+         if ( runEnd - bufStart <= maxVerts )
+         {
+            bufEnd = runEnd;
+            continue;
+         }
+
+         const U32 from = getMax( mRuns[i].mStart, bufStart );
+         const U32 perPrim = mRuns[i].mPrimType == GFXLineList ? 2 : 6;
+         bufEnd = from + ( bufStart + maxVerts - from ) / perPrim * perPrim;
+         break;
+      }
+
+      GFXVertexBufferHandle<GFXVertexPCT> verts( mDevice, bufEnd - bufStart, GFXBufferTypeVolatile );
+      verts.lock();
+      dMemcpy( verts.getPointer(), &mVerts[bufStart], ( bufEnd - bufStart ) * sizeof( GFXVertexPCT ) );
+      verts.unlock();
+
+      mDevice->setVertexBuffer( verts );
+
+      while ( pos < bufEnd )
+      {
+         const Run &current = mRuns[run];
+         const U32 runEnd = current.mStart + current.mCount;
+         const U32 drawEnd = getMin( runEnd, bufEnd );
+
+         mDevice->setStateBlock( current.mStateBlock );
+         if ( current.mTexture.isValid() )
+            mDevice->setTexture( 0, current.mTexture );
+         mDevice->setupGenericShaders( current.mShader );
+
+         const U32 numVerts = drawEnd - pos;
+         mDevice->drawPrimitive( current.mPrimType, pos - bufStart, current.mPrimType == GFXLineList ? numVerts / 2 : numVerts / 3 );
+         mNumDrawCalls++;
+
+         pos = drawEnd;
+         if ( pos == runEnd )
+            run++;
+      }
+   }
+
+   mVerts.clear();
+   mRuns.clear();
+   mBounds.set( 0, 0, 0, 0 );
+   mFlushing = false;
+}
@@ -0,0 +1,160 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _GFXDRAWLIST2D_H_
+#define _GFXDRAWLIST2D_H_
+
+#ifndef _GFXDEVICE_H_
+#include "gfx/gfxDevice.h"
+#endif
+#ifndef _GFXVERTEXTYPES_H_
+#include "gfx/gfxVertexTypes.h"
+#endif
+
+
+/// Collects the screen space quads and lines GFXDrawUtil and the font
+/// renderer would otherwise submit one draw call at a time, and submits
+/// them in as few draw calls as possible.
+///
+/// Commands are kept in the order they were added.  A command that uses
+/// the same primitive type, texture, state block and generic shader as the
+/// one before it is appended to the same run, and every run becomes one
+/// draw call when the list is flushed.
+///
+/// Each command is clipped on the CPU against the clip rect that was set
+/// when it was added, so commands from controls with different clip rects
+/// still end up in the same run.  That only works while the device is set
+/// up for plain 2D drawing, as it is after GFXDevice::setClipRect(); see
+/// canRecord().
+///
+/// Anything else that is about to use the device flushes the list first
+/// through GFXDevice::flushDrawList(), so mixing batched and immediate
+/// drawing keeps the order things were drawn in.
+class GFXDrawList2D
+{
+public:
+
+   GFXDrawList2D( GFXDevice *device );
+   ~GFXDrawList2D();
+
+   /// Start collecting commands.  Until end() is called, GFXDrawUtil adds
+   /// whatever it can to this list rather than drawing it.
+   void begin();
+
+   /// Flush the list and stop collecting.
+   void end();
+
+   /// Returns true between begin() and end().
+   bool isActive() const { return mActive; }
+
+   /// Returns true if commands can be added right now; the list has to be
+   /// active and the device in the screen space state set up by setClipRect().
+   bool canRecord();
+
+   /// Add a textured or untextured axis aligned quad.
+   ///
+   /// @param texture      Texture to draw with, or NULL for a plain color.
+   /// @param stateBlock   State block to draw with.
+   /// @param shader       Generic shader to draw with.
+   /// @param rect         Screen space position of the quad.
+   /// @param texRect      Texture coordinates at the upper left and lower
+   ///                     right corners of @a rect.  May be flipped.
+   /// @param color        Vertex color.
+   void addQuad(  GFXTextureObject *texture,
+                  GFXStateBlock *stateBlock,
+                  GFXDevice::GenericShaderType shader,
+                  const RectF &rect,
+                  const RectF &texRect,
+                  const GFXVertexColor &color );
+
+   /// Add a plain colored line.
+   void addLine( const Point2F &start, const Point2F &end, const GFXVertexColor &color, GFXStateBlock *stateBlock );
+
+   /// Submit everything collected so far.  Matrices and the viewport are
+   /// restored afterwards; the other device state is left as the last
+   /// command would have left it.
+   void flush();
+
+   /// @name Statistics
+   /// Counters for the last frame, ie. the last begin() / end() pair.
+   /// @{
+
+   /// Number of commands added.
+   U32 getNumCommands() const { return mLastNumCommands; }
+
+   /// Number of draw calls the commands were submitted with.
+   U32 getNumDrawCalls() const { return mLastNumDrawCalls; }
+
+   /// @}
+
+   /// If false, nothing is ever batched.  Exposed as $GFX::batch2D.
+   static bool smEnabled;
+
+   static void consoleInit();
+
+protected:
+
+   /// Commands that can be drawn with one draw call.
+   struct Run
+   {
+      GFXPrimitiveType mPrimType;
+      GFXTexHandle mTexture;
+      GFXStateBlockRef mStateBlock;
+      GFXDevice::GenericShaderType mShader;
+
+      /// Range of mVerts the run draws.
+      U32 mStart;
+      U32 mCount;
+   };
+
+   /// Return the run a new command with the given attributes goes into,
+   /// which is the last one if it matches and a new one otherwise.
+   Run& _getRun(  GFXPrimitiveType primType,
+                  GFXTextureObject *texture,
+                  GFXStateBlock *stateBlock,
+                  GFXDevice::GenericShaderType shader );
+
+   /// Grow the drawn area by the clip rect of a command just added and let
+   /// the device know there is something to flush.
+   void _markPending( const RectI &clip );
+
+   GFXDevice *mDevice;
+
+   bool mActive;
+
+   /// Set while flushing so that the device calls we make don't flush us.
+   bool mFlushing;
+
+   Vector<GFXVertexPCT> mVerts;
+   Vector<Run> mRuns;
+
+   /// Union of the clip rects of all commands, which is the viewport
+   /// everything is drawn with.
+   RectI mBounds;
+
+   U32 mNumCommands;
+   U32 mNumDrawCalls;
+   U32 mLastNumCommands;
+   U32 mLastNumDrawCalls;
+};
+
+#endif // _GFXDRAWLIST2D_H_
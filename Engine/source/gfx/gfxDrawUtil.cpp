@@ -30,6 +30,7 @@
 #include "math/util/sphereMesh.h"
 #include "math/mathUtils.h"
 #include "gfx/gfxFontRenderBatcher.h"
+#include "gfx/gfxDrawList2D.h"
 #include "gfx/gfxTransformSaver.h"
 #include "gfx/gfxPrimitiveBuffer.h"
 #include "gfx/primBuilder.h"
@@ -44,6 +45,7 @@ GFXDrawUtil::GFXDrawUtil( GFXDevice * d)
    mBitmapModulation.set(0xFF, 0xFF, 0xFF, 0xFF);
    mTextAnchorColor.set(0xFF, 0xFF, 0xFF, 0xFF);
    mFontRenderBatcher = new FontRenderBatcher();
+   mDrawList = new GFXDrawList2D(d);
 
    _setupStateBlocks();
 }
@@ -51,6 +53,7 @@ GFXDrawUtil::GFXDrawUtil( GFXDevice * d)
 GFXDrawUtil::~GFXDrawUtil()
 {
    delete mFontRenderBatcher;
+   delete mDrawList;
 }
 
 void GFXDrawUtil::_setupStateBlocks()
@@ -98,24 +101,33 @@ void GFXDrawUtil::_setupStateBlocks()
    {
       Con::errorf("GFXDrawUtil - could not find Rounded Rectangle shader");
    }
-   // Create ShaderConstBuffer and Handles
-   mRoundRectangleShaderConsts = mRoundRectangleShader->allocConstBuffer();
+   else
+   {
+      // Create ShaderConstBuffer and Handles
+      mRoundRectangleShaderConsts = mRoundRectangleShader->allocConstBuffer();
+   }
 
    mCircleShader = Sim::findObject("CircularGUI", shaderData) ? shaderData->getShader() : NULL;
    if (!mCircleShader)
    {
       Con::errorf("GFXDrawUtil - could not find circle shader");
    }
-   // Create ShaderConstBuffer and Handles
-   mCircleShaderConsts = mCircleShader->allocConstBuffer();
+   else
+   {
+      // Create ShaderConstBuffer and Handles
+      mCircleShaderConsts = mCircleShader->allocConstBuffer();
+   }
 
    mThickLineShader = Sim::findObject("ThickLineGUI", shaderData) ? shaderData->getShader() : NULL;
    if (!mThickLineShader)
    {
       Con::errorf("GFXDrawUtil - could not find Thick line shader");
    }
-   // Create ShaderConstBuffer and Handles
-   mThickLineShaderConsts = mThickLineShader->allocConstBuffer();
+   else
+   {
+      // Create ShaderConstBuffer and Handles
+      mThickLineShaderConsts = mThickLineShader->allocConstBuffer();
+   }
 
 }
 
@@ -383,8 +395,20 @@ void GFXDrawUtil::drawBitmapStretchSR( GFXTextureObject* texture, const RectF &d
    if(!texture)
       return;
 
-   GFXVertexBufferHandle<GFXVertexPCT> verts(mDevice, 4, GFXBufferTypeVolatile );
-   verts.lock();
+   GFXStateBlock *stateBlock;
+   switch (filter)
+   {
+   case GFXTextureFilterPoint :
+      stateBlock = in_wrap ? mBitmapStretchWrapSB : mBitmapStretchSB;
+      break;
+   case GFXTextureFilterLinear :
+      stateBlock = in_wrap ? mBitmapStretchWrapLinearSB : mBitmapStretchLinearSB;
+      break;
+   default:
+      AssertFatal(false, "No GFXDrawUtil state block defined for this filter type!");
+      stateBlock = mBitmapStretchSB;
+      break;
+   }
 
    F32 texLeft   = (srcRect.point.x)                    / (texture->mTextureSize.x);
    F32 texRight  = (srcRect.point.x + srcRect.extent.x) / (texture->mTextureSize.x);
@@ -410,6 +434,19 @@ void GFXDrawUtil::drawBitmapStretchSR( GFXTextureObject* texture, const RectF &d
    }
 
    const F32 fillConv = mDevice->getFillConventionOffset();
+
+   if ( angle == 0.0f && mDrawList->canRecord() )
+   {
+      mDrawList->addQuad(  texture, stateBlock, GFXDevice::GSModColorTexture,
+                           RectF( screenLeft - fillConv, screenTop - fillConv, dstRect.extent.x, dstRect.extent.y ),
+                           RectF( texLeft, texTop, texRight - texLeft, texBottom - texTop ),
+                           mBitmapModulation );
+      return;
+   }
+
+   GFXVertexBufferHandle<GFXVertexPCT> verts(mDevice, 4, GFXBufferTypeVolatile );
+   verts.lock();
+
    verts[0].point.set( screenLeft  - fillConv, screenTop    - fillConv, 0.f );
    verts[1].point.set( screenRight - fillConv, screenTop    - fillConv, 0.f );
    verts[2].point.set( screenLeft  - fillConv, screenBottom - fillConv, 0.f );
@@ -449,20 +486,7 @@ void GFXDrawUtil::drawBitmapStretchSR( GFXTextureObject* texture, const RectF &d
    verts.unlock();
 
    mDevice->setVertexBuffer( verts );
-
-   switch (filter)
-   {
-   case GFXTextureFilterPoint :
-      mDevice->setStateBlock(in_wrap ? mBitmapStretchWrapSB : mBitmapStretchSB);
-      break;
-   case GFXTextureFilterLinear :
-      mDevice->setStateBlock(in_wrap ? mBitmapStretchWrapLinearSB : mBitmapStretchLinearSB);
-      break;
-   default:
-      AssertFatal(false, "No GFXDrawUtil state block defined for this filter type!");
-      mDevice->setStateBlock(mBitmapStretchSB);
-      break;
-   }
+   mDevice->setStateBlock( stateBlock );
    mDevice->setTexture( 0, texture );
    mDevice->setupGenericShaders( GFXDevice::GSModColorTexture );
 
@@ -510,11 +534,38 @@ void GFXDrawUtil::drawRect( const Point2F &upperLeft, const Point2F &lowerRight,
    Point2F nw(-0.5f,-0.5f); /*  \  */
    Point2F ne(0.5f,-0.5f); /*  /  */
 
+   F32 ulOffset = 0.5f - mDevice->getFillConventionOffset();
+
+   if ( mDrawList->canRecord() )
+   {
+      // The same outline as four quads; v0-v4 is the outer edge
+      // and v1-v5 the inner one.
+      const RectF noTex( 0.0f, 0.0f, 0.0f, 0.0f );
+      const F32 outerL = upperLeft.x + ulOffset + nw.x;
+      const F32 outerT = upperLeft.y + ulOffset + nw.y;
+      const F32 outerR = lowerRight.x + ulOffset - nw.x;
+      const F32 outerB = lowerRight.y + ulOffset - nw.y;
+      const F32 innerL = upperLeft.x + ulOffset - nw.x;
+      const F32 innerT = upperLeft.y + ulOffset - nw.y;
+      const F32 innerR = lowerRight.x + ulOffset + nw.x;
+      const F32 innerB = lowerRight.y + ulOffset + nw.y;
+
+      if ( innerR <= innerL || innerB <= innerT )
+      {
+         mDrawList->addQuad( NULL, mRectFillSB, GFXDevice::GSColor, RectF( outerL, outerT, outerR - outerL, outerB - outerT ), noTex, color );
+         return;
+      }
+
+      mDrawList->addQuad( NULL, mRectFillSB, GFXDevice::GSColor, RectF( outerL, outerT, outerR - outerL, innerT - outerT ), noTex, color );
+      mDrawList->addQuad( NULL, mRectFillSB, GFXDevice::GSColor, RectF( outerL, innerB, outerR - outerL, outerB - innerB ), noTex, color );
+      mDrawList->addQuad( NULL, mRectFillSB, GFXDevice::GSColor, RectF( outerL, innerT, innerL - outerL, innerB - innerT ), noTex, color );
+      mDrawList->addQuad( NULL, mRectFillSB, GFXDevice::GSColor, RectF( innerR, innerT, outerR - innerR, innerB - innerT ), noTex, color );
+      return;
+   }
+
    GFXVertexBufferHandle<GFXVertexPCT> verts (mDevice, 10, GFXBufferTypeVolatile );
    verts.lock();
 
-   F32 ulOffset = 0.5f - mDevice->getFillConventionOffset();
-
    verts[0].point.set( upperLeft.x + ulOffset + nw.x, upperLeft.y + ulOffset + nw.y, 0.0f );
    verts[1].point.set( upperLeft.x + ulOffset - nw.x, upperLeft.y + ulOffset - nw.y, 0.0f );
    verts[2].point.set( lowerRight.x + ulOffset + ne.x, upperLeft.y + ulOffset + ne.y, 0.0f);
@@ -583,11 +634,25 @@ void GFXDrawUtil::drawRoundedRect(const F32& cornerRadius,
    Point2F nw(-0.5, -0.5); /*  \  */
    Point2F ne(0.5, -0.5); /*  /  */
 
+   F32 ulOffset = 0.5f - mDevice->getFillConventionOffset();
+
+   Point2F topLeftCorner(upperLeft.x + nw.x + ulOffset, upperLeft.y + nw.y + ulOffset);
+   Point2F bottomRightCorner(lowerRight.x - nw.x + ulOffset, lowerRight.y - nw.y + ulOffset);
+
+   // Without corners or a border this is a plain quad and doesn't need the
+   // rounded rectangle shader, so it can go in the draw list.
+   if (cornerRadius <= 0.0f && borderSize <= 0.0f && mDrawList->canRecord())
+   {
+      mDrawList->addQuad(NULL, mRectFillSB, GFXDevice::GSColor,
+                         RectF(topLeftCorner, bottomRightCorner - topLeftCorner),
+                         RectF(0.0f, 0.0f, 0.0f, 0.0f),
+                         color);
+      return;
+   }
+
    GFXVertexBufferHandle<GFXVertexPCT> verts(mDevice, 4, GFXBufferTypeVolatile);
    verts.lock();
 
-   F32 ulOffset = 0.5f - mDevice->getFillConventionOffset();
-
    verts[0].point.set(upperLeft.x + nw.x + ulOffset, upperLeft.y + nw.y + ulOffset, 0.0f);
    verts[1].point.set(lowerRight.x + ne.x + ulOffset, upperLeft.y + ne.y + ulOffset, 0.0f);
    verts[2].point.set(upperLeft.x - ne.x + ulOffset, lowerRight.y - ne.y + ulOffset, 0.0f);
@@ -600,9 +665,6 @@ void GFXDrawUtil::drawRoundedRect(const F32& cornerRadius,
 
    mDevice->setStateBlock(mRectFillSB);
 
-   Point2F topLeftCorner(upperLeft.x + nw.x + ulOffset, upperLeft.y + nw.y + ulOffset);
-   Point2F bottomRightCorner(lowerRight.x - nw.x + ulOffset, lowerRight.y - nw.y + ulOffset);
-
    /*mDevice->setupGenericShaders();*/
    GFX->setShader(mRoundRectangleShader);
    GFX->setShaderConstBuffer(mRoundRectangleShaderConsts);
@@ -767,6 +829,12 @@ void GFXDrawUtil::drawLine( F32 x1, F32 y1, F32 x2, F32 y2, const ColorI &color
 
 void GFXDrawUtil::drawLine( F32 x1, F32 y1, F32 z1, F32 x2, F32 y2, F32 z2, const ColorI &color )
 {
+   if ( z1 == 0.0f && z2 == 0.0f && mDrawList->canRecord() )
+   {
+      mDrawList->addLine( Point2F( x1, y1 ), Point2F( x2, y2 ), color, mRectFillSB );
+      return;
+   }
+
    GFXVertexBufferHandle<GFXVertexPCT> verts( mDevice, 2, GFXBufferTypeVolatile );
    verts.lock();
 
@@ -32,6 +32,7 @@
 #endif
 
 class FontRenderBatcher;
+class GFXDrawList2D;
 class Frustum;
 
 
@@ -165,6 +166,10 @@ public:
    /// If colors is NULL the default colors are RED, GREEEN, BLUE ( x, y, z ).
    void drawTransform( const GFXStateBlockDesc &desc, const MatrixF &mat, const Point3F *scale = NULL, const ColorI colors[3] = NULL );
 
+   /// Returns the list screen space rects, bitmaps, lines and text are
+   /// collected in between GFXDrawList2D::begin() and end().
+   GFXDrawList2D* getDrawList() const { return mDrawList; }
+
 protected:
 
    void _setupStateBlocks();
@@ -198,6 +203,8 @@ protected:
 
    FontRenderBatcher* mFontRenderBatcher;
 
+   GFXDrawList2D* mDrawList;
+
    // Expanded shaders
    // rounded rectangle.
    GFXShaderRef mRoundRectangleShader;
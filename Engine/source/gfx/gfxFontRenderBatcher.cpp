@@ -22,6 +22,8 @@
 
 #include "gfx/gfxFontRenderBatcher.h"
 #include "gfx/gFont.h"
+#include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxDrawList2D.h"
 
 FontRenderBatcher::FontRenderBatcher() : mStorage(8096)
 {
@@ -55,6 +57,39 @@ void FontRenderBatcher::render( F32 rot, const Point2F &offset )
    if( mLength == 0 )
       return;
 
+   // Unrotated text can go in the draw list with everything else.
+   GFXDrawList2D *drawList = GFX->getDrawUtil()->getDrawList();
+   if( rot == 0.f && drawList->canRecord() )
+   {
+      const F32 fillConventionOffset = GFX->getFillConventionOffset();
+
+      for( S32 i = 0; i < mSheets.size(); i++ )
+      {
+         if( !mSheets[i] || !mSheets[i]->numChars )
+            continue;
+
+         GFXTextureObject *tex = mFont->getTextureHandle(i);
+         const F32 texWidth = (F32)tex->getWidth();
+         const F32 texHeight = (F32)tex->getHeight();
+
+         for( S32 j = 0; j < mSheets[i]->numChars; j++ )
+         {
+            const CharMarker &m = mSheets[i]->charIndex[j];
+            const PlatformFont::CharInfo &ci = mFont->getCharInfo( m.c );
+
+            const F32 drawY = offset.y + mFont->getBaseline() - ci.yOrigin * TEXT_MAG;
+            const F32 drawX = offset.x + m.x + ci.xOrigin;
+
+            drawList->addQuad(   tex, mFontSB, GFXDevice::GSAddColorTexture,
+                                 RectF( drawX - fillConventionOffset, drawY - fillConventionOffset, ci.width * TEXT_MAG, ci.height * TEXT_MAG ),
+                                 RectF( ci.xOffset / texWidth, ci.yOffset / texHeight, ci.width / texWidth, ci.height / texHeight ),
+                                 m.color );
+         }
+      }
+
+      return;
+   }
+
    GFX->setStateBlock(mFontSB);
    for(U32 i = 0; i < GFX->getNumSamplers(); i++)
       GFX->setTexture(i, NULL);
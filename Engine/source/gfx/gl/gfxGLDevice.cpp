@@ -577,6 +577,8 @@ void GFXGLDevice::copyResource(GFXTextureObject* pDst, GFXCubemap* pSrc, const U
 
 void GFXGLDevice::clear(U32 flags, const LinearColorF& color, F32 z, U32 stencil)
 {
+   flushDrawList();
+
    // Make sure we have flushed our render target state.
    _updateRenderTargets();
 
@@ -618,6 +620,8 @@ void GFXGLDevice::clear(U32 flags, const LinearColorF& color, F32 z, U32 stencil
 
 void GFXGLDevice::clearColorAttachment(const U32 attachment, const LinearColorF& color)
 {
+   flushDrawList();
+
    const GLfloat clearColor[4] = { color.red, color.green, color.blue, color.alpha };
    glClearBufferfv(GL_COLOR, attachment, clearColor);
 }
@@ -902,6 +906,8 @@ void GFXGLDevice::setupGenericShaders( GenericShaderType type )
 {
    AssertFatal(type != GSTargetRestore, "");
 
+   flushDrawList();
+
    if( mGenericShader[GSColor] == NULL )
    {
       ShaderData *shaderData;
@@ -965,6 +971,8 @@ GFXShader* GFXGLDevice::createShader()
 
 void GFXGLDevice::setShader(GFXShader *shader, bool force)
 {
+   flushDrawList();
+
    if(mCurrentShader == shader && !force)
       return;
 
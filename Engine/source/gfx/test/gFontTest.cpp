@@ -0,0 +1,56 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "platform/threads/threadPool.h"
+#include "gfx/gFont.h"
+#include "console/console.h"
+
+TEST(GFont, PreloadUnreferencedFont)
+{
+   Resource<GFont> font = GFont::create( "Arial", 14, Con::getVariable( "$GUI::fontCacheDirectory" ) );
+   if ( font == NULL || !font->hasPlatformFont() )
+      GTEST_SKIP() << "No platform font to rasterize with";
+
+   GFont *fontPtr = font;
+
+   // The raster job must be the only thing keeping the font loaded.
+   GFont::queueRasterRange( font, 0x20, 0x17f );
+   font = NULL;
+
+   ThreadPool::GLOBAL().waitForAllItems();
+
+   // The glyphs wait for the main thread and the font is still around.
+   EXPECT_TRUE( fontPtr->isRasterPending() );
+
+   Resource<GFont> again = GFont::create( "Arial", 14, Con::getVariable( "$GUI::fontCacheDirectory" ) );
+   EXPECT_EQ( (GFont*)again, fontPtr ) << "The font was unloaded while it was rasterizing";
+
+   ThreadPool::processMainThreadWorkItems();
+
+   EXPECT_FALSE( fontPtr->isRasterPending() ) << "The glyphs should have been added";
+   EXPECT_TRUE( fontPtr->isValidChar( 'A' ) );
+}
+
+#endif
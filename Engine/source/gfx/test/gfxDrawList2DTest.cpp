@@ -0,0 +1,174 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxDrawList2D.h"
+
+// These run on the null device the test runner creates, which counts draw
+// calls but doesn't draw anything.
+
+class GFXDrawList2DTest : public ::testing::Test
+{
+protected:
+   GFXDrawUtil *mDrawUtil;
+   GFXDrawList2D *mDrawList;
+   U32 mStartDrawCalls;
+
+   void SetUp() override
+   {
+      mDrawUtil = GFX->getDrawUtil();
+      mDrawList = mDrawUtil->getDrawList();
+      GFXDrawList2D::smEnabled = true;
+      GFX->setClipRect( RectI( 0, 0, 800, 600 ) );
+      mStartDrawCalls = GFX->getDeviceStatistics()->mDrawCalls;
+   }
+
+   void TearDown() override
+   {
+      if ( mDrawList->isActive() )
+         mDrawList->end();
+      GFXDrawList2D::smEnabled = true;
+   }
+
+   U32 drawCalls() const { return GFX->getDeviceStatistics()->mDrawCalls - mStartDrawCalls; }
+
+   void drawControls( U32 count )
+   {
+      for ( U32 i = 0; i < count; i++ )
+      {
+         mDrawUtil->drawRect( RectI( i, i, 20, 20 ), ColorI::WHITE );
+         mDrawUtil->drawLine( Point2I( i, 0 ), Point2I( i, 100 ), ColorI::BLACK );
+      }
+   }
+};
+
+TEST_F(GFXDrawList2DTest, Immediate)
+{
+   drawControls( 100 );
+   EXPECT_EQ( drawCalls(), 200 )
+      << "Outside begin() / end() every call should draw right away";
+}
+
+TEST_F(GFXDrawList2DTest, Disabled)
+{
+   GFXDrawList2D::smEnabled = false;
+
+   mDrawList->begin();
+   drawControls( 100 );
+   mDrawList->end();
+
+   EXPECT_EQ( drawCalls(), 200 );
+   EXPECT_EQ( mDrawList->getNumCommands(), 0 );
+}
+
+TEST_F(GFXDrawList2DTest, Batched)
+{
+   // The rects and lines alternate, so they can't share a run.
+   mDrawList->begin();
+   drawControls( 100 );
+   EXPECT_EQ( drawCalls(), 0 ) << "Nothing should be drawn before the list is flushed";
+   mDrawList->end();
+
+   EXPECT_EQ( drawCalls(), 200 );
+   EXPECT_EQ( mDrawList->getNumCommands(), 500 ) << "drawRect() should add one quad per side";
+
+   // Now all the rects, then all the lines.
+   mStartDrawCalls = GFX->getDeviceStatistics()->mDrawCalls;
+   mDrawList->begin();
+   for ( U32 i = 0; i < 100; i++ )
+   {
+      mDrawUtil->drawRect( RectI( i, i, 20, 20 ), ColorI::WHITE );
+      mDrawUtil->drawRectFill( RectI( i, i, 20, 20 ), ColorI::BLACK );
+   }
+   for ( U32 i = 0; i < 100; i++ )
+      mDrawUtil->drawLine( Point2I( i, 0 ), Point2I( i, 100 ), ColorI::BLACK );
+   mDrawList->end();
+
+   EXPECT_EQ( drawCalls(), 2 );
+   EXPECT_EQ( mDrawList->getNumDrawCalls(), 2 );
+   EXPECT_EQ( mDrawList->getNumCommands(), 600 );
+}
+
+TEST_F(GFXDrawList2DTest, ClipRects)
+{
+   mDrawList->begin();
+
+   // Different clip rects don't break up a run...
+   GFX->setClipRect( RectI( 0, 0, 100, 100 ) );
+   mDrawUtil->drawRectFill( RectI( 10, 10, 20, 20 ), ColorI::WHITE );
+   GFX->setClipRect( RectI( 200, 200, 100, 100 ) );
+   mDrawUtil->drawRectFill( RectI( 210, 210, 20, 20 ), ColorI::WHITE );
+
+   // ...and anything outside the clip rect is dropped.
+   mDrawUtil->drawRectFill( RectI( 10, 10, 20, 20 ), ColorI::WHITE );
+   mDrawUtil->drawLine( Point2I( 0, 0 ), Point2I( 100, 100 ), ColorI::WHITE );
+
+   mDrawList->end();
+
+   EXPECT_EQ( drawCalls(), 1 );
+   EXPECT_EQ( mDrawList->getNumCommands(), 4 );
+}
+
+TEST_F(GFXDrawList2DTest, Ordering)
+{
+   mDrawList->begin();
+
+   mDrawUtil->drawRectFill( RectI( 10, 10, 20, 20 ), ColorI::WHITE );
+   mDrawUtil->drawRectFill( RectI( 40, 10, 20, 20 ), ColorI::WHITE );
+
+   // A line with depth can't be batched, so the rects have to be drawn
+   // before it.
+   mDrawUtil->drawLine( 0.0f, 0.0f, 1.0f, 100.0f, 100.0f, 1.0f, ColorI::WHITE );
+   EXPECT_EQ( drawCalls(), 2 );
+
+   mDrawUtil->drawRectFill( RectI( 70, 10, 20, 20 ), ColorI::WHITE );
+   mDrawList->end();
+
+   EXPECT_EQ( drawCalls(), 3 );
+   EXPECT_EQ( mDrawList->getNumDrawCalls(), 2 );
+}
+
+TEST_F(GFXDrawList2DTest, RestoresTransforms)
+{
+   GFX->setClipRect( RectI( 10, 20, 300, 200 ) );
+   const MatrixF proj = GFX->getProjectionMatrix();
+   const RectI viewport = GFX->getViewport();
+
+   mDrawList->begin();
+   mDrawUtil->drawRectFill( RectI( 10, 20, 20, 20 ), ColorI::WHITE );
+   GFX->setClipRect( RectI( 400, 300, 100, 100 ) );
+   mDrawUtil->drawRectFill( RectI( 410, 310, 20, 20 ), ColorI::WHITE );
+   GFX->setClipRect( RectI( 10, 20, 300, 200 ) );
+   mDrawList->end();
+
+   for ( U32 i = 0; i < 16; i++ )
+      EXPECT_EQ( GFX->getProjectionMatrix()[i], proj[i] );
+   EXPECT_TRUE( GFX->getViewport() == viewport );
+   EXPECT_TRUE( GFX->getWorldMatrix().isIdentity() );
+   EXPECT_TRUE( GFX->getViewMatrix().isIdentity() );
+}
+
+#endif
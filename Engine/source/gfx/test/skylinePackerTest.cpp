@@ -0,0 +1,135 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "gfx/util/skylinePacker.h"
+#include "core/stream/memStream.h"
+#include "math/mRect.h"
+
+using namespace GFXUtil;
+
+TEST(SkylinePacker, Fill)
+{
+   SkylinePacker packer( 64, 64 );
+   Point2I pos;
+
+   for ( U32 i = 0; i < 16; i++ )
+      EXPECT_TRUE( packer.pack( 16, 16, &pos ) );
+
+   EXPECT_FALSE( packer.pack( 16, 16, &pos ) ) << "There should be no room left";
+   EXPECT_FALSE( packer.pack( 65, 1, &pos ) );
+   EXPECT_EQ( packer.getOccupancy(), 1.0f );
+   EXPECT_EQ( packer.getNumSegments(), 1 );
+}
+
+TEST(SkylinePacker, BottomLeft)
+{
+   SkylinePacker packer( 64, 64 );
+   Point2I pos;
+
+   packer.pack( 40, 10, &pos );
+   EXPECT_EQ( pos, Point2I( 0, 0 ) );
+
+   packer.pack( 20, 30, &pos );
+   EXPECT_EQ( pos, Point2I( 40, 0 ) );
+
+   // Goes on top of the first one, not next to the tall one.
+   packer.pack( 40, 10, &pos );
+   EXPECT_EQ( pos, Point2I( 0, 10 ) );
+
+   // Fits in the last 4 columns.
+   packer.pack( 4, 40, &pos );
+   EXPECT_EQ( pos, Point2I( 60, 0 ) );
+}
+
+TEST(SkylinePacker, NoOverlap)
+{
+   SkylinePacker packer( 256, 256 );
+   Vector<RectI> rects;
+
+   // Glyph-like sizes from a fixed sequence.
+   U32 seed = 1376312589;
+   for ( U32 i = 0; i < 1000; i++ )
+   {
+      seed = seed * 1664525 + 1013904223;
+      const U32 width = 2 + ( seed >> 16 ) % 14;
+      const U32 height = 8 + ( seed >> 8 ) % 10;
+
+      Point2I pos;
+      if ( !packer.pack( width, height, &pos ) )
+         continue;
+
+      const RectI rect( pos, Point2I( width, height ) );
+      ASSERT_TRUE( RectI( 0, 0, 256, 256 ).contains( rect ) );
+
+      for ( U32 j = 0; j < rects.size(); j++ )
+         ASSERT_FALSE( rects[j].overlaps( rect ) ) << "Rect " << i << " overlaps rect " << j;
+
+      rects.push_back( rect );
+   }
+
+   EXPECT_GT( packer.getOccupancy(), 0.8f );
+}
+
+TEST(SkylinePacker, Serialization)
+{
+   SkylinePacker packer( 128, 128 );
+   Point2I pos;
+   packer.pack( 10, 20, &pos );
+   packer.pack( 30, 10, &pos );
+   packer.pack( 5, 5, &pos );
+
+   MemStream stream( 1024 );
+   ASSERT_TRUE( packer.write( stream ) );
+   stream.setPosition( 0 );
+
+   SkylinePacker copy;
+   ASSERT_TRUE( copy.read( stream ) );
+   EXPECT_EQ( copy.getWidth(), 128 );
+   EXPECT_EQ( copy.getHeight(), 128 );
+   EXPECT_EQ( copy.getUsedArea(), packer.getUsedArea() );
+
+   // Both should carry on the same way.
+   for ( U32 i = 0; i < 20; i++ )
+   {
+      Point2I a, b;
+      EXPECT_EQ( packer.pack( 7 + i, 9, &a ), copy.pack( 7 + i, 9, &b ) );
+      EXPECT_EQ( a, b );
+   }
+}
+
+TEST(SkylinePacker, SetFromRow)
+{
+   SkylinePacker packer( 64, 64 );
+   packer.setFromRow( 20, 32, 16 );
+
+   Point2I pos;
+   packer.pack( 10, 16, &pos );
+   EXPECT_EQ( pos, Point2I( 20, 32 ) ) << "Should carry on along the row";
+
+   packer.pack( 40, 16, &pos );
+   EXPECT_EQ( pos, Point2I( 0, 48 ) );
+}
+
+#endif
@@ -0,0 +1,250 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gfx/util/skylinePacker.h"
+
+#include "core/stream/stream.h"
+
+
+namespace GFXUtil
+{
+
+SkylinePacker::SkylinePacker()
+   : mWidth( 0 ),
+     mHeight( 0 ),
+     mUsedArea( 0 )
+{
+   VECTOR_SET_ASSOCIATION( mSkyline );
+}
+
+SkylinePacker::SkylinePacker( U32 width, U32 height )
+{
+   VECTOR_SET_ASSOCIATION( mSkyline );
+   reset( width, height );
+}
+
+void SkylinePacker::reset( U32 width, U32 height )
+{
+   mWidth = width;
+   mHeight = height;
+   mUsedArea = 0;
+
+   mSkyline.setSize( 1 );
+   mSkyline[0].x = 0;
+   mSkyline[0].y = 0;
+   mSkyline[0].width = width;
+}
+
+bool SkylinePacker::pack( U32 width, U32 height, Point2I *outPos )
+{
+   if ( width == 0 || height == 0 )
+   {
+      outPos->set( 0, 0 );
+      return true;
+   }
+
+   S32 bestIndex = -1;
+   S32 bestY = 0;
+   S32 bestBottom = S32_MAX;
+   S32 bestWidth = S32_MAX;
+
+   for ( U32 i = 0; i < mSkyline.size(); i++ )
+   {
+      const S32 y = _fit( i, width, height );
+      if ( y < 0 )
+         continue;
+
+      const S32 bottom = y + height;
+      if (  bottom < bestBottom ||
+            ( bottom == bestBottom && mSkyline[i].width < bestWidth ) )
+      {
+         bestIndex = i;
+         bestY = y;
+         bestBottom = bottom;
+         bestWidth = mSkyline[i].width;
+      }
+   }
+
+   if ( bestIndex == -1 )
+      return false;
+
+   outPos->set( mSkyline[bestIndex].x, bestY );
+   _addLevel( bestIndex, width, bestBottom );
+
+   mUsedArea += width * height;
+   return true;
+}
+
+S32 SkylinePacker::_fit( U32 index, S32 width, S32 height ) const
+{
+   if ( mSkyline[index].x + width > S32( mWidth ) )
+      return -1;
+
+   // The rectangle has to sit on the highest segment it spans.
+   S32 y = 0;
+   S32 widthLeft = width;
+   for ( U32 i = index; widthLeft > 0; i++ )
+   {
+      y = getMax( y, mSkyline[i].y );
+      if ( y + height > S32( mHeight ) )
+         return -1;
+
+      widthLeft -= mSkyline[i].width;
+   }
+
+   return y;
+}
+
+void SkylinePacker::_addLevel( U32 index, S32 width, S32 top )
+{
+   Segment level;
+   level.x = mSkyline[index].x;
+   level.y = top;
+   level.width = width;
+   mSkyline.insert( index, level );
+
+   // Cut the segments the new one covers.
+   const S32 levelRight = level.x + level.width;
+   for ( U32 i = index + 1; i < mSkyline.size(); )
+   {
+      Segment &seg = mSkyline[i];
+      if ( seg.x >= levelRight )
+         break;
+
+      const S32 shrink = levelRight - seg.x;
+      seg.x += shrink;
+      seg.width -= shrink;
+
+      if ( seg.width > 0 )
+         break;
+
+      mSkyline.erase( i );
+   }
+
+   // Merge neighbours at the same height.
+   for ( U32 i = 0; i + 1 < mSkyline.size(); )
+   {
+      if ( mSkyline[i].y == mSkyline[i + 1].y )
+      {
+         mSkyline[i].width += mSkyline[i + 1].width;
+         mSkyline.erase( i + 1 );
+      }
+      else
+         i++;
+   }
+}
+
+void SkylinePacker::setFromRow( U32 rowX, U32 rowY, U32 rowHeight )
+{
+   reset( mWidth, mHeight );
+
+   rowX = getMin( rowX, mWidth );
+   rowY = getMin( rowY, mHeight );
+   const U32 rowBottom = getMin( rowY + rowHeight, mHeight );
+
+   if ( rowX == 0 )
+      mSkyline[0].y = rowY;
+   else
+   {
+      mSkyline[0].y = rowBottom;
+      mSkyline[0].width = rowX;
+
+      if ( rowX < mWidth )
+      {
+         Segment rest;
+         rest.x = rowX;
+         rest.y = rowY;
+         rest.width = mWidth - rowX;
+         mSkyline.push_back( rest );
+      }
+   }
+
+   mUsedArea = rowY * mWidth + rowX * ( rowBottom - rowY );
+}
+
+void SkylinePacker::close()
+{
+   mSkyline.setSize( 1 );
+   mSkyline[0].x = 0;
+   mSkyline[0].y = mHeight;
+   mSkyline[0].width = mWidth;
+}
+
+F32 SkylinePacker::getOccupancy() const
+{
+   if ( mWidth == 0 || mHeight == 0 )
+      return 0.0f;
+
+   return F32( mUsedArea ) / F32( mWidth * mHeight );
+}
+
+bool SkylinePacker::read( Stream &stream )
+{
+   U32 numSegments = 0;
+   stream.read( &mWidth );
+   stream.read( &mHeight );
+   stream.read( &mUsedArea );
+   stream.read( &numSegments );
+
+   if ( stream.getStatus() != Stream::Ok || numSegments == 0 || numSegments > mWidth )
+      return false;
+
+   mSkyline.setSize( numSegments );
+
+   // The segments have to cover the width without gaps, or _fit() would
+   // run off the end.
+   S32 x = 0;
+   for ( U32 i = 0; i < numSegments; i++ )
+   {
+      Segment &seg = mSkyline[i];
+      stream.read( &seg.x );
+      stream.read( &seg.y );
+      stream.read( &seg.width );
+
+      if ( seg.x != x || seg.width <= 0 || seg.y < 0 || seg.y > S32( mHeight ) )
+         return false;
+
+      x += seg.width;
+   }
+
+   return x == S32( mWidth ) && stream.getStatus() == Stream::Ok;
+}
+
+bool SkylinePacker::write( Stream &stream ) const
+{
+   stream.write( mWidth );
+   stream.write( mHeight );
+   stream.write( mUsedArea );
+   stream.write( U32( mSkyline.size() ) );
+
+   for ( U32 i = 0; i < mSkyline.size(); i++ )
+   {
+      stream.write( mSkyline[i].x );
+      stream.write( mSkyline[i].y );
+      stream.write( mSkyline[i].width );
+   }
+
+   return stream.getStatus() == Stream::Ok;
+}
+
+} // namespace GFXUtil
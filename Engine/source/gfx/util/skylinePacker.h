@@ -0,0 +1,121 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _SKYLINE_PACKER_H_
+#define _SKYLINE_PACKER_H_
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+#ifndef _MPOINT2_H_
+#include "math/mPoint2.h"
+#endif
+
+class Stream;
+
+namespace GFXUtil
+{
+
+/// Packs rectangles into a fixed size area, as used for glyph and other
+/// texture atlases.
+///
+/// The packer only remembers the skyline, ie. the height of the highest
+/// rectangle in every column, as a list of horizontal segments.  A new
+/// rectangle goes where its bottom edge ends up lowest ("bottom left"),
+/// with ties going to the narrowest segment, which wastes a lot less space
+/// than packing rows of the tallest rectangle when sizes vary a lot, like
+/// latin and CJK glyphs in the same font.
+///
+/// Space below the skyline that ends up covered is never reused, so the
+/// packer works best when it is fed rectangles in roughly decreasing
+/// order of height, but it copes with any order.
+class SkylinePacker
+{
+public:
+
+   SkylinePacker();
+   SkylinePacker( U32 width, U32 height );
+
+   /// Empty the packer and set the size of the area to pack into.
+   void reset( U32 width, U32 height );
+
+   /// Find room for a rectangle of the given size.
+   ///
+   /// @param width   Width of the rectangle.
+   /// @param height  Height of the rectangle.
+   /// @param outPos  Set to the upper left corner of the rectangle.
+   ///
+   /// @return False if the rectangle doesn't fit anywhere, in which case
+   ///         nothing is changed.
+   bool pack( U32 width, U32 height, Point2I *outPos );
+
+   /// Set the skyline to what a row packer leaves behind after filling
+   /// everything above @a rowY and the row it is working on up to @a rowX.
+   /// Used to carry on packing an area filled by older code.
+   void setFromRow( U32 rowX, U32 rowY, U32 rowHeight );
+
+   /// Don't accept anything else.
+   void close();
+
+   U32 getWidth() const { return mWidth; }
+   U32 getHeight() const { return mHeight; }
+
+   /// Returns the area of all the rectangles packed so far.
+   U32 getUsedArea() const { return mUsedArea; }
+
+   /// Returns the fraction of the area that is used.
+   F32 getOccupancy() const;
+
+   /// Returns the number of segments in the skyline.
+   U32 getNumSegments() const { return mSkyline.size(); }
+
+   bool read( Stream &stream );
+   bool write( Stream &stream ) const;
+
+protected:
+
+   /// A horizontal segment of the skyline.
+   struct Segment
+   {
+      S32 x;
+      S32 y;
+      S32 width;
+   };
+
+   /// Returns the y a rectangle of the given size would be placed at if
+   /// its left edge was at the start of the segment, or -1 if it doesn't
+   /// fit there.
+   S32 _fit( U32 index, S32 width, S32 height ) const;
+
+   /// Raise the skyline over a rectangle placed at the start of a segment.
+   void _addLevel( U32 index, S32 width, S32 top );
+
+   Vector<Segment> mSkyline;
+
+   U32 mWidth;
+   U32 mHeight;
+   U32 mUsedArea;
+};
+
+} // namespace GFXUtil
+
+#endif // _SKYLINE_PACKER_H_
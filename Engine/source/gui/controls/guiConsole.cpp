@@ -69,6 +69,7 @@ GuiConsole::GuiConsole()
    mDisplayWarnings = true;
    mDisplayNormalMessages = true;
    mFiltersDirty = true;
+   mLogTrimCount = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -106,8 +107,9 @@ void GuiConsole::refreshLogText()
 
    Con::getLockLog(log, size);
 
-   if (mFilteredLog.size() != size || mFiltersDirty)
+   if (mFilteredLog.size() != size || mFiltersDirty || mLogTrimCount != Con::getLogTrimCount())
    {
+      mLogTrimCount = Con::getLogTrimCount();
       mFilteredLog.clear();
 
       U32 errorCount = 0;
@@ -44,6 +44,10 @@ class GuiConsole : public GuiArrayCtrl
       bool mDisplayNormalMessages;
       bool mFiltersDirty;
 
+      /// Con::getLogTrimCount() as of the last refresh.  If it changed, the
+      /// strings in mFilteredLog are gone and it must be rebuilt.
+      U32 mLogTrimCount;
+
       S32 getMaxWidth(S32 startIndex, S32 endIndex);
 
       Vector<ConsoleLogEntry> mFilteredLog;
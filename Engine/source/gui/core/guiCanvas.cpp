@@ -33,6 +33,7 @@
 #include "platform/profiler.h"
 #include "gfx/gfxDevice.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxDrawList2D.h"
 #include "gui/core/guiTypes.h"
 #include "gui/core/guiControl.h"
 #include "gui/editor/guiMenuBar.h"
@@ -1934,6 +1935,11 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
    buildUpdateUnion(&updateUnion);
    if (updateUnion.intersect(screenRect))
    {
+      // Collect what the controls draw and submit it in as few
+      // draw calls as we can once everything is drawn.
+      GFXDrawList2D *drawList = GFX->getDrawUtil()->getDrawList();
+      drawList->begin();
+
       // Render active GUI Dialogs
       for(iterator i = begin(); i != end(); i++)
       {
@@ -1943,7 +1949,7 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          GFX->setClipRect( updateUnion );
          GFX->setStateBlock(mDefaultGuiSB);
          
-         contentCtrl->onRender(contentCtrl->getPosition(), updateUnion);
+         contentCtrl->renderControl(contentCtrl->getPosition(), updateUnion);
       }
 
       // Fill Black if no Dialogs
@@ -2006,6 +2012,8 @@ void GuiCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = true */)
          pos -= spot;
          mouseCursor->render(pos);
       }
+
+      drawList->end();
    }
 
    // Render all RTT end of frame updates HERE
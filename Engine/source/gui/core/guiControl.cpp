@@ -39,6 +39,8 @@
 #include "gui/core/guiDefaultControlRender.h"
 #include "gui/editor/guiEditCtrl.h"
 #include "gfx/gfxDrawUtil.h"
+#include "gui/core/guiRenderLayer.h"
+#include "gfx/gfxTransformSaver.h"
 
 
 //#define DEBUG_SPEW
@@ -213,6 +215,8 @@ GuiControl::GuiControl() : mAddGroup( NULL ),
                            mIsContainer(false),
                            mCanResize(true),
                            mCanHit( true ),
+                           mRenderToLayer( false ),
+                           mRenderLayer( NULL ),
                            mLayer(0),
                            mMinExtent(8,2),
                            mLangTable(NULL),
@@ -237,6 +241,7 @@ GuiControl::GuiControl() : mAddGroup( NULL ),
 
 GuiControl::~GuiControl()
 {
+   SAFE_DELETE( mRenderLayer );
 }
 
 //-----------------------------------------------------------------------------
@@ -247,6 +252,11 @@ void GuiControl::consoleInit()
       "The control for which a command is currently being evaluated.  Only set during 'command' "
       "and altCommand callbacks to the control for which the command or altCommand is invoked.\n"
 	  "@ingroup GuiCore");
+
+   Con::addVariable( "$GUI::renderLayers", TypeBool, &GuiRenderLayer::smEnabled,
+      "If false, controls with renderToLayer set render directly every frame like all "
+      "other controls.\n"
+	  "@ingroup GuiCore");
 }
 
 //-----------------------------------------------------------------------------
@@ -297,6 +307,15 @@ void GuiControl::initPersistFields()
 
       addField("category", TypeString, Offset(mCategory, GuiControl),
          "Name of the category this gui control should be grouped into for organizational purposes. Primarily for tooling.");
+
+      addField("renderToLayer",     TypeBool,      Offset(mRenderToLayer, GuiControl),
+         "If true, the control and its children are rendered into an offscreen layer once and the "
+         "layer is drawn every frame after that.  The layer is redrawn whenever setUpdate() is "
+         "called on the control or one of its children, and when controls in it are moved, resized, "
+         "added or removed.\n\n"
+         "@note Only use this for controls that draw an opaque background and change rarely, like "
+         "static HUD elements and menus.  Controls that animate without calling setUpdate(), or "
+         "that render 3D views, will not show their changes." );
       
 
    endGroup( "Control" );	
@@ -564,6 +583,62 @@ bool GuiControl::defaultTooltipRender( const Point2I &hoverPos, const Point2I &c
 
 //-----------------------------------------------------------------------------
 
+void GuiControl::renderControl(Point2I offset, const RectI &updateRect)
+{
+   if ( !mRenderToLayer || !GuiRenderLayer::smEnabled || smDesignTime )
+   {
+      SAFE_DELETE( mRenderLayer );
+      onRender( offset, updateRect );
+      return;
+   }
+
+   if ( !mRenderLayer )
+      mRenderLayer = new GuiRenderLayer();
+
+   const Point2I extent = getExtent();
+   if ( mRenderLayer->isDirty( extent ) )
+   {
+      const RectI savedClipRect = GFX->getClipRect();
+      bool rendered = false;
+      {
+         GFXTransformSaver saver;
+         if ( mRenderLayer->begin( extent ) )
+         {
+            // Render the whole control at the origin of the layer, whatever
+            // part of it is visible right now.
+            GFX->setStateBlock( mDefaultGuiSB );
+            onRender( Point2I::Zero, RectI( Point2I::Zero, extent ) );
+            mRenderLayer->end();
+            rendered = true;
+         }
+      }
+      GFX->setClipRect( savedClipRect );
+      GFX->setStateBlock( mDefaultGuiSB );
+
+      // Couldn't get a target, so render this frame the usual way.
+      if ( !rendered )
+      {
+         onRender( offset, updateRect );
+         return;
+      }
+   }
+
+   mRenderLayer->draw( offset );
+}
+
+//-----------------------------------------------------------------------------
+
+void GuiControl::dirtyRenderLayers()
+{
+   for ( GuiControl *ctrl = this; ctrl; ctrl = ctrl->getParent() )
+   {
+      if ( ctrl->mRenderLayer )
+         ctrl->mRenderLayer->markDirty();
+   }
+}
+
+//-----------------------------------------------------------------------------
+
 void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
 {
    // Save the current clip rect 
@@ -588,7 +663,7 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
          {
             GFX->setClipRect( childClip );
             GFX->setStateBlock(mDefaultGuiSB);
-            ctrl->onRender(childPosition, childClip);
+            ctrl->renderControl(childPosition, childClip);
          }
       }
    }
@@ -602,6 +677,8 @@ void GuiControl::renderChildControls(Point2I offset, const RectI &updateRect)
 
 void GuiControl::setUpdateRegion(Point2I pos, Point2I ext)
 {
+   dirtyRenderLayers();
+
    Point2I upos = localToGlobalCoord(pos);
    GuiCanvas *root = getRoot();
    if (root)
@@ -885,6 +962,9 @@ void GuiControl::onSleep()
        mTooltipProfile->decLoadCount();
    }
 
+   // Don't hold on to the layer's texture while we're not on a canvas.
+   SAFE_DELETE( mRenderLayer );
+
    // Set Flag
    mAwake = false;
 }
@@ -1277,8 +1357,14 @@ bool GuiControl::resize(const Point2I &newPosition, const Point2I &newExtent)
 
    // Update Position
    if ( positionChanged )
+   {
       mBounds.point = newPosition;
 
+      // Our parents' layers have us in the old place.
+      if ( GuiControl *parent = getParent() )
+         parent->dirtyRenderLayers();
+   }
+
    // Update Extent
    if( extentChanged )
    {
@@ -1903,6 +1989,7 @@ void GuiControl::addObject(SimObject *object)
    AssertFatal( ctrl, "GuiControl::addObject() - cannot add non-GuiControl as child of GuiControl" );
 
 	Parent::addObject(object);
+   dirtyRenderLayers();
 
    AssertFatal(!ctrl->isAwake(), "GuiControl::addObject: object is already awake before add");
    if( mAwake )
@@ -1925,6 +2012,7 @@ void GuiControl::removeObject(SimObject *object)
    onChildRemoved( ctrl );
 
    Parent::removeObject(object);
+   dirtyRenderLayers();
 }
 
 //-----------------------------------------------------------------------------
@@ -2494,7 +2582,8 @@ void GuiControl::getCursor(GuiCursor *&cursor, bool &showCursor, const GuiEvent
 const char* GuiControl::evaluate( const char* str )
 {
    smThisControl = this;
-   const char* result = Con::evaluate(str, false).value;
+   // Copy the result out before the returned value goes away.
+   const char* result = Con::getReturnBuffer(Con::evaluate(str, false).value.getString());
    smThisControl = NULL;
 
    return result;
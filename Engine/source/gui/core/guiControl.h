@@ -53,6 +53,7 @@
 class GuiCanvas;
 class GuiEditCtrl;
 class GuiWindowCtrl;
+class GuiRenderLayer;
 
 
 DECLARE_SCOPE( GuiAPI );
@@ -178,6 +179,13 @@ class GuiControl : public SimGroup
       bool    mIsContainer; ///< if true, then the GuiEditor can drag other controls into this one.
       bool    mCanResize;
       bool    mCanHit;
+
+      /// If true, the control and its children are rendered into an
+      /// offscreen layer that is only redrawn when something in it changes.
+      bool    mRenderToLayer;
+
+      /// The layer, if mRenderToLayer is set and the control has rendered.
+      GuiRenderLayer* mRenderLayer;
       
       S32     mLayer;
       Point2I mMinExtent;
@@ -499,6 +507,17 @@ class GuiControl : public SimGroup
       /// @param   offset   The location this control is to begin rendering
       /// @param   updateRect   The screen area this control has drawing access to
       virtual void onRender(Point2I offset, const RectI &updateRect);
+
+      /// Called by the parent to render this control.  Calls onRender() or,
+      /// if the control renders to a layer, redraws the layer if needed and
+      /// draws it.
+      /// @param   offset   The location this control is to begin rendering
+      /// @param   updateRect   The screen area this control has drawing access to
+      void renderControl(Point2I offset, const RectI &updateRect);
+
+      /// Mark the render layers of this control and all its parents as
+      /// needing to be redrawn.
+      void dirtyRenderLayers();
       
       /// Called when this control should render its children
       /// @param   offset   The location this control is to begin rendering
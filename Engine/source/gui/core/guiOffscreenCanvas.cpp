@@ -200,7 +200,7 @@ void GuiOffscreenCanvas::renderFrame(bool preRenderOnly, bool bufferSwap /* = tr
          GFX->setClipRect( contentRect );
          GFX->setStateBlock(mDefaultGuiSB);
          
-         contentCtrl->onRender(contentCtrl->getPosition(), contentRect);
+         contentCtrl->renderControl(contentCtrl->getPosition(), contentRect);
       }
 
       // Fill Blue if no Dialogs
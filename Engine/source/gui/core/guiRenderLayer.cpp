@@ -0,0 +1,112 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "gui/core/guiRenderLayer.h"
+
+#include "gfx/gfxDevice.h"
+#include "gfx/gfxDrawUtil.h"
+#include "gfx/gfxTextureManager.h"
+#include "platform/profiler.h"
+
+
+bool GuiRenderLayer::smEnabled = true;
+U32 GuiRenderLayer::smNumRedraws = 0;
+
+
+GuiRenderLayer::GuiRenderLayer()
+   : mDirty( true )
+{
+   GFXTextureManager::addEventDelegate( this, &GuiRenderLayer::_onTextureEvent );
+}
+
+GuiRenderLayer::~GuiRenderLayer()
+{
+   GFXTextureManager::removeEventDelegate( this, &GuiRenderLayer::_onTextureEvent );
+}
+
+bool GuiRenderLayer::isDirty( const Point2I &size ) const
+{
+   return mDirty || !mTexture.isValid() || mTexture.getWidthHeight() != size;
+}
+
+bool GuiRenderLayer::begin( const Point2I &size )
+{
+   if ( size.x <= 0 || size.y <= 0 )
+      return false;
+
+   if ( !mTarget.isValid() )
+      mTarget = GFX->allocRenderToTextureTarget();
+   if ( !mTarget.isValid() )
+      return false;
+
+   if ( !mTexture.isValid() || mTexture.getWidthHeight() != size )
+   {
+      mTexture.set( size.x, size.y, GFXFormatR8G8B8A8, &GFXRenderTargetSRGBProfile, avar( "%s() - (line %d)", __FUNCTION__, __LINE__ ), 1, 0 );
+      if ( !mTexture.isValid() )
+         return false;
+
+      mTarget->attachTexture( GFXTextureTarget::Color0, mTexture );
+   }
+
+   PROFILE_START( GuiRenderLayer_Redraw );
+
+   GFX->pushActiveRenderTarget();
+   GFX->setActiveRenderTarget( mTarget );
+
+   const RectI layerRect( Point2I::Zero, size );
+   GFX->setViewport( layerRect );
+   GFX->clear( GFXClearTarget, LinearColorF( 0, 0, 0, 0 ), 1.0f, 0 );
+   GFX->setClipRect( layerRect );
+
+   smNumRedraws++;
+   return true;
+}
+
+void GuiRenderLayer::end()
+{
+   GFX->popActiveRenderTarget();
+   mDirty = false;
+
+   PROFILE_END();
+}
+
+void GuiRenderLayer::draw( const Point2I &offset )
+{
+   GFXDrawUtil *drawUtil = GFX->getDrawUtil();
+
+   ColorI modulation;
+   drawUtil->getBitmapModulation( &modulation );
+   drawUtil->clearBitmapModulation();
+
+   const Point2I size = mTexture.getWidthHeight();
+   drawUtil->drawBitmapStretchSR( mTexture, RectI( offset, size ), RectI( Point2I::Zero, size ), GFXBitmapFlip_None, GFXTextureFilterPoint, false );
+
+   drawUtil->setBitmapModulation( modulation );
+}
+
+void GuiRenderLayer::_onTextureEvent( GFXTexCallbackCode code )
+{
+   // Render targets come back empty after a device reset.
+   if ( code == GFXZombify || code == GFXResurrect )
+      mDirty = true;
+}
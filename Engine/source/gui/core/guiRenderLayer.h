@@ -0,0 +1,89 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _GUIRENDERLAYER_H_
+#define _GUIRENDERLAYER_H_
+
+#ifndef _GFXTARGET_H_
+#include "gfx/gfxTarget.h"
+#endif
+#ifndef _GFXTEXTUREHANDLE_H_
+#include "gfx/gfxTextureHandle.h"
+#endif
+
+
+/// Offscreen copy of what a GuiControl and its children last rendered.
+///
+/// A control with GuiControl::mRenderToLayer set renders itself into its
+/// layer only when the layer is dirty and otherwise just draws the layer,
+/// so a control tree that doesn't change costs one textured quad a frame.
+/// The layer is marked dirty whenever setUpdate() is called on the control
+/// or anything inside it, when a control inside it is moved, added or
+/// removed, when its size changes and when the device loses its textures.
+///
+/// The target is set up the same way as a GuiOffscreenCanvas target, but
+/// sized to the control rather than to a canvas.
+class GuiRenderLayer
+{
+public:
+
+   GuiRenderLayer();
+   ~GuiRenderLayer();
+
+   void markDirty() { mDirty = true; }
+
+   /// Returns true if the contents have to be rendered again before the
+   /// layer can be drawn at the given size.
+   bool isDirty( const Point2I &size ) const;
+
+   /// Make the layer the active render target, clear it and set the clip
+   /// rect to cover it.  Returns false if the target couldn't be set up,
+   /// in which case the control should render itself directly instead.
+   bool begin( const Point2I &size );
+
+   /// Restore the render target begin() replaced and mark the layer as up
+   /// to date.  The caller has to restore the clip rect and transforms.
+   void end();
+
+   /// Draw the contents at the given screen position, clipped to the
+   /// current clip rect.
+   void draw( const Point2I &offset );
+
+   GFXTextureObject* getTexture() const { return mTexture; }
+
+   /// If false, controls always render directly.  Exposed as $GUI::renderLayers.
+   static bool smEnabled;
+
+   /// Number of times any layer was rendered into, for profiling.
+   static U32 smNumRedraws;
+
+protected:
+
+   void _onTextureEvent( GFXTexCallbackCode code );
+
+   GFXTextureTargetRef mTarget;
+   GFXTexHandle mTexture;
+
+   bool mDirty;
+};
+
+#endif // _GUIRENDERLAYER_H_
@@ -59,6 +59,8 @@ F32 AdvancedLightBinManager::smLightFadeEnd = 75;
 
 bool AdvancedLightBinManager::smAllowLocalLightShadows = true;
 
+bool AdvancedLightBinManager::smClusteredLights = false;
+
 ImplementEnumType( ShadowFilterMode,
    "The shadow filtering modes for Advanced Lighting shadows.\n"
    "@ingroup AdvancedLighting" )
@@ -196,6 +198,19 @@ void AdvancedLightBinManager::consoleInit()
 
    Con::addVariable("$pref::allowLocalLightShadows", TypeBool, &smAllowLocalLightShadows, "Indicates if local lights(point/spot) can cast shadows.\n");
 
+   Con::addVariable( "$AL::ClusteredLights", TypeBool, &smClusteredLights,
+      "If true, point and spot lights are assigned to a grid of view space clusters each frame and "
+      "lights that don't touch any cluster are skipped.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$AL::ClusterParallel", TypeBool, &LightClusterGrid::smParallel,
+      "If true, the depth slices of the light cluster grid are assigned on worker threads.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$AL::ClusterParallelMinLights", TypeS32, &LightClusterGrid::smParallelMinLights,
+      "Number of visible lights needed before the light cluster grid is assigned on worker threads.\n"
+      "@ingroup AdvancedLighting\n" );
+
 }
 
 bool AdvancedLightBinManager::setTargetSize(const Point2I &newTargetSize)
@@ -443,6 +458,9 @@ void AdvancedLightBinManager::render( SceneRenderState *state )
    if(smUseLightFade || smMaximumNumOfLights != -1)
       _scoreLights(cameraTrans);
 
+   if ( smClusteredLights )
+      _assignLightClusters( state );
+
    S32 lightCount = 0;
 
    // Blend the lights in the bin to the light buffer
@@ -457,6 +475,17 @@ void AdvancedLightBinManager::render( SceneRenderState *state )
       LightInfo *curLightInfo = curEntry.lightInfo;
       if (curEntry.lightInfo->getType() >= LightInfo::Vector)
          continue;
+
+      // Skip lights the cluster grid found nothing visible for.
+      if ( smClusteredLights )
+      {
+         const S32 clusterLight = mClusterLightIndex[ U32( itr - mLightBin.begin() ) ];
+         if ( clusterLight >= 0 && mClusterGrid.getLightClusterCount( clusterLight ) == 0 )
+         {
+            mNumLightsCulled++;
+            continue;
+         }
+      }
       LightMaterialInfo *curLightMat = curEntry.lightMaterial;
       const U32 numPrims = curEntry.numPrims;
       const U32 numVerts = curEntry.vertBuffer->mNumVerts;
@@ -511,6 +540,26 @@ void AdvancedLightBinManager::render( SceneRenderState *state )
    GFX->popActiveRenderTarget();
 }
 
+void AdvancedLightBinManager::_assignLightClusters( const SceneRenderState *state )
+{
+   PROFILE_SCOPE( AdvancedLightBinManager_AssignLightClusters );
+
+   mClusterGrid.setFrustum( state->getCameraFrustum() );
+   mClusterGrid.clearLights();
+
+   // Only the lights the loop in render() gets to.
+   const U32 numLights = smMaximumNumOfLights != -1 ? getMin( (U32)smMaximumNumOfLights, (U32)mLightBin.size() ) : mLightBin.size();
+
+   mClusterLightIndex.setSize( mLightBin.size() );
+   for ( U32 i = 0; i < mLightBin.size(); i++ )
+      mClusterLightIndex[i] = i < numLights ? mClusterGrid.addLight( mLightBin[i].lightInfo ) : -1;
+
+   mClusterGrid.assign();
+
+   Con::setIntVariable( "lightMetrics::occupiedClusters", mClusterGrid.getNumOccupiedClusters() );
+   Con::setIntVariable( "lightMetrics::clusterLightIndices", mClusterGrid.getLightIndices().size() );
+}
+
 AdvancedLightBinManager::LightMaterialInfo* AdvancedLightBinManager::_getLightMaterial(   LightInfo::Type lightType, 
                                                                                           ShadowType shadowType, 
                                                                                           bool useCookieTex,
@@ -41,6 +41,9 @@
 #ifndef _SHADOW_COMMON_H_
 #include "lighting/shadowMap/shadowCommon.h"
 #endif
+#ifndef _LIGHTCLUSTERGRID_H_
+#include "lighting/advanced/lightClusterGrid.h"
+#endif
 
 
 class AdvancedLightManager;
@@ -117,6 +120,10 @@ public:
 
    static bool smAllowLocalLightShadows;
 
+   /// If true, the lights in the bin are assigned to a view space cluster
+   /// grid each frame and lights that end up in no cluster aren't drawn.
+   static bool smClusteredLights;
+
    // Used for console init
    AdvancedLightBinManager( AdvancedLightManager *lm = NULL, 
                             ShadowMapManager *sm = NULL,
@@ -155,6 +162,9 @@ public:
 
    AdvancedLightManager *getManager() { return mLightManager; }
 
+   /// The cluster grid built for the last frame when smClusteredLights is on.
+   const LightClusterGrid& getClusterGrid() const { return mClusterGrid; }
+
 protected:
 
    /// Frees all the currently allocated light materials.
@@ -218,6 +228,14 @@ protected:
    Vector<LightBinEntry> mLightBin;
    typedef Vector<LightBinEntry>::iterator LightBinIterator;
 
+   LightClusterGrid mClusterGrid;
+
+   /// Index of each bin entry in mClusterGrid, or -1 if it wasn't added.
+   Vector<S32> mClusterLightIndex;
+
+   /// Fills mClusterGrid with the lights render() is going to draw.
+   void _assignLightClusters( const SceneRenderState *state );
+
    bool mMRTLightmapsDuringDeferred;
 
    /// Used in setupSGData to set the object transform.
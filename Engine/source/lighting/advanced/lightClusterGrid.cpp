@@ -0,0 +1,553 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "lighting/advanced/lightClusterGrid.h"
+
+#include "lighting/lightInfo.h"
+#include "math/util/frustum.h"
+#include "math/mRandom.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
+#include "platform/profiler.h"
+#include "console/engineAPI.h"
+
+
+bool LightClusterGrid::smParallel = true;
+U32 LightClusterGrid::smParallelMinLights = 64;
+
+
+/// Returns the plane through a column or row boundary that faces along
+/// @a facing times @a axis.  @a offset is where the boundary crosses the
+/// near plane.
+static PlaneF _getBoundaryPlane( const Point3F &axis, F32 offset, F32 nearDist, bool isOrtho, F32 facing )
+{
+   Point3F normal = axis * facing;
+   F32 d;
+
+   if ( isOrtho )
+      d = -offset * facing;
+   else
+   {
+      // The boundary goes through the eye, so it leans out with depth.
+      normal.y = -offset / nearDist * facing;
+      d = 0.0f;
+   }
+
+   const F32 invLen = 1.0f / normal.len();
+   return PlaneF( normal.x * invLen, normal.y * invLen, normal.z * invLen, d * invLen );
+}
+
+
+/// Assigns one slice on a worker thread.
+struct LightClusterSliceWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   LightClusterGrid *mGrid;
+   U32 mSlice;
+   Semaphore *mDone;
+
+   LightClusterSliceWorkItem( LightClusterGrid *grid, U32 slice, Semaphore *done )
+      :  mGrid( grid ),
+         mSlice( slice ),
+         mDone( done ) {}
+
+protected:
+   void execute() override
+   {
+      mGrid->_assignSlice( mSlice );
+      mDone->release();
+   }
+   void onCancelled() override
+   {
+      // Never leave the render thread waiting on a cancelled slice.
+      execute();
+   }
+};
+
+
+LightClusterGrid::LightClusterGrid()
+   :  mTilesX( 16 ),
+      mTilesY( 9 ),
+      mNumSlices( 24 ),
+      mIsOrtho( false ),
+      mNearLeft( -1.0f ),
+      mNearRight( 1.0f ),
+      mNearTop( 1.0f ),
+      mNearBottom( -1.0f ),
+      mNearDist( 0.1f ),
+      mFarDist( 1000.0f ),
+      mLogDepthRatio( 1.0f ),
+      mWorldToView( true ),
+      mNumOccupiedClusters( 0 )
+{
+}
+
+LightClusterGrid::~LightClusterGrid()
+{
+}
+
+void LightClusterGrid::setGridSize( U32 tilesX, U32 tilesY, U32 numSlices )
+{
+   mTilesX = getMax( tilesX, (U32)1 );
+   mTilesY = getMax( tilesY, (U32)1 );
+   mNumSlices = getMax( numSlices, (U32)1 );
+}
+
+void LightClusterGrid::setFrustum( const Frustum &frustum )
+{
+   PROFILE_SCOPE( LightClusterGrid_setFrustum );
+
+   mIsOrtho = frustum.isOrtho();
+   mNearLeft = frustum.getNearLeft();
+   mNearRight = frustum.getNearRight();
+   mNearTop = frustum.getNearTop();
+   mNearBottom = frustum.getNearBottom();
+   mNearDist = getMax( frustum.getNearDist(), 0.001f );
+   mFarDist = getMax( frustum.getFarDist(), mNearDist * 1.001f );
+   mLogDepthRatio = mLog( mFarDist / mNearDist );
+
+   mWorldToView = frustum.getTransform();
+   mWorldToView.inverse();
+
+   // Boundaries are spread evenly over the near plane and the
+   // slices are spaced exponentially between near and far.
+   Vector<F32> columns( mTilesX + 1 );
+   Vector<F32> rows( mTilesY + 1 );
+   Vector<F32> depths( mNumSlices + 1 );
+   for ( U32 i = 0; i <= mTilesX; i++ )
+      columns.push_back( mNearLeft + ( mNearRight - mNearLeft ) * F32( i ) / F32( mTilesX ) );
+   for ( U32 i = 0; i <= mTilesY; i++ )
+      rows.push_back( mNearBottom + ( mNearTop - mNearBottom ) * F32( i ) / F32( mTilesY ) );
+   for ( U32 i = 0; i <= mNumSlices; i++ )
+      depths.push_back( mNearDist * mExp( mLogDepthRatio * F32( i ) / F32( mNumSlices ) ) );
+   depths.last() = mFarDist;
+
+   const Point3F xAxis( 1.0f, 0.0f, 0.0f );
+   const Point3F zAxis( 0.0f, 0.0f, 1.0f );
+
+   mColumnPlanes.clear();
+   for ( U32 i = 0; i < mTilesX; i++ )
+   {
+      mColumnPlanes.push_back( _getBoundaryPlane( xAxis, columns[ i ], mNearDist, mIsOrtho, 1.0f ) );
+      mColumnPlanes.push_back( _getBoundaryPlane( xAxis, columns[ i + 1 ], mNearDist, mIsOrtho, -1.0f ) );
+   }
+
+   mRowPlanes.clear();
+   for ( U32 i = 0; i < mTilesY; i++ )
+   {
+      mRowPlanes.push_back( _getBoundaryPlane( zAxis, rows[ i ], mNearDist, mIsOrtho, 1.0f ) );
+      mRowPlanes.push_back( _getBoundaryPlane( zAxis, rows[ i + 1 ], mNearDist, mIsOrtho, -1.0f ) );
+   }
+
+   mSlicePlanes.clear();
+   for ( U32 i = 0; i < mNumSlices; i++ )
+   {
+      mSlicePlanes.push_back( PlaneF( 0.0f, 1.0f, 0.0f, -depths[ i ] ) );
+      mSlicePlanes.push_back( PlaneF( 0.0f, -1.0f, 0.0f, depths[ i + 1 ] ) );
+   }
+
+   mFrustumPlanes[ 0 ] = mColumnPlanes.first();
+   mFrustumPlanes[ 1 ] = mColumnPlanes.last();
+   mFrustumPlanes[ 2 ] = mRowPlanes.first();
+   mFrustumPlanes[ 3 ] = mRowPlanes.last();
+   mFrustumPlanes[ 4 ] = mSlicePlanes.first();
+   mFrustumPlanes[ 5 ] = mSlicePlanes.last();
+
+   // The bounds of each cluster are the bounds of its eight corners.
+   mClusterBounds.setSize( getNumClusters() );
+   mClusterSpheres.setSize( getNumClusters() );
+   for ( U32 z = 0; z < mNumSlices; z++ )
+   {
+      for ( U32 y = 0; y < mTilesY; y++ )
+      {
+         for ( U32 x = 0; x < mTilesX; x++ )
+         {
+            Box3F bounds = Box3F::Invalid;
+            for ( U32 i = 0; i < 8; i++ )
+            {
+               const F32 depth = depths[ z + ( i & 1 ) ];
+               const F32 scale = mIsOrtho ? 1.0f : depth / mNearDist;
+               bounds.extend( Point3F( columns[ x + ( ( i >> 1 ) & 1 ) ] * scale,
+                                       depth,
+                                       rows[ y + ( i >> 2 ) ] * scale ) );
+            }
+
+            const U32 index = getClusterIndex( x, y, z );
+            mClusterBounds[ index ] = bounds;
+            mClusterSpheres[ index ] = bounds.getBoundingSphere();
+         }
+      }
+   }
+}
+
+void LightClusterGrid::clearLights()
+{
+   mLights.clear();
+   mConeIndex.clear();
+   mCones.clear();
+
+   mClusters.clear();
+   mLightIndices.clear();
+   mLightClusterCounts.clear();
+   mNumOccupiedClusters = 0;
+}
+
+S32 LightClusterGrid::addPointLight( const Point3F &position, F32 range )
+{
+   if ( mLights.size() >= MaxLights )
+      return -1;
+
+   mLights.push_back( SphereF( position, range ) );
+   mConeIndex.push_back( -1 );
+   return mLights.size() - 1;
+}
+
+S32 LightClusterGrid::addSpotLight( const Point3F &position, const VectorF &direction, F32 range, F32 coneAngle )
+{
+   const S32 index = addPointLight( position, range );
+   if ( index < 0 )
+      return index;
+
+   // A cone wider than a hemisphere is tested as a sphere.
+   const F32 halfAngle = mDegToRad( mClampF( coneAngle, 0.0f, 360.0f ) * 0.5f );
+   if ( halfAngle < M_HALFPI_F )
+   {
+      SpotCone cone;
+      cone.dir = direction;
+      cone.dir.normalizeSafe();
+      mSinCos( halfAngle, cone.sinHalfAngle, cone.cosHalfAngle );
+
+      mConeIndex.last() = mCones.size();
+      mCones.push_back( cone );
+   }
+
+   return index;
+}
+
+S32 LightClusterGrid::addLight( const LightInfo *light )
+{
+   const Point3F &range = light->getRange();
+
+   switch ( light->getType() )
+   {
+      case LightInfo::Point:
+         return addPointLight( light->getPosition(), getMax( range.x, getMax( range.y, range.z ) ) );
+
+      case LightInfo::Spot:
+         return addSpotLight( light->getPosition(), light->getDirection(), range.x, light->getOuterConeAngle() );
+
+      default:
+         return -1;
+   }
+}
+
+void LightClusterGrid::assign()
+{
+   PROFILE_SCOPE( LightClusterGrid_assign );
+
+   const U32 numClusters = getNumClusters();
+   const U32 numLights = mLights.size();
+
+   mClusters.setSize( numClusters );
+   dMemset( mClusters.address(), 0, numClusters * sizeof( Cluster ) );
+   mLightIndices.clear();
+   mLightClusterCounts.setSize( numLights );
+   dMemset( mLightClusterCounts.address(), 0, numLights * sizeof( U32 ) );
+   mNumOccupiedClusters = 0;
+
+   // Nothing to do without lights or before setFrustum().
+   if ( numLights == 0 || mClusterBounds.size() != numClusters )
+      return;
+
+   // Move everything into view space.
+   mViewSpheres.x.setSize( numLights );
+   mViewSpheres.y.setSize( numLights );
+   mViewSpheres.z.setSize( numLights );
+   mViewSpheres.radius = mLights.radius;
+   m_matF_x_point3F_batch( mWorldToView,
+                           mLights.x.address(), mLights.y.address(), mLights.z.address(),
+                           mViewSpheres.x.address(), mViewSpheres.y.address(), mViewSpheres.z.address(),
+                           numLights );
+
+   mViewCones = mCones;
+   for ( U32 i = 0; i < mViewCones.size(); i++ )
+      mWorldToView.mulV( mViewCones[ i ].dir );
+
+   // Drop everything outside the grid up front.
+   mResults.setSize( numLights );
+   mViewSpheres.testPlanes( mFrustumPlanes, 6, mResults.address() );
+
+   mVisibleLights.clear();
+   mVisibleSpheres.clear();
+   for ( U32 i = 0; i < numLights; i++ )
+   {
+      if ( mResults[ i ] == GeometryOutside )
+         continue;
+
+      mVisibleLights.push_back( i );
+      mVisibleSpheres.x.push_back( mViewSpheres.x[ i ] );
+      mVisibleSpheres.y.push_back( mViewSpheres.y[ i ] );
+      mVisibleSpheres.z.push_back( mViewSpheres.z[ i ] );
+      mVisibleSpheres.radius.push_back( mViewSpheres.radius[ i ] );
+   }
+
+   if ( mVisibleLights.empty() )
+      return;
+
+   if ( mSlices.size() != mNumSlices )
+      mSlices.setSize( mNumSlices );
+
+   // Slices only read the shared state and write their own
+   // results, so each one can go to a worker thread.  This
+   // thread takes the first one.
+   if ( smParallel && mNumSlices > 1 && mVisibleLights.size() >= smParallelMinLights )
+   {
+      Semaphore done( 0 );
+      for ( U32 i = 1; i < mNumSlices; i++ )
+      {
+         ThreadSafeRef< LightClusterSliceWorkItem > item( new LightClusterSliceWorkItem( this, i, &done ) );
+         ThreadPool::GLOBAL().queueWorkItem( item );
+      }
+
+      _assignSlice( 0 );
+
+      for ( U32 i = 1; i < mNumSlices; i++ )
+         done.acquire();
+   }
+   else
+   {
+      for ( U32 i = 0; i < mNumSlices; i++ )
+         _assignSlice( i );
+   }
+
+   // Join the slices in order.
+   const U32 clustersPerSlice = mTilesX * mTilesY;
+   Cluster *cluster = mClusters.address();
+   for ( U32 i = 0; i < mNumSlices; i++ )
+   {
+      const Slice &slice = mSlices[ i ];
+
+      U32 offset = mLightIndices.size();
+      mLightIndices.merge( slice.indices );
+
+      for ( U32 n = 0; n < clustersPerSlice; n++, cluster++ )
+      {
+         cluster->offset = offset;
+         cluster->count = slice.counts[ n ];
+         offset += cluster->count;
+
+         if ( cluster->count )
+            mNumOccupiedClusters++;
+      }
+   }
+
+   for ( U32 i = 0; i < mLightIndices.size(); i++ )
+      mLightClusterCounts[ mLightIndices[ i ] ]++;
+}
+
+void LightClusterGrid::_assignSlice( U32 sliceIndex )
+{
+   Slice &slice = mSlices[ sliceIndex ];
+
+   slice.counts.setSize( mTilesX * mTilesY );
+   dMemset( slice.counts.address(), 0, slice.counts.size() * sizeof( U32 ) );
+   slice.indices.clear();
+
+   slice.results.setSize( mVisibleLights.size() );
+   mVisibleSpheres.testPlanes( &mSlicePlanes[ sliceIndex * 2 ], 2, slice.results.address() );
+   _gather( mVisibleLights, mVisibleSpheres, slice.results.address(), slice.sliceLights, slice.sliceSpheres );
+
+   if ( slice.sliceLights.empty() )
+      return;
+
+   for ( U32 y = 0; y < mTilesY; y++ )
+   {
+      slice.sliceSpheres.testPlanes( &mRowPlanes[ y * 2 ], 2, slice.results.address() );
+      _gather( slice.sliceLights, slice.sliceSpheres, slice.results.address(), slice.rowLights, slice.rowSpheres );
+
+      if ( slice.rowLights.empty() )
+         continue;
+
+      const SphereFBatch &spheres = slice.rowSpheres;
+
+      for ( U32 x = 0; x < mTilesX; x++ )
+      {
+         spheres.testPlanes( &mColumnPlanes[ x * 2 ], 2, slice.results.address() );
+
+         const U32 cluster = getClusterIndex( x, y, sliceIndex );
+         const Box3F &bounds = mClusterBounds[ cluster ];
+         U32 &count = slice.counts[ y * mTilesX + x ];
+
+         for ( U32 i = 0; i < spheres.size(); i++ )
+         {
+            if ( slice.results[ i ] == GeometryOutside )
+               continue;
+
+            // The planes let through spheres that only touch
+            // the corners, which the box catches.
+            const Point3F center( spheres.x[ i ], spheres.y[ i ], spheres.z[ i ] );
+            const F32 radius = spheres.radius[ i ];
+            if ( bounds.getSqDistanceToPoint( center ) > radius * radius )
+               continue;
+
+            const U16 light = slice.rowLights[ i ];
+            const S32 cone = mConeIndex[ light ];
+            if ( cone >= 0 && !_testCone( center, radius, mViewCones[ cone ], mClusterSpheres[ cluster ] ) )
+               continue;
+
+            slice.indices.push_back( light );
+            count++;
+         }
+      }
+   }
+}
+
+void LightClusterGrid::_gather(  const Vector<U16> &lights, const SphereFBatch &spheres, const S8 *results,
+                                 Vector<U16> &outLights, SphereFBatch &outSpheres )
+{
+   outLights.clear();
+   outSpheres.clear();
+
+   for ( U32 i = 0; i < lights.size(); i++ )
+   {
+      if ( results[ i ] == GeometryOutside )
+         continue;
+
+      outLights.push_back( lights[ i ] );
+      outSpheres.x.push_back( spheres.x[ i ] );
+      outSpheres.y.push_back( spheres.y[ i ] );
+      outSpheres.z.push_back( spheres.z[ i ] );
+      outSpheres.radius.push_back( spheres.radius[ i ] );
+   }
+}
+
+bool LightClusterGrid::_testCone( const Point3F &apex, F32 range, const SpotCone &cone, const SphereF &bounds )
+{
+   const Point3F toBounds = bounds.center - apex;
+   const F32 distAlongDir = mDot( toBounds, cone.dir );
+
+   // Beyond the range or behind the apex.
+   if ( distAlongDir > range + bounds.radius || distAlongDir < -bounds.radius )
+      return false;
+
+   // Distance from the sphere center to the side of the cone.
+   const F32 distSq = mDot( toBounds, toBounds );
+   const F32 distFromAxis = mSqrt( getMax( distSq - distAlongDir * distAlongDir, 0.0f ) );
+   return cone.cosHalfAngle * distFromAxis - distAlongDir * cone.sinHalfAngle <= bounds.radius;
+}
+
+bool LightClusterGrid::findCluster( const Point3F &position, U32 *outIndex ) const
+{
+   Point3F viewPos;
+   mWorldToView.mulP( position, &viewPos );
+
+   const F32 depth = viewPos.y;
+   if ( mClusterBounds.empty() || depth < mNearDist || depth > mFarDist )
+      return false;
+
+   // Project onto the near plane.
+   const F32 scale = mIsOrtho ? 1.0f : mNearDist / depth;
+   const F32 fx = ( viewPos.x * scale - mNearLeft ) / ( mNearRight - mNearLeft );
+   const F32 fy = ( viewPos.z * scale - mNearBottom ) / ( mNearTop - mNearBottom );
+   if ( fx < 0.0f || fx > 1.0f || fy < 0.0f || fy > 1.0f )
+      return false;
+
+   const F32 fz = mLog( depth / mNearDist ) / mLogDepthRatio;
+
+   const U32 x = getMin( U32( fx * mTilesX ), mTilesX - 1 );
+   const U32 y = getMin( U32( fy * mTilesY ), mTilesY - 1 );
+   const U32 z = getMin( U32( getMax( fz, 0.0f ) * mNumSlices ), mNumSlices - 1 );
+
+   *outIndex = getClusterIndex( x, y, z );
+   return true;
+}
+
+
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( benchmarkLightClusters, void, ( S32 numLights, S32 iterations, S32 spotPercent ), ( 1024, 100, 50 ),
+   "@brief Scatters point and spot lights through a camera frustum and times assigning "
+   "them to a 16x9x24 cluster grid on this thread and on the thread pool.\n\n"
+   "@param numLights Number of lights.\n"
+   "@param iterations Number of times to assign the lights.\n"
+   "@param spotPercent Percentage of the lights that are spot lights.\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   const U32 lightCount = mClamp( numLights, 1, (S32)LightClusterGrid::MaxLights );
+   const U32 count = getMax( iterations, 1 );
+
+   Frustum frustum;
+   frustum.set( false, M_HALFPI_F, 16.0f / 9.0f, 0.1f, 500.0f );
+
+   LightClusterGrid grid;
+   grid.setFrustum( frustum );
+
+   // Lights are spread out evenly in depth like they are in a level,
+   // with some of them outside the frustum.
+   MRandomLCG rand( 1 );
+   for ( U32 i = 0; i < lightCount; i++ )
+   {
+      const F32 depth = rand.randF( 0.0f, 400.0f );
+      const Point3F pos( rand.randF( -depth, depth ), depth, rand.randF( -depth, depth ) * 0.6f );
+      const F32 range = rand.randF( 2.0f, 20.0f );
+
+      if ( rand.randI( 0, 99 ) < spotPercent )
+      {
+         VectorF dir( rand.randF( -1.0f, 1.0f ), rand.randF( -1.0f, 1.0f ), rand.randF( -1.0f, 1.0f ) );
+         grid.addSpotLight( pos, dir, range, rand.randF( 20.0f, 120.0f ) );
+      }
+      else
+         grid.addPointLight( pos, range );
+   }
+
+   const bool oldParallel = LightClusterGrid::smParallel;
+
+   U32 times[ 2 ];
+   for ( U32 pass = 0; pass < 2; pass++ )
+   {
+      LightClusterGrid::smParallel = ( pass == 1 );
+
+      const U32 start = Platform::getRealMilliseconds();
+      for ( U32 i = 0; i < count; i++ )
+         grid.assign();
+      times[ pass ] = Platform::getRealMilliseconds() - start;
+   }
+
+   LightClusterGrid::smParallel = oldParallel;
+
+   U32 numVisible = 0;
+   for ( U32 i = 0; i < lightCount; i++ )
+   {
+      if ( grid.getLightClusterCount( i ) )
+         numVisible++;
+   }
+
+   Con::printf( "benchmarkLightClusters: %d lights, %d clusters", lightCount, grid.getNumClusters() );
+   Con::printf( "   serial    %6dms   %.3fms per assign", times[ 0 ], F32( times[ 0 ] ) / count );
+   Con::printf( "   parallel  %6dms   %.3fms per assign", times[ 1 ], F32( times[ 1 ] ) / count );
+   Con::printf( "   %d lights in view, %d occupied clusters, %d light indices (%.1f per occupied cluster)",
+      numVisible, grid.getNumOccupiedClusters(), grid.getLightIndices().size(),
+      grid.getNumOccupiedClusters() ? F32( grid.getLightIndices().size() ) / grid.getNumOccupiedClusters() : 0.0f );
+}
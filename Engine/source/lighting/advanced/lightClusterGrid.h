@@ -0,0 +1,239 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _LIGHTCLUSTERGRID_H_
+#define _LIGHTCLUSTERGRID_H_
+
+#ifndef _MMATHBATCH_H_
+#include "math/mMathBatch.h"
+#endif
+#ifndef _MMATRIX_H_
+#include "math/mMatrix.h"
+#endif
+
+class Frustum;
+class LightInfo;
+struct LightClusterSliceWorkItem;
+
+
+/// Assigns point and spot lights to the cells of a grid that divides the
+/// view frustum into clusters, and builds a compact list of the lights
+/// touching each cluster.
+///
+/// The frustum is split into screen space tiles and into depth slices that
+/// get exponentially thicker with distance, so clusters stay roughly cube
+/// shaped.  The lists are laid out the way a forward+ or tiled deferred
+/// shader would read them: getClusters() holds an offset and a count into
+/// getLightIndices() for every cluster, slice by slice, row by row.
+///
+/// Lights are first tested as spheres against the planes bounding each
+/// slice, then each row of the slice and then each cluster of the row with
+/// the batch math functions, so each step only sees the lights left over
+/// from the one before.  Spheres that pass the plane tests are checked
+/// against the bounds of the cluster and spot lights against their cone.
+/// Slices are assigned in parallel on the thread pool.
+///
+/// The grid only works on positions and ranges, so it has no dependency on
+/// the renderer and can be filled without any LightInfo at all.
+class LightClusterGrid
+{
+public:
+
+   /// A range of getLightIndices().
+   struct Cluster
+   {
+      U32 offset;
+      U32 count;
+   };
+
+   /// The light indices are stored as U16s.
+   static const U32 MaxLights = 0xFFFF;
+
+   LightClusterGrid();
+   ~LightClusterGrid();
+
+   /// Sets the number of tiles along each screen axis and the number of
+   /// depth slices.  Takes effect on the next call to setFrustum().
+   void setGridSize( U32 tilesX, U32 tilesY, U32 numSlices );
+
+   U32 getTilesX() const { return mTilesX; }
+   U32 getTilesY() const { return mTilesY; }
+   U32 getNumSlices() const { return mNumSlices; }
+   U32 getNumClusters() const { return mTilesX * mTilesY * mNumSlices; }
+
+   /// Builds the cluster bounds for a camera frustum.  Lights are expected
+   /// in the space the frustum's transform puts the camera in, which is
+   /// world space for a scene camera.
+   void setFrustum( const Frustum &frustum );
+
+   /// @name Lights
+   /// @{
+
+   /// Removes all lights and the results of the last assign().
+   void clearLights();
+
+   /// Adds a point light and returns its index in the light lists, or -1
+   /// if the grid is full.
+   S32 addPointLight( const Point3F &position, F32 range );
+
+   /// Adds a spot light pointing along @a direction with an outer cone of
+   /// @a coneAngle degrees, as LightInfo::getOuterConeAngle() returns it.
+   S32 addSpotLight( const Point3F &position, const VectorF &direction, F32 range, F32 coneAngle );
+
+   /// Adds a point or spot light.  Other light types are ignored and
+   /// return -1.
+   S32 addLight( const LightInfo *light );
+
+   U32 getNumLights() const { return mLights.size(); }
+
+   /// @}
+
+   /// Fills the cluster lists for the lights added since clearLights().
+   void assign();
+
+   /// @name Results
+   /// @{
+
+   U32 getClusterIndex( U32 x, U32 y, U32 slice ) const { return ( slice * mTilesY + y ) * mTilesX + x; }
+
+   const Cluster& getCluster( U32 x, U32 y, U32 slice ) const { return mClusters[ getClusterIndex( x, y, slice ) ]; }
+
+   const Vector<Cluster>& getClusters() const { return mClusters; }
+
+   const Vector<U16>& getLightIndices() const { return mLightIndices; }
+
+   /// Returns the number of clusters the light was assigned to.  A light
+   /// that isn't in any cluster can't light anything the camera sees.
+   U32 getLightClusterCount( U32 light ) const { return mLightClusterCounts[ light ]; }
+
+   /// Returns the number of clusters with at least one light.
+   U32 getNumOccupiedClusters() const { return mNumOccupiedClusters; }
+
+   /// Returns the view space bounds of a cluster.
+   const Box3F& getClusterBounds( U32 x, U32 y, U32 slice ) const { return mClusterBounds[ getClusterIndex( x, y, slice ) ]; }
+
+   /// Finds the cluster a position lies in, the way a shader would look
+   /// it up for a pixel.  Returns false if the position is outside the grid.
+   bool findCluster( const Point3F &position, U32 *outIndex ) const;
+
+   /// @}
+
+   /// If false, all slices are assigned on the calling thread.  Exposed as
+   /// $AL::ClusterParallel.
+   static bool smParallel;
+
+   /// Lights needed before the slices are handed to the thread pool.
+   /// Exposed as $AL::ClusterParallelMinLights.
+   static U32 smParallelMinLights;
+
+protected:
+
+   friend struct LightClusterSliceWorkItem;
+
+   struct SpotCone
+   {
+      Point3F dir;
+      F32 cosHalfAngle;
+      F32 sinHalfAngle;
+   };
+
+   /// Per slice results and scratch space so slices can be assigned at
+   /// the same time.
+   struct Slice
+   {
+      /// Counts for the clusters of the slice, row by row.
+      Vector<U32> counts;
+
+      /// Light indices for the clusters of the slice, in cluster order.
+      Vector<U16> indices;
+
+      /// Lights left after the slice and row tests.
+      Vector<U16> sliceLights;
+      SphereFBatch sliceSpheres;
+      Vector<U16> rowLights;
+      SphereFBatch rowSpheres;
+      Vector<S8> results;
+   };
+
+   void _assignSlice( U32 slice );
+
+   /// Copies the spheres @a results says aren't outside into @a outLights
+   /// and @a outSpheres.
+   static void _gather( const Vector<U16> &lights, const SphereFBatch &spheres, const S8 *results,
+                        Vector<U16> &outLights, SphereFBatch &outSpheres );
+
+   static bool _testCone( const Point3F &apex, F32 range, const SpotCone &cone, const SphereF &bounds );
+
+   U32 mTilesX;
+   U32 mTilesY;
+   U32 mNumSlices;
+
+   bool mIsOrtho;
+   F32 mNearLeft;
+   F32 mNearRight;
+   F32 mNearTop;
+   F32 mNearBottom;
+   F32 mNearDist;
+   F32 mFarDist;
+
+   /// log( far / near ) used to find the slice for a depth.
+   F32 mLogDepthRatio;
+
+   MatrixF mWorldToView;
+
+   /// View space planes bounding each column, row and slice; two for each,
+   /// facing into it.
+   Vector<PlaneF> mColumnPlanes;
+   Vector<PlaneF> mRowPlanes;
+   Vector<PlaneF> mSlicePlanes;
+
+   /// The planes around the whole grid.
+   PlaneF mFrustumPlanes[ 6 ];
+
+   Vector<Box3F> mClusterBounds;
+   Vector<SphereF> mClusterSpheres;
+
+   /// World space spheres as added.
+   SphereFBatch mLights;
+
+   /// Index into mCones for each light, or -1 for point lights.
+   Vector<S32> mConeIndex;
+
+   /// Spot light cones in world and in view space.
+   Vector<SpotCone> mCones;
+   Vector<SpotCone> mViewCones;
+
+   /// Lights inside the frustum, in view space.
+   Vector<U16> mVisibleLights;
+   SphereFBatch mVisibleSpheres;
+   SphereFBatch mViewSpheres;
+   Vector<S8> mResults;
+
+   Vector<Slice> mSlices;
+
+   Vector<Cluster> mClusters;
+   Vector<U16> mLightIndices;
+   Vector<U32> mLightClusterCounts;
+   U32 mNumOccupiedClusters;
+};
+
+#endif // _LIGHTCLUSTERGRID_H_
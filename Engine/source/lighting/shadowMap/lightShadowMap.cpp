@@ -34,7 +34,9 @@
 #include "materials/baseMatInstance.h"
 #include "scene/sceneManager.h"
 #include "scene/sceneRenderState.h"
+#include "scene/sceneObject.h"
 #include "scene/zones/sceneZoneSpace.h"
+#include "T3D/objectTypes.h"
 #include "lighting/lightManager.h"
 #include "math/mathUtils.h"
 #include "shaderGen/shaderGenVars.h"
@@ -62,6 +64,14 @@ const GFXFormat LightShadowMap::ShadowMapFormat = GFXFormatR32F; // GFXFormatR8G
 bool LightShadowMap::smDebugRenderFrustums;
 F32 LightShadowMap::smShadowTexScalar = 1.0f;
 
+bool LightShadowMap::smCacheStaticShadows = false;
+F32 LightShadowMap::smStaticCacheMargin = 0.25f;
+U32 LightShadowMap::smStaticLayerUpdates = 0;
+U32 LightShadowMap::smStaticLayerReuses = 0;
+
+const U32 LightShadowMap::StaticCasterTypeMask = StaticShapeObjectType;
+const U32 LightShadowMap::DynamicCasterTypeMask = SHADOW_TYPEMASK;
+
 Vector<LightShadowMap*> LightShadowMap::smUsedShadowMaps;
 Vector<LightShadowMap*> LightShadowMap::smShadowMaps;
 
@@ -86,6 +96,7 @@ LightShadowMap::LightShadowMap( LightInfo *light )
       mTexSize( 0 ),
       mLight( light ),
       mLastShader( NULL ),
+      mRenderingDynamicLayer( false ),
       mIsViewDependent( false ),
       mLastCull( 0 ),
       mLastScreenSize( 0.0f ),
@@ -100,6 +111,7 @@ LightShadowMap::LightShadowMap( LightInfo *light )
 LightShadowMap::~LightShadowMap()
 {
    mTarget = NULL;
+   mStaticTarget = NULL;
 
    releaseTextures();
 
@@ -144,6 +156,92 @@ U32 LightShadowMap::releaseUnusedTextures()
    return smUsedShadowMaps.size();
 }
 
+void LightShadowMap::updateStaticShadowHooks()
+{
+   // Stay off the signals when there is no cache, the bounds one
+   // goes off for every object that moves.
+   SceneObject::smSceneObjectAdd.remove( &LightShadowMap::_onStaticCasterAdded );
+   SceneObject::smSceneObjectRemove.remove( &LightShadowMap::_onStaticCasterAdded );
+   SceneObject::smSceneObjectBoundsChanged.remove( &LightShadowMap::_onStaticCasterMoved );
+   SceneObject::smSceneObjectTypeMaskChanged.remove( &LightShadowMap::_onCasterTypeMaskChanged );
+
+   if ( !smCacheStaticShadows )
+      return;
+
+   SceneObject::smSceneObjectAdd.notify( &LightShadowMap::_onStaticCasterAdded );
+   SceneObject::smSceneObjectRemove.notify( &LightShadowMap::_onStaticCasterAdded );
+   SceneObject::smSceneObjectBoundsChanged.notify( &LightShadowMap::_onStaticCasterMoved );
+   SceneObject::smSceneObjectTypeMaskChanged.notify( &LightShadowMap::_onCasterTypeMaskChanged );
+}
+
+void LightShadowMap::invalidateStaticShadows( const Box3F &worldBox )
+{
+   for ( U32 i=0; i < smShadowMaps.size(); i++ )
+      smShadowMaps[i]->_invalidateStaticLayer( worldBox );
+}
+
+void LightShadowMap::invalidateAllStaticShadows()
+{
+   // The layers are rendered again when they are missing.
+   for ( U32 i=0; i < smShadowMaps.size(); i++ )
+      smShadowMaps[i]->mStaticShadowMapTex = NULL;
+}
+
+bool LightShadowMap::_isStaticCasterType( U32 typeMask )
+{
+   // Game objects like turrets, path shapes and mines claim to be
+   // static shapes but move and animate, so they're always dynamic.
+   return   ( typeMask & StaticCasterTypeMask ) &&
+            !( typeMask & GameBaseObjectType );
+}
+
+bool LightShadowMap::_isStaticCaster( SceneObject *object )
+{
+   // Only the client side objects are rendered.
+   return   smCacheStaticShadows &&
+            object->isClientObject() &&
+            _isStaticCasterType( object->getTypeMask() );
+}
+
+bool LightShadowMap::_isLayerCaster( SceneObject *object )
+{
+   if ( !smCacheStaticShadows )
+      return true;
+
+   // The static layer is queried for static shapes or the terrain,
+   // it only has to leave out the game objects among them.
+   if ( mRenderingDynamicLayer )
+      return !_isStaticCasterType( object->getTypeMask() );
+   else
+      return !( object->getTypeMask() & GameBaseObjectType );
+}
+
+void LightShadowMap::_onStaticCasterAdded( SceneObject *object )
+{
+   if ( _isStaticCaster( object ) )
+      invalidateStaticShadows( object->getWorldBox() );
+}
+
+void LightShadowMap::_onStaticCasterMoved( SceneObject *object, const Box3F &oldWorldBox )
+{
+   if ( !_isStaticCaster( object ) )
+      return;
+
+   // It has to disappear from where it was and show up where it is.
+   invalidateStaticShadows( oldWorldBox );
+   invalidateStaticShadows( object->getWorldBox() );
+}
+
+void LightShadowMap::_onCasterTypeMaskChanged( SceneObject *object, U32 oldTypeMask )
+{
+   if ( !smCacheStaticShadows || !object->isClientObject() )
+      return;
+
+   // It either joins the static layer or has to be taken out of it.
+   if ( _isStaticCasterType( oldTypeMask ) != _isStaticCasterType( object->getTypeMask() ) )
+      invalidateStaticShadows( object->getWorldBox() );
+}
+
 void LightShadowMap::_onTextureEvent( GFXTexCallbackCode code )
 {
    if ( code == GFXZombify )
@@ -153,7 +251,7 @@ void LightShadowMap::_onTextureEvent( GFXTexCallbackCode code )
    // to be reallocated when the shadow becomes visible.
 }
 
-void LightShadowMap::calcLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum )
+void LightShadowMap::calcLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum, F32 distanceScale )
 {
    // Create light matrix, set projection
 
@@ -166,8 +264,9 @@ void LightShadowMap::calcLightMatrices( MatrixF &outLightMatrix, const Frustum &
          // Calculate the bonding box of the shadowed area 
          // we're interested in... this is the shadow box 
          // transformed by the frustum transform.
-         Box3F viewBB( -p->shadowDistance, -p->shadowDistance, -p->shadowDistance,
-                        p->shadowDistance, p->shadowDistance, p->shadowDistance );
+         const F32 shadowDistance = p->shadowDistance * distanceScale;
+         Box3F viewBB( -shadowDistance, -shadowDistance, -shadowDistance,
+                        shadowDistance, shadowDistance, shadowDistance );
          viewFrustum.getTransform().mul( viewBB );
 
          // Calculate a light "projection" matrix.
@@ -239,6 +338,7 @@ void LightShadowMap::calcLightMatrices( MatrixF &outLightMatrix, const Frustum &
 void LightShadowMap::releaseTextures()
 {
    mShadowMapTex = NULL;
+   mStaticShadowMapTex = NULL;
    mDebugTarget.setTexture( NULL );
    smUsedShadowMaps.remove( this );
 }
@@ -324,7 +424,7 @@ BaseMatInstance* LightShadowMap::getShadowMaterial( BaseMatInstance *inMat ) con
       inMat->addHook( hook );
    }
 
-   return hook->getShadowMat( getShadowType() );
+   return hook->getShadowMat( getShadowType(), mRenderingDynamicLayer );
 }
 
 U32 LightShadowMap::getBestTexSize( U32 scale ) const
@@ -66,6 +66,7 @@ class GFXShaderConstHandle;
 class GFXShader;
 class LightManager;
 class RenderPassManager;
+class SceneObject;
 
 
 // Shader constant handle lookup
@@ -149,6 +150,39 @@ public:
    /// rendering enabled.
    static bool smDebugRenderFrustums;
 
+   /// If true, spot and PSSM shadows keep what the static casters render
+   /// in a separate layer which is only rendered again when a static caster
+   /// inside it changes, and each update just draws the dynamic casters
+   /// over a copy of it.
+   ///
+   /// Static casters are whatever has StaticShapeObjectType, so the static
+   /// layer doesn't pick up wind or animation on them and keeps the LOD they
+   /// had when it was rendered.  Exposed as $pref::Shadows::cacheStatic.
+   static bool smCacheStaticShadows;
+
+   /// How much bigger than the shadowed area a static PSSM layer and each
+   /// of its splits is made so that it can be reused while the camera moves.
+   /// This costs the splits the same fraction of their resolution.  Exposed
+   /// as $pref::Shadows::staticCacheMargin.
+   static F32 smStaticCacheMargin;
+
+   /// The number of static layers, counting each PSSM split as one, that
+   /// were rendered and reused since the last resetStaticStats().
+   static U32 smStaticLayerUpdates;
+   static U32 smStaticLayerReuses;
+
+   static void resetStaticStats() { smStaticLayerUpdates = smStaticLayerReuses = 0; }
+
+   /// Mark the static layers that cover any of @a worldBox as out of date.
+   static void invalidateStaticShadows( const Box3F &worldBox );
+
+   /// Mark all the static layers as out of date.
+   static void invalidateAllStaticShadows();
+
+   /// Hook up the scene signals that tell us about changes to static casters
+   /// while smCacheStaticShadows is set, and unhook them otherwise.
+   static void updateStaticShadowHooks();
+
 public:
 
    LightShadowMap( LightInfo *light );
@@ -232,6 +266,35 @@ protected:
    /// Helper for rendering shadow map for debugging.
    NamedTexTarget mDebugTarget;
 
+   /// The type masks of the casters that go into the static and
+   /// dynamic layers when smCacheStaticShadows is on.  GameBase objects
+   /// are never static casters, _isLayerCaster() sorts them out.
+   static const U32 StaticCasterTypeMask;
+   static const U32 DynamicCasterTypeMask;
+
+   static bool _isStaticCasterType( U32 typeMask );
+   static bool _isStaticCaster( SceneObject *object );
+   static void _onStaticCasterAdded( SceneObject *object );
+   static void _onStaticCasterMoved( SceneObject *object, const Box3F &oldWorldBox );
+   static void _onCasterTypeMaskChanged( SceneObject *object, U32 oldTypeMask );
+
+   /// The object filter for the shadow render states which keeps each
+   /// caster in the layer being rendered.
+   bool _isLayerCaster( SceneObject *object );
+
+   /// Called with the world box of a static caster that was added, removed
+   /// or moved so that the static layer can be marked out of date if it
+   /// covers it.
+   virtual void _invalidateStaticLayer( const Box3F &worldBox ) {}
+
+   /// The cached static casters, which is released with the other textures.
+   GFXTexHandle mStaticShadowMapTex;
+   GFXTextureTargetRef mStaticTarget;
+
+   /// Set while drawing the dynamic casters over the static layer so that
+   /// getShadowMaterial() returns the material that does that.
+   bool mRenderingDynamicLayer;
+
    /// If true the shadow is view dependent and cannot
    /// be skipped if visible and within active range.
    bool mIsViewDependent;
@@ -257,8 +320,9 @@ protected:
    GFXShader* mLastShader;
    GFXShaderConstHandle* mBlurBoundaries;
 
-   // Calculate view matrices and set proper projection with GFX
-   void calcLightMatrices( MatrixF& outLightMatrix, const Frustum &viewFrustum );
+   // Calculate view matrices and set proper projection with GFX.  For vector
+   // lights the shadowed area is the shadow distance times distanceScale.
+   void calcLightMatrices( MatrixF& outLightMatrix, const Frustum &viewFrustum, F32 distanceScale = 1.0f );
 
    /// The callback used to get texture events.
    /// @see GFXTextureManager::addEventDelegate
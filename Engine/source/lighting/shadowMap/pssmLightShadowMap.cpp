@@ -38,6 +38,7 @@
 #include "ts/tsShapeInstance.h"
 #include "console/consoleTypes.h"
 #include "math/mathUtils.h"
+#include "gfx/primBuilder.h"
 
 
 AFTER_MODULE_INIT( Sim )
@@ -70,6 +71,10 @@ PSSMLightShadowMap::PSSMLightShadowMap( LightInfo *light )
    for (U32 i = 0; i <= MAX_SPLITS; i++) //% depth distance
       mSplitDist[i] = mPow(F32(i/MAX_SPLITS),2.0f);
 
+   mStaticLightSpace.valid = false;
+   for (U32 i = 0; i < MAX_SPLITS; i++)
+      mStaticSplits[i].dirty = true;
+
    mIsViewDependent = true;
 }
 
@@ -202,8 +207,6 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    PROFILE_SCOPE(PSSMLightShadowMap_render);
 
    const ShadowMapParams *params = mLight->getExtended<ShadowMapParams>();
-   const LightMapParams *lmParams = mLight->getExtended<LightMapParams>();
-   const bool bUseLightmappedGeometry = lmParams ? !lmParams->representedInLightmap || lmParams->includeLightmappedGeometryInShadow : true;
 
    const U32 texSize = getBestTexSize( params->numSplits < 4 ? params->numSplits : 2 );
 
@@ -222,16 +225,14 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    GFXFrustumSaver frustSaver;
    GFXTransformSaver saver;
 
-   // Set our render target
-   GFX->pushActiveRenderTarget();
-   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
-   mTarget->attachTexture( GFXTextureTarget::DepthStencil, mShadowMapDepth );
-   GFX->setActiveRenderTarget( mTarget );
-   GFX->clear( GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0 );
+   const bool cacheStatic = smCacheStaticShadows;
 
    // Calculate our standard light matrices
    MatrixF lightMatrix;
-   calcLightMatrices( lightMatrix, diffuseState->getCameraFrustum() );
+   if ( cacheStatic )
+      _calcStaticLightMatrices( lightMatrix, diffuseState->getCameraFrustum(), params );
+   else
+      calcLightMatrices( lightMatrix, diffuseState->getCameraFrustum() );
    lightMatrix.inverse();
    MatrixF tempProjMat = GFX->getProjectionMatrix();
    tempProjMat.reverseProjection();
@@ -256,142 +257,74 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    TSShapeInstance::smDetailAdjust *= smDetailAdjustScale;
    TSShapeInstance::smSmallestVisiblePixelSize = smSmallestVisiblePixelSize;
 
+   if ( cacheStatic )
+      _updateStaticLayer( renderPass, diffuseState, fullFrustum, lightMatrix, lightViewProj, pnear, pfar );
+
    Vector< Vector<PlaneF> > _extraCull;
    _calcPlanesCullForShadowCasters( _extraCull, fullFrustum, mLight->getDirection() );
 
+   // Set our render target
+   GFX->pushActiveRenderTarget();
+
+   // Start from a copy of the static layer and keep the closest
+   // of it and the dynamic casters.
+   if ( cacheStatic )
+      mStaticTarget->resolveTo( mShadowMapTex );
+
+   mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
+   mTarget->attachTexture( GFXTextureTarget::DepthStencil, mShadowMapDepth );
+   GFX->setActiveRenderTarget( mTarget );
+
+   if ( cacheStatic )
+      GFX->clear( GFXClearStencil | GFXClearZBuffer, ColorI(255,255,255), 0.0f, 0 );
+   else
+      GFX->clear( GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0 );
+
+   mRenderingDynamicLayer = cacheStatic;
+
    for (U32 i = 0; i < mNumSplits; i++)
    {
+      const bool terrainOnly = i == mNumSplits-1 && params->lastSplitTerrainOnly;
+
+      // The terrain is all in the static layer.
+      if ( cacheStatic && terrainOnly )
+         continue;
+
       GFXTransformSaver splitSaver;
 
-      // Calculate a sub-frustum
-      Frustum subFrustum(fullFrustum);
-      subFrustum.cropNearFar(mSplitDist[i], mSplitDist[i+1]);
-
-      // Calculate our AABB in the light's clip space.
-      Box3F clipAABB = _calcClipSpaceAABB(subFrustum, lightViewProj, fullFrustum.getFarDist());
- 
-      // Calculate our crop matrix
-      Point3F scale(2.0f / (clipAABB.maxExtents.x - clipAABB.minExtents.x),
-         2.0f / (clipAABB.maxExtents.y - clipAABB.minExtents.y),
-         1.0f);
-
-      // TODO: This seems to produce less "pops" of the
-      // shadow resolution as the camera spins around and
-      // it should produce pixels that are closer to being
-      // square.
-      //
-      // Still is it the right thing to do?
-      //
-      scale.y = scale.x = ( getMin( scale.x, scale.y ) ); 
-      //scale.x = mFloor(scale.x); 
-      //scale.y = mFloor(scale.y); 
-
-      Point3F offset(   -0.5f * (clipAABB.maxExtents.x + clipAABB.minExtents.x) * scale.x,
-                        -0.5f * (clipAABB.maxExtents.y + clipAABB.minExtents.y) * scale.y,
-                        0.0f );
-
-      MatrixF cropMatrix(true);
-      cropMatrix.scale(scale);
-      cropMatrix.setPosition(offset);
-
-      _roundProjection(lightMatrix, cropMatrix, offset, i);
-
-      cropMatrix.setPosition(offset);      
-
-      // Save scale/offset for shader computations
-      mScaleProj[i].set(scale);
-      mOffsetProj[i].set(offset);
-
-      // Adjust the far plane to the max z we got (maybe add a little to deal with split overlap)
-      bool isOrtho;
+      Frustum croppedFrustum;
+      if ( cacheStatic )
       {
-         F32 left, right, bottom, top, nearDist, farDist;
-         GFX->getFrustum(&left, &right, &bottom, &top, &nearDist, &farDist,&isOrtho);
-         // BTRTODO: Fix me!
-         farDist = clipAABB.maxExtents.z;
-         if (!isOrtho)
-            GFX->setFrustum(left, right, bottom, top, nearDist, farDist);
-         else
-         {
-            // Calculate a new far plane, add a fudge factor to avoid bringing
-            // the far plane in too close.
-            F32 newFar = pfar * clipAABB.maxExtents.z + 1.0f;
-            mFarPlaneScalePSSM[i] = (pfar - pnear) / (newFar - pnear);
-            GFX->setOrtho(left, right, bottom, top, pnear, newFar, true);
-         }
+         // Use the projection the static split was rendered with.
+         GFX->setProjectionMatrix( mStaticSplits[i].proj );
+         croppedFrustum = mStaticSplits[i].croppedFrustum;
       }
+      else
+      {
+         // Calculate a sub-frustum
+         Frustum subFrustum(fullFrustum);
+         subFrustum.cropNearFar(mSplitDist[i], mSplitDist[i+1]);
 
-      // Crop matrix multiply needs to be post-projection.
-      MatrixF alightProj = GFX->getProjectionMatrix();
-      alightProj.reverseProjection();
-      alightProj = cropMatrix * alightProj;
-      alightProj.reverseProjection();
+         // Calculate our AABB in the light's clip space.
+         Box3F clipAABB = _calcClipSpaceAABB(subFrustum, lightViewProj, fullFrustum.getFarDist());
 
-      // Set our new projection
-      GFX->setProjectionMatrix(alightProj);
+         croppedFrustum = _setupSplit( i, clipAABB, lightMatrix, pnear, pfar );
+      }
 
       // Render into the quad of the shadow map we are using.
       GFX->setViewport(mViewports[i]);
 
-      SceneManager* sceneManager = diffuseState->getSceneManager();
-
-      // The frustum is currently the  full size and has not had
-      // cropping applied.
-      //
-      // We make that adjustment here.
-
-      const Frustum& uncroppedFrustum = GFX->getFrustum();
-      Frustum croppedFrustum;
-      scale *= 0.5f;
-      croppedFrustum.set(
-         isOrtho,
-         uncroppedFrustum.getNearLeft() / scale.x,
-         uncroppedFrustum.getNearRight() / scale.x,
-         uncroppedFrustum.getNearTop() / scale.y,
-         uncroppedFrustum.getNearBottom() / scale.y,
-         uncroppedFrustum.getNearDist(),
-         uncroppedFrustum.getFarDist(),
-         uncroppedFrustum.getTransform()
-      );
-
-      MatrixF camera = GFX->getWorldMatrix();
-      camera.inverse();
-      croppedFrustum.setTransform( camera );
-
-      // Setup the scene state and use the diffuse state
-      // camera position and screen metrics values so that
-      // lod is done the same as in the diffuse pass.
-
-      SceneRenderState shadowRenderState
-      (
-         sceneManager,
-         SPT_Shadow,
-         SceneCameraState( diffuseState->getViewport(), croppedFrustum,
-                           GFX->getWorldMatrix(), GFX->getProjectionMatrix() ),
-         renderPass
-      );
-
-      shadowRenderState.getMaterialDelegate().bind( this, &LightShadowMap::getShadowMaterial );
-      shadowRenderState.renderNonLightmappedMeshes( true );
-      shadowRenderState.renderLightmappedMeshes( bUseLightmappedGeometry );
-
-      shadowRenderState.setDiffuseCameraTransform( diffuseState->getCameraTransform() );
-      shadowRenderState.setWorldToScreenScale( diffuseState->getWorldToScreenScale() );
-
-      PlaneSetF planeSet( _extraCull[i].address(), _extraCull[i].size() );
-      shadowRenderState.getCullingState().setExtraPlanesCull( planeSet );
-
       U32 objectMask = SHADOW_TYPEMASK;
-      if ( i == mNumSplits-1 && params->lastSplitTerrainOnly )
+      if ( cacheStatic )
+         objectMask = DynamicCasterTypeMask;
+      else if ( terrainOnly )
          objectMask = TerrainObjectType;
 
-      sceneManager->renderSceneNoLights( &shadowRenderState, objectMask );
-
-      shadowRenderState.getCullingState().clearExtraPlanesCull();
-
-      _debugRender( &shadowRenderState );
+      _renderSplit( renderPass, diffuseState, croppedFrustum, objectMask, &_extraCull[i] );
    }
 
+   mRenderingDynamicLayer = false;
+
    // Restore the original TS lod settings.
    TSShapeInstance::smSmallestVisiblePixelSize = savedSmallestVisible;
    TSShapeInstance::smDetailAdjust = savedDetailAdjust;
@@ -401,6 +334,326 @@ void PSSMLightShadowMap::_render(   RenderPassManager* renderPass,
    GFX->popActiveRenderTarget();
 }
 
+Frustum PSSMLightShadowMap::_setupSplit( U32 splitNum, const Box3F &clipAABB, const MatrixF &lightMat, F32 pnear, F32 pfar )
+{
+   // Calculate our crop matrix
+   Point3F scale(2.0f / (clipAABB.maxExtents.x - clipAABB.minExtents.x),
+      2.0f / (clipAABB.maxExtents.y - clipAABB.minExtents.y),
+      1.0f);
+
+   // TODO: This seems to produce less "pops" of the
+   // shadow resolution as the camera spins around and
+   // it should produce pixels that are closer to being
+   // square.
+   //
+   // Still is it the right thing to do?
+   //
+   scale.y = scale.x = ( getMin( scale.x, scale.y ) ); 
+   //scale.x = mFloor(scale.x); 
+   //scale.y = mFloor(scale.y); 
+
+   Point3F offset(   -0.5f * (clipAABB.maxExtents.x + clipAABB.minExtents.x) * scale.x,
+                     -0.5f * (clipAABB.maxExtents.y + clipAABB.minExtents.y) * scale.y,
+                     0.0f );
+
+   MatrixF cropMatrix(true);
+   cropMatrix.scale(scale);
+   cropMatrix.setPosition(offset);
+
+   _roundProjection(lightMat, cropMatrix, offset, splitNum);
+
+   cropMatrix.setPosition(offset);      
+
+   // Save scale/offset for shader computations
+   mScaleProj[splitNum].set(scale);
+   mOffsetProj[splitNum].set(offset);
+
+   // Adjust the far plane to the max z we got (maybe add a little to deal with split overlap)
+   bool isOrtho;
+   {
+      F32 left, right, bottom, top, nearDist, farDist;
+      GFX->getFrustum(&left, &right, &bottom, &top, &nearDist, &farDist,&isOrtho);
+      // BTRTODO: Fix me!
+      farDist = clipAABB.maxExtents.z;
+      if (!isOrtho)
+         GFX->setFrustum(left, right, bottom, top, nearDist, farDist);
+      else
+      {
+         // Calculate a new far plane, add a fudge factor to avoid bringing
+         // the far plane in too close.
+         F32 newFar = pfar * clipAABB.maxExtents.z + 1.0f;
+         mFarPlaneScalePSSM[splitNum] = (pfar - pnear) / (newFar - pnear);
+         GFX->setOrtho(left, right, bottom, top, pnear, newFar, true);
+      }
+   }
+
+   // Crop matrix multiply needs to be post-projection.
+   MatrixF alightProj = GFX->getProjectionMatrix();
+   alightProj.reverseProjection();
+   alightProj = cropMatrix * alightProj;
+   alightProj.reverseProjection();
+
+   // Set our new projection
+   GFX->setProjectionMatrix(alightProj);
+
+   // The frustum is currently the  full size and has not had
+   // cropping applied.
+   //
+   // We make that adjustment here.
+
+   const Frustum& uncroppedFrustum = GFX->getFrustum();
+   Frustum croppedFrustum;
+   scale *= 0.5f;
+   croppedFrustum.set(
+      isOrtho,
+      uncroppedFrustum.getNearLeft() / scale.x,
+      uncroppedFrustum.getNearRight() / scale.x,
+      uncroppedFrustum.getNearTop() / scale.y,
+      uncroppedFrustum.getNearBottom() / scale.y,
+      uncroppedFrustum.getNearDist(),
+      uncroppedFrustum.getFarDist(),
+      uncroppedFrustum.getTransform()
+   );
+
+   MatrixF camera = GFX->getWorldMatrix();
+   camera.inverse();
+   croppedFrustum.setTransform( camera );
+
+   return croppedFrustum;
+}
+
+void PSSMLightShadowMap::_renderSplit( RenderPassManager *renderPass,
+                                       const SceneRenderState *diffuseState,
+                                       const Frustum &croppedFrustum,
+                                       U32 objectMask,
+                                       const Vector<PlaneF> *extraCull )
+{
+   const LightMapParams *lmParams = mLight->getExtended<LightMapParams>();
+   const bool bUseLightmappedGeometry = lmParams ? !lmParams->representedInLightmap || lmParams->includeLightmappedGeometryInShadow : true;
+
+   SceneManager* sceneManager = diffuseState->getSceneManager();
+
+   // Setup the scene state and use the diffuse state
+   // camera position and screen metrics values so that
+   // lod is done the same as in the diffuse pass.
+
+   SceneRenderState shadowRenderState
+   (
+      sceneManager,
+      SPT_Shadow,
+      SceneCameraState( diffuseState->getViewport(), croppedFrustum,
+                        GFX->getWorldMatrix(), GFX->getProjectionMatrix() ),
+      renderPass
+   );
+
+   shadowRenderState.getMaterialDelegate().bind( this, &LightShadowMap::getShadowMaterial );
+   shadowRenderState.getObjectFilter().bind( this, &PSSMLightShadowMap::_isLayerCaster );
+   shadowRenderState.renderNonLightmappedMeshes( true );
+   shadowRenderState.renderLightmappedMeshes( bUseLightmappedGeometry );
+
+   shadowRenderState.setDiffuseCameraTransform( diffuseState->getCameraTransform() );
+   shadowRenderState.setWorldToScreenScale( diffuseState->getWorldToScreenScale() );
+
+   if ( extraCull )
+   {
+      PlaneSetF planeSet( extraCull->address(), extraCull->size() );
+      shadowRenderState.getCullingState().setExtraPlanesCull( planeSet );
+   }
+
+   sceneManager->renderSceneNoLights( &shadowRenderState, objectMask );
+
+   shadowRenderState.getCullingState().clearExtraPlanesCull();
+
+   _debugRender( &shadowRenderState );
+}
+
+void PSSMLightShadowMap::_calcStaticLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum, const ShadowMapParams *params )
+{
+   StaticLightSpace &space = mStaticLightSpace;
+
+   if (  space.valid &&
+         space.lightDir == mLight->getDirection() &&
+         space.shadowDistance == params->shadowDistance )
+   {
+      // Does the shadowed area around the camera still fit?
+      Box3F viewBB( -params->shadowDistance, -params->shadowDistance, -params->shadowDistance,
+                     params->shadowDistance, params->shadowDistance, params->shadowDistance );
+      viewFrustum.getTransform().mul( viewBB );
+      space.lightViewProj.mul( viewBB );
+
+      if ( Box3F( -1.0f, -1.0f, 0.0f, 1.0f, 1.0f, 1.0f ).isContained( viewBB ) )
+      {
+         outLightMatrix = space.lightMatrix;
+         mLight->setRange( space.lightRange );
+         mLight->setPosition( space.lightPos );
+         GFX->setOrtho( space.left, space.right, space.bottom, space.top, space.nearDist, space.farDist, true );
+         return;
+      }
+   }
+
+   calcLightMatrices( outLightMatrix, viewFrustum, 1.0f + smStaticCacheMargin );
+
+   space.valid = true;
+   space.lightDir = mLight->getDirection();
+   space.shadowDistance = params->shadowDistance;
+   space.lightMatrix = outLightMatrix;
+   space.lightPos = mLight->getPosition();
+   space.lightRange = mLight->getRange();
+   GFX->getFrustum( &space.left, &space.right, &space.bottom, &space.top, &space.nearDist, &space.farDist, NULL );
+
+   MatrixF proj = GFX->getProjectionMatrix();
+   proj.reverseProjection();
+   MatrixF worldToLight = outLightMatrix;
+   worldToLight.inverse();
+   space.lightViewProj = proj * worldToLight;
+
+   // Everything in the static layer moved.
+   for ( U32 i = 0; i < MAX_SPLITS; i++ )
+      mStaticSplits[i].dirty = true;
+}
+
+void PSSMLightShadowMap::_updateStaticLayer(  RenderPassManager *renderPass,
+                                             const SceneRenderState *diffuseState,
+                                             const Frustum &fullFrustum,
+                                             const MatrixF &lightMatrix,
+                                             const MatrixF &lightViewProj,
+                                             F32 pnear, F32 pfar )
+{
+   PROFILE_SCOPE(PSSMLightShadowMap_updateStaticLayer);
+
+   const ShadowMapParams *params = mLight->getExtended<ShadowMapParams>();
+
+   if ( mStaticShadowMapTex.isNull() )
+   {
+      mStaticShadowMapTex.set(   mShadowMapTex->getWidth(), mShadowMapTex->getHeight(), 
+                                 ShadowMapFormat, &ShadowMapProfile, 
+                                 "PSSMLightShadowMap static" );
+
+      for ( U32 i = 0; i < MAX_SPLITS; i++ )
+         mStaticSplits[i].dirty = true;
+   }
+
+   // Find the splits that need to be rendered again, which includes
+   // the ones that don't cover their part of the view any more.
+   U32 numDirty = 0;
+   for ( U32 i = 0; i < mNumSplits; i++ )
+   {
+      StaticSplit &split = mStaticSplits[i];
+
+      Frustum subFrustum( fullFrustum );
+      subFrustum.cropNearFar( mSplitDist[i], mSplitDist[i+1] );
+      const Box3F clipAABB = _calcClipSpaceAABB( subFrustum, lightViewProj, fullFrustum.getFarDist() );
+
+      if ( !split.dirty && split.clipBounds.isContained( clipAABB ) )
+      {
+         smStaticLayerReuses++;
+         continue;
+      }
+
+      // Leave some room to move around in.
+      const Point3F center = clipAABB.getCenter();
+      const Point3F halfSize = ( clipAABB.maxExtents - center ) * ( 1.0f + smStaticCacheMargin );
+      split.clipBounds.set( center - halfSize, center + halfSize );
+      split.dirty = true;
+      numDirty++;
+   }
+
+   if ( numDirty == 0 )
+      return;
+
+   if ( mStaticTarget.isNull() )
+      mStaticTarget = GFX->allocRenderToTextureTarget();
+
+   GFX->pushActiveRenderTarget();
+   mStaticTarget->attachTexture( GFXTextureTarget::Color0, mStaticShadowMapTex );
+   mStaticTarget->attachTexture( GFXTextureTarget::DepthStencil, mShadowMapDepth );
+   GFX->setActiveRenderTarget( mStaticTarget );
+
+   // A clear covers the whole target, so only use it if we can.
+   const bool clearAll = numDirty == mNumSplits;
+   if ( clearAll )
+      GFX->clear( GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0 );
+
+   MatrixF clipToWorld( lightViewProj );
+   clipToWorld.inverse();
+
+   for ( U32 i = 0; i < mNumSplits; i++ )
+   {
+      StaticSplit &split = mStaticSplits[i];
+      if ( !split.dirty )
+         continue;
+
+      GFXTransformSaver splitSaver;
+
+      GFX->setViewport( mViewports[i] );
+      if ( !clearAll )
+         _clearViewport();
+
+      split.croppedFrustum = _setupSplit( i, split.clipBounds, lightMatrix, pnear, pfar );
+      split.proj = GFX->getProjectionMatrix();
+
+      // Anything between the light and the split can cast into it.
+      Box3F casterBounds( split.clipBounds );
+      casterBounds.minExtents.z = getMin( casterBounds.minExtents.z, 0.0f );
+      split.worldBounds = casterBounds;
+      clipToWorld.mul( split.worldBounds );
+
+      U32 objectMask = StaticCasterTypeMask;
+      if ( i == mNumSplits-1 && params->lastSplitTerrainOnly )
+         objectMask = TerrainObjectType;
+
+      // The extra culling planes only work for the current view,
+      // so the static casters are only culled by the split.
+      _renderSplit( renderPass, diffuseState, split.croppedFrustum, objectMask, NULL );
+
+      split.dirty = false;
+      smStaticLayerUpdates++;
+   }
+
+   mStaticTarget->resolve();
+   GFX->popActiveRenderTarget();
+}
+
+void PSSMLightShadowMap::_clearViewport()
+{
+   if ( mClearSB.isNull() )
+   {
+      GFXStateBlockDesc desc;
+      desc.setZReadWrite( true, true );
+      desc.zFunc = GFXCmpAlways;
+      desc.setCullMode( GFXCullNone );
+      mClearSB = GFX->createStateBlock( desc );
+   }
+
+   GFXTransformSaver saver;
+   const MatrixF savedWorld = GFX->getWorldMatrix();
+
+   GFX->setWorldMatrix( MatrixF::Identity );
+   GFX->setViewMatrix( MatrixF::Identity );
+   GFX->setProjectionMatrix( MatrixF::Identity );
+   GFX->setStateBlock( mClearSB );
+
+   // An empty shadow at the far plane, which is zero with our reversed depth.
+   PrimBuild::begin( GFXTriangleStrip, 4 );
+      PrimBuild::color( ColorI::WHITE );
+      PrimBuild::vertex3f( -1.0f, -1.0f, 0.0f );
+      PrimBuild::vertex3f( -1.0f,  1.0f, 0.0f );
+      PrimBuild::vertex3f(  1.0f, -1.0f, 0.0f );
+      PrimBuild::vertex3f(  1.0f,  1.0f, 0.0f );
+   PrimBuild::end();
+
+   GFX->setWorldMatrix( savedWorld );
+}
+
+void PSSMLightShadowMap::_invalidateStaticLayer( const Box3F &worldBox )
+{
+   for ( U32 i = 0; i < mNumSplits; i++ )
+   {
+      if ( !mStaticSplits[i].dirty && mStaticSplits[i].worldBounds.isOverlapped( worldBox ) )
+         mStaticSplits[i].dirty = true;
+   }
+}
+
 void PSSMLightShadowMap::setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc)
 {
    PROFILE_SCOPE( PSSMLightShadowMap_setShaderParameters );
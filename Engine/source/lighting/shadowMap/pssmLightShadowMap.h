@@ -28,6 +28,9 @@
 #ifndef _MATHUTIL_FRUSTUM_H_
 #include "math/util/frustum.h"
 #endif
+#ifndef _GFXSTATEBLOCK_H_
+#include "gfx/gfxStateBlock.h"
+#endif
 
 
 class PSSMLightShadowMap : public LightShadowMap
@@ -59,6 +62,37 @@ protected:
    void _calcPlanesCullForShadowCasters(Vector< Vector<PlaneF> > &out, const Frustum &viewFrustum, const Point3F &_ligthDir);
    void _roundProjection(const MatrixF& lightMat, const MatrixF& cropMatrix, Point3F &offset, U32 splitNum);
 
+   /// Set the projection for a split that covers @a clipAABB in the light's
+   /// clip space and return the frustum to cull its casters with.
+   Frustum _setupSplit( U32 splitNum, const Box3F &clipAABB, const MatrixF &lightMat, F32 pnear, F32 pfar );
+
+   /// Render the casters in @a objectMask into the split the current
+   /// projection is set up for.
+   void _renderSplit(   RenderPassManager *renderPass,
+                        const SceneRenderState *diffuseState,
+                        const Frustum &croppedFrustum,
+                        U32 objectMask,
+                        const Vector<PlaneF> *extraCull );
+
+   /// Like calcLightMatrices(), but reuses the light space the static layer
+   /// was rendered in for as long as the shadowed area fits in it.
+   void _calcStaticLightMatrices( MatrixF &outLightMatrix, const Frustum &viewFrustum, const ShadowMapParams *params );
+
+   /// Render the static casters into the splits of the static layer that
+   /// are missing, out of date or don't cover their part of the view.
+   void _updateStaticLayer(   RenderPassManager *renderPass,
+                              const SceneRenderState *diffuseState,
+                              const Frustum &fullFrustum,
+                              const MatrixF &lightMatrix,
+                              const MatrixF &lightViewProj,
+                              F32 pnear, F32 pfar );
+
+   /// Fill the current viewport with an empty shadow.
+   void _clearViewport();
+
+   // LightShadowMap
+   void _invalidateStaticLayer( const Box3F &worldBox ) override;
+
    static const S32 MAX_SPLITS = 4;
    U32 mNumSplits;
    F32 mSplitDist[MAX_SPLITS+1];   // +1 because we store a cap
@@ -67,6 +101,40 @@ protected:
    Point3F mOffsetProj[MAX_SPLITS];
    Point4F mFarPlaneScalePSSM;
    F32 mLogWeight;
+
+   /// The light space the static layer was rendered in.
+   struct StaticLightSpace
+   {
+      bool valid;
+      VectorF lightDir;
+      F32 shadowDistance;
+      MatrixF lightMatrix;
+      MatrixF lightViewProj;
+      Point3F lightPos;
+      Point3F lightRange;
+      F32 left, right, bottom, top, nearDist, farDist;
+   };
+
+   StaticLightSpace mStaticLightSpace;
+
+   /// What each split of the static layer was rendered with.
+   struct StaticSplit
+   {
+      bool dirty;
+
+      /// The part of the light's clip space the split covers.
+      Box3F clipBounds;
+
+      /// The world space box around clipBounds.
+      Box3F worldBounds;
+
+      MatrixF proj;
+      Frustum croppedFrustum;
+   };
+
+   StaticSplit mStaticSplits[MAX_SPLITS];
+
+   GFXStateBlockRef mClearSB;
 };
 
 #endif
@@ -32,6 +32,7 @@
 #include "gfx/gfxTextureManager.h"
 #include "core/module.h"
 #include "console/consoleTypes.h"
+#include "console/engineAPI.h"
 
 
 GFX_ImplementTextureProfile(ShadowMapTexProfile,
@@ -91,6 +92,37 @@ AFTER_MODULE_INIT( Sim )
       TypeF32, &ShadowMapPass::smShadowsTurnRate,
       "Minimum angle moved per frame to determine that we are turning quickly.\n");
    Con::addVariableNotify("$pref::Shadows::turnRate", shadowCallback);
+
+   Con::addVariable( "$pref::Shadows::cacheStatic",
+      TypeBool, &LightShadowMap::smCacheStaticShadows,
+      "@brief If true, spot light and PSSM shadows keep the static casters in a cached layer.\n"
+      "The layer is only rendered again when a static caster inside it is added, removed or moved, "
+      "and each shadow update just draws the dynamic casters over it.  Objects with StaticShapeObjectType "
+      "are static casters, so any wind, animation or LOD change on them doesn't show up in the shadow "
+      "until the layer is rendered again.\n"
+      "@see invalidateStaticShadows()\n"
+      "@ingroup AdvancedLighting\n" );
+   Con::addVariableNotify( "$pref::Shadows::cacheStatic", callabck );
+   Con::addVariableNotify( "$pref::Shadows::cacheStatic", Con::NotifyDelegate( &LightShadowMap::updateStaticShadowHooks ) );
+
+   Con::addVariable( "$pref::Shadows::staticCacheMargin",
+      TypeF32, &LightShadowMap::smStaticCacheMargin,
+      "@brief How much bigger than needed the cached static PSSM splits are made.\n"
+      "A bigger margin lets the splits be reused for longer while the camera moves, but "
+      "costs them the same fraction of their resolution.\n"
+      "@ingroup AdvancedLighting\n" );
+   Con::addVariableNotify( "$pref::Shadows::staticCacheMargin", Con::NotifyDelegate( &LightShadowMap::invalidateAllStaticShadows ) );
+
+   LightShadowMap::updateStaticShadowHooks();
+}
+
+DefineEngineFunction( invalidateStaticShadows, void, (),,
+   "@brief Renders the cached static shadow layers again on their next update.\n"
+   "Call this after changing a static shadow caster in a way that doesn't move it.\n"
+   "@see $pref::Shadows::cacheStatic\n"
+   "@ingroup AdvancedLighting\n" )
+{
+   LightShadowMap::invalidateAllStaticShadows();
 }
 
 Signal<void(void)> ShadowMapManager::smShadowDeactivateSignal;
@@ -108,6 +108,14 @@ ShadowMapPass::ShadowMapPass(LightManager* lightManager, ShadowMapManager* shado
       "The shadow stats showing the number of render target changes for shadow maps in this frame.\n"
       "@ingroup AdvancedLighting\n" );
 
+   Con::addVariable( "$ShadowStats::staticLayerUpdates", TypeS32, &LightShadowMap::smStaticLayerUpdates,
+      "The shadow stats showing the number of cached static shadow layers and PSSM splits rendered this frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
+   Con::addVariable( "$ShadowStats::staticLayerReuses", TypeS32, &LightShadowMap::smStaticLayerReuses,
+      "The shadow stats showing the number of cached static shadow layers and PSSM splits reused this frame.\n"
+      "@ingroup AdvancedLighting\n" );
+
    Con::addVariable( "$ShadowStats::poolTexCount", TypeS32, &smShadowPoolTexturesCount,
       "The shadow stats showing the number of shadow textures in the shadow texture pool.\n"
       "@ingroup AdvancedLighting\n" );
@@ -135,6 +143,7 @@ void ShadowMapPass::render(   SceneManager *sceneManager,
    smActiveShadowMaps = 0;
    smUpdatedShadowMaps = 0;
    smNearShadowMaps = 0;
+   LightShadowMap::resetStaticStats();
    GFXDeviceStatistics stats;
    stats.start( GFX->getDeviceStatistics() );
 
@@ -36,6 +36,7 @@
 const MatInstanceHookType ShadowMaterialHook::Type( "ShadowMap" );
 
 ShadowMaterialHook::ShadowMaterialHook()
+   : mDynamicLayerMat( NULL )
 {
    dMemset( mShadowMat, 0, sizeof( mShadowMat ) );
 }
@@ -44,6 +45,8 @@ ShadowMaterialHook::~ShadowMaterialHook()
 {
    for ( U32 i = 0; i < ShadowType_Count; i++ )
       SAFE_DELETE( mShadowMat[i] );
+
+   SAFE_DELETE( mDynamicLayerMat );
 }
 
 void ShadowMaterialHook::init( BaseMatInstance *inMat )
@@ -112,6 +115,22 @@ void ShadowMaterialHook::init( BaseMatInstance *inMat )
    
    mShadowMat[ShadowType_Spot] = newMat;
 
+   // The shadow maps hold depth in the red channel, so a min blend
+   // does the depth test against a copied static layer for us.
+   newMat = new ShadowMatInstance( shadowMat );
+   newMat->setUserObject( inMat->getUserObject() );
+   newMat->getFeaturesDelegate().bind( &ShadowMaterialHook::_overrideFeatures );
+   GFXStateBlockDesc minBlend( forced );
+   minBlend.setBlend( true, GFXBlendOne, GFXBlendOne, GFXBlendOpMin );
+   newMat->addStateBlockDesc( minBlend );
+   if( !newMat->init( features, inMat->getVertexFormat() ) )
+   {
+      SAFE_DELETE( newMat );
+      newMat = MATMGR->createWarningMatInstance();
+   }
+
+   mDynamicLayerMat = newMat;
+
    newMat = new ShadowMatInstance( shadowMat );
    newMat->setUserObject( inMat->getUserObject() );
    newMat->getFeaturesDelegate().bind( &ShadowMaterialHook::_overrideFeatures );
@@ -158,7 +177,7 @@ void ShadowMaterialHook::init( BaseMatInstance *inMat )
    */
 }
 
-BaseMatInstance* ShadowMaterialHook::getShadowMat( ShadowType type ) const
+BaseMatInstance* ShadowMaterialHook::getShadowMat( ShadowType type, bool dynamicLayer ) const
 { 
    AssertFatal( type < ShadowType_Count, "ShadowMaterialHook::getShadowMat() - Bad light type!" );
 
@@ -166,7 +185,7 @@ BaseMatInstance* ShadowMaterialHook::getShadowMat( ShadowType type ) const
    // spotlight material for shadows.
    if (  type == ShadowType_Spot ||         
          type == ShadowType_PSSM )
-      return mShadowMat[ShadowType_Spot];   
+      return dynamicLayer ? mDynamicLayerMat : mShadowMat[ShadowType_Spot];   
 
    // Get the specialized shadow material.
    return mShadowMat[type]; 
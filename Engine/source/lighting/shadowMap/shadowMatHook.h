@@ -61,7 +61,11 @@ public:
    /// The material hook type.
    static const MatInstanceHookType Type;
 
-   BaseMatInstance* getShadowMat( ShadowType type ) const;
+   /// Returns the shadow material for the shadow type.  If @a dynamicLayer
+   /// is set, the material keeps the closest depth of what it renders and
+   /// what is already in the target, so dynamic casters can be drawn over a
+   /// copy of a cached static layer without its depth buffer.
+   BaseMatInstance* getShadowMat( ShadowType type, bool dynamicLayer = false ) const;
 
    void init( BaseMatInstance *mat );
 
@@ -75,6 +79,9 @@ protected:
    /// 
    BaseMatInstance* mShadowMat[ShadowType_Count];
 
+   /// The spot and PSSM material for the dynamic layer.
+   BaseMatInstance* mDynamicLayerMat;
+
 
 };
 
@@ -34,7 +34,10 @@
 #include "renderInstance/renderPassManager.h"
 
 SingleLightShadowMap::SingleLightShadowMap(  LightInfo *light )
-   :  LightShadowMap( light )
+   :  LightShadowMap( light ),
+      mStaticDirty( true ),
+      mStaticBounds( Box3F::Invalid ),
+      mStaticWorldToLightProj( true )
 {
 }
 
@@ -48,9 +51,6 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
 {
    PROFILE_SCOPE(SingleLightShadowMap_render);
 
-   const LightMapParams *lmParams = mLight->getExtended<LightMapParams>();
-   const bool bUseLightmappedGeometry = lmParams ? !lmParams->representedInLightmap || lmParams->includeLightmappedGeometryInShadow : true;
-
    const U32 texSize = getBestTexSize();
 
    if (  mShadowMapTex.isNull() ||
@@ -75,14 +75,100 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
    lightProj.reverseProjection();
    mWorldToLightProj = lightProj * lightMatrix;
 
+   const bool cacheStatic = smCacheStaticShadows;
+   if ( cacheStatic )
+      _updateStaticLayer( renderPass, diffuseState );
+
    // Render the shadowmap!
    GFX->pushActiveRenderTarget();
+
+   // Start from a copy of the static layer and keep the closest
+   // of it and the dynamic casters.
+   if ( cacheStatic )
+      mStaticTarget->resolveTo( mShadowMapTex );
+
    mTarget->attachTexture( GFXTextureTarget::Color0, mShadowMapTex );
    mTarget->attachTexture( GFXTextureTarget::DepthStencil, 
       _getDepthTarget( mShadowMapTex->getWidth(), mShadowMapTex->getHeight() ) );
    GFX->setActiveRenderTarget(mTarget);
+
+   if ( cacheStatic )
+   {
+      GFX->clear(GFXClearStencil | GFXClearZBuffer, ColorI(255,255,255), 0.0f, 0);
+
+      mRenderingDynamicLayer = true;
+      _renderCasters( renderPass, diffuseState, DynamicCasterTypeMask );
+      mRenderingDynamicLayer = false;
+   }
+   else
+   {
+      GFX->clear(GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0);
+      _renderCasters( renderPass, diffuseState, SHADOW_TYPEMASK );
+   }
+
+   mTarget->resolve();
+   GFX->popActiveRenderTarget();
+}
+
+void SingleLightShadowMap::_updateStaticLayer(  RenderPassManager* renderPass,
+                                                const SceneRenderState *diffuseState )
+{
+   // The static layer is good as long as the light didn't
+   // move and nothing static changed inside its range.
+   if (  !mStaticDirty &&
+         mStaticShadowMapTex.isValid() &&
+         mStaticShadowMapTex->getWidth() == mTexSize &&
+         dMemcmp( (const F32*)mStaticWorldToLightProj, (const F32*)mWorldToLightProj, sizeof( F32 ) * 16 ) == 0 )
+   {
+      smStaticLayerReuses++;
+      return;
+   }
+
+   PROFILE_SCOPE(SingleLightShadowMap_updateStaticLayer);
+
+   if (  mStaticShadowMapTex.isNull() ||
+         mStaticShadowMapTex->getWidth() != mTexSize )
+      mStaticShadowMapTex.set(   mTexSize, mTexSize, 
+                                 ShadowMapFormat, &ShadowMapProfile, 
+                                 "SingleLightShadowMap static" );
+
+   if ( mStaticTarget.isNull() )
+      mStaticTarget = GFX->allocRenderToTextureTarget();
+
+   GFX->pushActiveRenderTarget();
+   mStaticTarget->attachTexture( GFXTextureTarget::Color0, mStaticShadowMapTex );
+   mStaticTarget->attachTexture( GFXTextureTarget::DepthStencil, 
+      _getDepthTarget( mStaticShadowMapTex->getWidth(), mStaticShadowMapTex->getHeight() ) );
+   GFX->setActiveRenderTarget( mStaticTarget );
    GFX->clear(GFXClearStencil | GFXClearZBuffer | GFXClearTarget, ColorI(255,255,255), 0.0f, 0);
 
+   _renderCasters( renderPass, diffuseState, StaticCasterTypeMask );
+
+   mStaticTarget->resolve();
+   GFX->popActiveRenderTarget();
+
+   const Point3F &pos = mLight->getPosition();
+   const F32 range = mLight->getRange().x;
+   mStaticBounds.set( pos - Point3F( range, range, range ), pos + Point3F( range, range, range ) );
+   mStaticWorldToLightProj = mWorldToLightProj;
+   mStaticDirty = false;
+
+   smStaticLayerUpdates++;
+}
+
+void SingleLightShadowMap::_invalidateStaticLayer( const Box3F &worldBox )
+{
+   if ( mStaticBounds.isOverlapped( worldBox ) )
+      mStaticDirty = true;
+}
+
+void SingleLightShadowMap::_renderCasters(   RenderPassManager* renderPass,
+                                             const SceneRenderState *diffuseState,
+                                             U32 objectMask )
+{
+   const LightMapParams *lmParams = mLight->getExtended<LightMapParams>();
+   const bool bUseLightmappedGeometry = lmParams ? !lmParams->representedInLightmap || lmParams->includeLightmappedGeometryInShadow : true;
+
    SceneManager* sceneManager = diffuseState->getSceneManager();
    
    SceneRenderState shadowRenderState
@@ -94,17 +180,15 @@ void SingleLightShadowMap::_render( RenderPassManager* renderPass,
    );
 
    shadowRenderState.getMaterialDelegate().bind( this, &LightShadowMap::getShadowMaterial );
+   shadowRenderState.getObjectFilter().bind( this, &SingleLightShadowMap::_isLayerCaster );
    shadowRenderState.renderNonLightmappedMeshes( true );
    shadowRenderState.renderLightmappedMeshes( bUseLightmappedGeometry );
    shadowRenderState.setDiffuseCameraTransform( diffuseState->getCameraTransform() );
    shadowRenderState.setWorldToScreenScale( diffuseState->getWorldToScreenScale() );
 
-   sceneManager->renderSceneNoLights( &shadowRenderState, SHADOW_TYPEMASK );
+   sceneManager->renderSceneNoLights( &shadowRenderState, objectMask );
 
    _debugRender( &shadowRenderState );
-
-   mTarget->resolve();
-   GFX->popActiveRenderTarget();
 }
 
 void SingleLightShadowMap::setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc)
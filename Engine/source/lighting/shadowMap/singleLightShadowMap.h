@@ -40,6 +40,28 @@ public:
    ShadowType getShadowType() const override { return ShadowType_Spot; }
    void _render( RenderPassManager* renderPass, const SceneRenderState *diffuseState ) override;
    void setShaderParameters(GFXShaderConstBuffer* params, LightingShaderConstants* lsc) override;
+
+protected:
+
+   // LightShadowMap
+   void _invalidateStaticLayer( const Box3F &worldBox ) override;
+
+   /// Render the casters in @a objectMask into the active target.
+   void _renderCasters( RenderPassManager* renderPass, const SceneRenderState *diffuseState, U32 objectMask );
+
+   /// Render the static casters into the static layer if it is missing or
+   /// out of date.
+   void _updateStaticLayer( RenderPassManager* renderPass, const SceneRenderState *diffuseState );
+
+   /// Set when a static caster inside the static layer changes.
+   bool mStaticDirty;
+
+   /// The light's range around its position when the static layer was
+   /// rendered, which is all it can cover.
+   Box3F mStaticBounds;
+
+   /// The light projection the static layer was rendered with.
+   MatrixF mStaticWorldToLightProj;
 };
 
 
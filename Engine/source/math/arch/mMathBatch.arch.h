@@ -0,0 +1,74 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _MMATHBATCH_ARCH_H_
+#define _MMATHBATCH_ARCH_H_
+
+// The C versions are always available.
+extern void m_matF_x_point3F_batch_C( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count );
+extern void m_box3F_x_planes_batch_C( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults );
+extern void m_sphereF_x_planes_batch_C( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults );
+extern void m_matF_x_matF_batch_C( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count );
+
+#if (defined( TORQUE_CPU_X86 ) || defined( TORQUE_CPU_X64 ))
+# // x86 CPU family implementations
+# define TORQUE_MATH_BATCH_X86
+
+// GCC and Clang only emit SIMD instructions the target allows, so the
+// functions using them are individually tagged instead of building the
+// whole file with -msse4.1 or -mavx.  MSVC has no such restriction.
+# if defined( TORQUE_COMPILER_GCC ) || defined( __clang__ )
+#  define TORQUE_MATH_BATCH_TARGET( isa ) __attribute__(( target( isa ) ))
+# else
+#  define TORQUE_MATH_BATCH_TARGET( isa )
+# endif
+
+extern void m_matF_x_point3F_batch_SSE4( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count );
+extern void m_box3F_x_planes_batch_SSE4( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults );
+extern void m_sphereF_x_planes_batch_SSE4( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults );
+extern void m_matF_x_matF_batch_SSE4( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count );
+extern void m_matF_x_matF_SSE4( const F32 *a, const F32 *b, F32 *result );
+
+extern void m_matF_x_point3F_batch_AVX( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count );
+extern void m_box3F_x_planes_batch_AVX( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults );
+extern void m_sphereF_x_planes_batch_AVX( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults );
+extern void m_matF_x_matF_batch_AVX( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count );
+
+/// Turns the lane masks of the SIMD overlap tests into OverlapTestResults.
+inline void m_writeOverlapResults_batch( S32 outsideBits, S32 intersectBits, U32 numLanes, S8 *outResults )
+{
+   for ( U32 k = 0; k < numLanes; k++ )
+   {
+      if ( outsideBits & ( 1 << k ) )
+         outResults[k] = GeometryOutside;
+      else if ( intersectBits & ( 1 << k ) )
+         outResults[k] = GeometryIntersecting;
+      else
+         outResults[k] = GeometryInside;
+   }
+}
+#
+#else
+# // Other CPU types go here...
+#endif
+
+#endif // _MMATHBATCH_ARCH_H_
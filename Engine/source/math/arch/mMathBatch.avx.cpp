@@ -0,0 +1,184 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "math/mMathBatch.h"
+#include "math/arch/mMathBatch.arch.h"
+
+#if defined( TORQUE_MATH_BATCH_X86 )
+#include <immintrin.h>
+
+// The same algorithms as the SSE4.1 versions, eight elements at a time.
+// Only AVX float instructions are used and no FMA, so the results are
+// identical to the C and SSE4.1 versions.
+
+TORQUE_MATH_BATCH_TARGET( "avx" )
+void m_matF_x_point3F_batch_AVX( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count )
+{
+   const __m256 m0 = _mm256_set1_ps( m[0] ), m1 = _mm256_set1_ps( m[1] ), m2  = _mm256_set1_ps( m[2] ),  m3  = _mm256_set1_ps( m[3] );
+   const __m256 m4 = _mm256_set1_ps( m[4] ), m5 = _mm256_set1_ps( m[5] ), m6  = _mm256_set1_ps( m[6] ),  m7  = _mm256_set1_ps( m[7] );
+   const __m256 m8 = _mm256_set1_ps( m[8] ), m9 = _mm256_set1_ps( m[9] ), m10 = _mm256_set1_ps( m[10] ), m11 = _mm256_set1_ps( m[11] );
+
+   U32 i = 0;
+   for ( ; i + 8 <= count; i += 8 )
+   {
+      const __m256 px = _mm256_loadu_ps( x + i );
+      const __m256 py = _mm256_loadu_ps( y + i );
+      const __m256 pz = _mm256_loadu_ps( z + i );
+
+      _mm256_storeu_ps( outX + i, _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m0, px ), _mm256_mul_ps( m1, py ) ), _mm256_mul_ps( m2, pz ) ), m3 ) );
+      _mm256_storeu_ps( outY + i, _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m4, px ), _mm256_mul_ps( m5, py ) ), _mm256_mul_ps( m6, pz ) ), m7 ) );
+      _mm256_storeu_ps( outZ + i, _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( m8, px ), _mm256_mul_ps( m9, py ) ), _mm256_mul_ps( m10, pz ) ), m11 ) );
+   }
+
+   if ( i < count )
+      m_matF_x_point3F_batch_C( m, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i );
+}
+
+TORQUE_MATH_BATCH_TARGET( "avx" )
+void m_box3F_x_planes_batch_AVX( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults )
+{
+   const __m256 backEpsilon = _mm256_set1_ps( -0.005f );
+   const __m256 frontEpsilon = _mm256_set1_ps( 0.005f );
+
+   U32 i = 0;
+   for ( ; i + 8 <= count; i += 8 )
+   {
+      const __m256 bMinX = _mm256_loadu_ps( minX + i );
+      const __m256 bMinY = _mm256_loadu_ps( minY + i );
+      const __m256 bMinZ = _mm256_loadu_ps( minZ + i );
+      const __m256 bMaxX = _mm256_loadu_ps( maxX + i );
+      const __m256 bMaxY = _mm256_loadu_ps( maxY + i );
+      const __m256 bMaxZ = _mm256_loadu_ps( maxZ + i );
+
+      __m256 outside = _mm256_setzero_ps();
+      __m256 intersect = _mm256_setzero_ps();
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+         const __m256 nx = _mm256_set1_ps( plane.x );
+         const __m256 ny = _mm256_set1_ps( plane.y );
+         const __m256 nz = _mm256_set1_ps( plane.z );
+         const __m256 d = _mm256_set1_ps( plane.d );
+
+         // The normal is the same for every lane, so picking the
+         // positive and negative vertices is just picking arrays.
+         const bool posX = plane.x > 0.0f;
+         const bool posY = plane.y > 0.0f;
+         const bool posZ = plane.z > 0.0f;
+
+         const __m256 pDist = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps(
+            _mm256_mul_ps( nx, posX ? bMaxX : bMinX ),
+            _mm256_mul_ps( ny, posY ? bMaxY : bMinY ) ),
+            _mm256_mul_ps( nz, posZ ? bMaxZ : bMinZ ) ), d );
+         outside = _mm256_or_ps( outside, _mm256_cmp_ps( pDist, backEpsilon, _CMP_LE_OQ ) );
+
+         const __m256 nDist = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps(
+            _mm256_mul_ps( nx, posX ? bMinX : bMaxX ),
+            _mm256_mul_ps( ny, posY ? bMinY : bMaxY ) ),
+            _mm256_mul_ps( nz, posZ ? bMinZ : bMaxZ ) ), d );
+         intersect = _mm256_or_ps( intersect, _mm256_cmp_ps( nDist, frontEpsilon, _CMP_LT_OQ ) );
+
+         if ( _mm256_movemask_ps( outside ) == 0xFF )
+            break;
+      }
+
+      m_writeOverlapResults_batch( _mm256_movemask_ps( outside ), _mm256_movemask_ps( intersect ), 8, outResults + i );
+   }
+
+   if ( i < count )
+      m_box3F_x_planes_batch_C( planes, numPlanes, minX + i, minY + i, minZ + i, maxX + i, maxY + i, maxZ + i, count - i, outResults + i );
+}
+
+TORQUE_MATH_BATCH_TARGET( "avx" )
+void m_sphereF_x_planes_batch_AVX( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults )
+{
+   const __m256 signMask = _mm256_set1_ps( -0.0f );
+
+   U32 i = 0;
+   for ( ; i + 8 <= count; i += 8 )
+   {
+      const __m256 cx = _mm256_loadu_ps( x + i );
+      const __m256 cy = _mm256_loadu_ps( y + i );
+      const __m256 cz = _mm256_loadu_ps( z + i );
+      const __m256 r = _mm256_loadu_ps( radius + i );
+      const __m256 negR = _mm256_xor_ps( r, signMask );
+
+      __m256 outside = _mm256_setzero_ps();
+      __m256 intersect = _mm256_setzero_ps();
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+
+         const __m256 dist = _mm256_add_ps( _mm256_add_ps( _mm256_add_ps(
+            _mm256_mul_ps( _mm256_set1_ps( plane.x ), cx ),
+            _mm256_mul_ps( _mm256_set1_ps( plane.y ), cy ) ),
+            _mm256_mul_ps( _mm256_set1_ps( plane.z ), cz ) ), _mm256_set1_ps( plane.d ) );
+
+         outside = _mm256_or_ps( outside, _mm256_cmp_ps( dist, negR, _CMP_LT_OQ ) );
+         intersect = _mm256_or_ps( intersect, _mm256_cmp_ps( dist, r, _CMP_NGT_UQ ) );
+
+         if ( _mm256_movemask_ps( outside ) == 0xFF )
+            break;
+      }
+
+      m_writeOverlapResults_batch( _mm256_movemask_ps( outside ), _mm256_movemask_ps( intersect ), 8, outResults + i );
+   }
+
+   if ( i < count )
+      m_sphereF_x_planes_batch_C( planes, numPlanes, x + i, y + i, z + i, radius + i, count - i, outResults + i );
+}
+
+/// Computes two rows of the result per step: the low half works on
+/// the first row and the high half on the second, each scaling the
+/// (broadcast) rows of b by the elements of its row of a.
+TORQUE_MATH_BATCH_TARGET( "avx" )
+void m_matF_x_matF_batch_AVX( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const F32 *matA = a + 16 * ( aIndex ? aIndex[i] : i );
+      const F32 *matB = b + 16 * i;
+      F32 *matR = result + 16 * i;
+
+      const __m256 b0 = _mm256_broadcast_ps( (const __m128*)( matB ) );
+      const __m256 b1 = _mm256_broadcast_ps( (const __m128*)( matB + 4 ) );
+      const __m256 b2 = _mm256_broadcast_ps( (const __m128*)( matB + 8 ) );
+      const __m256 b3 = _mm256_broadcast_ps( (const __m128*)( matB + 12 ) );
+
+      for ( U32 row = 0; row < 16; row += 8 )
+      {
+         const F32 *r0 = matA + row;
+         const F32 *r1 = matA + row + 4;
+
+         __m256 r = _mm256_mul_ps( _mm256_setr_ps( r0[0], r0[0], r0[0], r0[0], r1[0], r1[0], r1[0], r1[0] ), b0 );
+         r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_setr_ps( r0[1], r0[1], r0[1], r0[1], r1[1], r1[1], r1[1], r1[1] ), b1 ) );
+         r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_setr_ps( r0[2], r0[2], r0[2], r0[2], r1[2], r1[2], r1[2], r1[2] ), b2 ) );
+         r = _mm256_add_ps( r, _mm256_mul_ps( _mm256_setr_ps( r0[3], r0[3], r0[3], r0[3], r1[3], r1[3], r1[3], r1[3] ), b3 ) );
+         _mm256_storeu_ps( matR + row, r );
+      }
+   }
+}
+
+#endif // TORQUE_MATH_BATCH_X86
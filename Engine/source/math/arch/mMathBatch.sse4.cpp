@@ -0,0 +1,188 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "math/mMathBatch.h"
+#include "math/arch/mMathBatch.arch.h"
+
+#if defined( TORQUE_MATH_BATCH_X86 )
+#include <smmintrin.h>
+
+// All of these work on four elements at a time and hand whatever is
+// left over to the C version.  The arithmetic is done in the same order
+// as the C code so both give identical results.
+
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+void m_matF_x_point3F_batch_SSE4( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count )
+{
+   const __m128 m0 = _mm_set1_ps( m[0] ), m1 = _mm_set1_ps( m[1] ), m2  = _mm_set1_ps( m[2] ),  m3  = _mm_set1_ps( m[3] );
+   const __m128 m4 = _mm_set1_ps( m[4] ), m5 = _mm_set1_ps( m[5] ), m6  = _mm_set1_ps( m[6] ),  m7  = _mm_set1_ps( m[7] );
+   const __m128 m8 = _mm_set1_ps( m[8] ), m9 = _mm_set1_ps( m[9] ), m10 = _mm_set1_ps( m[10] ), m11 = _mm_set1_ps( m[11] );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      const __m128 px = _mm_loadu_ps( x + i );
+      const __m128 py = _mm_loadu_ps( y + i );
+      const __m128 pz = _mm_loadu_ps( z + i );
+
+      _mm_storeu_ps( outX + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m0, px ), _mm_mul_ps( m1, py ) ), _mm_mul_ps( m2, pz ) ), m3 ) );
+      _mm_storeu_ps( outY + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m4, px ), _mm_mul_ps( m5, py ) ), _mm_mul_ps( m6, pz ) ), m7 ) );
+      _mm_storeu_ps( outZ + i, _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( m8, px ), _mm_mul_ps( m9, py ) ), _mm_mul_ps( m10, pz ) ), m11 ) );
+   }
+
+   if ( i < count )
+      m_matF_x_point3F_batch_C( m, x + i, y + i, z + i, outX + i, outY + i, outZ + i, count - i );
+}
+
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+void m_box3F_x_planes_batch_SSE4( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults )
+{
+   const __m128 backEpsilon = _mm_set1_ps( -0.005f );
+   const __m128 frontEpsilon = _mm_set1_ps( 0.005f );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      const __m128 bMinX = _mm_loadu_ps( minX + i );
+      const __m128 bMinY = _mm_loadu_ps( minY + i );
+      const __m128 bMinZ = _mm_loadu_ps( minZ + i );
+      const __m128 bMaxX = _mm_loadu_ps( maxX + i );
+      const __m128 bMaxY = _mm_loadu_ps( maxY + i );
+      const __m128 bMaxZ = _mm_loadu_ps( maxZ + i );
+
+      __m128 outside = _mm_setzero_ps();
+      __m128 intersect = _mm_setzero_ps();
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+         const __m128 nx = _mm_set1_ps( plane.x );
+         const __m128 ny = _mm_set1_ps( plane.y );
+         const __m128 nz = _mm_set1_ps( plane.z );
+         const __m128 d = _mm_set1_ps( plane.d );
+
+         // The normal is the same for every lane, so picking the
+         // positive and negative vertices is just picking arrays.
+         const bool posX = plane.x > 0.0f;
+         const bool posY = plane.y > 0.0f;
+         const bool posZ = plane.z > 0.0f;
+
+         const __m128 pDist = _mm_add_ps( _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( nx, posX ? bMaxX : bMinX ),
+            _mm_mul_ps( ny, posY ? bMaxY : bMinY ) ),
+            _mm_mul_ps( nz, posZ ? bMaxZ : bMinZ ) ), d );
+         outside = _mm_or_ps( outside, _mm_cmple_ps( pDist, backEpsilon ) );
+
+         const __m128 nDist = _mm_add_ps( _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( nx, posX ? bMinX : bMaxX ),
+            _mm_mul_ps( ny, posY ? bMinY : bMaxY ) ),
+            _mm_mul_ps( nz, posZ ? bMinZ : bMaxZ ) ), d );
+         intersect = _mm_or_ps( intersect, _mm_cmplt_ps( nDist, frontEpsilon ) );
+
+         if ( _mm_movemask_ps( outside ) == 0xF )
+            break;
+      }
+
+      m_writeOverlapResults_batch( _mm_movemask_ps( outside ), _mm_movemask_ps( intersect ), 4, outResults + i );
+   }
+
+   if ( i < count )
+      m_box3F_x_planes_batch_C( planes, numPlanes, minX + i, minY + i, minZ + i, maxX + i, maxY + i, maxZ + i, count - i, outResults + i );
+}
+
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+void m_sphereF_x_planes_batch_SSE4( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults )
+{
+   const __m128 signMask = _mm_set1_ps( -0.0f );
+
+   U32 i = 0;
+   for ( ; i + 4 <= count; i += 4 )
+   {
+      const __m128 cx = _mm_loadu_ps( x + i );
+      const __m128 cy = _mm_loadu_ps( y + i );
+      const __m128 cz = _mm_loadu_ps( z + i );
+      const __m128 r = _mm_loadu_ps( radius + i );
+      const __m128 negR = _mm_xor_ps( r, signMask );
+
+      __m128 outside = _mm_setzero_ps();
+      __m128 intersect = _mm_setzero_ps();
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+
+         const __m128 dist = _mm_add_ps( _mm_add_ps( _mm_add_ps(
+            _mm_mul_ps( _mm_set1_ps( plane.x ), cx ),
+            _mm_mul_ps( _mm_set1_ps( plane.y ), cy ) ),
+            _mm_mul_ps( _mm_set1_ps( plane.z ), cz ) ), _mm_set1_ps( plane.d ) );
+
+         outside = _mm_or_ps( outside, _mm_cmplt_ps( dist, negR ) );
+         intersect = _mm_or_ps( intersect, _mm_cmpngt_ps( dist, r ) );
+
+         if ( _mm_movemask_ps( outside ) == 0xF )
+            break;
+      }
+
+      m_writeOverlapResults_batch( _mm_movemask_ps( outside ), _mm_movemask_ps( intersect ), 4, outResults + i );
+   }
+
+   if ( i < count )
+      m_sphereF_x_planes_batch_C( planes, numPlanes, x + i, y + i, z + i, radius + i, count - i, outResults + i );
+}
+
+/// Computes one row of the result at a time by scaling the rows of b
+/// with the elements of the matching row of a.  All of b is loaded up
+/// front and each row of a is read before its result row is written, so
+/// the result may alias either input.
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+static inline void _mulMatrix( const F32 *a, const F32 *b, F32 *result )
+{
+   const __m128 b0 = _mm_loadu_ps( b );
+   const __m128 b1 = _mm_loadu_ps( b + 4 );
+   const __m128 b2 = _mm_loadu_ps( b + 8 );
+   const __m128 b3 = _mm_loadu_ps( b + 12 );
+
+   for ( U32 row = 0; row < 16; row += 4 )
+   {
+      __m128 r = _mm_mul_ps( _mm_set1_ps( a[row] ), b0 );
+      r = _mm_add_ps( r, _mm_mul_ps( _mm_set1_ps( a[row + 1] ), b1 ) );
+      r = _mm_add_ps( r, _mm_mul_ps( _mm_set1_ps( a[row + 2] ), b2 ) );
+      r = _mm_add_ps( r, _mm_mul_ps( _mm_set1_ps( a[row + 3] ), b3 ) );
+      _mm_storeu_ps( result + row, r );
+   }
+}
+
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+void m_matF_x_matF_SSE4( const F32 *a, const F32 *b, F32 *result )
+{
+   _mulMatrix( a, b, result );
+}
+
+TORQUE_MATH_BATCH_TARGET( "sse4.1" )
+void m_matF_x_matF_batch_SSE4( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+      _mulMatrix( a + 16 * ( aIndex ? aIndex[i] : i ), b + 16 * i, result + 16 * i );
+}
+
+#endif // TORQUE_MATH_BATCH_X86
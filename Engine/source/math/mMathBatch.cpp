@@ -0,0 +1,313 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platform.h"
+#include "math/mMathBatch.h"
+#include "math/arch/mMathBatch.arch.h"
+
+#include "math/mMathFn.h"
+#include "math/mMatrix.h"
+#include "math/mPlaneSet.h"
+#include "math/mRandom.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+
+
+//------------------------------------------------------------------------------
+// Default C++ Implementations
+//------------------------------------------------------------------------------
+
+void m_matF_x_point3F_batch_C( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const F32 px = x[i];
+      const F32 py = y[i];
+      const F32 pz = z[i];
+
+      outX[i] = m[0]*px + m[1]*py + m[2]*pz  + m[3];
+      outY[i] = m[4]*px + m[5]*py + m[6]*pz  + m[7];
+      outZ[i] = m[8]*px + m[9]*py + m[10]*pz + m[11];
+   }
+}
+
+void m_box3F_x_planes_batch_C( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      S8 result = GeometryInside;
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+
+         // Distance of the corner furthest along the plane normal.  If even
+         // that is behind the plane the whole box is.
+         const F32 pDist = plane.x * ( plane.x > 0.0f ? maxX[i] : minX[i] ) +
+                           plane.y * ( plane.y > 0.0f ? maxY[i] : minY[i] ) +
+                           plane.z * ( plane.z > 0.0f ? maxZ[i] : minZ[i] ) + plane.d;
+         if ( pDist <= -0.005f )
+         {
+            result = GeometryOutside;
+            break;
+         }
+
+         // And the nearest corner, which tells us if it's fully in front.
+         const F32 nDist = plane.x * ( plane.x > 0.0f ? minX[i] : maxX[i] ) +
+                           plane.y * ( plane.y > 0.0f ? minY[i] : maxY[i] ) +
+                           plane.z * ( plane.z > 0.0f ? minZ[i] : maxZ[i] ) + plane.d;
+         if ( nDist < 0.005f )
+            result = GeometryIntersecting;
+      }
+
+      outResults[i] = result;
+   }
+}
+
+void m_sphereF_x_planes_batch_C( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      S8 result = GeometryInside;
+
+      for ( U32 n = 0; n < numPlanes; n++ )
+      {
+         const PlaneF &plane = planes[n];
+         const F32 dist = plane.x * x[i] + plane.y * y[i] + plane.z * z[i] + plane.d;
+
+         if ( dist < -radius[i] )
+         {
+            result = GeometryOutside;
+            break;
+         }
+
+         if ( !( dist > radius[i] ) )
+            result = GeometryIntersecting;
+      }
+
+      outResults[i] = result;
+   }
+}
+
+extern void default_matF_x_matF_C( const F32 *a, const F32 *b, F32 *mresult );
+
+void m_matF_x_matF_batch_C( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count )
+{
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const F32 *matA = a + 16 * ( aIndex ? aIndex[i] : i );
+      default_matF_x_matF_C( matA, b + 16 * i, result + 16 * i );
+   }
+}
+
+
+//------------------------------------------------------------------------------
+// Installable pointers.
+//------------------------------------------------------------------------------
+
+void (*m_matF_x_point3F_batch)( const F32 *m, const F32 *x, const F32 *y, const F32 *z, F32 *outX, F32 *outY, F32 *outZ, U32 count ) = m_matF_x_point3F_batch_C;
+void (*m_box3F_x_planes_batch)( const PlaneF *planes, U32 numPlanes, const F32 *minX, const F32 *minY, const F32 *minZ, const F32 *maxX, const F32 *maxY, const F32 *maxZ, U32 count, S8 *outResults ) = m_box3F_x_planes_batch_C;
+void (*m_sphereF_x_planes_batch)( const PlaneF *planes, U32 numPlanes, const F32 *x, const F32 *y, const F32 *z, const F32 *radius, U32 count, S8 *outResults ) = m_sphereF_x_planes_batch_C;
+void (*m_matF_x_matF_batch)( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count ) = m_matF_x_matF_batch_C;
+
+static const MathBatchImpl smMathBatchImpls[] =
+{
+   { "C", 0, m_matF_x_point3F_batch_C, m_box3F_x_planes_batch_C, m_sphereF_x_planes_batch_C, m_matF_x_matF_batch_C },
+#if defined( TORQUE_MATH_BATCH_X86 )
+   { "SSE4.1", CPU_PROP_SSE4_1, m_matF_x_point3F_batch_SSE4, m_box3F_x_planes_batch_SSE4, m_sphereF_x_planes_batch_SSE4, m_matF_x_matF_batch_SSE4 },
+   { "AVX", CPU_PROP_AVX, m_matF_x_point3F_batch_AVX, m_box3F_x_planes_batch_AVX, m_sphereF_x_planes_batch_AVX, m_matF_x_matF_batch_AVX },
+#endif
+};
+
+const MathBatchImpl* mGetMathBatchImpls( U32 &outCount )
+{
+   outCount = sizeof( smMathBatchImpls ) / sizeof( smMathBatchImpls[0] );
+   return smMathBatchImpls;
+}
+
+void mInstallLibrary_Batch( U32 properties )
+{
+   // Later entries are preferred, so the last supported one wins.
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !impl.isSupported( properties ) )
+         continue;
+
+      if ( impl.cpuProps )
+         Con::printf( "   Installing %s batch extensions", impl.name );
+
+      m_matF_x_point3F_batch     = impl.xfm;
+      m_box3F_x_planes_batch     = impl.box;
+      m_sphereF_x_planes_batch   = impl.sphere;
+      m_matF_x_matF_batch        = impl.mat;
+   }
+
+#if defined( TORQUE_MATH_BATCH_X86 )
+
+   // The single matrix multiply is what MatrixSet uses to
+   // build its lazily evaluated products.
+   if ( properties & CPU_PROP_SSE4_1 )
+   {
+      m_matF_x_matF              = m_matF_x_matF_SSE4;
+      m_matF_x_matF_aligned      = m_matF_x_matF_SSE4;
+   }
+
+#endif
+}
+
+
+//------------------------------------------------------------------------------
+// Benchmark.
+//------------------------------------------------------------------------------
+
+DefineEngineFunction( benchmarkMathBatch, void, ( S32 count, S32 iterations ), ( 4096, 1000 ),
+   "@brief Times the batch math functions against the per element math they replace.\n\n"
+   "Every implementation usable on this CPU is run over the same random data and the "
+   "results are printed to the console.\n\n"
+   "@param count Number of points, boxes, spheres and matrices in each batch.\n"
+   "@param iterations Number of times each batch is processed.\n"
+   "@ingroup Math" )
+{
+   count = getMax( count, 1 );
+   iterations = getMax( iterations, 1 );
+
+   MRandomLCG rand( 1 );
+
+   Point3FBatch points;
+   Box3FBatch boxes;
+   SphereFBatch spheres;
+   Vector<MatrixF> matsA, matsB, matsOut;
+   Vector<S32> indices;
+
+   points.reserve( count );
+   boxes.reserve( count );
+   spheres.reserve( count );
+   matsA.setSize( count );
+   matsB.setSize( count );
+   matsOut.setSize( count );
+   indices.setSize( count );
+
+   for ( S32 i = 0; i < count; i++ )
+   {
+      const Point3F pos( rand.randF( -500.0f, 500.0f ), rand.randF( -500.0f, 500.0f ), rand.randF( -50.0f, 50.0f ) );
+      const Point3F ext( rand.randF( 0.5f, 10.0f ), rand.randF( 0.5f, 10.0f ), rand.randF( 0.5f, 10.0f ) );
+
+      points.push_back( pos );
+      boxes.push_back( Box3F( pos - ext, pos + ext ) );
+      spheres.push_back( SphereF( pos, ext.len() ) );
+
+      matsA[i].set( EulerF( rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.0f, M_2PI_F ) ), pos );
+      matsB[i].set( EulerF( rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.0f, M_2PI_F ), rand.randF( 0.0f, M_2PI_F ) ), ext );
+      indices[i] = rand.randI( 0, count - 1 );
+   }
+
+   // A frustum like set of six planes around the origin.
+   PlaneF planes[ 6 ];
+   planes[0].set( Point3F( -400.0f, 0.0f, 0.0f ), Point3F( 1.0f, 0.0f, 0.0f ) );
+   planes[1].set( Point3F( 400.0f, 0.0f, 0.0f ), Point3F( -1.0f, 0.0f, 0.0f ) );
+   planes[2].set( Point3F( 0.0f, -300.0f, 0.0f ), Point3F( 0.2f, 1.0f, 0.0f ) );
+   planes[3].set( Point3F( 0.0f, 300.0f, 0.0f ), Point3F( 0.2f, -1.0f, 0.0f ) );
+   planes[4].set( Point3F( 0.0f, 0.0f, -40.0f ), Point3F( 0.0f, 0.3f, 1.0f ) );
+   planes[5].set( Point3F( 0.0f, 0.0f, 40.0f ), Point3F( 0.0f, 0.3f, -1.0f ) );
+   for ( U32 i = 0; i < 6; i++ )
+      planes[i].normalize();
+
+   Point3FBatch outPoints;
+   outPoints.setSize( count );
+   Vector<S8> results;
+   results.setSize( count );
+
+   const MatrixF xfm( EulerF( 0.3f, 0.2f, 0.1f ), Point3F( 10.0f, 20.0f, 30.0f ) );
+   const PlaneSetF planeSet( planes, 6 );
+
+   Con::printf( "benchmarkMathBatch: %d elements x %d iterations", count, iterations );
+
+   // The per element versions we're replacing.
+   {
+      U32 start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         for ( S32 i = 0; i < count; i++ )
+         {
+            Point3F p = points.get( i );
+            xfm.mulP( p );
+            outPoints.x[i] = p.x; outPoints.y[i] = p.y; outPoints.z[i] = p.z;
+         }
+      const U32 xfmMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         for ( S32 i = 0; i < count; i++ )
+            results[i] = planeSet.testPotentialIntersection( boxes.get( i ) );
+      const U32 boxMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         for ( S32 i = 0; i < count; i++ )
+            results[i] = planeSet.testPotentialIntersection( spheres.get( i ) );
+      const U32 sphereMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         for ( S32 i = 0; i < count; i++ )
+            matsOut[i].mul( matsA[ indices[i] ], matsB[i] );
+      const U32 matMs = Platform::getRealMilliseconds() - start;
+
+      Con::printf( "   %-8s points %5dms  boxes %5dms  spheres %5dms  matrices %5dms", "AoS", xfmMs, boxMs, sphereMs, matMs );
+   }
+
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !impl.isSupported( Platform::SystemInfo.processor.properties ) )
+         continue;
+
+      U32 start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         impl.xfm( xfm, points.x.address(), points.y.address(), points.z.address(),
+                   outPoints.x.address(), outPoints.y.address(), outPoints.z.address(), count );
+      const U32 xfmMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         impl.box( planes, 6, boxes.minX.address(), boxes.minY.address(), boxes.minZ.address(),
+                   boxes.maxX.address(), boxes.maxY.address(), boxes.maxZ.address(), count, results.address() );
+      const U32 boxMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         impl.sphere( planes, 6, spheres.x.address(), spheres.y.address(), spheres.z.address(),
+                      spheres.radius.address(), count, results.address() );
+      const U32 sphereMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for ( S32 n = 0; n < iterations; n++ )
+         impl.mat( *matsA.address(), indices.address(), *matsB.address(), *matsOut.address(), count );
+      const U32 matMs = Platform::getRealMilliseconds() - start;
+
+      Con::printf( "   %-8s points %5dms  boxes %5dms  spheres %5dms  matrices %5dms", impl.name, xfmMs, boxMs, sphereMs, matMs );
+   }
+}
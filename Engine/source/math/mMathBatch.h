@@ -0,0 +1,233 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifndef _MMATHBATCH_H_
+#define _MMATHBATCH_H_
+
+#ifndef _MPLANE_H_
+#include "math/mPlane.h"
+#endif
+#ifndef _MBOX_H_
+#include "math/mBox.h"
+#endif
+#ifndef _MSPHERE_H_
+#include "math/mSphere.h"
+#endif
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// @name Batch Math
+///
+/// These work on many points, boxes, spheres or matrices per call.  Geometry
+/// is passed in structure-of-arrays form (all the x values, then all the y
+/// values, ...) so that each SIMD lane handles a different element and no
+/// shuffling is needed.  The best implementation for the CPU is installed
+/// by mInstallLibrary_Batch() from Math::init(); until then the C versions
+/// are used.
+///
+/// The overlap tests write one OverlapTestResult per element and classify
+/// exactly like PlaneSetF::testPotentialIntersection().
+///
+/// @{
+
+/// Transforms @a count points by the affine matrix @a m, as MatrixF::mulP()
+/// would.  The outputs may alias the inputs.
+extern void (*m_matF_x_point3F_batch)( const F32 *m,
+                                       const F32 *x, const F32 *y, const F32 *z,
+                                       F32 *outX, F32 *outY, F32 *outZ,
+                                       U32 count );
+
+/// Tests @a count axis aligned boxes against the volume enclosed by
+/// @a numPlanes planes.
+extern void (*m_box3F_x_planes_batch)( const PlaneF *planes, U32 numPlanes,
+                                       const F32 *minX, const F32 *minY, const F32 *minZ,
+                                       const F32 *maxX, const F32 *maxY, const F32 *maxZ,
+                                       U32 count, S8 *outResults );
+
+/// Tests @a count spheres against the volume enclosed by @a numPlanes planes.
+extern void (*m_sphereF_x_planes_batch)( const PlaneF *planes, U32 numPlanes,
+                                         const F32 *x, const F32 *y, const F32 *z, const F32 *radius,
+                                         U32 count, S8 *outResults );
+
+/// Multiplies @a count pairs of matrices so that result[i] = a[j] * b[i]
+/// where j is @a aIndex[i], or i if @a aIndex is NULL.  This is the shape of
+/// the skinning bone update where a node transform is combined with each
+/// bone's inverse bind pose.  The results must not alias @a a or @a b.
+extern void (*m_matF_x_matF_batch)( const F32 *a, const S32 *aIndex, const F32 *b, F32 *result, U32 count );
+
+/// Installs the batch functions best suited to the given CPU properties.
+extern void mInstallLibrary_Batch( U32 properties );
+
+/// One complete set of batch functions and the CPU properties it needs.
+struct MathBatchImpl
+{
+   const char *name;
+   U32 cpuProps;
+
+   void (*xfm)( const F32*, const F32*, const F32*, const F32*, F32*, F32*, F32*, U32 );
+   void (*box)( const PlaneF*, U32, const F32*, const F32*, const F32*, const F32*, const F32*, const F32*, U32, S8* );
+   void (*sphere)( const PlaneF*, U32, const F32*, const F32*, const F32*, const F32*, U32, S8* );
+   void (*mat)( const F32*, const S32*, const F32*, F32*, U32 );
+
+   /// Returns true if the CPU described by @a properties can run it.
+   bool isSupported( U32 properties ) const { return ( properties & cpuProps ) == cpuProps; }
+};
+
+/// Returns every batch implementation compiled into this build, from the
+/// C versions up to the most preferred, whether or not the running CPU
+/// supports them.  This is the table mInstallLibrary_Batch() picks from,
+/// so tests and benchmarks can run each one directly.
+extern const MathBatchImpl* mGetMathBatchImpls( U32 &outCount );
+
+/// @}
+
+
+/// A set of points in structure-of-arrays form for the batch functions.
+class Point3FBatch
+{
+public:
+
+   Vector<F32> x;
+   Vector<F32> y;
+   Vector<F32> z;
+
+   U32 size() const { return x.size(); }
+   bool empty() const { return x.empty(); }
+
+   void clear()
+   {
+      x.clear(); y.clear(); z.clear();
+   }
+
+   void reserve( U32 count )
+   {
+      x.reserve( count ); y.reserve( count ); z.reserve( count );
+   }
+
+   void setSize( U32 count )
+   {
+      x.setSize( count ); y.setSize( count ); z.setSize( count );
+   }
+
+   void push_back( const Point3F &point )
+   {
+      x.push_back( point.x ); y.push_back( point.y ); z.push_back( point.z );
+   }
+
+   Point3F get( U32 index ) const { return Point3F( x[index], y[index], z[index] ); }
+};
+
+
+/// A set of axis aligned boxes in structure-of-arrays form for the batch functions.
+class Box3FBatch
+{
+public:
+
+   Vector<F32> minX;
+   Vector<F32> minY;
+   Vector<F32> minZ;
+   Vector<F32> maxX;
+   Vector<F32> maxY;
+   Vector<F32> maxZ;
+
+   U32 size() const { return minX.size(); }
+   bool empty() const { return minX.empty(); }
+
+   void clear()
+   {
+      minX.clear(); minY.clear(); minZ.clear();
+      maxX.clear(); maxY.clear(); maxZ.clear();
+   }
+
+   void reserve( U32 count )
+   {
+      minX.reserve( count ); minY.reserve( count ); minZ.reserve( count );
+      maxX.reserve( count ); maxY.reserve( count ); maxZ.reserve( count );
+   }
+
+   void push_back( const Box3F &box )
+   {
+      minX.push_back( box.minExtents.x ); minY.push_back( box.minExtents.y ); minZ.push_back( box.minExtents.z );
+      maxX.push_back( box.maxExtents.x ); maxY.push_back( box.maxExtents.y ); maxZ.push_back( box.maxExtents.z );
+   }
+
+   Box3F get( U32 index ) const
+   {
+      return Box3F( minX[index], minY[index], minZ[index], maxX[index], maxY[index], maxZ[index] );
+   }
+
+   /// Classifies every box against the planes.
+   /// @see m_box3F_x_planes_batch
+   void testPlanes( const PlaneF *planes, U32 numPlanes, S8 *outResults ) const
+   {
+      m_box3F_x_planes_batch( planes, numPlanes,
+                              minX.address(), minY.address(), minZ.address(),
+                              maxX.address(), maxY.address(), maxZ.address(),
+                              size(), outResults );
+   }
+};
+
+
+/// A set of spheres in structure-of-arrays form for the batch functions.
+class SphereFBatch
+{
+public:
+
+   Vector<F32> x;
+   Vector<F32> y;
+   Vector<F32> z;
+   Vector<F32> radius;
+
+   U32 size() const { return x.size(); }
+   bool empty() const { return x.empty(); }
+
+   void clear()
+   {
+      x.clear(); y.clear(); z.clear(); radius.clear();
+   }
+
+   void reserve( U32 count )
+   {
+      x.reserve( count ); y.reserve( count ); z.reserve( count ); radius.reserve( count );
+   }
+
+   void push_back( const SphereF &sphere )
+   {
+      x.push_back( sphere.center.x ); y.push_back( sphere.center.y ); z.push_back( sphere.center.z );
+      radius.push_back( sphere.radius );
+   }
+
+   SphereF get( U32 index ) const { return SphereF( Point3F( x[index], y[index], z[index] ), radius[index] ); }
+
+   /// Classifies every sphere against the planes.
+   /// @see m_sphereF_x_planes_batch
+   void testPlanes( const PlaneF *planes, U32 numPlanes, S8 *outResults ) const
+   {
+      m_sphereF_x_planes_batch( planes, numPlanes,
+                                x.address(), y.address(), z.address(), radius.address(),
+                                size(), outResults );
+   }
+};
+
+#endif // _MMATHBATCH_H_
@@ -0,0 +1,275 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_TESTS_ENABLED
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "math/mMathBatch.h"
+#include "math/mMatrix.h"
+#include "math/mPlaneSet.h"
+#include "math/mRandom.h"
+#include "math/util/frustum.h"
+
+// Every implementation is checked against the per element math it
+// replaces, whichever one happens to be installed.  The element counts
+// aren't multiples of the SIMD width so the C tail handling is covered.
+
+static const F32 POINT_TOLERANCE = 0.001f;
+static const F32 MATRIX_TOLERANCE = 0.0001f;
+
+static bool isImplAvailable( const MathBatchImpl &impl )
+{
+   return impl.isSupported( Platform::SystemInfo.processor.properties );
+}
+
+/// A box of planes around the origin with slanted normals
+/// so both vertex selections get used for every axis.
+static void buildTestPlanes( PlaneF *planes )
+{
+   planes[0].set( Point3F( -40.0f, 0.0f, 0.0f ), Point3F( 1.0f, 0.2f, 0.0f ) );
+   planes[1].set( Point3F( 40.0f, 0.0f, 0.0f ), Point3F( -1.0f, 0.0f, 0.3f ) );
+   planes[2].set( Point3F( 0.0f, -30.0f, 0.0f ), Point3F( 0.2f, 1.0f, 0.0f ) );
+   planes[3].set( Point3F( 0.0f, 30.0f, 0.0f ), Point3F( 0.0f, -1.0f, -0.2f ) );
+   planes[4].set( Point3F( 0.0f, 0.0f, -20.0f ), Point3F( -0.1f, 0.3f, 1.0f ) );
+   planes[5].set( Point3F( 0.0f, 0.0f, 20.0f ), Point3F( 0.0f, 0.3f, -1.0f ) );
+   for ( U32 i = 0; i < 6; i++ )
+      planes[i].normalize();
+}
+
+TEST(MathBatch, TransformPoints)
+{
+   MRandomLCG rand( 7 );
+
+   const U32 count = 37;
+   Point3FBatch points;
+   for ( U32 i = 0; i < count; i++ )
+      points.push_back( Point3F( rand.randF( -100.0f, 100.0f ), rand.randF( -100.0f, 100.0f ), rand.randF( -100.0f, 100.0f ) ) );
+
+   MatrixF xfm( EulerF( 0.4f, -1.1f, 2.3f ), Point3F( 5.0f, -7.0f, 9.0f ) );
+   xfm.scale( Point3F( 1.5f, 0.5f, 2.0f ) );
+
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !isImplAvailable( impl ) )
+         continue;
+
+      Point3FBatch out;
+      out.setSize( count );
+      impl.xfm( xfm, points.x.address(), points.y.address(), points.z.address(),
+                out.x.address(), out.y.address(), out.z.address(), count );
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         Point3F expected = points.get( i );
+         xfm.mulP( expected );
+
+         const Point3F result = out.get( i );
+         EXPECT_NEAR( expected.x, result.x, POINT_TOLERANCE ) << impl.name << " point " << i;
+         EXPECT_NEAR( expected.y, result.y, POINT_TOLERANCE ) << impl.name << " point " << i;
+         EXPECT_NEAR( expected.z, result.z, POINT_TOLERANCE ) << impl.name << " point " << i;
+      }
+   }
+}
+
+TEST(MathBatch, TransformPointsInPlace)
+{
+   Point3FBatch points;
+   for ( U32 i = 0; i < 11; i++ )
+      points.push_back( Point3F( F32( i ), F32( i * 2 ), F32( i * 3 ) ) );
+
+   MatrixF xfm( true );
+   xfm.setPosition( Point3F( 1.0f, 2.0f, 3.0f ) );
+
+   m_matF_x_point3F_batch( xfm, points.x.address(), points.y.address(), points.z.address(),
+                           points.x.address(), points.y.address(), points.z.address(), points.size() );
+
+   for ( U32 i = 0; i < points.size(); i++ )
+      EXPECT_EQ( points.get( i ), Point3F( F32( i ) + 1.0f, F32( i * 2 ) + 2.0f, F32( i * 3 ) + 3.0f ) );
+}
+
+TEST(MathBatch, BoxesVsPlanes)
+{
+   MRandomLCG rand( 11 );
+
+   PlaneF planes[6];
+   buildTestPlanes( planes );
+   const PlaneSetF planeSet( planes, 6 );
+
+   // Scatter boxes around the volume so that we get a good mix
+   // of inside, outside and intersecting results.
+   const U32 count = 203;
+   Box3FBatch boxes;
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const Point3F center( rand.randF( -60.0f, 60.0f ), rand.randF( -50.0f, 50.0f ), rand.randF( -40.0f, 40.0f ) );
+      const Point3F ext( rand.randF( 0.1f, 15.0f ), rand.randF( 0.1f, 15.0f ), rand.randF( 0.1f, 15.0f ) );
+      boxes.push_back( Box3F( center - ext, center + ext ) );
+   }
+
+   U32 counts[3] = { 0, 0, 0 };
+
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !isImplAvailable( impl ) )
+         continue;
+
+      Vector<S8> results;
+      results.setSize( count );
+      impl.box( planes, 6, boxes.minX.address(), boxes.minY.address(), boxes.minZ.address(),
+                boxes.maxX.address(), boxes.maxY.address(), boxes.maxZ.address(), count, results.address() );
+
+      for ( U32 i = 0; i < count; i++ )
+      {
+         const OverlapTestResult expected = planeSet.testPotentialIntersection( boxes.get( i ) );
+         EXPECT_EQ( expected, results[i] ) << impl.name << " box " << i;
+
+         if ( k == 0 )
+            counts[ expected + 1 ]++;
+      }
+   }
+
+   EXPECT_GT( counts[ GeometryOutside + 1 ], 0U );
+   EXPECT_GT( counts[ GeometryIntersecting + 1 ], 0U );
+   EXPECT_GT( counts[ GeometryInside + 1 ], 0U );
+}
+
+TEST(MathBatch, SpheresVsPlanes)
+{
+   MRandomLCG rand( 13 );
+
+   PlaneF planes[6];
+   buildTestPlanes( planes );
+   const PlaneSetF planeSet( planes, 6 );
+
+   const U32 count = 203;
+   SphereFBatch spheres;
+   for ( U32 i = 0; i < count; i++ )
+   {
+      const Point3F center( rand.randF( -60.0f, 60.0f ), rand.randF( -50.0f, 50.0f ), rand.randF( -40.0f, 40.0f ) );
+      spheres.push_back( SphereF( center, rand.randF( 0.1f, 15.0f ) ) );
+   }
+
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !isImplAvailable( impl ) )
+         continue;
+
+      Vector<S8> results;
+      results.setSize( count );
+      impl.sphere( planes, 6, spheres.x.address(), spheres.y.address(), spheres.z.address(),
+                   spheres.radius.address(), count, results.address() );
+
+      for ( U32 i = 0; i < count; i++ )
+         EXPECT_EQ( planeSet.testPotentialIntersection( spheres.get( i ) ), results[i] ) << impl.name << " sphere " << i;
+   }
+}
+
+TEST(MathBatch, MultiplyMatrices)
+{
+   MRandomLCG rand( 17 );
+
+   const U32 count = 9;
+   Vector<MatrixF> a, b;
+   Vector<S32> indices;
+   a.setSize( count );
+   b.setSize( count );
+   indices.setSize( count );
+   for ( U32 i = 0; i < count; i++ )
+   {
+      for ( U32 n = 0; n < 16; n++ )
+      {
+         a[i][n] = rand.randF( -2.0f, 2.0f );
+         b[i][n] = rand.randF( -2.0f, 2.0f );
+      }
+      indices[i] = rand.randI( 0, count - 1 );
+   }
+
+   U32 numImpls;
+   const MathBatchImpl *impls = mGetMathBatchImpls( numImpls );
+   for ( U32 k = 0; k < numImpls; k++ )
+   {
+      const MathBatchImpl &impl = impls[k];
+      if ( !isImplAvailable( impl ) )
+         continue;
+
+      Vector<MatrixF> out;
+      out.setSize( count );
+
+      // Pairwise...
+      impl.mat( *a.address(), NULL, *b.address(), *out.address(), count );
+      for ( U32 i = 0; i < count; i++ )
+      {
+         MatrixF expected;
+         expected.mul( a[i], b[i] );
+         for ( U32 n = 0; n < 16; n++ )
+            EXPECT_NEAR( expected[n], out[i][n], MATRIX_TOLERANCE ) << impl.name << " matrix " << i;
+      }
+
+      // ...and indexed like the skin bones.
+      impl.mat( *a.address(), indices.address(), *b.address(), *out.address(), count );
+      for ( U32 i = 0; i < count; i++ )
+      {
+         MatrixF expected;
+         expected.mul( a[ indices[i] ], b[i] );
+         for ( U32 n = 0; n < 16; n++ )
+            EXPECT_NEAR( expected[n], out[i][n], MATRIX_TOLERANCE ) << impl.name << " indexed matrix " << i;
+      }
+   }
+}
+
+TEST(MathBatch, FrustumCulling)
+{
+   Frustum frustum( false, -1.0f, 1.0f, 0.75f, -0.75f, 0.5f, 100.0f, MatrixF( true ) );
+
+   Box3FBatch boxes;
+   boxes.push_back( Box3F( Point3F( -1.0f, 10.0f, -1.0f ), Point3F( 1.0f, 12.0f, 1.0f ) ) );     // In front.
+   boxes.push_back( Box3F( Point3F( -1.0f, -12.0f, -1.0f ), Point3F( 1.0f, -10.0f, 1.0f ) ) );   // Behind.
+   boxes.push_back( Box3F( Point3F( -1.0f, 99.0f, -1.0f ), Point3F( 1.0f, 101.0f, 1.0f ) ) );    // On the far plane.
+   boxes.push_back( Box3F( Point3F( 200.0f, 10.0f, -1.0f ), Point3F( 201.0f, 12.0f, 1.0f ) ) );  // Off to the side.
+   boxes.push_back( Box3F( Point3F( -5.0f, 50.0f, -5.0f ), Point3F( 5.0f, 60.0f, 5.0f ) ) );     // In front.
+
+   Vector<S8> results;
+   results.setSize( boxes.size() );
+   frustum.testPotentialIntersectionBatch( boxes, results.address() );
+
+   for ( U32 i = 0; i < boxes.size(); i++ )
+   {
+      EXPECT_EQ( frustum.testPotentialIntersection( boxes.get( i ) ), results[i] ) << "box " << i;
+      EXPECT_EQ( frustum.isCulled( boxes.get( i ) ), results[i] == GeometryOutside ) << "box " << i;
+   }
+
+   EXPECT_NE( GeometryOutside, results[0] );
+   EXPECT_EQ( GeometryOutside, results[1] );
+   EXPECT_EQ( GeometryIntersecting, results[2] );
+   EXPECT_EQ( GeometryOutside, results[3] );
+}
+
+#endif
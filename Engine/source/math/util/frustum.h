@@ -47,6 +47,10 @@
 #include "math/mSphere.h"
 #endif
 
+#ifndef _MMATHBATCH_H_
+#include "math/mMathBatch.h"
+#endif
+
 
 //TODO: Specialize intersection tests for frustums using octant tests
 
@@ -466,6 +470,14 @@ class Frustum : public PolyhedronImpl< FrustumData >
       /// Return true if the contents of the given sphere can be culled.
       bool isCulled( const SphereF& sphere ) const { return ( testPotentialIntersection( sphere ) == GeometryOutside ); }
 
+      /// Classify every AABB in the batch against the frustum in one pass.
+      /// One OverlapTestResult per box is written to @a outResults.
+      void testPotentialIntersectionBatch( const Box3FBatch& boxes, S8* outResults ) const { boxes.testPlanes( getPlanes(), getNumPlanes(), outResults ); }
+
+      /// Classify every sphere in the batch against the frustum in one pass.
+      /// One OverlapTestResult per sphere is written to @a outResults.
+      void testPotentialIntersectionBatch( const SphereFBatch& spheres, S8* outResults ) const { spheres.testPlanes( getPlanes(), getNumPlanes(), outResults ); }
+
       /// @}
 
       /// @name Projection Type
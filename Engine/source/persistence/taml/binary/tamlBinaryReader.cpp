@@ -55,6 +55,13 @@ SimObject* TamlBinaryReader::read( FileStream& stream )
     bool compressed;
     stream.read( &compressed );
 
+    // Is this an indexed document?
+    if ( versionId >= 3 && !compressed )
+    {
+        // Yes, so read it in place.
+        return readIndexed( stream );
+    }
+
     SimObject* pSimObject = NULL;
 
     // Is the stream compressed?
@@ -92,6 +99,56 @@ void TamlBinaryReader::resetParse( void )
 
 //-----------------------------------------------------------------------------
 
+SimObject* TamlBinaryReader::findReference( const U32 tamlRefToId )
+{
+    // Fetch reference.
+    typeObjectReferenceHash::Iterator referenceItr = mObjectReferenceMap.find( tamlRefToId );
+
+    // Did we find the reference?
+    if ( referenceItr == mObjectReferenceMap.end() )
+    {
+        // No, so warn.
+        Con::warnf( "Taml: Could not find a reference Id of '%d'", tamlRefToId );
+        return NULL;
+    }
+
+    // Return object.
+    return referenceItr->value;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::registerElement( SimObject* pSimObject, StringTableEntry typeName, StringTableEntry objectName, const U32 tamlRefId )
+{
+    // Does the object require a name?
+    if ( objectName == StringTable->EmptyString() )
+    {
+        // No, so just register anonymously.
+        pSimObject->registerObject();
+    }
+    else
+    {
+        // Yes, so register a named object.
+        pSimObject->registerObject( objectName );
+
+        // Was the name assigned?
+        if ( pSimObject->getName() != objectName )
+        {
+            // No, so warn that the name was rejected.
+            Con::warnf( "Taml::parseElement() - Registered an instance of type '%s' but a request to name it '%s' was rejected.  This is typically because an object of that name already exists.  '%s'", typeName, objectName, mpTaml->getFilePathBuffer() );
+        }
+    }
+
+    // Do we have a reference Id?
+    if ( tamlRefId != 0 )
+    {
+        // Yes, so insert reference.
+        mObjectReferenceMap.insertUnique( tamlRefId, pSimObject );
+    }
+}
+
+//-----------------------------------------------------------------------------
+
 SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
 {
     // Debug Profiling.
@@ -120,19 +177,8 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
     // Do we have a reference to Id?
     if ( tamlRefToId != 0 )
     {
-        // Yes, so fetch reference.
-        typeObjectReferenceHash::Iterator referenceItr = mObjectReferenceMap.find( tamlRefToId );
-
-        // Did we find the reference?
-        if ( referenceItr == mObjectReferenceMap.end() )
-        {
-            // No, so warn.
-            Con::warnf( "Taml: Could not find a reference Id of '%d'", tamlRefToId );
-            return NULL;
-        }
-
-        // Return object.
-        return referenceItr->value;
+        // Yes, so return the reference.
+        return findReference( tamlRefToId );
     }
 
 #ifdef TORQUE_DEBUG
@@ -162,35 +208,8 @@ SimObject* TamlBinaryReader::parseElement( Stream& stream, const U32 versionId )
     // Parse attributes.
     parseAttributes( stream, pSimObject, versionId );
 
-    // Does the object require a name?
-    if ( objectName == StringTable->EmptyString() )
-    {
-        // No, so just register anonymously.
-        pSimObject->registerObject();
-    }
-    else
-    {
-        // Yes, so register a named object.
-        pSimObject->registerObject( objectName );
-
-        // Was the name assigned?
-        if ( pSimObject->getName() != objectName )
-        {
-            // No, so warn that the name was rejected.
-#ifdef TORQUE_DEBUG
-            Con::warnf( "Taml::parseElement() - Registered an instance of type '%s' but a request to name it '%s' was rejected.  This is typically because an object of that name already exists.  '%s'", typeName, objectName, typeLocationBuffer );
-#else
-            Con::warnf( "Taml::parseElement() - Registered an instance of type '%s' but a request to name it '%s' was rejected.  This is typically because an object of that name already exists.", typeName, objectName );
-#endif
-        }
-    }
-
-    // Do we have a reference Id?
-    if ( tamlRefId != 0 )
-    {
-        // Yes, so insert reference.
-        mObjectReferenceMap.insertUnique( tamlRefId, pSimObject );
-    }
+    // Register the object.
+    registerElement( pSimObject, typeName, objectName, tamlRefId );
 
     // Parse custom elements.
     TamlCustomNodes customProperties;
@@ -428,4 +447,447 @@ void TamlBinaryReader::parseCustomNode( Stream& stream, TamlCustomNode* pCustomN
             pChildNode->addField( fieldName, valueBuffer );
         }
     }
-}
\ No newline at end of file
+}
+//-----------------------------------------------------------------------------
+
+struct TamlBinaryReader::IndexedDocument
+{
+    const U8*                   mpData;
+    U32                         mSize;
+    U32                         mPosition;
+    bool                        mCorrupt;
+
+    const char*                 mpStringData;
+    U32                         mStringDataSize;
+    Vector<U32>                 mStringOffsets;
+    Vector<StringTableEntry>    mStringEntries;
+
+    IndexedDocument( const U8* pData, const U32 size ) :
+        mpData( pData ),
+        mSize( size ),
+        mPosition( 0 ),
+        mCorrupt( false ),
+        mpStringData( NULL ),
+        mStringDataSize( 0 )
+    {
+    }
+
+    bool read( U32& value )
+    {
+        if ( mCorrupt || mPosition + sizeof(U32) > mSize )
+        {
+            mCorrupt = true;
+            return false;
+        }
+
+        U32 rawValue;
+        dMemcpy( &rawValue, mpData + mPosition, sizeof(U32) );
+        value = convertLEndianToHost( rawValue );
+        mPosition += sizeof(U32);
+        return true;
+    }
+
+    bool read( bool& value )
+    {
+        if ( mCorrupt || mPosition + 1 > mSize )
+        {
+            mCorrupt = true;
+            return false;
+        }
+
+        value = mpData[mPosition++] != 0;
+        return true;
+    }
+
+    bool readStringTable( void )
+    {
+        U32 stringCount;
+        if ( !read( stringCount ) || !read( mStringDataSize ) )
+            return false;
+
+        // Read the string offsets.
+        if ( stringCount > ( mSize - mPosition ) / sizeof(U32) )
+        {
+            mCorrupt = true;
+            return false;
+        }
+
+        mStringOffsets.setSize( stringCount );
+        for ( U32 index = 0; index < stringCount; ++index )
+            read( mStringOffsets[index] );
+
+        // The string data is used in place.
+        if ( mStringDataSize > mSize - mPosition || ( mStringDataSize > 0 && mpData[mPosition + mStringDataSize - 1] != 0 ) )
+        {
+            mCorrupt = true;
+            return false;
+        }
+
+        mpStringData = (const char*)mpData + mPosition;
+        mPosition += mStringDataSize;
+
+        // String table entries are only created as needed.
+        mStringEntries.setSize( stringCount );
+        dMemset( mStringEntries.address(), 0, sizeof(StringTableEntry) * stringCount );
+
+        return true;
+    }
+
+    /// Returns the string at the index, in place within the document.
+    const char* getString( const U32 index )
+    {
+        if ( index >= (U32)mStringOffsets.size() || mStringOffsets[index] >= mStringDataSize )
+        {
+            mCorrupt = true;
+            return NULL;
+        }
+
+        return mpStringData + mStringOffsets[index];
+    }
+
+    /// Returns the string at the index as a string table entry.
+    StringTableEntry getStringEntry( const U32 index )
+    {
+        const char* pString = getString( index );
+        if ( pString == NULL )
+            return NULL;
+
+        if ( mStringEntries[index] == NULL )
+            mStringEntries[index] = StringTable->insert( pString );
+
+        return mStringEntries[index];
+    }
+};
+
+//-----------------------------------------------------------------------------
+
+SimObject* TamlBinaryReader::readIndexed( FileStream& stream )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ReadIndexed);
+
+    // Read the rest of the file in one go.  Everything is parsed in place from here.
+    const U32 documentSize = stream.getStreamSize() - stream.getPosition();
+    Vector<U8> documentData;
+    documentData.setSize( documentSize );
+    if ( documentSize == 0 || !stream.read( documentSize, documentData.address() ) )
+    {
+        // Warn.
+        Con::warnf( "Taml: Cannot read binary file '%s' as it is truncated.", mpTaml->getFilePathBuffer() );
+        return NULL;
+    }
+
+    IndexedDocument document( documentData.address(), documentSize );
+
+    // Read the string table.
+    if ( !document.readStringTable() )
+    {
+        // Warn.
+        Con::warnf( "Taml: Cannot read binary file '%s' as its string table is corrupt.", mpTaml->getFilePathBuffer() );
+        return NULL;
+    }
+
+    // Parse the root element.
+    SimObject* pSimObject = parseIndexedElement( document );
+
+    // Was the document corrupt?
+    if ( document.mCorrupt )
+    {
+        // Yes, so warn.
+        Con::warnf( "Taml: Binary file '%s' is corrupt at offset %u.", mpTaml->getFilePathBuffer(), document.mPosition );
+    }
+
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
+SimObject* TamlBinaryReader::parseIndexedElement( IndexedDocument& document )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseIndexedElement);
+
+#ifdef TORQUE_DEBUG
+    // Format the type location.
+    char typeLocationBuffer[64];
+    dSprintf( typeLocationBuffer, sizeof(typeLocationBuffer), "Taml [format='binary' offset=%u]", document.mPosition );
+#endif
+
+    // Read element and object names, and references.
+    U32 typeNameIndex, objectNameIndex, tamlRefId, tamlRefToId;
+    if ( !document.read( typeNameIndex ) || !document.read( objectNameIndex ) ||
+         !document.read( tamlRefId ) || !document.read( tamlRefToId ) )
+        return NULL;
+
+    StringTableEntry typeName = document.getStringEntry( typeNameIndex );
+    StringTableEntry objectName = document.getStringEntry( objectNameIndex );
+    if ( typeName == NULL || objectName == NULL )
+        return NULL;
+
+    // Do we have a reference to Id?
+    if ( tamlRefToId != 0 )
+    {
+        // Yes, so return the reference.
+        return findReference( tamlRefToId );
+    }
+
+    // Read the element size.
+    U32 elementSize;
+    if ( !document.read( elementSize ) )
+        return NULL;
+
+    if ( elementSize > document.mSize - document.mPosition )
+    {
+        document.mCorrupt = true;
+        return NULL;
+    }
+
+    const U32 elementEnd = document.mPosition + elementSize;
+
+#ifdef TORQUE_DEBUG
+    // Create type.
+    SimObject* pSimObject = Taml::createType( typeName, mpTaml, typeLocationBuffer );
+#else
+    // Create type.
+    SimObject* pSimObject = Taml::createType( typeName, mpTaml );
+#endif
+
+    // Did we create the type?
+    if ( pSimObject == NULL )
+    {
+        // No, so skip the whole element.
+        document.mPosition = elementEnd;
+        return NULL;
+    }
+
+    pSimObject->setFilename(mpTaml->getFilePathBuffer());
+
+    // Find Taml callbacks.
+    TamlCallbacks* pCallbacks = dynamic_cast<TamlCallbacks*>( pSimObject );
+
+    // Are there any Taml callbacks?
+    if ( pCallbacks != NULL )
+    {
+        // Yes, so call it.
+        mpTaml->tamlPreRead( pCallbacks );
+    }
+
+    // Read attribute count.
+    U32 attributeCount = 0;
+    document.read( attributeCount );
+
+    // Iterate attributes.
+    for ( U32 index = 0; index < attributeCount && !document.mCorrupt; ++index )
+    {
+        U32 attributeNameIndex, attributeValueIndex;
+        if ( !document.read( attributeNameIndex ) || !document.read( attributeValueIndex ) )
+            break;
+
+        // Fetch attribute.  The value is used in place.
+        StringTableEntry attributeName = document.getStringEntry( attributeNameIndex );
+        const char* pAttributeValue = document.getString( attributeValueIndex );
+        if ( attributeName == NULL || pAttributeValue == NULL )
+            break;
+
+        // We can assume this is a field for now.
+        pSimObject->setPrefixedDataField( attributeName, NULL, pAttributeValue );
+    }
+
+    // Register the object.
+    registerElement( pSimObject, typeName, objectName, tamlRefId );
+
+    // Parse children.
+    parseIndexedChildren( document, pSimObject );
+
+    // Parse custom elements.
+    TamlCustomNodes customProperties;
+    parseIndexedCustomElements( document, pCallbacks, customProperties );
+
+    // Are there any Taml callbacks?
+    if ( pCallbacks != NULL )
+    {
+        // Yes, so call it.
+        mpTaml->tamlPostRead( pCallbacks, customProperties );
+    }
+
+    // Return object.
+    return pSimObject;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseIndexedChildren( IndexedDocument& document, SimObject* pSimObject )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseIndexedChildren);
+
+    // Fetch children count.
+    U32 childrenCount;
+    if ( !document.read( childrenCount ) || childrenCount == 0 )
+        return;
+
+    // Fetch the Taml children.
+    TamlChildren* pChildren = dynamic_cast<TamlChildren*>( pSimObject );
+
+    // Fetch any container child class specifier.
+    AbstractClassRep* pContainerChildClass = pSimObject->getClassRep()->getContainerChildClass( true );
+
+    // Is this a sim set?
+    if ( pChildren == NULL )
+    {
+        // No, so warn.
+        Con::warnf("Taml: Child element found under parent but object cannot have children." );
+    }
+
+    // Iterate children.
+    for ( U32 index = 0; index < childrenCount && !document.mCorrupt; ++ index )
+    {
+        // Parse child element.
+        SimObject* pChildSimObject = parseIndexedElement( document );
+
+        // Skip if the child failed.  Its element has been skipped so carry on with its siblings.
+        if ( pChildSimObject == NULL || pChildren == NULL )
+            continue;
+
+        // Do we have a container child class?
+        if ( pContainerChildClass != NULL )
+        {
+            // Yes, so is the child object the correctly derived type?
+            if ( !pChildSimObject->getClassRep()->isClass( pContainerChildClass ) )
+            {
+                // No, so warn.
+                Con::warnf("Taml: Child element '%s' found under parent '%s' but object is restricted to children of type '%s'.",
+                    pChildSimObject->getClassName(),
+                    pSimObject->getClassName(),
+                    pContainerChildClass->getClassName() );
+
+                // NOTE: We can't delete the object as it may be referenced elsewhere!
+                continue;
+            }
+        }
+
+        // Add child.
+        pChildren->addTamlChild( pChildSimObject );
+
+        // Find Taml callbacks for child.
+        TamlCallbacks* pChildCallbacks = dynamic_cast<TamlCallbacks*>( pChildSimObject );
+
+        // Do we have callbacks on the child?
+        if ( pChildCallbacks != NULL )
+        {
+            // Yes, so perform callback.
+            mpTaml->tamlAddParent( pChildCallbacks, pSimObject );
+        }
+    }
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseIndexedCustomElements( IndexedDocument& document, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryReader_ParseIndexedCustomElements);
+
+    // Read custom node count.
+    U32 customNodeCount;
+    if ( !document.read( customNodeCount ) || customNodeCount == 0 )
+        return;
+
+    // Iterate custom nodes.
+    for ( U32 nodeIndex = 0; nodeIndex < customNodeCount && !document.mCorrupt; ++nodeIndex )
+    {
+        // Read custom node name and child count.
+        U32 nodeNameIndex, childNodeCount;
+        if ( !document.read( nodeNameIndex ) || !document.read( childNodeCount ) )
+            return;
+
+        StringTableEntry nodeName = document.getStringEntry( nodeNameIndex );
+        if ( nodeName == NULL )
+            return;
+
+        // Add custom node.
+        TamlCustomNode* pCustomNode = customNodes.addNode( nodeName );
+
+        // Parse the custom node children.
+        for ( U32 childIndex = 0; childIndex < childNodeCount && !document.mCorrupt; ++childIndex )
+            parseIndexedCustomNode( document, pCustomNode );
+    }
+
+    // Do we have callbacks?
+    if ( pCallbacks == NULL )
+    {
+        // No, so warn.
+        Con::warnf( "Taml: Encountered custom data but object does not support custom data." );
+        return;
+    }
+
+    // Custom read callback.
+    mpTaml->tamlCustomRead( pCallbacks, customNodes );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryReader::parseIndexedCustomNode( IndexedDocument& document, TamlCustomNode* pCustomNode )
+{
+    // Fetch if a proxy object.
+    bool isProxyObject;
+    if ( !document.read( isProxyObject ) )
+        return;
+
+    // Is this a proxy object?
+    if ( isProxyObject )
+    {
+        // Yes, so parse proxy object.
+        SimObject* pProxyObject = parseIndexedElement( document );
+
+        // Add child node.
+        if ( pProxyObject != NULL )
+            pCustomNode->addNode( pProxyObject );
+
+        return;
+    }
+
+    // No, so read custom node name and text.
+    U32 nodeNameIndex, nodeTextIndex;
+    if ( !document.read( nodeNameIndex ) || !document.read( nodeTextIndex ) )
+        return;
+
+    StringTableEntry nodeName = document.getStringEntry( nodeNameIndex );
+    const char* pNodeText = document.getString( nodeTextIndex );
+    if ( nodeName == NULL || pNodeText == NULL )
+        return;
+
+    // Add child node.
+    TamlCustomNode* pChildNode = pCustomNode->addNode( nodeName );
+    pChildNode->setNodeText( pNodeText );
+
+    // Read child node count.
+    U32 childNodeCount;
+    if ( !document.read( childNodeCount ) )
+        return;
+
+    // Parse children nodes.
+    for( U32 childIndex = 0; childIndex < childNodeCount && !document.mCorrupt; ++childIndex )
+        parseIndexedCustomNode( document, pChildNode );
+
+    // Read child field count.
+    U32 childFieldCount;
+    if ( !document.read( childFieldCount ) )
+        return;
+
+    // Parse child fields.
+    for( U32 childFieldIndex = 0; childFieldIndex < childFieldCount && !document.mCorrupt; ++childFieldIndex )
+    {
+        U32 fieldNameIndex, fieldValueIndex;
+        if ( !document.read( fieldNameIndex ) || !document.read( fieldValueIndex ) )
+            return;
+
+        StringTableEntry fieldName = document.getStringEntry( fieldNameIndex );
+        const char* pFieldValue = document.getString( fieldValueIndex );
+        if ( fieldName == NULL || pFieldValue == NULL )
+            return;
+
+        // Add field.
+        pChildNode->addField( fieldName, pFieldValue );
+    }
+}
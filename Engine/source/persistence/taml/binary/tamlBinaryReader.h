@@ -55,14 +55,26 @@ private:
 
     typeObjectReferenceHash mObjectReferenceMap;
 
+    /// An indexed document read into memory along with its string table.
+    struct IndexedDocument;
+
 private:
     void resetParse( void );
 
+    SimObject* findReference( const U32 tamlRefToId );
+    void registerElement( SimObject* pSimObject, StringTableEntry typeName, StringTableEntry objectName, const U32 tamlRefId );
+
     SimObject* parseElement( Stream& stream, const U32 versionId );
     void parseAttributes( Stream& stream, SimObject* pSimObject, const U32 versionId );
     void parseChildren( Stream& stream, TamlCallbacks* pCallbacks, SimObject* pSimObject, const U32 versionId );
     void parseCustomElements( Stream& stream, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes, const U32 versionId );
     void parseCustomNode( Stream& stream, TamlCustomNode* pCustomNode, const U32 versionId );
+
+    SimObject* readIndexed( FileStream& stream );
+    SimObject* parseIndexedElement( IndexedDocument& document );
+    void parseIndexedChildren( IndexedDocument& document, SimObject* pSimObject );
+    void parseIndexedCustomElements( IndexedDocument& document, TamlCallbacks* pCallbacks, TamlCustomNodes& customNodes );
+    void parseIndexedCustomNode( IndexedDocument& document, TamlCustomNode* pCustomNode );
 };
 
 #endif // _TAML_BINARYREADER_H_
\ No newline at end of file
@@ -26,6 +26,10 @@
 #include "core/util/zip/zipSubStream.h"
 #endif
 
+#ifndef _MEMSTREAM_H_
+#include "core/stream/memStream.h"
+#endif
+
 // Debug Profiling.
 #include "platform/profiler.h"
 
@@ -39,6 +43,19 @@ bool TamlBinaryWriter::write( FileStream& stream, const TamlWriteNode* pTamlWrit
     // Write Taml signature.
     stream.writeString( StringTable->insert( TAML_SIGNATURE ) );
 
+    // Are we compressed?
+    if ( !compressed )
+    {
+        // No, so write the indexed version Id.
+        stream.write( mIndexedVersionId );
+
+        // Write compressed flag.
+        stream.write( compressed );
+
+        // Write indexed document.
+        return writeIndexed( stream, pTamlWriteNode );
+    }
+
     // Write version Id.
     stream.write( mVersionId );
 
@@ -294,4 +311,184 @@ void TamlBinaryWriter::writeCustomNode( Stream& stream, const TamlCustomNode* pC
             stream.writeLongString( MAX_TAML_NODE_FIELDVALUE_LENGTH, pField->getFieldValue() );
         }
     }
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlBinaryWriter::writeIndexed( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteIndexed);
+
+    // Reset the string table.
+    mStringIndices.clear();
+    mStringOffsets.clear();
+    mStringData.clear();
+
+    // Write the elements to memory first as the string table precedes them.
+    MemStream elementStream( 64 * 1024 );
+    writeIndexedElement( elementStream, pTamlWriteNode );
+
+    // Write the string table.
+    stream.write( (U32)mStringOffsets.size() );
+    stream.write( (U32)mStringData.size() );
+
+    for ( U32 index = 0; index < (U32)mStringOffsets.size(); ++index )
+        stream.write( mStringOffsets[index] );
+
+    stream.write( (U32)mStringData.size(), mStringData.address() );
+
+    // Write the elements.
+    return stream.write( elementStream.getStreamSize(), elementStream.getBuffer() );
+}
+
+//-----------------------------------------------------------------------------
+
+U32 TamlBinaryWriter::getStringIndex( const char* pString )
+{
+    if ( pString == NULL )
+        pString = StringTable->EmptyString();
+
+    // Is the string already in the string table?
+    String string( pString );
+    typeStringIndexHash::iterator stringItr = mStringIndices.find( string );
+    if ( stringItr != mStringIndices.end() )
+    {
+        // Yes, so use it.
+        return stringItr->value;
+    }
+
+    // No, so add it, including the terminator so it can be used in place.
+    const U32 index = (U32)mStringOffsets.size();
+    const U32 length = (U32)string.length();
+    const U32 offset = (U32)mStringData.size();
+
+    mStringOffsets.push_back( offset );
+    mStringData.setSize( offset + length + 1 );
+    dMemcpy( mStringData.address() + offset, pString, length + 1 );
+
+    mStringIndices.insert( string, index );
+
+    return index;
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeIndexedElement( Stream& stream, const TamlWriteNode* pTamlWriteNode )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlBinaryWriter_WriteIndexedElement);
+
+    // Fetch object.
+    SimObject* pSimObject = pTamlWriteNode->mpSimObject;
+
+    // Write element and object names.
+    stream.write( getStringIndex( pSimObject->getClassName() ) );
+    stream.write( getStringIndex( pTamlWriteNode->mpObjectName ) );
+
+    // Write reference Id.
+    stream.write( pTamlWriteNode->mRefId );
+
+    // Do we have a reference to node?
+    if ( pTamlWriteNode->mRefToNode != NULL )
+    {
+        // Yes, so fetch reference to Id.
+        const U32 tamlRefToId = pTamlWriteNode->mRefToNode->mRefId;
+
+        // Sanity!
+        AssertFatal( tamlRefToId != 0, "Taml: Invalid reference to Id." );
+
+        // Write reference to Id.
+        stream.write( tamlRefToId );
+
+        // Finished.
+        return;
+    }
+
+    // No, so write no reference to Id.
+    stream.write( (U32)0 );
+
+    // Write placeholder element size.
+    const U32 sizePosition = stream.getPosition();
+    stream.write( (U32)0 );
+
+    // Write attributes.
+    const Vector<TamlWriteNode::FieldValuePair*>& fields = pTamlWriteNode->mFields;
+    stream.write( (U32)fields.size() );
+    for( Vector<TamlWriteNode::FieldValuePair*>::const_iterator itr = fields.begin(); itr != fields.end(); ++itr )
+    {
+        stream.write( getStringIndex( (*itr)->mName ) );
+        stream.write( getStringIndex( (*itr)->mpValue ) );
+    }
+
+    // Write children.
+    Vector<TamlWriteNode*>* pChildren = pTamlWriteNode->mChildren;
+    stream.write( pChildren == NULL ? (U32)0 : (U32)pChildren->size() );
+    if ( pChildren != NULL )
+    {
+        for( Vector<TamlWriteNode*>::iterator itr = pChildren->begin(); itr != pChildren->end(); ++itr )
+            writeIndexedElement( stream, (*itr) );
+    }
+
+    // Write custom elements.
+    const TamlCustomNodeVector& nodes = pTamlWriteNode->mCustomNodes.getNodes();
+    stream.write( (U32)nodes.size() );
+    for( TamlCustomNodeVector::const_iterator customNodesItr = nodes.begin(); customNodesItr != nodes.end(); ++customNodesItr )
+    {
+        // Fetch the custom node.
+        const TamlCustomNode* pCustomNode = *customNodesItr;
+
+        // Write custom node name.
+        stream.write( getStringIndex( pCustomNode->getNodeName() ) );
+
+        // Write the custom node children.
+        const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+        stream.write( (U32)nodeChildren.size() );
+        for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+            writeIndexedCustomNode( stream, *childNodeItr );
+    }
+
+    // Patch the element size so readers can skip the element.
+    const U32 endPosition = stream.getPosition();
+    stream.setPosition( sizePosition );
+    stream.write( endPosition - sizePosition - (U32)sizeof(U32) );
+    stream.setPosition( endPosition );
+}
+
+//-----------------------------------------------------------------------------
+
+void TamlBinaryWriter::writeIndexedCustomNode( Stream& stream, const TamlCustomNode* pCustomNode )
+{
+    // Is the node a proxy object?
+    if ( pCustomNode->isProxyObject() )
+    {
+        // Yes, so flag as proxy object.
+        stream.write( true );
+
+        // Write the element.
+        writeIndexedElement( stream, pCustomNode->getProxyWriteNode() );
+        return;
+    }
+
+    // No, so flag as custom node.
+    stream.write( false );
+
+    // Write custom node name and text.
+    stream.write( getStringIndex( pCustomNode->getNodeName() ) );
+    stream.write( getStringIndex( pCustomNode->getNodeTextField().getFieldValue() ) );
+
+    // Write custom node children.
+    const TamlCustomNodeVector& nodeChildren = pCustomNode->getChildren();
+    stream.write( (U32)nodeChildren.size() );
+    for( TamlCustomNodeVector::const_iterator childNodeItr = nodeChildren.begin(); childNodeItr != nodeChildren.end(); ++childNodeItr )
+        writeIndexedCustomNode( stream, *childNodeItr );
+
+    // Write custom node fields.
+    const TamlCustomFieldVector& fields = pCustomNode->getFields();
+    stream.write( (U32)fields.size() );
+    for ( TamlCustomFieldVector::const_iterator fieldItr = fields.begin(); fieldItr != fields.end(); ++fieldItr )
+    {
+        stream.write( getStringIndex( (*fieldItr)->getFieldName() ) );
+        stream.write( getStringIndex( (*fieldItr)->getFieldValue() ) );
+    }
+}
@@ -27,6 +27,10 @@
 #include "persistence/taml/taml.h"
 #endif
 
+#ifndef _TDICTIONARY_H_
+#include "core/util/tDictionary.h"
+#endif
+
 //-----------------------------------------------------------------------------
 
 /// @ingroup tamlGroup
@@ -36,7 +40,8 @@ class TamlBinaryWriter
 public:
     TamlBinaryWriter( Taml* pTaml ) :
         mpTaml( pTaml ),
-        mVersionId(2)
+        mVersionId(2),
+        mIndexedVersionId(3)
     {
     }
     virtual ~TamlBinaryWriter() {}
@@ -48,12 +53,27 @@ private:
     Taml* mpTaml;
     const U32 mVersionId;
 
+    /// Uncompressed documents are written with a string table and with the size of
+    /// each element so they can be read in place and have subtrees skipped.
+    const U32 mIndexedVersionId;
+
+    typedef HashMap<String, U32> typeStringIndexHash;
+
+    typeStringIndexHash mStringIndices;
+    Vector<U32> mStringOffsets;
+    Vector<char> mStringData;
+
 private:
     void writeElement( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeAttributes( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeChildren( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeCustomElements( Stream& stream, const TamlWriteNode* pTamlWriteNode );
     void writeCustomNode( Stream& stream, const TamlCustomNode* pCustomNode );
+
+    bool writeIndexed( Stream& stream, const TamlWriteNode* pTamlWriteNode );
+    U32 getStringIndex( const char* pString );
+    void writeIndexedElement( Stream& stream, const TamlWriteNode* pTamlWriteNode );
+    void writeIndexedCustomNode( Stream& stream, const TamlCustomNode* pCustomNode );
 };
 
 #endif // _TAML_BINARYWRITER_H_
\ No newline at end of file
@@ -815,28 +815,27 @@ ImplementEnumType(_TamlFormatMode,
       Vector<SimFieldDictionary::Entry*> dynamicFieldList(__FILE__, __LINE__);
 
       // Ensure the dynamic field doesn't conflict with static field.
-      for (U32 hashIndex = 0; hashIndex < SimFieldDictionary::HashTableSize; ++hashIndex)
+      for (SimFieldDictionaryIterator itr(pFieldDictionary); *itr; ++itr)
       {
-         for (SimFieldDictionary::Entry* pEntry = pFieldDictionary->mHashTable[hashIndex]; pEntry; pEntry = pEntry->next)
+         SimFieldDictionary::Entry* pEntry = *itr;
+
+         // Iterate static fields.
+         U32 fieldIndex;
+         for (fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex)
          {
-            // Iterate static fields.
-            U32 fieldIndex;
-            for (fieldIndex = 0; fieldIndex < fieldCount; ++fieldIndex)
-            {
-               if (fieldList[fieldIndex].pFieldname == pEntry->slotName)
-                  break;
-            }
+            if (fieldList[fieldIndex].pFieldname == pEntry->slotName)
+               break;
+         }
 
-            // Skip if found.
-            if (fieldIndex != (U32)fieldList.size())
-               continue;
+         // Skip if found.
+         if (fieldIndex != (U32)fieldList.size())
+            continue;
 
-            // Skip if not writing field.
-            if (!pSimObject->writeField(pEntry->slotName, pEntry->value))
-               continue;
+         // Skip if not writing field.
+         if (!pSimObject->writeField(pEntry->slotName, pEntry->value))
+            continue;
 
-            dynamicFieldList.push_back(pEntry);
-         }
+         dynamicFieldList.push_back(pEntry);
       }
 
       // Sort Entries to prevent version control conflicts
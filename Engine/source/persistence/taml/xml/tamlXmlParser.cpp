@@ -85,8 +85,18 @@ bool TamlXmlParser::accept( const char* pFilename, TamlVisitor& visitor )
     // Close the stream.
     // stream.close();
 
+    return accept( filenameBuffer, xmlDocument, visitor );
+}
+
+//-----------------------------------------------------------------------------
+
+bool TamlXmlParser::accept( const char* pFilename, VfsXMLDocument& xmlDocument, TamlVisitor& visitor )
+{
+    // Debug Profiling.
+    PROFILE_SCOPE(TamlXmlParser_AcceptDocument);
+
     // Set parsing filename.
-    setParsingFilename( filenameBuffer );
+    setParsingFilename( pFilename );
 
     // Flag document as not dirty.
     mDocumentDirty = false;
@@ -110,7 +120,7 @@ bool TamlXmlParser::accept( const char* pFilename, TamlVisitor& visitor )
     }*/
 
     // Yes, so save the document.
-    if ( !xmlDocument.SaveFile( filenameBuffer ) )
+    if ( !xmlDocument.SaveFile( pFilename ) )
     {
         // Warn!
         Con::warnf("TamlXmlParser: Could not save Taml XML document.");
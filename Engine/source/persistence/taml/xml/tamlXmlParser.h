@@ -33,6 +33,7 @@
 
 //-----------------------------------------------------------------------------
 class fsTiXmlElement;
+class VfsXMLDocument;
 
 /// @ingroup tamlGroup
 /// @see tamlGroup
@@ -48,6 +49,11 @@ public:
     /// Accept visitor.
     bool accept( const char* pFilename, TamlVisitor& visitor ) override;
 
+    /// Accept visitor for a document that has already been loaded from the
+    /// (expanded) filename.  This allows the loading to be done elsewhere,
+    /// such as on a worker thread.
+    bool accept( const char* pFilename, VfsXMLDocument& xmlDocument, TamlVisitor& visitor );
+
 private:
     inline bool parseElement( tinyxml2::XMLElement* pXmlElement, TamlVisitor& visitor );
     inline bool parseAttributes( tinyxml2::XMLElement* pXmlElement, TamlVisitor& visitor );
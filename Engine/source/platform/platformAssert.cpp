@@ -91,6 +91,10 @@ bool PlatformAssert::process(Type         assertType,
             Con::warnf(ConsoleLogEntry::Assert, "%s(%ld,0): {%s} - %s", filename, lineNumber, typeName[assertType], message);
         else
             Con::errorf(ConsoleLogEntry::Assert, "%s(%ld,0): {%s} - %s", filename, lineNumber, typeName[assertType], message);
+
+        // Make sure the assert and whatever led up to it is on disk in case
+        // we don't live through it.
+        Con::flushLog();
     }
     
     // if not a WARNING pop-up a dialog box
@@ -87,6 +87,12 @@ inline U32 dAtomicRead( volatile U32 &ref )
    #endif
 }
 
+/// Performs an atomic write operation with release semantics.
+inline void dAtomicWrite( volatile U32 &ref, U32 val )
+{
+   __atomic_store_n( &ref, val, __ATOMIC_RELEASE );
+}
+
 #ifdef TORQUE_OS_MAC
 #pragma GCC diagnostic pop
 #endif
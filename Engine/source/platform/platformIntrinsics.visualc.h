@@ -58,4 +58,10 @@ inline U32 dAtomicRead( volatile U32 &ref )
    return _InterlockedExchangeAdd( ( volatile long* )&ref, 0 );
 }
 
+/// Performs an atomic write operation with release semantics.
+inline void dAtomicWrite( volatile U32 &ref, U32 val )
+{
+   _InterlockedExchange( ( volatile long* )&ref, val );
+}
+
 #endif // _TORQUE_PLATFORM_PLATFORMINTRINSICS_VISUALC_H_
@@ -1773,6 +1773,24 @@ AFTER_MODULE_INIT( Sim )
       "@ingroup Debugging" );
 }
 
+#elif defined(TORQUE_SLAB_ALLOCATOR)
+
+// Size classed slabs with per-thread caches, see platformMemorySlab.cpp
+void* dMalloc_r(dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return Memory::slabAlloc(in_size, fileName);
+}
+
+void dFree(void* in_pFree)
+{
+   Memory::slabFree(in_pFree);
+}
+
+void* dRealloc_r(void* in_pResize, dsize_t in_size, const char* fileName, const dsize_t line)
+{
+   return Memory::slabRealloc(in_pResize, in_size, fileName);
+}
+
 #else
 
 // Don't manage our own memory
@@ -54,6 +54,43 @@ namespace Memory
    dsize_t     getMemoryAllocated();
    void        getMemoryInfo( void* ptr, Info& info );
    void        validate();
+
+   /// Subsystems the slab allocator keeps byte counts for.  Allocations are
+   /// tagged by the directory of the source file passed to dMalloc_r.
+   enum ETag
+   {
+      TAG_General,
+      TAG_Gfx,
+      TAG_Script,
+      TAG_TS,
+      TAG_Net,
+      TAG_SFX,
+      TAG_Count
+   };
+
+   /// @name Slab Allocator
+   ///
+   /// Size classed allocator with per-thread caches.  Blocks up to 32K are
+   /// carved out of slabs and recycled through a cache owned by the thread
+   /// freeing them, so most allocations and frees don't touch any shared
+   /// state.  Larger blocks go to the system heap.
+   ///
+   /// Backs dMalloc_r, dRealloc_r and dFree if TORQUE_SLAB_ALLOCATOR is
+   /// defined and the memory manager is disabled, but can be used directly
+   /// in any configuration.
+   /// @{
+
+   void*       slabAlloc( dsize_t size, const char* fileName = NULL );
+   void*       slabRealloc( void* mem, dsize_t size, const char* fileName = NULL );
+   void        slabFree( void* mem );
+
+   /// Returns the number of bytes currently allocated from the slab
+   /// allocator under the given tag.  Counts are pushed from the per-thread
+   /// caches in batches, so other threads' latest allocations may be missing.
+   S64         getTagBytes( ETag tag );
+   const char* getTagName( ETag tag );
+
+   /// @}
 }
 
 #endif // _TORQUE_PLATFORM_PLATFORMMEMORY_H_
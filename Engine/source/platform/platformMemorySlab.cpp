@@ -0,0 +1,709 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "platform/platformMemory.h"
+#include "platform/platformIntrinsics.h"
+#include "platform/threads/threadPool.h"
+#include "console/console.h"
+#include "console/engineAPI.h"
+#include "math/mRandom.h"
+
+#ifdef new
+#undef new
+#endif
+
+namespace Memory
+{
+
+//-----------------------------------------------------------------------------
+// Size classes
+//
+// Eight classes 16 bytes apart up to 128 bytes, then four classes per power
+// of two up to 32K.  Block sizes include the header, which keeps every block
+// 16 byte aligned and tells slabFree() where the block goes back to.
+//-----------------------------------------------------------------------------
+
+enum SlabConstants : U32
+{
+   SlabHeaderSize    = 16,
+   SlabMaxBlockSize  = 32 * 1024,
+   SlabClassCount    = 40,
+   SlabLargeClass    = 0xFFFF,
+   SlabMinSlabSize   = 64 * 1024,
+
+   /// Blocks moved between a thread cache and the central lists at a time
+   /// is this many bytes worth, clamped to [2, SlabMaxBatch].
+   SlabBatchBytes    = 16 * 1024,
+   SlabMaxBatch      = 64,
+
+   /// Tag counter changes are pushed to the global counters once they
+   /// add up to this many bytes.
+   SlabTagFlushBytes = 64 * 1024,
+
+   SlabTagCacheSize  = 64,
+
+   /// Times a thread waiting for a central list checks the lock before
+   /// it gives up the rest of its time slice.
+   SlabLockSpins     = 128,
+};
+
+struct SlabHeader
+{
+   /// Size asked for; what the tag counters are updated with.
+   dsize_t mSize;
+   U16 mClass;
+   U16 mTag;
+
+   /// Fills the header out to SlabHeaderSize whatever the size of dsize_t.
+   U8 mPad[ SlabHeaderSize - sizeof( dsize_t ) - 2 * sizeof( U16 ) ];
+};
+
+static_assert( sizeof( SlabHeader ) == SlabHeaderSize, "SlabHeader must keep the blocks behind it 16 byte aligned" );
+
+/// Free blocks are linked through their first bytes.
+struct SlabFreeBlock
+{
+   SlabFreeBlock* mNext;
+};
+
+/// The lists shared by all threads for one size class.
+struct SlabCentral
+{
+   volatile U32 mLock;
+   SlabFreeBlock* mFree;
+
+   /// Unused remainder of the slab blocks are currently carved from.
+   U8* mCarve;
+   U8* mCarveEnd;
+};
+
+/// Everything a thread keeps for itself.  Trivially constructible and
+/// destructible so it can be used from allocations during static
+/// initialization and destruction.
+struct SlabThreadCache
+{
+   SlabFreeBlock* mFree[ SlabClassCount ];
+   U32 mCount[ SlabClassCount ];
+
+   /// Tag counter changes not yet pushed to smTagBytes.
+   S64 mTagDelta[ TAG_Count ];
+
+   /// Source files seen recently and the tag they map to.
+   const char* mTagFile[ SlabTagCacheSize ];
+   U8 mTagFileTag[ SlabTagCacheSize ];
+
+   bool mInitialized;
+
+   /// Set once the thread is exiting and the cache has been handed back.
+   bool mReleased;
+};
+
+static SlabCentral smCentral[ SlabClassCount ];
+static volatile U64 smTagBytes[ TAG_Count ];
+
+static thread_local SlabThreadCache tSlabCache;
+
+static void _releaseThreadCache();
+
+/// Hands the thread cache back when its thread exits.
+struct SlabCacheReaper
+{
+   ~SlabCacheReaper() { _releaseThreadCache(); }
+};
+
+static thread_local SlabCacheReaper tSlabCacheReaper;
+
+static const char* smTagNames[ TAG_Count ] =
+{
+   "general", "gfx", "script", "ts", "net", "sfx"
+};
+
+/// Directories that put an allocation in a tag.  Matched at the start
+/// of a path component of the allocating source file.
+static const struct
+{
+   const char* mPath;
+   ETag mTag;
+} smTagPaths[] =
+{
+   { "gfx/",                  TAG_Gfx },
+   { "console/",              TAG_Script },
+   { "ts/",                   TAG_TS },
+   { "sfx/",                  TAG_SFX },
+   { "app/net/",              TAG_Net },
+   { "sim/net",               TAG_Net },
+   { "sim/connection",        TAG_Net },
+   { "platform/platformNet",  TAG_Net },
+};
+
+//-----------------------------------------------------------------------------
+
+static inline U32 _getSlabClass( dsize_t blockSize )
+{
+   if( blockSize <= 128 )
+      return ( U32( blockSize ) + 15 ) / 16 - 1;
+
+   const U32 n = U32( blockSize ) - 1;
+   U32 log2 = 7;
+   while( n >> ( log2 + 1 ) )
+      log2 ++;
+
+   return 8 + ( log2 - 7 ) * 4 + ( n >> ( log2 - 2 ) ) - 4;
+}
+
+static inline U32 _getSlabClassSize( U32 slabClass )
+{
+   if( slabClass < 8 )
+      return ( slabClass + 1 ) * 16;
+
+   const U32 log2 = 7 + ( slabClass - 8 ) / 4;
+   return ( 4 + ( slabClass - 8 ) % 4 + 1 ) << ( log2 - 2 );
+}
+
+static inline U32 _getSlabBatch( U32 slabClass )
+{
+   return getMax( getMin( SlabBatchBytes / _getSlabClassSize( slabClass ), U32( SlabMaxBatch ) ), U32( 2 ) );
+}
+
+static void _lockCentral( SlabCentral& central )
+{
+   // Wait on plain reads so the waiters don't keep taking the cache line
+   // away from the holder, and yield in case the holder got preempted.
+   U32 spins = 0;
+   while( !dCompareAndSwap( central.mLock, 0, 1 ) )
+   {
+      while( central.mLock )
+      {
+         if( ++ spins >= SlabLockSpins )
+         {
+            Platform::sleep( 0 );
+            spins = 0;
+         }
+      }
+   }
+}
+
+static void _unlockCentral( SlabCentral& central )
+{
+   dAtomicWrite( central.mLock, 0 );
+}
+
+//-----------------------------------------------------------------------------
+
+static void _addTagBytes( ETag tag, S64 bytes )
+{
+   U64 oldValue;
+   do
+   {
+      oldValue = smTagBytes[ tag ];
+   }
+   while( !dCompareAndSwap( smTagBytes[ tag ], oldValue, oldValue + U64( bytes ) ) );
+}
+
+static void _flushTagDeltas( SlabThreadCache& cache )
+{
+   for( U32 i = 0; i < TAG_Count; i ++ )
+   {
+      if( cache.mTagDelta[ i ] )
+      {
+         _addTagBytes( ETag( i ), cache.mTagDelta[ i ] );
+         cache.mTagDelta[ i ] = 0;
+      }
+   }
+}
+
+static inline void _countTagBytes( ETag tag, S64 bytes )
+{
+   SlabThreadCache& cache = tSlabCache;
+   if( cache.mReleased )
+   {
+      _addTagBytes( tag, bytes );
+      return;
+   }
+
+   S64& delta = cache.mTagDelta[ tag ];
+   delta += bytes;
+   if( delta >= SlabTagFlushBytes || delta <= -S64( SlabTagFlushBytes ) )
+   {
+      _addTagBytes( tag, delta );
+      delta = 0;
+   }
+}
+
+/// Returns true if @a path starts with @a prefix, treating backslashes
+/// as forward slashes.
+static bool _matchPathPrefix( const char* path, const char* prefix )
+{
+   for( ; *prefix; path ++, prefix ++ )
+   {
+      const char c = ( *path == '\\' ) ? '/' : *path;
+      if( c != *prefix )
+         return false;
+   }
+   return true;
+}
+
+static ETag _classifyFile( const char* fileName )
+{
+   for( const char* component = fileName; *component; component ++ )
+   {
+      if( component != fileName && component[ -1 ] != '/' && component[ -1 ] != '\\' )
+         continue;
+
+      for( U32 i = 0; i < sizeof( smTagPaths ) / sizeof( smTagPaths[ 0 ] ); i ++ )
+      {
+         if( _matchPathPrefix( component, smTagPaths[ i ].mPath ) )
+            return smTagPaths[ i ].mTag;
+      }
+   }
+
+   return TAG_General;
+}
+
+static ETag _getFileTag( const char* fileName )
+{
+   if( !fileName )
+      return TAG_General;
+
+   SlabThreadCache& cache = tSlabCache;
+   if( cache.mReleased )
+      return _classifyFile( fileName );
+
+   // __FILE__ strings are constants, so the pointer is a good enough key.
+   const U32 slot = U32( uintptr_t( fileName ) >> 3 ) & ( SlabTagCacheSize - 1 );
+   if( cache.mTagFile[ slot ] != fileName )
+   {
+      cache.mTagFile[ slot ] = fileName;
+      cache.mTagFileTag[ slot ] = _classifyFile( fileName );
+   }
+
+   return ETag( cache.mTagFileTag[ slot ] );
+}
+
+//-----------------------------------------------------------------------------
+
+/// Take up to @a count blocks of the given class from the central lists,
+/// carving new ones as needed.  Returns the number of blocks taken.
+static U32 _takeFromCentral( U32 slabClass, U32 count, SlabFreeBlock*& outList )
+{
+   SlabCentral& central = smCentral[ slabClass ];
+   const U32 blockSize = _getSlabClassSize( slabClass );
+
+   _lockCentral( central );
+
+   U32 taken = 0;
+   SlabFreeBlock* list = NULL;
+   while( taken < count )
+   {
+      SlabFreeBlock* block;
+      if( central.mFree )
+      {
+         block = central.mFree;
+         central.mFree = block->mNext;
+      }
+      else
+      {
+         if( central.mCarve + blockSize > central.mCarveEnd )
+         {
+            // Slabs are never given back; their blocks just get recycled.
+            const U32 slabSize = getMax( U32( SlabMinSlabSize ), blockSize * 8 );
+            U8* slab = ( U8* ) dRealMalloc( slabSize );
+            if( !slab )
+               break;
+
+            central.mCarve = slab;
+            central.mCarveEnd = slab + slabSize;
+         }
+
+         block = ( SlabFreeBlock* ) central.mCarve;
+         central.mCarve += blockSize;
+      }
+
+      block->mNext = list;
+      list = block;
+      taken ++;
+   }
+
+   _unlockCentral( central );
+
+   outList = list;
+   return taken;
+}
+
+/// Put a list of @a count blocks back on the central lists.
+static void _giveToCentral( U32 slabClass, SlabFreeBlock* list, SlabFreeBlock* last )
+{
+   SlabCentral& central = smCentral[ slabClass ];
+
+   _lockCentral( central );
+   last->mNext = central.mFree;
+   central.mFree = list;
+   _unlockCentral( central );
+}
+
+static void _releaseThreadCache()
+{
+   SlabThreadCache& cache = tSlabCache;
+   if( cache.mReleased )
+      return;
+
+   for( U32 i = 0; i < SlabClassCount; i ++ )
+   {
+      SlabFreeBlock* list = cache.mFree[ i ];
+      if( !list )
+         continue;
+
+      SlabFreeBlock* last = list;
+      while( last->mNext )
+         last = last->mNext;
+
+      _giveToCentral( i, list, last );
+      cache.mFree[ i ] = NULL;
+      cache.mCount[ i ] = 0;
+   }
+
+   _flushTagDeltas( cache );
+   cache.mReleased = true;
+}
+
+static SlabFreeBlock* _allocBlock( U32 slabClass )
+{
+   SlabThreadCache& cache = tSlabCache;
+   if( !cache.mInitialized )
+   {
+      cache.mInitialized = true;
+
+      // Touching the reaper is what makes it get destroyed at thread exit.
+      SlabCacheReaper* volatile reaper = &tSlabCacheReaper;
+      ( void ) reaper;
+   }
+
+   if( cache.mReleased )
+   {
+      SlabFreeBlock* block;
+      return _takeFromCentral( slabClass, 1, block ) ? block : NULL;
+   }
+
+   SlabFreeBlock* block = cache.mFree[ slabClass ];
+   if( !block )
+   {
+      cache.mCount[ slabClass ] = _takeFromCentral( slabClass, _getSlabBatch( slabClass ), block );
+      if( !block )
+         return NULL;
+   }
+
+   cache.mFree[ slabClass ] = block->mNext;
+   cache.mCount[ slabClass ] --;
+   return block;
+}
+
+static void _freeBlock( U32 slabClass, SlabFreeBlock* block )
+{
+   SlabThreadCache& cache = tSlabCache;
+   if( cache.mReleased )
+   {
+      _giveToCentral( slabClass, block, block );
+      return;
+   }
+
+   block->mNext = cache.mFree[ slabClass ];
+   cache.mFree[ slabClass ] = block;
+
+   // Don't let a thread that frees what others allocate hoard the blocks.
+   const U32 batch = _getSlabBatch( slabClass );
+   if( ++ cache.mCount[ slabClass ] > batch * 2 )
+   {
+      SlabFreeBlock* list = cache.mFree[ slabClass ];
+      SlabFreeBlock* last = list;
+      for( U32 i = 1; i < batch; i ++ )
+         last = last->mNext;
+
+      cache.mFree[ slabClass ] = last->mNext;
+      cache.mCount[ slabClass ] -= batch;
+      _giveToCentral( slabClass, list, last );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+static void* _slabAlloc( dsize_t size, ETag tag )
+{
+   const dsize_t blockSize = size + SlabHeaderSize;
+
+   SlabHeader* header;
+   U32 slabClass;
+   if( blockSize <= SlabMaxBlockSize )
+   {
+      slabClass = _getSlabClass( blockSize );
+      header = ( SlabHeader* ) _allocBlock( slabClass );
+   }
+   else
+   {
+      slabClass = SlabLargeClass;
+      header = ( SlabHeader* ) dRealMalloc( blockSize );
+   }
+
+   if( !header )
+      return NULL;
+
+   header->mSize = size;
+   header->mClass = slabClass;
+   header->mTag = tag;
+   _countTagBytes( tag, S64( size ) );
+
+   return header + 1;
+}
+
+void* slabAlloc( dsize_t size, const char* fileName )
+{
+   return _slabAlloc( size, _getFileTag( fileName ) );
+}
+
+void slabFree( void* mem )
+{
+   if( !mem )
+      return;
+
+   SlabHeader* header = ( ( SlabHeader* ) mem ) - 1;
+   AssertFatal( header->mClass == SlabLargeClass || header->mClass < SlabClassCount,
+      "Memory::slabFree - Not a block from the slab allocator." );
+
+   _countTagBytes( ETag( header->mTag ), -S64( header->mSize ) );
+
+   if( header->mClass == SlabLargeClass )
+      dRealFree( header );
+   else
+      _freeBlock( header->mClass, ( SlabFreeBlock* ) header );
+}
+
+void* slabRealloc( void* mem, dsize_t size, const char* fileName )
+{
+   if( !mem )
+      return slabAlloc( size, fileName );
+   if( !size )
+   {
+      slabFree( mem );
+      return NULL;
+   }
+
+   SlabHeader* header = ( ( SlabHeader* ) mem ) - 1;
+
+   // Stay in the block if it's the right size class already.
+   const dsize_t blockSize = size + SlabHeaderSize;
+   if( header->mClass != SlabLargeClass && blockSize <= SlabMaxBlockSize && _getSlabClass( blockSize ) == header->mClass )
+   {
+      _countTagBytes( ETag( header->mTag ), S64( size ) - S64( header->mSize ) );
+      header->mSize = size;
+      return mem;
+   }
+
+   // The block stays with the subsystem that first allocated it.
+   void* newMem = _slabAlloc( size, ETag( header->mTag ) );
+   if( newMem )
+   {
+      dMemcpy( newMem, mem, size < header->mSize ? size : header->mSize );
+      slabFree( mem );
+   }
+   return newMem;
+}
+
+S64 getTagBytes( ETag tag )
+{
+   AssertFatal( tag < TAG_Count, "Memory::getTagBytes - Invalid tag." );
+
+   // At least make the calling thread's own numbers exact.
+   if( !tSlabCache.mReleased )
+      _flushTagDeltas( tSlabCache );
+
+   return S64( smTagBytes[ tag ] );
+}
+
+const char* getTagName( ETag tag )
+{
+   AssertFatal( tag < TAG_Count, "Memory::getTagName - Invalid tag." );
+   return smTagNames[ tag ];
+}
+
+} // namespace Memory
+
+//-----------------------------------------------------------------------------
+// Console.
+//-----------------------------------------------------------------------------
+
+DefineEngineFunction( getMemoryTagBytes, const char*, ( const char* tag ),,
+   "@brief Returns the number of bytes allocated through the slab allocator for a subsystem.\n\n"
+   "@param tag One of general, gfx, script, ts, net or sfx.\n"
+   "@return Byte count, or -1 if the tag is unknown.\n"
+   "@note Only dMalloc allocations are counted, and only if the engine is built with TORQUE_SLAB_ALLOCATOR.\n"
+   "@ingroup Debugging" )
+{
+   S64 bytes = -1;
+   for( U32 i = 0; i < Memory::TAG_Count; i ++ )
+   {
+      if( dStricmp( tag, Memory::getTagName( Memory::ETag( i ) ) ) == 0 )
+         bytes = Memory::getTagBytes( Memory::ETag( i ) );
+   }
+
+   char* buffer = Con::getReturnBuffer( 32 );
+   dSprintf( buffer, 32, "%lld", ( long long ) bytes );
+   return buffer;
+}
+
+DefineEngineFunction( dumpMemoryTags, void, (),,
+   "@brief Prints how much memory each subsystem has allocated through the slab allocator.\n\n"
+   "@ingroup Debugging" )
+{
+   Con::printf( "Slab allocator bytes by tag:" );
+   for( U32 i = 0; i < Memory::TAG_Count; i ++ )
+   {
+      const S64 bytes = Memory::getTagBytes( Memory::ETag( i ) );
+      Con::printf( "   %-8s %10.2f KB", Memory::getTagName( Memory::ETag( i ) ), F64( bytes ) / 1024.0 );
+   }
+}
+
+//-----------------------------------------------------------------------------
+// Benchmark.
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   /// An allocator under test.
+   struct BenchAllocator
+   {
+      const char* mName;
+      void* ( *mAlloc )( dsize_t size );
+      void* ( *mRealloc )( void* mem, dsize_t size );
+      void ( *mFree )( void* mem );
+   };
+
+   void* _systemAlloc( dsize_t size ) { return dRealMalloc( size ); }
+   void* _systemRealloc( void* mem, dsize_t size ) { return realloc( mem, size ); }
+   void _systemFree( void* mem ) { dRealFree( mem ); }
+
+   void* _engineAlloc( dsize_t size ) { return dMalloc( size ); }
+   void* _engineRealloc( void* mem, dsize_t size ) { return dRealloc( mem, size ); }
+   void _engineFree( void* mem ) { dFree( mem ); }
+
+   void* _slabAlloc( dsize_t size ) { return Memory::slabAlloc( size, __FILE__ ); }
+   void* _slabRealloc( void* mem, dsize_t size ) { return Memory::slabRealloc( mem, size, __FILE__ ); }
+   void _slabFree( void* mem ) { Memory::slabFree( mem ); }
+
+   const BenchAllocator smBenchAllocators[] =
+   {
+      { "system", _systemAlloc, _systemRealloc, _systemFree },
+      { "dMalloc", _engineAlloc, _engineRealloc, _engineFree },
+      { "slab", _slabAlloc, _slabRealloc, _slabFree },
+   };
+
+   /// Short lived small blocks of mixed sizes, like script strings and
+   /// field values: keeps a pool of live blocks and replaces random ones.
+   void _benchSmallChurn( const BenchAllocator& allocator, U32 count, S32 seed )
+   {
+      const U32 PoolSize = 4096;
+      void* pool[ PoolSize ] = {};
+
+      MRandomLCG random( seed );
+      for( U32 i = 0; i < count; i ++ )
+      {
+         const U32 index = random.randI( 0, PoolSize - 1 );
+         allocator.mFree( pool[ index ] );
+         pool[ index ] = allocator.mAlloc( random.randI( 8, 256 ) );
+      }
+
+      for( U32 i = 0; i < PoolSize; i ++ )
+         allocator.mFree( pool[ i ] );
+   }
+
+   /// Arrays grown one element at a time the way Vector grows them.
+   void _benchGrowingArrays( const BenchAllocator& allocator, U32 count )
+   {
+      for( U32 i = 0; i < count; i ++ )
+      {
+         void* mem = NULL;
+         U32 capacity = 0;
+         for( U32 size = 0; size < 1024; size ++ )
+         {
+            if( size >= capacity )
+            {
+               capacity = getMax( capacity * 2, U32( 4 ) );
+               mem = allocator.mRealloc( mem, capacity * 16 );
+            }
+         }
+         allocator.mFree( mem );
+      }
+   }
+
+   struct ChurnWorkItem : public ThreadPool::WorkItem
+   {
+      const BenchAllocator& mAllocator;
+      U32 mCount;
+      S32 mSeed;
+
+      ChurnWorkItem( const BenchAllocator& allocator, U32 count, S32 seed )
+         : mAllocator( allocator ), mCount( count ), mSeed( seed ) {}
+
+   protected:
+      void execute() override
+      {
+         _benchSmallChurn( mAllocator, mCount, mSeed );
+      }
+   };
+}
+
+DefineEngineFunction( benchmarkAllocators, void, ( S32 iterations ), ( 1000000 ),
+   "@brief Runs allocation heavy workloads against the system heap, whatever dMalloc is "
+   "currently built to use, and the slab allocator, and prints how long each takes.\n\n"
+   "The workloads are churning small blocks of mixed sizes on the main thread, growing arrays "
+   "one element at a time, and churning small blocks on several thread pool threads at once.\n"
+   "@param iterations Number of allocations done by the churn workloads.\n"
+   "@ingroup Debugging\n"
+   "@internal" )
+{
+   iterations = getMax( iterations, 1000 );
+
+   const U32 numThreads = 4;
+   Con::printf( "benchmarkAllocators: %d iterations", iterations );
+
+   for( U32 i = 0; i < sizeof( smBenchAllocators ) / sizeof( smBenchAllocators[ 0 ] ); i ++ )
+   {
+      const BenchAllocator& allocator = smBenchAllocators[ i ];
+
+      U32 start = Platform::getRealMilliseconds();
+      _benchSmallChurn( allocator, iterations, 1 );
+      const U32 churnMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      _benchGrowingArrays( allocator, iterations / 1000 );
+      const U32 arraysMs = Platform::getRealMilliseconds() - start;
+
+      start = Platform::getRealMilliseconds();
+      for( U32 n = 0; n < numThreads; n ++ )
+      {
+         ThreadSafeRef< ChurnWorkItem > item( new ChurnWorkItem( allocator, iterations / numThreads, n + 1 ) );
+         ThreadPool::GLOBAL().queueWorkItem( item );
+      }
+      ThreadPool::GLOBAL().waitForAllItems();
+      const U32 threadedMs = Platform::getRealMilliseconds() - start;
+
+      Con::printf( "   %-8s churn %6dms   arrays %6dms   threaded churn %6dms", allocator.mName, churnMs, arraysMs, threadedMs );
+   }
+}
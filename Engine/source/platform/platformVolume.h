@@ -48,6 +48,30 @@ namespace FS
    
    bool Touch( const Path &path );
 
+   /// A read-only view of a whole file mapped into memory.  The view
+   /// stays valid for as long as a reference to it is held.
+   class MappedFile : public StrongRefBase
+   {
+   public:
+      virtual ~MappedFile() {}
+
+      /// Returns the first byte of the file.
+      virtual const U8* getData() const = 0;
+
+      /// Returns the size of the file in bytes.
+      virtual U32 getSize() const = 0;
+   };
+
+   typedef StrongRefPtr< MappedFile > MappedFileRef;
+
+   /// Map a file into memory for reading.
+   ///
+   /// This only works for files that resolve to the native file system
+   /// and returns NULL for anything else (files in zips, empty files,
+   /// files larger than 4GB) so callers must be prepared to fall back
+   /// to regular stream access.
+   MappedFileRef MapFile( const Path &path );
+
 } // Namespace FS
 } // Namespace Platform
 
@@ -27,6 +27,7 @@
 #include "console/engineAPI.h"
 
 extern void mInstallLibrary_C();
+extern void mInstallLibrary_Batch(U32 properties);
 
 static MRandomLCG sgPlatRandom;
 
@@ -64,6 +65,8 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
                                      "    - 'DETECT' Autodetect math lib settings.\n\n"
                                      "    - 'C' Enable the C math routines. C routines are always enabled.\n\n"
                                      "    - 'SSE' Enable SSE math routines.\n\n"
+                                     "    - 'SSE4' Enable SSE4.1 batch math routines.\n\n"
+                                     "    - 'AVX' Enable AVX batch math routines.\n\n"
                                      "@ingroup Math")
 {
    U32 properties = CPU_PROP_C;  // C entensions are always used
@@ -88,6 +91,16 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
          properties |= CPU_PROP_SSE;
          continue;
       }
+      if( dStricmp( *argv, "SSE4" ) == 0 )
+      {
+         properties |= CPU_PROP_SSE4_1;
+         continue;
+      }
+      if( dStricmp( *argv, "AVX" ) == 0 )
+      {
+         properties |= CPU_PROP_AVX;
+         continue;
+      }
       //Con::printf("Error: MathInit(): ignoring unknown math extension '%s'", *argv);
    }
    Math::init(properties);
@@ -116,6 +129,8 @@ void Math::init(U32 properties)
    }
    #endif
    
+   mInstallLibrary_Batch(properties);
+
    Con::printf(" ");
 }   
 
@@ -30,6 +30,7 @@
 
 extern void mInstallLibrary_C();
 extern void mInstallLibrary_ASM();
+extern void mInstallLibrary_Batch(U32 properties);
 
 //--------------------------------------
 DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
@@ -38,6 +39,8 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
                                      "    - 'DETECT' Autodetect math lib settings.\n\n"
                                      "    - 'C' Enable the C math routines. C routines are always enabled.\n\n"
                                      "    - 'SSE' Enable SSE math routines.\n\n"
+                                     "    - 'SSE4' Enable SSE4.1 batch math routines.\n\n"
+                                     "    - 'AVX' Enable AVX batch math routines.\n\n"
                                      "@ingroup Math")
 {
    U32 properties = CPU_PROP_C;  // C entensions are always used
@@ -69,6 +72,14 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
          properties |= CPU_PROP_SSE;
          continue;
       }
+      if (dStricmp(*argv, "SSE4") == 0) {
+         properties |= CPU_PROP_SSE4_1;
+         continue;
+      }
+      if (dStricmp(*argv, "AVX") == 0) {
+         properties |= CPU_PROP_AVX;
+         continue;
+      }
       Con::printf("Error: MathInit(): ignoring unknown math extension '%s'", (const char*)argv[0]);
    }
    Math::init(properties);
@@ -112,6 +123,8 @@ void Math::init(U32 properties)
    }
 #endif //mwerks>2.4
 
+   mInstallLibrary_Batch(properties);
+
    Con::printf(" ");
 }
 
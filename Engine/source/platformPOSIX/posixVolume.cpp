@@ -22,6 +22,8 @@
 #include <unistd.h>
 #include <stdlib.h>
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
 
 #include "core/crc.h"
 #include "core/frameAllocator.h"
@@ -592,6 +594,55 @@ String   Platform::FS::getAssetDir()
    return Platform::getExecutablePath();
 }
 
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   class PosixMappedFile : public Platform::FS::MappedFile
+   {
+   public:
+      PosixMappedFile( void *data, U32 size ) : mData( data ), mSize( size ) {}
+      ~PosixMappedFile() { ::munmap( mData, mSize ); }
+
+      const U8* getData() const override { return (const U8*)mData; }
+      U32 getSize() const override { return mSize; }
+
+   private:
+      void *mData;
+      U32 mSize;
+   };
+}
+
+Platform::FS::MappedFileRef Platform::FS::MapFile( const Path &path )
+{
+   // Only files that really live on disk can be mapped.
+   FileNodeRef node = GetFileNode( path );
+   Posix::PosixFile *file = dynamic_cast< Posix::PosixFile* >( node.getPointer() );
+   if ( !file )
+      return NULL;
+
+   int fd = ::open( file->getNativeName().c_str(), O_RDONLY );
+   if ( fd == -1 )
+      return NULL;
+
+   struct stat info;
+   if ( ::fstat( fd, &info ) != 0 || info.st_size <= 0 || info.st_size > U32_MAX )
+   {
+      ::close( fd );
+      return NULL;
+   }
+
+   // The mapping keeps its own reference to the file so the
+   // descriptor isn't needed past this point.
+   void *data = ::mmap( NULL, info.st_size, PROT_READ, MAP_SHARED, fd, 0 );
+   ::close( fd );
+
+   if ( data == MAP_FAILED )
+      return NULL;
+
+   return new PosixMappedFile( data, (U32)info.st_size );
+}
+
 /// Function invoked by the kernel layer to install OS specific
 /// file systems.
 bool Platform::FS::InstallFileSystems()
@@ -81,6 +81,9 @@ public:
    NodeStatus getStatus() const;
    bool getAttributes(Attributes*);
 
+   /// Returns the name of the file in the OS file system.
+   const String& getNativeName() const { return _name; }
+
    U32 getPosition();
    U32 setPosition(U32,SeekMode);
 
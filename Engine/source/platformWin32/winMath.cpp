@@ -29,6 +29,7 @@
 
 extern void mInstallLibrary_C();
 extern void mInstallLibrary_ASM();
+extern void mInstallLibrary_Batch(U32 properties);
 
 //--------------------------------------
 DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
@@ -39,6 +40,8 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
                 "    - 'FPU' Enable floating point unit routines.\n\n"
                 "    - 'MMX' Enable MMX math routines.\n\n"
                 "    - 'SSE' Enable SSE math routines.\n\n"
+                "    - 'SSE4' Enable SSE4.1 batch math routines.\n\n"
+                "    - 'AVX' Enable AVX batch math routines.\n\n"
 				"@ingroup Math")
 
 
@@ -73,6 +76,14 @@ DefineEngineStringlyVariadicFunction( mathInit, void, 1, 10, "( ... )"
          properties |= CPU_PROP_SSE;
          continue;
       }
+      if (dStricmp(str, "SSE4") == 0) {
+         properties |= CPU_PROP_SSE4_1;
+         continue;
+      }
+      if (dStricmp(str, "AVX") == 0) {
+         properties |= CPU_PROP_AVX;
+         continue;
+      }
       if (dStricmp(str, "SSE2") == 0) {
          properties |= CPU_PROP_SSE2;
          continue;
@@ -116,6 +127,8 @@ void Math::init(U32 properties)
       Con::printf("   Installing SSE extensions");
    }
 
+   mInstallLibrary_Batch(properties);
+
    Con::printf(" ");
 }
 
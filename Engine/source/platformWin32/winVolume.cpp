@@ -768,6 +768,66 @@ String   Platform::FS::getAssetDir()
    return Path::CleanSeparators(cen_buf);
 }
 
+//-----------------------------------------------------------------------------
+
+namespace
+{
+   class Win32MappedFile : public Platform::FS::MappedFile
+   {
+   public:
+      Win32MappedFile( HANDLE mapping, const void *data, U32 size ) : mMapping( mapping ), mData( data ), mSize( size ) {}
+      ~Win32MappedFile()
+      {
+         ::UnmapViewOfFile( mData );
+         ::CloseHandle( mMapping );
+      }
+
+      const U8* getData() const override { return (const U8*)mData; }
+      U32 getSize() const override { return mSize; }
+
+   private:
+      HANDLE mMapping;
+      const void *mData;
+      U32 mSize;
+   };
+}
+
+Platform::FS::MappedFileRef Platform::FS::MapFile( const Path &path )
+{
+   // Only files that really live on disk can be mapped.
+   FileNodeRef node = GetFileNode( path );
+   Win32::Win32File *file = dynamic_cast< Win32::Win32File* >( node.getPointer() );
+   if ( !file )
+      return NULL;
+
+   HANDLE handle = ::CreateFileW( PathToOS( file->getNativeName() ).utf16(), GENERIC_READ, FILE_SHARE_READ,
+                                  NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+   if ( handle == INVALID_HANDLE_VALUE )
+      return NULL;
+
+   LARGE_INTEGER size;
+   if ( !::GetFileSizeEx( handle, &size ) || size.QuadPart <= 0 || size.QuadPart > U32_MAX )
+   {
+      ::CloseHandle( handle );
+      return NULL;
+   }
+
+   // The mapping object keeps the file open on its own.
+   HANDLE mapping = ::CreateFileMappingW( handle, NULL, PAGE_READONLY, 0, 0, NULL );
+   ::CloseHandle( handle );
+   if ( mapping == NULL )
+      return NULL;
+
+   const void *data = ::MapViewOfFile( mapping, FILE_MAP_READ, 0, 0, 0 );
+   if ( data == NULL )
+   {
+      ::CloseHandle( mapping );
+      return NULL;
+   }
+
+   return new Win32MappedFile( mapping, data, (U32)size.QuadPart );
+}
+
 /// Function invoked by the kernel layer to install OS specific
 /// file systems.
 bool Platform::FS::InstallFileSystems()
@@ -70,6 +70,9 @@ public:
    bool getAttributes(Attributes*) override;
    U64 getSize() override;
 
+   /// Returns the name of the file in the OS file system.
+   const String& getNativeName() const { return mName; }
+
    U32 getPosition() override;
    U32 setPosition(U32,SeekMode) override;
 
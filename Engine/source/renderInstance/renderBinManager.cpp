@@ -27,6 +27,7 @@
 #include "materials/matInstance.h"
 #include "scene/sceneManager.h"
 #include "console/engineAPI.h"
+#include "math/mRandom.h"
 
 
 IMPLEMENT_CONOBJECT(RenderBinManager);
@@ -40,9 +41,14 @@ RenderBinManager::RenderBinManager( const RenderInstType& ritype, F32 renderOrde
    mBasicOnly ( false )
 {
    VECTOR_SET_ASSOCIATION( mElementList );
+   VECTOR_SET_ASSOCIATION( mSortScratch );
    mElementList.reserve( 2048 );
 }
 
+bool RenderBinManager::smRadixSort = true;
+bool RenderBinManager::smParallelSort = true;
+S32 RenderBinManager::smParallelSortThreshold = 1024;
+
 
 ConsoleDocClass( RenderBinManager, 
    "@brief The abstract base for all render bins.\n\n"
@@ -68,6 +74,21 @@ void RenderBinManager::initPersistFields()
    Parent::initPersistFields();
 }
 
+void RenderBinManager::consoleInit()
+{
+   Con::addVariable( "$RenderBin::radixSort", TypeBool, &smRadixSort,
+      "If true the render bins are sorted with a radix sort instead of qsort.\n"
+      "@ingroup RenderBin\n" );
+
+   Con::addVariable( "$RenderBin::parallelSort", TypeBool, &smParallelSort,
+      "If true the render passes sort their larger bins on worker threads.\n"
+      "@ingroup RenderBin\n" );
+
+   Con::addVariable( "$RenderBin::parallelSortThreshold", TypeS32, &smParallelSortThreshold,
+      "The number of elements above which a bin is sorted on a worker thread.\n"
+      "@ingroup RenderBin\n" );
+}
+
 void RenderBinManager::onRemove()
 {
    // Tell the render pass to remove us when 
@@ -139,7 +160,90 @@ void RenderBinManager::clear()
 
 void RenderBinManager::sort()
 {
-   dQsort( mElementList.address(), mElementList.size(), sizeof(MainSortElem), cmpKeyFunc);
+   sortElements( mElementList, mSortScratch );
+}
+
+void RenderBinManager::sortElements( Vector<MainSortElem> &elements, Vector<MainSortElem> &scratch )
+{
+   PROFILE_SCOPE( RenderBinManager_sortElements );
+
+   const U32 count = elements.size();
+   if ( count < 2 )
+      return;
+
+   if ( !smRadixSort )
+   {
+      dQsort( elements.address(), count, sizeof(MainSortElem), cmpKeyFunc );
+      return;
+   }
+
+   MainSortElem *src = elements.address();
+
+   // The histograms cost more than they save on tiny 
+   // lists so just do an insertion sort there.
+   if ( count <= 32 )
+   {
+      for ( U32 i=1; i < count; i++ )
+      {
+         const MainSortElem elem = src[i];
+         const U64 key = getSortKey( elem );
+
+         U32 j = i;
+         for ( ; j > 0 && getSortKey( src[j-1] ) > key; j-- )
+            src[j] = src[j-1];
+
+         src[j] = elem;
+      }
+
+      return;
+   }
+
+   // Gather the histograms for all eight byte 
+   // digits of the key in a single pass.
+   U32 histograms[8][256];
+   dMemset( histograms, 0, sizeof( histograms ) );
+
+   for ( U32 i=0; i < count; i++ )
+   {
+      const U64 key = getSortKey( src[i] );
+      for ( U32 pass=0; pass < 8; pass++ )
+         histograms[pass][ ( key >> ( pass * 8 ) ) & 0xFF ]++;
+   }
+
+   scratch.setSize( count );
+   MainSortElem *dst = scratch.address();
+
+   for ( U32 pass=0; pass < 8; pass++ )
+   {
+      U32 *offsets = histograms[pass];
+      const U32 shift = pass * 8;
+
+      // Skip the pass if every element has the same digit, which
+      // is common in the high bytes of key2.
+      if ( offsets[ ( getSortKey( src[0] ) >> shift ) & 0xFF ] == count )
+         continue;
+
+      U32 offset = 0;
+      for ( U32 i=0; i < 256; i++ )
+      {
+         const U32 digitCount = offsets[i];
+         offsets[i] = offset;
+         offset += digitCount;
+      }
+
+      for ( U32 i=0; i < count; i++ )
+      {
+         const U32 digit = ( getSortKey( src[i] ) >> shift ) & 0xFF;
+         dst[ offsets[digit]++ ] = src[i];
+      }
+
+      MainSortElem *temp = src;
+      src = dst;
+      dst = temp;
+   }
+
+   if ( src != elements.address() )
+      dMemcpy( elements.address(), src, count * sizeof( MainSortElem ) );
 }
 
 S32 FN_CDECL RenderBinManager::cmpKeyFunc(const void* p1, const void* p2)
@@ -191,3 +295,76 @@ DefineEngineMethod(RenderBinManager, getRenderOrder, F32, (), ,
 {
    return object->getRenderOrder();
 }
+
+DefineEngineFunction( benchmarkRenderBinSort, void, ( S32 count, S32 iterations ), ( 10000, 50 ),
+   "@brief Sorts a synthetic render bin element list with both the qsort and the radix sort "
+   "and prints the time taken by each and whether they produced the same order.\n\n"
+   "@param count The number of render instances in the list.\n"
+   "@param iterations The number of times the list is sorted by each method.\n"
+   "@ingroup RenderBin\n" )
+{
+   typedef RenderBinManager::MainSortElem MainSortElem;
+
+   count = getMax( count, 1 );
+   iterations = getMax( iterations, 1 );
+
+   // Build instances keyed like the mesh bin with a material 
+   // state hint shared by many instances and a mostly unique
+   // buffer key.  The keys stay below 2^30 so that the qsort
+   // comparator never overflows and the results can be compared.
+   MRandomLCG random( 0x1e3c );
+   const S32 numMaterials = getMax( count / 64, 1 );
+
+   Vector<RenderInst> insts;
+   insts.setSize( count );
+
+   Vector<MainSortElem> source;
+   source.setSize( count );
+
+   for ( U32 i=0; i < count; i++ )
+   {
+      RenderInst &inst = insts[i];
+      inst.clear();
+      inst.defaultKey = ( (U32)random.randI( 0, numMaterials - 1 ) * 2654435761u ) & 0x3FFFFFFF;
+      inst.defaultKey2 = random.randI() & 0x3FFFFFFF;
+
+      source[i].inst = &inst;
+      source[i].key = inst.defaultKey;
+      source[i].key2 = inst.defaultKey2;
+   }
+
+   Vector<MainSortElem> sorted[2];
+   Vector<MainSortElem> scratch;
+   U32 times[2];
+
+   const bool oldRadixSort = RenderBinManager::smRadixSort;
+
+   for ( U32 pass=0; pass < 2; pass++ )
+   {
+      RenderBinManager::smRadixSort = ( pass == 1 );
+
+      const U32 startTime = Platform::getRealMilliseconds();
+      for ( U32 i=0; i < iterations; i++ )
+      {
+         sorted[pass] = source;
+         RenderBinManager::sortElements( sorted[pass], scratch );
+      }
+      times[pass] = Platform::getRealMilliseconds() - startTime;
+   }
+
+   RenderBinManager::smRadixSort = oldRadixSort;
+
+   // The qsort isn't stable so only the keys are compared.
+   U32 mismatches = 0;
+   for ( U32 i=0; i < count; i++ )
+   {
+      if (  sorted[0][i].key != sorted[1][i].key ||
+            sorted[0][i].key2 != sorted[1][i].key2 )
+         mismatches++;
+   }
+
+   Con::printf( "Render bin sort of %d elements, %d iterations:", count, iterations );
+   Con::printf( "   qsort: %dms (%.3fms per sort)", times[0], (F32)times[0] / (F32)iterations );
+   Con::printf( "   radix: %dms (%.3fms per sort)", times[1], (F32)times[1] / (F32)iterations );
+   Con::printf( "   %s", mismatches == 0 ? "Results match." : avar( "%d elements differ!", mismatches ) );
+}
@@ -83,6 +83,7 @@ public:
 
    DECLARE_CONOBJECT(RenderBinManager);
    static void initPersistFields();
+   static void consoleInit();
 
    MaterialOverrideDelegate& getMatOverrideDelegate() { return mMatOverrideDelegate; }
 
@@ -93,6 +94,34 @@ public:
       U32 key2;
    };
 
+   /// Returns the packed 64bit sort key of the element which orders
+   /// by key descending and then by key2 ascending.
+   static inline U64 getSortKey( const MainSortElem &elem )
+   {
+      return ( (U64)( ~elem.key ) << 32 ) | (U64)elem.key2;
+   }
+
+   /// Sorts the elements in ascending sort key order.  This is a stable 
+   /// LSD radix sort unless $RenderBin::radixSort is disabled in which 
+   /// case the older qsort path is used.
+   ///
+   /// @param elements The elements to sort.
+   /// @param scratch A buffer used by the radix passes.
+   static void sortElements( Vector<MainSortElem> &elements, Vector<MainSortElem> &scratch );
+
+   /// Returns the number of elements the next sort() will process.  This
+   /// is used to decide which bins are worth sorting on a worker thread.
+   virtual U32 getSortCount() const { return mElementList.size(); }
+
+   /// If true the bins use the radix sort.
+   static bool smRadixSort;
+
+   /// If true the render pass sorts its larger bins on worker threads.
+   static bool smParallelSort;
+
+   /// The element count above which a bin is sorted on a worker thread.
+   static S32 smParallelSortThreshold;
+
 protected:
    void setRenderPass( RenderPassManager *rpm );
 
@@ -101,6 +130,7 @@ protected:
    void notifyType( const RenderInstType &type );
 
    Vector< MainSortElem > mElementList; // List of our instances
+   Vector< MainSortElem > mSortScratch; // Radix sort buffer
    F32 mProcessAddOrder;   // Where in the list do we process RenderInstance additions?
    F32 mRenderOrder;       // Where in the list do we render?
 
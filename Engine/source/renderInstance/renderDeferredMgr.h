@@ -61,6 +61,7 @@ public:
    void render(SceneRenderState * state) override;
    void sort() override;
    void clear() override;
+   U32 getSortCount() const override { return mElementList.size() + mTerrainElementList.size() + mObjectElementList.size(); }
    void addElement( RenderInst *inst ) override;
 
    // ConsoleObject
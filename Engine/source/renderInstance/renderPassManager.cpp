@@ -39,6 +39,8 @@
 #include "core/util/safeDelete.h"
 #include "math/util/matrixSet.h"
 #include "console/engineAPI.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
 
 
 const RenderInstType RenderInstType::Invalid( "" );
@@ -209,16 +211,72 @@ void RenderPassManager::addInst( RenderInst *inst )
    iter->value.trigger( inst );
 }
 
+/// Sorts a single render bin on a worker thread.
+struct RenderBinSortWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   RenderBinManager *mBin;
+   Semaphore *mDone;
+
+   RenderBinSortWorkItem( RenderBinManager *bin, Semaphore *done )
+      : mBin( bin ), mDone( done ) {}
+
+protected:
+   void execute() override
+   {
+      mBin->sort();
+      mDone->release();
+   }
+   void onCancelled() override
+   {
+      // Never leave the render thread waiting on a cancelled sort.
+      mBin->sort();
+      mDone->release();
+   }
+};
+
 void RenderPassManager::sort()
 {
    PROFILE_SCOPE( RenderPassManager_Sort );
 
+   // The bins only sort their own element lists so the larger 
+   // ones are handed to the worker threads while the small 
+   // ones are sorted here.
+   const U32 threshold = getMax( RenderBinManager::smParallelSortThreshold, 1 );
+   const bool parallel = RenderBinManager::smParallelSort;
+
+   Semaphore done( 0 );
+   U32 numQueued = 0;
+   RenderBinManager *lastLargeBin = NULL;
+
    for (Vector<RenderBinManager *>::iterator itr = mRenderBins.begin();
       itr != mRenderBins.end(); itr++)
    {
       AssertFatal(*itr, "Render manager invalid!");
-      (*itr)->sort();
+
+      if ( !parallel || (*itr)->getSortCount() < threshold )
+      {
+         (*itr)->sort();
+         continue;
+      }
+
+      // Keep one of the large bins for this thread.
+      if ( lastLargeBin )
+      {
+         ThreadSafeRef< RenderBinSortWorkItem > item( new RenderBinSortWorkItem( lastLargeBin, &done ) );
+         ThreadPool::GLOBAL().queueWorkItem( item );
+         numQueued++;
+      }
+
+      lastLargeBin = *itr;
    }
+
+   if ( lastLargeBin )
+      lastLargeBin->sort();
+
+   for ( U32 i=0; i < numQueued; i++ )
+      done.acquire();
 }
 
 void RenderPassManager::clear()
@@ -26,11 +26,14 @@
 #include "scene/sceneManager.h"
 #include "scene/sceneObject.h"
 #include "scene/zones/sceneZoneSpace.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
 #include "math/mathUtils.h"
 #include "platform/profiler.h"
 #include "terrain/terrData.h"
 #include "util/tempAlloc.h"
 #include "gfx/sim/debugDraw.h"
+#include "platform/threads/threadPool.h"
+#include "platform/threads/semaphore.h"
 
 
 extern bool gEditingMission;
@@ -39,6 +42,9 @@ extern bool gEditingMission;
 bool SceneCullingState::smDisableTerrainOcclusion = true;
 bool SceneCullingState::smDisableZoneCulling = false;
 U32 SceneCullingState::smMaxOccludersPerZone = 4;
+bool SceneCullingState::smParallelCull = true;
+U32 SceneCullingState::smParallelCullChunkSize = 256;
+bool SceneCullingState::smSoftwareOcclusion = true;
 F32 SceneCullingState::smOccluderMinWidthPercentage = 0.1f;
 F32 SceneCullingState::smOccluderMinHeightPercentage = 0.1f;
 
@@ -50,7 +56,9 @@ SceneCullingState::SceneCullingState( SceneManager* sceneManager, const SceneCam
    : mSceneManager( sceneManager ),
      mCameraState( viewState ),
      mDisableTerrainOcclusion( smDisableTerrainOcclusion ),
-     mDisableZoneCulling( smDisableZoneCulling )
+     mDisableZoneCulling( smDisableZoneCulling ),
+     mSoftwareOcclusion( smSoftwareOcclusion ),
+     mOcclusionBuffer( NULL )
 {
    AssertFatal( sceneManager->getZoneManager(), "SceneCullingState::SceneCullingState - SceneManager must have a zone manager!" );
 
@@ -94,6 +102,14 @@ SceneCullingState::SceneCullingState( SceneManager* sceneManager, const SceneCam
 
 //-----------------------------------------------------------------------------
 
+SceneCullingState::~SceneCullingState()
+{
+   if( mOcclusionBuffer )
+      SceneOcclusionBuffer::release( mOcclusionBuffer );
+}
+
+//-----------------------------------------------------------------------------
+
 bool SceneCullingState::isWithinVisibleZone( SceneObject* object ) const
 {
    SceneManager* mgr = object->getSceneManager();
@@ -137,6 +153,12 @@ void SceneCullingState::addOccluder( SceneObject* object )
       return;
    mAddedOccluderObjects.push_back( object );
 
+   // If the object gives us a mesh, rasterize it into the
+   // occlusion buffer rather than building a culling volume.
+
+   if( mSoftwareOcclusion && _rasterizeOccluder( object ) )
+      return;
+
    // Let the object build a silhouette.  If it doesn't
    // return one, abort.
 
@@ -174,6 +196,60 @@ void SceneCullingState::addOccluder( SceneObject* object )
 
 //-----------------------------------------------------------------------------
 
+bool SceneCullingState::_rasterizeOccluder( SceneObject* object )
+{
+   MatrixF transform;
+   const Vector< Point3F >* triangles = NULL;
+
+   if( !object->getOccluderMesh( &transform, &triangles ) )
+      return false;
+
+   if( !mOcclusionBuffer )
+   {
+      mOcclusionBuffer = SceneOcclusionBuffer::acquire();
+      mOcclusionBuffer->setup( getCullingFrustum() );
+   }
+
+   mOcclusionBuffer->rasterizeTriangles( transform, triangles->address(), triangles->size() );
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneCullingState::addTerrainOccluders()
+{
+   if( mDisableTerrainOcclusion || !mSoftwareOcclusion )
+      return;
+
+   PROFILE_SCOPE( SceneCullingState_addTerrainOccluders );
+
+   const Vector< SceneObject* >& terrains = getSceneManager()->getContainer()->getTerrains();
+   for( U32 i = 0; i < terrains.size(); ++ i )
+   {
+      TerrainBlock* terrain = dynamic_cast< TerrainBlock* >( terrains[ i ] );
+      if( !terrain )
+         continue;
+
+      // Don't occlude if we're below the terrain.  The occluder mesh
+      // sits below the surface so it only holds when looking from above.
+      // Outside of the terrain or over a hole, we need to be above all of it.
+
+      Point3F localCamPos = getCameraState().getViewPosition();
+      terrain->getWorldTransform().mulP( localCamPos );
+
+      F32 height;
+      if( !terrain->getHeight( Point2F( localCamPos.x, localCamPos.y ), &height ) )
+         height = terrain->getObjBox().maxExtents.z;
+
+      if( localCamPos.z < height )
+         continue;
+
+      _rasterizeOccluder( terrain );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
 bool SceneCullingState::addCullingVolumeToZone( U32 zoneId, const SceneCullingVolume& volume )
 {
    PROFILE_SCOPE( SceneCullingState_addCullingVolumeToZone );
@@ -728,10 +804,93 @@ bool SceneCullingState::isOccluded( const SphereF& sphere, const U32* zones, U32
 
 //-----------------------------------------------------------------------------
 
+/// Culls one chunk of an object list on a worker thread.
+struct SceneCullWorkItem : public ThreadPool::WorkItem
+{
+   typedef ThreadPool::WorkItem Parent;
+
+   const SceneCullingState* mState;
+   SceneObject** mObjects;
+   U32 mNumObjects;
+   U32 mCullOptions;
+   U32* mNumRemainingObjects;
+   Semaphore* mDone;
+
+   SceneCullWorkItem( const SceneCullingState* state, SceneObject** objects, U32 numObjects,
+                      U32 cullOptions, U32* numRemainingObjects, Semaphore* done )
+      :  mState( state ),
+         mObjects( objects ),
+         mNumObjects( numObjects ),
+         mCullOptions( cullOptions ),
+         mNumRemainingObjects( numRemainingObjects ),
+         mDone( done ) {}
+
+protected:
+   void execute() override
+   {
+      *mNumRemainingObjects = mState->_cullObjects( mObjects, mNumObjects, mCullOptions );
+      mDone->release();
+   }
+   void onCancelled() override
+   {
+      // Never leave the render thread waiting on a cancelled chunk.
+      execute();
+   }
+};
+
 U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 cullOptions ) const
 {
    PROFILE_SCOPE( SceneCullingState_cullObjects );
 
+   // Bring the occlusion buffer's tiles up to date.  After this,
+   // the buffer is only read from.
+   if( mOcclusionBuffer )
+      mOcclusionBuffer->updateTiles();
+
+   // Small lists aren't worth the hand off.  The ray-based terrain occlusion
+   // test goes through the terrain ray caster which isn't thread safe.
+   const U32 chunkSize = getMax( smParallelCullChunkSize, (U32)1 );
+   if(   !smParallelCull ||
+         numObjects < chunkSize * 2 ||
+         ( !mDisableTerrainOcclusion && !mSoftwareOcclusion ) )
+      return _cullObjects( objects, numObjects, cullOptions );
+
+   // The tests only read the objects and the culling state, so each
+   // chunk is culled in place on a worker thread.  This thread takes
+   // the first chunk.
+   const U32 numChunks = ( numObjects + chunkSize - 1 ) / chunkSize;
+
+   Vector< U32 > numRemaining;
+   numRemaining.setSize( numChunks );
+
+   Semaphore done( 0 );
+   for( U32 i = 1; i < numChunks; ++ i )
+   {
+      const U32 start = i * chunkSize;
+      ThreadSafeRef< SceneCullWorkItem > item( new SceneCullWorkItem(
+         this, objects + start, getMin( chunkSize, numObjects - start ), cullOptions, &numRemaining[ i ], &done ) );
+      ThreadPool::GLOBAL().queueWorkItem( item );
+   }
+
+   numRemaining[ 0 ] = _cullObjects( objects, chunkSize, cullOptions );
+
+   for( U32 i = 1; i < numChunks; ++ i )
+      done.acquire();
+
+   // Join the surviving objects of each chunk in order.
+   U32 numRemainingObjects = numRemaining[ 0 ];
+   for( U32 i = 1; i < numChunks; ++ i )
+   {
+      SceneObject** chunk = objects + i * chunkSize;
+      for( U32 n = 0; n < numRemaining[ i ]; ++ n )
+         objects[ numRemainingObjects ++ ] = chunk[ n ];
+   }
+
+   return numRemainingObjects;
+}
+
+U32 SceneCullingState::_cullObjects( SceneObject** objects, U32 numObjects, U32 cullOptions ) const
+{
    U32 numRemainingObjects = 0;
 
    // We test near and far planes separately in order to not do the tests
@@ -772,9 +931,11 @@ U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 c
       else if( object->isGlobalBounds() )
          isCulled = false;
 
-      // If terrain occlusion checks are enabled, run them now.
+      // If terrain occlusion checks are enabled and the terrain isn't
+      // going through the occlusion buffer, run them now.
 
       else if( !mDisableTerrainOcclusion &&
+               !mSoftwareOcclusion &&
                object->getWorldBox().minExtents.x > -1e5 &&
                isOccludedByTerrain( object ) )
       {
@@ -811,6 +972,11 @@ U32 SceneCullingState::cullObjects( SceneObject** objects, U32 numObjects, U32 c
       if( !isCulled )
          isCulled = isOccludedWithExtraPlanesCull( object->getWorldBox() );
 
+      // Finally, test against the occluders in the occlusion buffer.
+
+      if( !isCulled && mOcclusionBuffer && !object->isGlobalBounds() )
+         isCulled = mOcclusionBuffer->isOccluded( object->getWorldBox() );
+
       if( !isCulled )
          objects[ numRemainingObjects ++ ] = object;
    }
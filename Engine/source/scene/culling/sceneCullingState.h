@@ -50,6 +50,7 @@
 
 class SceneObject;
 class SceneManager;
+class SceneOcclusionBuffer;
 
 
 /// An object that gathers the culling state for a scene.
@@ -64,6 +65,19 @@ class SceneCullingState
       /// Whether to force zone culling to off by default.
       static bool smDisableZoneCulling;
 
+      /// If true, large object lists are culled in chunks on worker threads.
+      static bool smParallelCull;
+
+      /// Number of objects in each chunk of a parallel cull.  Lists smaller
+      /// than two chunks are culled on the calling thread.
+      static U32 smParallelCullChunkSize;
+
+      /// If true, occluders that provide an occluder mesh are rasterized into a
+      /// software depth buffer instead of being turned into culling volumes.  This
+      /// also replaces the ray-based terrain occlusion tests.
+      /// @see SceneOcclusionBuffer
+      static bool smSoftwareOcclusion;
+
       /// @name Occluder Restrictions
       /// Size restrictions on occlusion culling volumes.  Any occlusion volume
       /// that does not meet these minimum requirements is not accepted into the
@@ -132,12 +146,21 @@ class SceneCullingState
       /// frustum.
       bool mDisableZoneCulling;
 
+      /// Whether occluder meshes go into the software occlusion buffer.
+      bool mSoftwareOcclusion;
+
+      /// Depth buffer that occluder meshes are rasterized into.  Only
+      /// allocated once the first occluder mesh is added.
+      SceneOcclusionBuffer* mOcclusionBuffer;
+
    public:
 
       ///
       SceneCullingState( SceneManager* sceneManager,
                          const SceneCameraState& cameraState );
 
+      ~SceneCullingState();
+
       /// Return the scene which is being culled in this state.
       SceneManager* getSceneManager() const { return mSceneManager; }
 
@@ -209,6 +232,16 @@ class SceneCullingState
       ///   to the zone state.
       void addOccluder( SceneObject* object );
 
+      /// Rasterize the terrains in the scene into the software occlusion buffer.
+      ///
+      /// @note This does nothing if terrain occlusion or software occlusion is
+      ///   disabled.  It should be called after all other occluders have been added.
+      void addTerrainOccluders();
+
+      /// Return the software occlusion buffer or NULL if no occluder mesh
+      /// has been rasterized.
+      SceneOcclusionBuffer* getOcclusionBuffer() const { return mOcclusionBuffer; }
+
       /// Test whether the given object is occluded by any of the terrains
       /// in the scene.
       bool isOccludedByTerrain( SceneObject* object ) const;
@@ -321,8 +354,18 @@ class SceneCullingState
 
    private:
 
+      friend struct SceneCullWorkItem;
+
       typedef SceneZoneCullingState::CullingTestResult CullingTestResult;
 
+      /// Cull the given list of objects on the calling thread.
+      /// @see cullObjects
+      U32 _cullObjects( SceneObject** objects, U32 numObjects, U32 cullOptions ) const;
+
+      /// Rasterize the occluder mesh of the given object into the occlusion buffer.
+      /// @return False if the object doesn't provide an occluder mesh.
+      bool _rasterizeOccluder( SceneObject* object );
+
       // Helper methods to avoid code duplication.
 
       template< bool OCCLUDERS_ONLY, typename T > CullingTestResult _test( const T& bounds, const U32* zones, U32 numZones ) const;
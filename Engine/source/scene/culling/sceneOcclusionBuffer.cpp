@@ -0,0 +1,412 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#include "platform/platform.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
+
+#include "platform/profiler.h"
+
+
+U32 SceneOcclusionBuffer::smWidth = 256;
+Vector< SceneOcclusionBuffer* > SceneOcclusionBuffer::smPool;
+
+
+//-----------------------------------------------------------------------------
+
+SceneOcclusionBuffer::SceneOcclusionBuffer()
+   :  mWidth( 0 ),
+      mHeight( 0 ),
+      mTilesX( 0 ),
+      mTilesY( 0 ),
+      mWorldToView( true ),
+      mIsOrtho( false ),
+      mNearDist( 0.f ),
+      mScaleX( 0.f ),
+      mOffsetX( 0.f ),
+      mScaleY( 0.f ),
+      mOffsetY( 0.f ),
+      mDirtyMinX( 1 ),
+      mDirtyMinY( 1 ),
+      mDirtyMaxX( 0 ),
+      mDirtyMaxY( 0 ),
+      mHasOccluders( false )
+{
+   VECTOR_SET_ASSOCIATION( mDepth );
+   VECTOR_SET_ASSOCIATION( mTileDepth );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::setup( const Frustum& frustum )
+{
+   PROFILE_SCOPE( SceneOcclusionBuffer_setup );
+
+   // Size the buffer to whole tiles and keep the aspect
+   // ratio of the frustum so pixels stay square.
+
+   const U32 width = mClamp( smWidth, 32, 1024 );
+   mWidth = ( width + TileSize - 1 ) & ~( TileSize - 1 );
+
+   const F32 aspect = frustum.getWidth() > 0.f ? frustum.getHeight() / frustum.getWidth() : 1.f;
+   const U32 height = mClamp( ( U32 ) mRound( F32( mWidth ) * aspect ), TileSize, mWidth * 2 );
+   mHeight = ( height + TileSize - 1 ) & ~( TileSize - 1 );
+
+   mTilesX = mWidth / TileSize;
+   mTilesY = mHeight / TileSize;
+
+   mDepth.setSize( mWidth * mHeight );
+   mTileDepth.setSize( mTilesX * mTilesY );
+
+   for( U32 i = 0; i < mDepth.size(); ++ i )
+      mDepth[ i ] = -F32_MAX;
+   for( U32 i = 0; i < mTileDepth.size(); ++ i )
+      mTileDepth[ i ] = -F32_MAX;
+
+   mDirtyMinX = mTilesX;
+   mDirtyMinY = mTilesY;
+   mDirtyMaxX = 0;
+   mDirtyMaxY = 0;
+   mHasOccluders = false;
+
+   // Set up the view transform and projection.
+
+   mWorldToView = frustum.getTransform();
+   mWorldToView.inverse();
+
+   mIsOrtho = frustum.isOrtho();
+   mNearDist = frustum.getNearDist();
+
+   const F32 left = frustum.getNearLeft();
+   const F32 right = frustum.getNearRight();
+   const F32 top = frustum.getNearTop();
+   const F32 bottom = frustum.getNearBottom();
+
+   mScaleX = F32( mWidth ) / ( right - left );
+   mOffsetX = -left * mScaleX;
+
+   // Rows go top to bottom.
+   mScaleY = -F32( mHeight ) / ( top - bottom );
+   mOffsetY = -top * mScaleY;
+}
+
+//-----------------------------------------------------------------------------
+
+inline Point3F SceneOcclusionBuffer::_project( const Point3F& viewPoint ) const
+{
+   if( mIsOrtho )
+      return Point3F(   mScaleX * viewPoint.x + mOffsetX,
+                        mScaleY * viewPoint.z + mOffsetY,
+                        -viewPoint.y );
+
+   const F32 invY = 1.f / viewPoint.y;
+   const F32 scale = mNearDist * invY;
+
+   return Point3F(   mScaleX * viewPoint.x * scale + mOffsetX,
+                     mScaleY * viewPoint.z * scale + mOffsetY,
+                     invY );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::rasterizeTriangles( const MatrixF& objToWorld, const Point3F* points, U32 numPoints )
+{
+   PROFILE_SCOPE( SceneOcclusionBuffer_rasterizeTriangles );
+
+   MatrixF objToView = mWorldToView;
+   objToView.mul( objToWorld );
+
+   for( U32 i = 0; i + 2 < numPoints; i += 3 )
+   {
+      Point3F tri[ 3 ];
+      for( U32 n = 0; n < 3; ++ n )
+         objToView.mulP( points[ i + n ], &tri[ n ] );
+
+      // Clip against the near plane.  This leaves us with
+      // at most a quad.
+
+      Point3F clipped[ 4 ];
+      U32 numClipped = 0;
+
+      for( U32 n = 0; n < 3; ++ n )
+      {
+         const Point3F& a = tri[ n ];
+         const Point3F& b = tri[ ( n + 1 ) % 3 ];
+
+         const bool aInside = a.y >= mNearDist;
+         const bool bInside = b.y >= mNearDist;
+
+         if( aInside )
+            clipped[ numClipped ++ ] = a;
+
+         if( aInside != bInside )
+         {
+            const F32 t = ( mNearDist - a.y ) / ( b.y - a.y );
+            clipped[ numClipped ++ ] = a + ( b - a ) * t;
+         }
+      }
+
+      if( numClipped < 3 )
+         continue;
+
+      Point3F projected[ 4 ];
+      for( U32 n = 0; n < numClipped; ++ n )
+         projected[ n ] = _project( clipped[ n ] );
+
+      for( U32 n = 2; n < numClipped; ++ n )
+         _rasterizeTriangle( projected[ 0 ], projected[ n - 1 ], projected[ n ] );
+   }
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::_rasterizeTriangle( const Point3F& p0, const Point3F& p1, const Point3F& p2 )
+{
+   const Point3F* v0 = &p0;
+   const Point3F* v1 = &p1;
+   const Point3F* v2 = &p2;
+
+   // Occluders are double-sided so just fix up the winding.
+
+   F32 area = ( v1->x - v0->x ) * ( v2->y - v0->y ) - ( v1->y - v0->y ) * ( v2->x - v0->x );
+   if( area < 0.f )
+   {
+      const Point3F* temp = v1;
+      v1 = v2;
+      v2 = temp;
+      area = -area;
+   }
+   if( area < 0.5f )
+      return;
+
+   // Find the pixel range.  Only pixels that are completely covered
+   // are written so we can round outwards here.
+
+   const F32 minX = mClampF( getMin( getMin( v0->x, v1->x ), v2->x ), 0.f, F32( mWidth ) );
+   const F32 maxX = mClampF( getMax( getMax( v0->x, v1->x ), v2->x ), 0.f, F32( mWidth ) );
+   const F32 minY = mClampF( getMin( getMin( v0->y, v1->y ), v2->y ), 0.f, F32( mHeight ) );
+   const F32 maxY = mClampF( getMax( getMax( v0->y, v1->y ), v2->y ), 0.f, F32( mHeight ) );
+
+   const U32 startX = ( U32 ) mFloor( minX );
+   const U32 endX = ( U32 ) mCeil( maxX );
+   const U32 startY = ( U32 ) mFloor( minY );
+   const U32 endY = ( U32 ) mCeil( maxY );
+
+   if( startX >= endX || startY >= endY )
+      return;
+
+   // Set up the edge functions as A*x + B*y + C.  Shifting C by half the
+   // gradient extent makes the test at the pixel center equivalent to testing
+   // the pixel's worst corner, i.e. the test passes only if the triangle
+   // covers the whole pixel.
+
+   const Point3F* edges[ 3 ][ 2 ] = { { v0, v1 }, { v1, v2 }, { v2, v0 } };
+   F32 edgeA[ 3 ], edgeB[ 3 ], edgeC[ 3 ];
+
+   for( U32 i = 0; i < 3; ++ i )
+   {
+      const Point3F& a = *edges[ i ][ 0 ];
+      const Point3F& b = *edges[ i ][ 1 ];
+
+      edgeA[ i ] = a.y - b.y;
+      edgeB[ i ] = b.x - a.x;
+      edgeC[ i ] = -( edgeA[ i ] * a.x + edgeB[ i ] * a.y )
+                   - 0.5f * ( mFabs( edgeA[ i ] ) + mFabs( edgeB[ i ] ) );
+   }
+
+   // Set up the depth plane the same way, shifting it to the
+   // farthest depth within each pixel.  Since written pixels are fully
+   // inside the triangle, depth never drops below the farthest vertex.
+
+   const F32 invArea = 1.f / area;
+   const F32 dk1 = v1->z - v0->z;
+   const F32 dk2 = v2->z - v0->z;
+   const F32 depthA = ( dk1 * ( v2->y - v0->y ) - dk2 * ( v1->y - v0->y ) ) * invArea;
+   const F32 depthB = ( dk2 * ( v1->x - v0->x ) - dk1 * ( v2->x - v0->x ) ) * invArea;
+   const F32 depthC = v0->z - depthA * v0->x - depthB * v0->y
+                      - 0.5f * ( mFabs( depthA ) + mFabs( depthB ) );
+   const F32 depthMin = getMin( getMin( v0->z, v1->z ), v2->z );
+
+   for( U32 y = startY; y < endY; ++ y )
+   {
+      const F32 cy = F32( y ) + 0.5f;
+      const F32 row0 = edgeB[ 0 ] * cy + edgeC[ 0 ];
+      const F32 row1 = edgeB[ 1 ] * cy + edgeC[ 1 ];
+      const F32 row2 = edgeB[ 2 ] * cy + edgeC[ 2 ];
+      const F32 rowDepth = depthB * cy + depthC;
+
+      F32* depth = &mDepth[ y * mWidth ];
+
+      for( U32 x = startX; x < endX; ++ x )
+      {
+         const F32 cx = F32( x ) + 0.5f;
+         const bool inside = ( edgeA[ 0 ] * cx + row0 >= 0.f ) &
+                             ( edgeA[ 1 ] * cx + row1 >= 0.f ) &
+                             ( edgeA[ 2 ] * cx + row2 >= 0.f );
+         const F32 key = getMax( depthA * cx + rowDepth, depthMin );
+         const F32 current = depth[ x ];
+
+         depth[ x ] = ( inside && key > current ) ? key : current;
+      }
+   }
+
+   // Flag the tiles we touched.
+
+   mDirtyMinX = getMin( mDirtyMinX, startX / TileSize );
+   mDirtyMinY = getMin( mDirtyMinY, startY / TileSize );
+   mDirtyMaxX = getMax( mDirtyMaxX, ( endX - 1 ) / TileSize );
+   mDirtyMaxY = getMax( mDirtyMaxY, ( endY - 1 ) / TileSize );
+
+   mHasOccluders = true;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::updateTiles()
+{
+   if( mDirtyMinX > mDirtyMaxX || mDirtyMinY > mDirtyMaxY )
+      return;
+
+   PROFILE_SCOPE( SceneOcclusionBuffer_updateTiles );
+
+   for( U32 ty = mDirtyMinY; ty <= mDirtyMaxY; ++ ty )
+      for( U32 tx = mDirtyMinX; tx <= mDirtyMaxX; ++ tx )
+      {
+         F32 farthest = F32_MAX;
+
+         for( U32 y = 0; y < TileSize; ++ y )
+         {
+            const F32* depth = &mDepth[ ( ty * TileSize + y ) * mWidth + tx * TileSize ];
+            for( U32 x = 0; x < TileSize; ++ x )
+               farthest = getMin( farthest, depth[ x ] );
+         }
+
+         mTileDepth[ ty * mTilesX + tx ] = farthest;
+      }
+
+   mDirtyMinX = mTilesX;
+   mDirtyMinY = mTilesY;
+   mDirtyMaxX = 0;
+   mDirtyMaxY = 0;
+}
+
+//-----------------------------------------------------------------------------
+
+bool SceneOcclusionBuffer::isOccluded( const Box3F& worldBox ) const
+{
+   AssertFatal( mDirtyMinX > mDirtyMaxX || mDirtyMinY > mDirtyMaxY,
+      "SceneOcclusionBuffer::isOccluded - Tiles are out of date; call updateTiles() first!" );
+
+   if( !mHasOccluders )
+      return false;
+
+   // Project the box corners.  If the box reaches in front of the
+   // near plane, we can't say anything about it.
+
+   F32 minX = F32_MAX, minY = F32_MAX;
+   F32 maxX = -F32_MAX, maxY = -F32_MAX;
+   F32 nearest = -F32_MAX;
+
+   for( U32 i = 0; i < 8; ++ i )
+   {
+      Point3F corner = worldBox.computeVertex( i );
+      mWorldToView.mulP( corner );
+
+      if( corner.y < mNearDist )
+         return false;
+
+      const Point3F projected = _project( corner );
+
+      minX = getMin( minX, projected.x );
+      maxX = getMax( maxX, projected.x );
+      minY = getMin( minY, projected.y );
+      maxY = getMax( maxY, projected.y );
+      nearest = getMax( nearest, projected.z );
+   }
+
+   // Boxes entirely off screen are left to the frustum tests.
+
+   const U32 startX = ( U32 ) mFloor( mClampF( minX, 0.f, F32( mWidth ) ) );
+   const U32 endX = ( U32 ) mCeil( mClampF( maxX, 0.f, F32( mWidth ) ) );
+   const U32 startY = ( U32 ) mFloor( mClampF( minY, 0.f, F32( mHeight ) ) );
+   const U32 endY = ( U32 ) mCeil( mClampF( maxY, 0.f, F32( mHeight ) ) );
+
+   if( startX >= endX || startY >= endY )
+      return false;
+
+   // Walk the tiles the box touches.  Tiles whose farthest depth is
+   // still in front of the box hide their part of it entirely.  For the
+   // rest, look at the individual pixels.
+
+   for( U32 ty = startY / TileSize; ty <= ( endY - 1 ) / TileSize; ++ ty )
+      for( U32 tx = startX / TileSize; tx <= ( endX - 1 ) / TileSize; ++ tx )
+      {
+         if( mTileDepth[ ty * mTilesX + tx ] > nearest )
+            continue;
+
+         const U32 x0 = getMax( startX, tx * TileSize );
+         const U32 x1 = getMin( endX, ( tx + 1 ) * TileSize );
+         const U32 y0 = getMax( startY, ty * TileSize );
+         const U32 y1 = getMin( endY, ( ty + 1 ) * TileSize );
+
+         bool visible = false;
+         for( U32 y = y0; y < y1; ++ y )
+         {
+            const F32* depth = &mDepth[ y * mWidth ];
+            for( U32 x = x0; x < x1; ++ x )
+               visible |= ( depth[ x ] <= nearest );
+         }
+
+         if( visible )
+            return false;
+      }
+
+   return true;
+}
+
+//-----------------------------------------------------------------------------
+
+SceneOcclusionBuffer* SceneOcclusionBuffer::acquire()
+{
+   if( smPool.empty() )
+      return new SceneOcclusionBuffer;
+
+   SceneOcclusionBuffer* buffer = smPool.last();
+   smPool.pop_back();
+   return buffer;
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::release( SceneOcclusionBuffer* buffer )
+{
+   smPool.push_back( buffer );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneOcclusionBuffer::freePool()
+{
+   for( U32 i = 0; i < smPool.size(); ++ i )
+      delete smPool[ i ];
+   smPool.clear();
+}
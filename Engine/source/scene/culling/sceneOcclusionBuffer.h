@@ -0,0 +1,162 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+
+#ifndef _SCENEOCCLUSIONBUFFER_H_
+#define _SCENEOCCLUSIONBUFFER_H_
+
+#ifndef _MATHUTIL_FRUSTUM_H_
+#include "math/util/frustum.h"
+#endif
+
+#ifndef _TVECTOR_H_
+#include "core/util/tVector.h"
+#endif
+
+
+/// A low-resolution depth buffer that occluder geometry is rasterized into
+/// on the CPU and that object bounds can then be tested against.
+///
+/// Depth is stored as a "nearness" key that is linear in screen space: 1/y
+/// for perspective views and -y for orthographic views (y being the view
+/// direction).  Larger keys are nearer to the viewer.  Pixels that no occluder
+/// has been rasterized into hold -F32_MAX.
+///
+/// Both rasterization and testing are conservative.  A pixel is only written
+/// if the triangle covers it completely and it receives the farthest depth the
+/// triangle has within the pixel.  A box is only reported occluded if every pixel
+/// its projection touches holds a depth nearer than the nearest point of the box.
+///
+/// On top of the pixels, the buffer keeps the farthest depth of each TileSize x
+/// TileSize tile.  Tiles that are entirely in front of a box are rejected without
+/// looking at their pixels.
+///
+/// The inner loops are kept branch-free over pixel rows so the compiler can
+/// vectorize them.
+///
+/// @note Once updateTiles() has been called, any number of threads may test
+///   against the buffer concurrently.  Rasterization must not overlap with testing.
+class SceneOcclusionBuffer
+{
+   public:
+
+      enum
+      {
+         /// Edge length of the tiles that make up the coarse level of the buffer.
+         TileSize = 8,
+      };
+
+      /// Width of the buffer in pixels.  The height is derived from the
+      /// aspect ratio of the frustum.  Exposed as $Scene::occlusionBufferWidth.
+      static U32 smWidth;
+
+   protected:
+
+      /// The pool of buffers recycled through acquire() and release().
+      static Vector< SceneOcclusionBuffer* > smPool;
+
+      U32 mWidth;
+      U32 mHeight;
+      U32 mTilesX;
+      U32 mTilesY;
+
+      /// Transform from world space to view space.
+      MatrixF mWorldToView;
+
+      bool mIsOrtho;
+      F32 mNearDist;
+
+      /// @name Projection
+      /// Screen x is mScaleX * x' + mOffsetX where x' is x/y * nearDist for
+      /// perspective views and x for orthographic views.  Same for z.
+      /// @{
+
+      F32 mScaleX;
+      F32 mOffsetX;
+      F32 mScaleY;
+      F32 mOffsetY;
+
+      /// @}
+
+      /// Per-pixel depth keys.
+      Vector< F32 > mDepth;
+
+      /// Farthest depth key in each tile.
+      Vector< F32 > mTileDepth;
+
+      /// Range of tiles touched since the last updateTiles().
+      U32 mDirtyMinX, mDirtyMinY, mDirtyMaxX, mDirtyMaxY;
+
+      /// Whether anything has been rasterized since setup().
+      bool mHasOccluders;
+
+      /// Transform a view-space point to screen space and its depth key.
+      Point3F _project( const Point3F& viewPoint ) const;
+
+      /// Rasterize a single triangle given in screen space with depth keys in z.
+      void _rasterizeTriangle( const Point3F& v0, const Point3F& v1, const Point3F& v2 );
+
+   public:
+
+      SceneOcclusionBuffer();
+
+      /// Clear the buffer and set it up for the given frustum.
+      /// @param frustum Culling frustum with its projection offset baked in.
+      void setup( const Frustum& frustum );
+
+      /// Rasterize the given triangle list into the buffer.
+      /// @param objToWorld Transform from the space of @a points to world space.
+      /// @param points Triangle list; every three points make up one triangle.
+      /// @param numPoints Number of points in @a points.
+      void rasterizeTriangles( const MatrixF& objToWorld, const Point3F* points, U32 numPoints );
+
+      /// Bring the tile depths up to date with everything rasterized so far.
+      void updateTiles();
+
+      /// Return true if anything has been rasterized into the buffer.
+      bool hasOccluders() const { return mHasOccluders; }
+
+      /// Return true if the given world-space box is completely hidden
+      /// behind the occluders in the buffer.
+      bool isOccluded( const Box3F& worldBox ) const;
+
+      U32 getWidth() const { return mWidth; }
+      U32 getHeight() const { return mHeight; }
+
+      /// @name Pooling
+      /// Culling states are created and destroyed several times per frame, so
+      /// their buffers are recycled rather than reallocated.
+      /// @{
+
+      /// Return a buffer from the pool or allocate a new one.
+      static SceneOcclusionBuffer* acquire();
+
+      /// Return a buffer to the pool.
+      static void release( SceneOcclusionBuffer* buffer );
+
+      /// Delete all pooled buffers.
+      static void freePool();
+
+      /// @}
+};
+
+#endif // _SCENEOCCLUSIONBUFFER_H_
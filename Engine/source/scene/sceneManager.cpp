@@ -28,6 +28,7 @@
 #include "scene/sceneRenderState.h"
 #include "scene/zones/sceneRootZone.h"
 #include "scene/zones/sceneZoneSpace.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
 #include "lighting/lightManager.h"
 #include "renderInstance/renderPassManager.h"
 #include "gfx/gfxDevice.h"
@@ -76,6 +77,23 @@ MODULE_BEGIN( Scene )
          "If true, the bounding boxes of objects will be displayed.\n\n"
          "@ingroup Rendering" );
 
+      Con::addVariable( "$Scene::parallelCull", TypeBool, &SceneCullingState::smParallelCull,
+         "If true, large object lists are culled in chunks on worker threads.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$Scene::parallelCullChunkSize", TypeS32, &SceneCullingState::smParallelCullChunkSize,
+         "Number of objects culled by each worker thread task when $Scene::parallelCull is enabled.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$Scene::softwareOcclusion", TypeBool, &SceneCullingState::smSoftwareOcclusion,
+         "If true, occluders that provide an occluder mesh (OcclusionVolumes, terrains and TSStatics with "
+         "'occluder' set) are rasterized into a low resolution software depth buffer that objects are tested against.\n\n"
+         "@ingroup Rendering" );
+
+      Con::addVariable( "$Scene::occlusionBufferWidth", TypeS32, &SceneOcclusionBuffer::smWidth,
+         "Width in pixels of the software occlusion buffer.  The height follows the aspect ratio of the view.\n\n"
+         "@ingroup Rendering" );
+
       Con::addVariable( "$Scene::maxOccludersPerZone", TypeS32, &SceneCullingState::smMaxOccludersPerZone,
          "Maximum number of occluders that will be concurrently allowed into the scene culling state of any given zone.\n\n"
          "@ingroup Rendering" );
@@ -93,6 +111,8 @@ MODULE_BEGIN( Scene )
    {
       SAFE_DELETE( gClientSceneGraph );
       SAFE_DELETE( gServerSceneGraph );
+
+      SceneOcclusionBuffer::freePool();
    }
 
 MODULE_END;
@@ -417,6 +437,11 @@ void SceneManager::_renderScene( SceneRenderState* state, U32 objectMask, SceneZ
       queryBox.maxExtents.setMin( state->getRenderArea().maxExtents );
    }
 
+   // Now that the zone traversal has added its occluders,
+   // rasterize the terrains into the occlusion buffer.
+
+   state->getCullingState().addTerrainOccluders();
+
    PROFILE_START( Scene_cullObjects );
 
    //TODO: We should split the codepaths here based on whether the outdoor zone has visible space.
@@ -99,6 +99,8 @@ extern bool gEditingMission;
 
 Signal< void( SceneObject* ) > SceneObject::smSceneObjectAdd;
 Signal< void( SceneObject* ) > SceneObject::smSceneObjectRemove;
+Signal< void( SceneObject*, const Box3F& ) > SceneObject::smSceneObjectBoundsChanged;
+Signal< void( SceneObject*, U32 ) > SceneObject::smSceneObjectTypeMaskChanged;
 
 
 //-----------------------------------------------------------------------------
@@ -520,6 +522,8 @@ void SceneObject::resetWorldBox()
 {
    AssertFatal(mObjBox.isValidBox(), "SceneObject::resetWorldBox - Bad object box!");
 
+   const Box3F oldWorldBox = mWorldBox;
+
    mWorldBox = mObjBox;
 
    Point3F scale = Point3F(mFabs(mObjScale.x), mFabs(mObjScale.y), mFabs(mObjScale.z));
@@ -542,6 +546,23 @@ void SceneObject::resetWorldBox()
    for( SceneObjectLink* link = mSceneObjectLinks; link != NULL; 
         link = link->getNextLink() )
       link->update();
+
+   if( mSceneManager != NULL && !smSceneObjectBoundsChanged.isEmpty() )
+      smSceneObjectBoundsChanged.trigger( this, oldWorldBox );
+}
+
+//-----------------------------------------------------------------------------
+
+void SceneObject::setTypeMask( U32 typeMask )
+{
+   const U32 oldTypeMask = mTypeMask;
+   if ( typeMask == oldTypeMask )
+      return;
+
+   mTypeMask = typeMask;
+
+   if( mSceneManager != NULL && !smSceneObjectTypeMaskChanged.isEmpty() )
+      smSceneObjectTypeMaskChanged.trigger( this, oldTypeMask );
 }
 
 //-----------------------------------------------------------------------------
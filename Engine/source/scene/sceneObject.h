@@ -288,6 +288,10 @@ class SceneObject : public NetObject, public ProcessObject
       /// Regenerates the world-space bounding box and bounding sphere.
       void resetWorldBox();
 
+      /// Changes the type mask of an object that may already be in a
+      /// scene and lets smSceneObjectTypeMaskChanged know about it.
+      void setTypeMask( U32 typeMask );
+
       /// Regenerates the render-world-space bounding box and sphere.
       void resetRenderWorldBox();
 
@@ -357,6 +361,15 @@ class SceneObject : public NetObject, public ProcessObject
       /// Triggered when a SceneObject onRemove is called.
       static Signal< void( SceneObject* ) > smSceneObjectRemove;
 
+      /// Triggered when the world box of a SceneObject that is in a scene
+      /// changes, ie. when it moves or its object box or scale changes.
+      /// The second argument is the world box it had before.
+      static Signal< void( SceneObject*, const Box3F& ) > smSceneObjectBoundsChanged;
+
+      /// Triggered when setTypeMask() changes the type mask of a SceneObject
+      /// that is in a scene.  The second argument is the mask it had before.
+      static Signal< void( SceneObject*, U32 ) > smSceneObjectTypeMaskChanged;
+
       /// Return the type mask that indicates to which broad object categories
       /// this object belongs.
       U32 getTypeMask() const { return mTypeMask; }
@@ -562,6 +575,18 @@ class SceneObject : public NetObject, public ProcessObject
       ///   if method is not implemented.
       virtual void buildSilhouette( const SceneCameraState& cameraState, Vector< Point3F >& outPoints ) {}
 
+      /// Return a triangle list to rasterize into the software occlusion buffer.
+      ///
+      /// The triangles must lie within the solid parts of the object as anything
+      /// behind them will be culled.  They need not match the rendered geometry.
+      ///
+      /// @param outTransform Receives the transform from the space of the triangles to world space.
+      /// @param outTriangles Receives the triangle list; every three points make up one triangle.
+      ///   The list must stay valid until the object changes.
+      /// @return True if the object provides an occluder mesh, false if not.
+      /// @see SceneOcclusionBuffer
+      virtual bool getOccluderMesh( MatrixF* outTransform, const Vector< Point3F >** outTriangles ) { return false; }
+
       /// Return true if the given point is contained by the object's (collision) shape.
       ///
       /// The default implementation will return true if the point is within the object's
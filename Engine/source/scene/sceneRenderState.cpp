@@ -105,6 +105,9 @@ void SceneRenderState::renderObjects( SceneObject** objects, U32 numObjects )
    for( U32 i = 0; i < numObjects; ++ i )
    {
       SceneObject* object = objects[ i ];
+      if ( !mObjectFilter.empty() && !mObjectFilter( object ) )
+         continue;
+
       object->prepRenderImage( this );
    }
 
@@ -61,6 +61,10 @@ class SceneRenderState
       /// @see getOverrideMaterial
       typedef Delegate< BaseMatInstance*( BaseMatInstance* ) > MatDelegate;
 
+      /// The delegate used to pick which of the culled objects get rendered.
+      /// @see getObjectFilter
+      typedef Delegate< bool( SceneObject* ) > ObjectFilter;
+
    protected:
 
       /// SceneManager being rendered in this state.
@@ -81,6 +85,9 @@ class SceneRenderState
       /// The optional material override delegate.
       MatDelegate mMatDelegate;
 
+      /// The optional object filter delegate.
+      ObjectFilter mObjectFilter;
+
       ///
       MatrixF mDiffuseCameraTransform;
 
@@ -329,6 +336,12 @@ class SceneRenderState
       MatDelegate& getMaterialDelegate() { return mMatDelegate; }
       const MatDelegate& getMaterialDelegate() const { return mMatDelegate; }
 
+      /// Returns the optional delegate which decides if an object that
+      /// passed the type mask and culling is rendered, for passes that
+      /// can't pick their objects with a type mask alone.
+      ObjectFilter& getObjectFilter() { return mObjectFilter; }
+      const ObjectFilter& getObjectFilter() const { return mObjectFilter; }
+
       /// @}
 };
 
@@ -44,6 +44,18 @@ void FeatureType::addDefaultTypes( FeatureSet *outFeatures )
    }   
 }
 
+const FeatureType* FeatureType::findByName( const String &name )
+{
+   const FeatureTypeVector &types = _getTypes();
+   for ( U32 i=0; i < types.size(); i++ )
+   {
+      if ( types[i]->getName().equal( name ) )
+         return types[i];
+   }
+
+   return NULL;
+}
+
 FeatureType::FeatureType( const char *name, U32 group, F32 order, bool isDefault )
    :  mName( name ),
       mGroup( group ),
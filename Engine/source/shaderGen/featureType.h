@@ -70,6 +70,10 @@ public:
    /// Adds all the default features types to the set.
    static void addDefaultTypes( FeatureSet *outFeatures );
 
+   /// Returns the registered feature type with the name
+   /// or NULL if no such type exists.
+   static const FeatureType* findByName( const String &name );
+
    /// You should not use this constructor directly.
    /// @see DeclareFeatureType
    /// @see ImplementFeatureType
@@ -30,6 +30,11 @@
 #include "gfx/gfxDevice.h"
 #include "core/memVolume.h"
 #include "core/module.h"
+#include "console/consoleTypes.h"
+#include "console/engineAPI.h"
+#include "app/version.h"
+#include "materials/materialManager.h"
+#include "materials/materialDefinition.h"
 
 #ifdef TORQUE_D3D11
 #include "shaderGen/HLSL/customFeatureHLSL.h"
@@ -46,6 +51,12 @@ MODULE_BEGIN( ShaderGen )
    MODULE_INIT
    {
       ManagedSingleton< ShaderGen >::createSingleton();
+
+      Con::addVariable( "$ShaderGen::useSourceCache", TypeBool, &ShaderGen::smUseSourceCache,
+         "If true ShaderGen reuses the shader source written by a previous run of the same "
+         "engine build when the shader cache manifest shows it was generated from the same "
+         "features and the files are unchanged.\n"
+         "@ingroup GFX\n" );
    }
 
    MODULE_SHUTDOWN
@@ -57,11 +68,33 @@ MODULE_END;
 
 String ShaderGen::smCommonShaderPath("shaders/common");
 
+bool ShaderGen::smUseSourceCache = true;
+
+/// The shader cache manifest file in the shader cache path.
+static const char* sShaderCacheManifestFile = "shadergen:/shaderCache.manifest";
+
+/// Bump this when the manifest layout or the generated source changes 
+/// in a way that isn't captured by the feature signature.  Source from
+/// other engine builds is never reused as the features may generate
+/// different code, see _getEngineBuild().
+static const U32 sShaderCacheSignature = makeFourCCTag( 'S', 'G', 'M', 'C' );
+static const U32 sShaderCacheVersion = 2;
+
+/// Identifies the engine build which wrote the shader cache manifest.
+static String _getEngineBuild()
+{
+   return String::ToString( "%s %s", getVersionString(), getCompileTimeString() );
+}
+
 ShaderGen::ShaderGen()
 {
    mInit = false;
    GFXDevice::getDeviceEventSignal().notify(this, &ShaderGen::_handleGFXEvent);
    mOutput = NULL;
+   mShaderCachePersistent = false;
+   mShaderCacheDirty = false;
+   mPrewarmQueued = false;
+   resetShaderCacheStats();
 }
 
 ShaderGen::~ShaderGen()
@@ -84,6 +117,7 @@ bool ShaderGen::_handleGFXEvent(GFXDevice::GFXDeviceEventType event)
       break;
    case GFXDevice::deDestroy :
       {
+         saveShaderCache();
          flushProceduralShaders();
       }
       break;
@@ -133,6 +167,12 @@ void ShaderGen::initShaderGen()
 
    // Delete the auto-generated conditioner include file.
    Torque::FS::Remove( "shadergen:/" + ConditionerFeature::ConditionerIncludeFileName );
+
+   // The manifest is only worth keeping if the shaders 
+   // themselves are kept between runs.
+   mShaderCachePersistent = mMemFS.isNull();
+   if ( mShaderCachePersistent )
+      _loadShaderCache();
 }
 
 void ShaderGen::generateShader( const MaterialFeatureData &featureData,
@@ -141,7 +181,8 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
                                 F32 *pixVersion,
                                 const GFXVertexFormat *vertexFormat,
                                 const char* cacheName,
-                                Vector<GFXShaderMacro> &macros)
+                                Vector<GFXShaderMacro> &macros,
+                                bool macrosOnly )
 {
    PROFILE_SCOPE( ShaderGen_GenerateShader );
 
@@ -165,7 +206,7 @@ void ShaderGen::generateShader( const MaterialFeatureData &featureData,
    // this needs to change - need to optimize down to ps v.1.1
    *pixVersion = GFX->getPixelShaderVersion();
 
-   if ( !Con::getBoolVariable( "ShaderGen::GenNewShaders", true ) )
+   if ( macrosOnly || !Con::getBoolVariable( "ShaderGen::GenNewShaders", true ) )
    {
       // If we are not regenerating the shader we will return here.
       // But we must fill in the shader macros first!
@@ -450,7 +491,7 @@ void ShaderGen::_printPixShader( Stream &stream )
    mPrinter->printPixelShaderCloser(stream);
 }
 
-GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const GFXVertexFormat *vertexFormat, const Vector<GFXShaderMacro> *macros, const Vector<String> &samplers )
+GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const GFXVertexFormat *vertexFormat, const Vector<GFXShaderMacro> *macros, const Vector<String> &samplers, const char *materialName )
 {
    PROFILE_SCOPE( ShaderGen_GetShader );
 
@@ -479,31 +520,90 @@ GFXShader* ShaderGen::getShader( const MaterialFeatureData &featureData, const G
    // return shader if exists
    GFXShader *match = mProcShaders[cacheKey];
    if ( match )
+   {
+      mStatMemoryHits++;
       return match;
+   }
 
    // if not, then create it
    char vertFile[256];
    char pixFile[256];
    F32  pixVersion;
 
+   // If a previous run generated the same source we only 
+   // need the macros from the features.
+   const U32 featureSignature = _getFeatureSignature( features );
+   ShaderCacheMap::Iterator cacheIter = mShaderCache.find( cacheKey );
+   const bool sourceCached =  smUseSourceCache && 
+                              cacheIter != mShaderCache.end() &&
+                              _isSourceCached( cacheKey, cacheIter->value, featureSignature );
+
+   U32 startTime = Platform::getRealMilliseconds();
+
    Vector<GFXShaderMacro> shaderMacros;
    shaderMacros.push_back( GFXShaderMacro( "TORQUE_SHADERGEN" ) );
    if ( macros )
       shaderMacros.merge( *macros );
-   generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheKey, shaderMacros );
+   generateShader( featureData, vertFile, pixFile, &pixVersion, vertexFormat, cacheKey, shaderMacros, sourceCached );
+
+   if ( sourceCached )
+   {
+      // The instancing format is normally filled in while 
+      // generating the source so restore it from the manifest.
+      const ShaderCacheEntry &entry = cacheIter->value;
+      mInstancingFormat.clear();
+      for ( U32 i=0; i < entry.instancingElements.size(); i++ )
+      {
+         const CachedVertexElement &element = entry.instancingElements[i];
+         mInstancingFormat.addElement( element.semantic, (GFXDeclType)element.type, element.semanticIndex, element.streamIndex );
+      }
+
+      mStatSourceHits++;
+   }
+   else
+      mStatGenerated++;
+
+   const U32 compileTime = Platform::getRealMilliseconds();
+   mStatGenerateMs += compileTime - startTime;
 
    GFXShader *shader = GFX->createShader();
    shader->setShaderStageFile(GFXShaderStage::VERTEX_SHADER, vertFile);
    shader->setShaderStageFile(GFXShaderStage::PIXEL_SHADER, pixFile);
 
-   if (!shader->init(pixVersion, shaderMacros, samplers, &mInstancingFormat))
+   const bool success = shader->init(pixVersion, shaderMacros, samplers, &mInstancingFormat);
+   mStatCompileMs += Platform::getRealMilliseconds() - compileTime;
+
+   if ( !success )
    {
+      // Don't keep a failed shader in the manifest.
+      if ( cacheIter != mShaderCache.end() )
+      {
+         mShaderCache.erase( cacheIter );
+         mShaderCacheDirty = true;
+      }
+
+      mStatFailed++;
       delete shader;
       return NULL;
    }
 
    mProcShaders[cacheKey] = shader;
 
+   if ( !sourceCached )
+      _recordShaderCacheEntry( cacheKey, featureData, vertexFormat, macros, samplers, featureSignature );
+
+   // Remember the material so that pre-warming can 
+   // skip shaders for materials that aren't loaded.
+   if ( materialName && materialName[0] )
+   {
+      ShaderCacheEntry &entry = mShaderCache[cacheKey];
+      if ( !entry.materials.contains( materialName ) )
+      {
+         entry.materials.push_back( materialName );
+         mShaderCacheDirty = true;
+      }
+   }
+
    return shader;
 }
 
@@ -513,3 +613,488 @@ void ShaderGen::flushProceduralShaders()
    // just need to clear the map.
    mProcShaders.clear();
 }
+
+String ShaderGen::_getShaderFilePath( const String &cacheKey, const char *stage ) const
+{
+   return String::ToString( "shadergen:/%s_%s.%s", cacheKey.c_str(), stage, mFileEnding.c_str() );
+}
+
+U32 ShaderGen::_getFeatureSignature( const FeatureSet &features ) const
+{
+   // The same feature type can be implemented by different 
+   // shader features depending on the active lighting system
+   // so hash the names of the features that generate the source.
+   U32 signature = sShaderCacheVersion;
+   for ( U32 i=0; i < features.getCount(); i++ )
+   {
+      S32 index;
+      const FeatureType &type = features.getAt( i, &index );
+      ShaderFeature *feature = FEATUREMGR->getByType( type );
+      if ( !feature )
+         continue;
+
+      const String name = String::ToString( "%s %d", feature->getName().c_str(), index );
+      signature = Torque::hash( (const U8*)name.c_str(), name.length(), signature );
+   }
+
+   return signature;
+}
+
+bool ShaderGen::_isSourceCached( const String &cacheKey, const ShaderCacheEntry &entry, U32 featureSignature ) const
+{
+   if ( entry.featureSignature != featureSignature )
+      return false;
+
+   // Make sure the files are still the ones we wrote.
+   Torque::FS::FileNodeRef vertNode = Torque::FS::GetFileNode( _getShaderFilePath( cacheKey, "V" ) );
+   if ( vertNode.isNull() || vertNode->getChecksum() != entry.vertChecksum )
+      return false;
+
+   Torque::FS::FileNodeRef pixNode = Torque::FS::GetFileNode( _getShaderFilePath( cacheKey, "P" ) );
+   if ( pixNode.isNull() || pixNode->getChecksum() != entry.pixChecksum )
+      return false;
+
+   return true;
+}
+
+static void _recordFeatures( const FeatureSet &features, Vector<ShaderGen::CachedFeature> *outFeatures )
+{
+   outFeatures->setSize( features.getCount() );
+   for ( U32 i=0; i < features.getCount(); i++ )
+   {
+      ShaderGen::CachedFeature &cached = (*outFeatures)[i];
+      cached.name = features.getAt( i, &cached.index ).getName();
+   }
+}
+
+static void _recordVertexFormat( const GFXVertexFormat &format, Vector<ShaderGen::CachedVertexElement> *outElements )
+{
+   outElements->setSize( format.getElementCount() );
+   for ( U32 i=0; i < format.getElementCount(); i++ )
+   {
+      const GFXVertexElement &element = format.getElement( i );
+      ShaderGen::CachedVertexElement &cached = (*outElements)[i];
+      cached.semantic = element.getSemantic();
+      cached.type = (U32)element.getType();
+      cached.semanticIndex = element.getSemanticIndex();
+      cached.streamIndex = element.getStreamIndex();
+   }
+}
+
+void ShaderGen::_recordShaderCacheEntry(  const String &cacheKey,
+                                          const MaterialFeatureData &featureData,
+                                          const GFXVertexFormat *vertexFormat,
+                                          const Vector<GFXShaderMacro> *macros,
+                                          const Vector<String> &samplers,
+                                          U32 featureSignature )
+{
+   ShaderCacheEntry &entry = mShaderCache[cacheKey];
+
+   _recordFeatures( featureData.features, &entry.features );
+   _recordFeatures( featureData.materialFeatures, &entry.materialFeatures );
+
+   _recordVertexFormat( *vertexFormat, &entry.vertexElements );
+   entry.vertexInstancing = vertexFormat->hasInstancing();
+   _recordVertexFormat( mInstancingFormat, &entry.instancingElements );
+
+   entry.macros.clear();
+   if ( macros )
+      entry.macros = *macros;
+   entry.samplers = samplers;
+
+   entry.featureSignature = featureSignature;
+
+   Torque::FS::FileNodeRef vertNode = Torque::FS::GetFileNode( _getShaderFilePath( cacheKey, "V" ) );
+   Torque::FS::FileNodeRef pixNode = Torque::FS::GetFileNode( _getShaderFilePath( cacheKey, "P" ) );
+   entry.vertChecksum = vertNode.isNull() ? 0 : vertNode->getChecksum();
+   entry.pixChecksum = pixNode.isNull() ? 0 : pixNode->getChecksum();
+
+   mShaderCacheDirty = true;
+}
+
+static bool _restoreFeatures( const Vector<ShaderGen::CachedFeature> &features, FeatureSet *outFeatures )
+{
+   for ( U32 i=0; i < features.size(); i++ )
+   {
+      const FeatureType *type = FeatureType::findByName( features[i].name );
+      if ( !type )
+         return false;
+
+      outFeatures->addFeature( *type, features[i].index );
+   }
+
+   return true;
+}
+
+bool ShaderGen::_prewarmEntry( const ShaderCacheEntry &entry )
+{
+   MaterialFeatureData featureData;
+   if (  !_restoreFeatures( entry.features, &featureData.features ) ||
+         !_restoreFeatures( entry.materialFeatures, &featureData.materialFeatures ) )
+      return false;
+
+   GFXVertexFormat vertexFormat;
+   for ( U32 i=0; i < entry.vertexElements.size(); i++ )
+   {
+      const CachedVertexElement &element = entry.vertexElements[i];
+      vertexFormat.addElement( element.semantic, (GFXDeclType)element.type, element.semanticIndex, element.streamIndex );
+   }
+   if ( entry.vertexInstancing )
+      vertexFormat.enableInstancing();
+
+   // Copy these as getShader() can modify the manifest.
+   const Vector<GFXShaderMacro> macros( entry.macros );
+   const Vector<String> samplers( entry.samplers );
+
+   return getShader( featureData, &vertexFormat, &macros, samplers ) != NULL;
+}
+
+U32 ShaderGen::prewarmShaders( U32 maxTimeMs )
+{
+   PROFILE_SCOPE( ShaderGen_PrewarmShaders );
+
+   if ( !mInit )
+      return 0;
+
+   if ( !mPrewarmQueued )
+   {
+      // Gather the names of the materials which are loaded.
+      HashMap<String, bool> loadedMaterials;
+      SimSet *materialSet = MATMGR->getMaterialSet();
+      for ( SimSet::iterator iter = materialSet->begin(); iter != materialSet->end(); iter++ )
+      {
+         const char *name = (*iter)->getName();
+         if ( name && name[0] )
+            loadedMaterials.insert( name, true );
+      }
+
+      // Queue the entries which aren't already created and which
+      // either belong to a loaded material or to no material at all.
+      mPrewarmQueue.clear();
+      for ( ShaderCacheMap::Iterator iter = mShaderCache.begin(); iter != mShaderCache.end(); iter++ )
+      {
+         if ( mProcShaders.contains( iter->key ) )
+            continue;
+
+         const Vector<String> &materials = iter->value.materials;
+         bool used = materials.empty();
+         for ( U32 i=0; !used && i < materials.size(); i++ )
+            used = loadedMaterials.find( materials[i] ) != loadedMaterials.end();
+
+         if ( used )
+            mPrewarmQueue.push_back( iter->key );
+      }
+
+      mPrewarmQueued = true;
+   }
+
+   const U32 startTime = Platform::getRealMilliseconds();
+
+   while ( !mPrewarmQueue.empty() )
+   {
+      const String cacheKey = mPrewarmQueue.last();
+      mPrewarmQueue.pop_back();
+
+      ShaderCacheMap::Iterator iter = mShaderCache.find( cacheKey );
+      if ( iter == mShaderCache.end() || mProcShaders.contains( cacheKey ) )
+         continue;
+
+      if ( _prewarmEntry( iter->value ) )
+         mStatPrewarmed++;
+      else
+      {
+         // The features no longer exist or the shader 
+         // failed to compile, so forget about it.
+         iter = mShaderCache.find( cacheKey );
+         if ( iter != mShaderCache.end() )
+            mShaderCache.erase( iter );
+         mShaderCacheDirty = true;
+      }
+
+      if ( maxTimeMs > 0 && Platform::getRealMilliseconds() - startTime >= maxTimeMs )
+         break;
+   }
+
+   if ( mPrewarmQueue.empty() )
+      mPrewarmQueued = false;
+
+   return mPrewarmQueue.size();
+}
+
+static bool _readCacheString( Stream &stream, String *outString )
+{
+   U8 len8;
+   if ( !stream.read( &len8 ) )
+      return false;
+
+   U16 len = len8;
+   if ( len8 == 255 && !stream.read( &len ) )
+      return false;
+
+   FrameTemp<char> buffer( len );
+   if ( !stream.read( len, buffer.address() ) )
+      return false;
+
+   *outString = String( buffer.address(), len );
+   return true;
+}
+
+static bool _readCachedFeatures( Stream &stream, Vector<ShaderGen::CachedFeature> *outFeatures )
+{
+   U32 count;
+   if ( !stream.read( &count ) )
+      return false;
+
+   outFeatures->setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      ShaderGen::CachedFeature &feature = (*outFeatures)[i];
+      if ( !_readCacheString( stream, &feature.name ) || !stream.read( &feature.index ) )
+         return false;
+   }
+
+   return true;
+}
+
+static void _writeCachedFeatures( Stream &stream, const Vector<ShaderGen::CachedFeature> &features )
+{
+   stream.write( (U32)features.size() );
+   for ( U32 i=0; i < features.size(); i++ )
+   {
+      stream.write( features[i].name );
+      stream.write( features[i].index );
+   }
+}
+
+static bool _readCachedElements( Stream &stream, Vector<ShaderGen::CachedVertexElement> *outElements )
+{
+   U32 count;
+   if ( !stream.read( &count ) )
+      return false;
+
+   outElements->setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      ShaderGen::CachedVertexElement &element = (*outElements)[i];
+      if (  !_readCacheString( stream, &element.semantic ) ||
+            !stream.read( &element.type ) ||
+            !stream.read( &element.semanticIndex ) ||
+            !stream.read( &element.streamIndex ) )
+         return false;
+   }
+
+   return true;
+}
+
+static void _writeCachedElements( Stream &stream, const Vector<ShaderGen::CachedVertexElement> &elements )
+{
+   stream.write( (U32)elements.size() );
+   for ( U32 i=0; i < elements.size(); i++ )
+   {
+      stream.write( elements[i].semantic );
+      stream.write( elements[i].type );
+      stream.write( elements[i].semanticIndex );
+      stream.write( elements[i].streamIndex );
+   }
+}
+
+static bool _readCachedStrings( Stream &stream, Vector<String> *outStrings )
+{
+   U32 count;
+   if ( !stream.read( &count ) )
+      return false;
+
+   outStrings->setSize( count );
+   for ( U32 i=0; i < count; i++ )
+   {
+      if ( !_readCacheString( stream, &(*outStrings)[i] ) )
+         return false;
+   }
+
+   return true;
+}
+
+static void _writeCachedStrings( Stream &stream, const Vector<String> &strings )
+{
+   stream.write( (U32)strings.size() );
+   for ( U32 i=0; i < strings.size(); i++ )
+      stream.write( strings[i] );
+}
+
+bool ShaderGen::_loadShaderCache()
+{
+   PROFILE_SCOPE( ShaderGen_LoadShaderCache );
+
+   mShaderCache.clear();
+   mShaderCacheDirty = false;
+
+   if ( !Torque::FS::IsFile( sShaderCacheManifestFile ) )
+      return false;
+
+   FileStream stream;
+   if ( !stream.open( sShaderCacheManifestFile, Torque::FS::File::Read ) )
+      return false;
+
+   // The generated source depends on the engine build, device 
+   // and shader model so check those along with the version.
+   U32 signature, version, adapterType, entryCount;
+   F32 pixVersion;
+   String engineBuild, fileEnding;
+   if (  !stream.read( &signature ) || signature != sShaderCacheSignature ||
+         !stream.read( &version ) || version != sShaderCacheVersion ||
+         !_readCacheString( stream, &engineBuild ) || !engineBuild.equal( _getEngineBuild() ) ||
+         !stream.read( &adapterType ) || adapterType != (U32)GFX->getAdapterType() ||
+         !stream.read( &pixVersion ) || pixVersion != GFX->getPixelShaderVersion() ||
+         !_readCacheString( stream, &fileEnding ) || !fileEnding.equal( mFileEnding ) ||
+         !stream.read( &entryCount ) )
+   {
+      Con::printf( "ShaderGen: Ignoring out of date shader cache manifest." );
+      mShaderCacheDirty = true;
+      return false;
+   }
+
+   for ( U32 i=0; i < entryCount; i++ )
+   {
+      String cacheKey;
+      ShaderCacheEntry entry;
+      Vector<String> macroNames;
+      Vector<String> macroValues;
+
+      if (  !_readCacheString( stream, &cacheKey ) ||
+            !_readCachedFeatures( stream, &entry.features ) ||
+            !_readCachedFeatures( stream, &entry.materialFeatures ) ||
+            !_readCachedElements( stream, &entry.vertexElements ) ||
+            !stream.read( &entry.vertexInstancing ) ||
+            !_readCachedElements( stream, &entry.instancingElements ) ||
+            !_readCachedStrings( stream, &macroNames ) ||
+            !_readCachedStrings( stream, &macroValues ) ||
+            macroNames.size() != macroValues.size() ||
+            !_readCachedStrings( stream, &entry.samplers ) ||
+            !_readCachedStrings( stream, &entry.materials ) ||
+            !stream.read( &entry.featureSignature ) ||
+            !stream.read( &entry.vertChecksum ) ||
+            !stream.read( &entry.pixChecksum ) )
+      {
+         Con::warnf( "ShaderGen: The shader cache manifest is corrupt." );
+         mShaderCache.clear();
+         mShaderCacheDirty = true;
+         return false;
+      }
+
+      for ( U32 j=0; j < macroNames.size(); j++ )
+         entry.macros.push_back( GFXShaderMacro( macroNames[j], macroValues[j] ) );
+
+      mShaderCache[cacheKey] = entry;
+   }
+
+   Con::printf( "ShaderGen: Loaded %d entries from the shader cache manifest.", mShaderCache.size() );
+
+   return true;
+}
+
+bool ShaderGen::saveShaderCache()
+{
+   PROFILE_SCOPE( ShaderGen_SaveShaderCache );
+
+   if ( !mInit || !mShaderCachePersistent || !mShaderCacheDirty )
+      return false;
+
+   FileStream stream;
+   if ( !stream.open( sShaderCacheManifestFile, Torque::FS::File::Write ) )
+   {
+      Con::warnf( "ShaderGen: Could not write the shader cache manifest." );
+      return false;
+   }
+
+   stream.write( sShaderCacheSignature );
+   stream.write( sShaderCacheVersion );
+   stream.write( _getEngineBuild() );
+   stream.write( (U32)GFX->getAdapterType() );
+   stream.write( GFX->getPixelShaderVersion() );
+   stream.write( mFileEnding );
+   stream.write( mShaderCache.size() );
+
+   for ( ShaderCacheMap::Iterator iter = mShaderCache.begin(); iter != mShaderCache.end(); iter++ )
+   {
+      const ShaderCacheEntry &entry = iter->value;
+
+      stream.write( iter->key );
+      _writeCachedFeatures( stream, entry.features );
+      _writeCachedFeatures( stream, entry.materialFeatures );
+      _writeCachedElements( stream, entry.vertexElements );
+      stream.write( entry.vertexInstancing );
+      _writeCachedElements( stream, entry.instancingElements );
+
+      stream.write( (U32)entry.macros.size() );
+      for ( U32 i=0; i < entry.macros.size(); i++ )
+         stream.write( entry.macros[i].name );
+      stream.write( (U32)entry.macros.size() );
+      for ( U32 i=0; i < entry.macros.size(); i++ )
+         stream.write( entry.macros[i].value );
+
+      _writeCachedStrings( stream, entry.samplers );
+      _writeCachedStrings( stream, entry.materials );
+      stream.write( entry.featureSignature );
+      stream.write( entry.vertChecksum );
+      stream.write( entry.pixChecksum );
+   }
+
+   mShaderCacheDirty = false;
+   return true;
+}
+
+void ShaderGen::resetShaderCacheStats()
+{
+   mStatMemoryHits = 0;
+   mStatSourceHits = 0;
+   mStatGenerated = 0;
+   mStatFailed = 0;
+   mStatPrewarmed = 0;
+   mStatGenerateMs = 0;
+   mStatCompileMs = 0;
+}
+
+void ShaderGen::dumpShaderCacheStats()
+{
+   const U32 misses = mStatSourceHits + mStatGenerated + mStatFailed;
+
+   Con::printf( "ShaderGen cache statistics:" );
+   Con::printf( "   Manifest entries: %d (%s)", mShaderCache.size(), mShaderCachePersistent ? "persistent" : "memory only" );
+   Con::printf( "   Loaded shaders: %d", mProcShaders.size() );
+   Con::printf( "   Memory hits: %d", mStatMemoryHits );
+   Con::printf( "   Misses: %d", misses );
+   Con::printf( "      Cached source: %d", mStatSourceHits );
+   Con::printf( "      Generated source: %d", mStatGenerated );
+   Con::printf( "      Failed: %d", mStatFailed );
+   Con::printf( "   Pre-warmed: %d", mStatPrewarmed );
+   Con::printf( "   Generate time: %dms", mStatGenerateMs );
+   Con::printf( "   Compile time: %dms (%.2fms per shader)", mStatCompileMs, misses > 0 ? (F32)mStatCompileMs / (F32)misses : 0.0f );
+}
+
+DefineEngineFunction( prewarmShaderCache, S32, ( S32 maxTimeMs ), ( 0 ),
+   "@brief Creates the procedural shaders recorded in the shader cache manifest "
+   "for the loaded materials so that they aren't built on first use.\n\n"
+   "@param maxTimeMs The time budget in milliseconds or zero to create all of them.\n"
+   "@return The number of shaders still waiting to be created.\n"
+   "@ingroup GFX\n" )
+{
+   return SHADERGEN->prewarmShaders( getMax( maxTimeMs, 0 ) );
+}
+
+DefineEngineFunction( saveShaderCache, bool, (), ,
+   "@brief Writes the procedural shader cache manifest to the shader cache path.\n\n"
+   "@return True if the manifest was written.\n"
+   "@ingroup GFX\n" )
+{
+   return SHADERGEN->saveShaderCache();
+}
+
+DefineEngineFunction( dumpShaderCacheStats, void, ( bool reset ), ( false ),
+   "@brief Prints the procedural shader cache hit, miss and timing statistics to the console.\n\n"
+   "@param reset If true the statistics are cleared afterwards.\n"
+   "@ingroup GFX\n" )
+{
+   SHADERGEN->dumpShaderCacheStats();
+   if ( reset )
+      SHADERGEN->resetShaderCacheStats();
+}
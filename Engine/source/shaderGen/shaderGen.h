@@ -120,6 +120,8 @@ public:
 //**************************************************************************
 
 
+class ShaderGenCacheFixture;
+
 //**************************************************************************
 // Shader generator
 //**************************************************************************
@@ -145,21 +147,98 @@ public:
    /// the vertex and pixel shader files.  pixVersion is also filled in by
    /// this function.
    /// @param assignNum used to assign a specific number as the filename   
+   /// @param macrosOnly If true the shader files are not written and only
+   /// the feature macros are filled in.
    void generateShader( const MaterialFeatureData &featureData,
                         char *vertFile, 
                         char *pixFile, 
                         F32 *pixVersion,
                         const GFXVertexFormat *vertexFormat,
                         const char* cacheName,
-                        Vector<GFXShaderMacro> &macros);
+                        Vector<GFXShaderMacro> &macros,
+                        bool macrosOnly = false );
 
-   // Returns a shader that implements the features listed by dat.
-   GFXShader* getShader( const MaterialFeatureData &dat, const GFXVertexFormat *vertexFormat, const Vector<GFXShaderMacro> *macros, const Vector<String> &samplers );
+   // Returns a shader that implements the features listed by dat.  The optional
+   // materialName is recorded in the shader cache manifest for pre-warming.
+   GFXShader* getShader( const MaterialFeatureData &dat, const GFXVertexFormat *vertexFormat, const Vector<GFXShaderMacro> *macros, const Vector<String> &samplers, const char *materialName = NULL );
 
    // This will delete all of the procedural shaders that we have.  Used to regenerate shaders when
    // the ShaderFeatures have changed (due to lighting system change, or new plugin)
    virtual void flushProceduralShaders();
 
+   /// Creates the shaders recorded in the shader cache manifest which are not
+   /// yet loaded, so that they don't need to be built on first use.  Entries
+   /// recorded for materials are only created if the material is currently
+   /// known to the MaterialManager.
+   ///
+   /// @param maxTimeMs The time budget for this call or zero for no limit.
+   /// @return The number of entries still waiting to be created.
+   U32 prewarmShaders( U32 maxTimeMs = 0 );
+
+   /// Writes the shader cache manifest to the shader cache path.
+   bool saveShaderCache();
+
+   /// Prints the shader cache hit, miss and timing statistics to the console.
+   void dumpShaderCacheStats();
+
+   /// Clears the shader cache statistics.
+   void resetShaderCacheStats();
+
+   /// If true the shader source written by a previous run is reused when
+   /// the shader cache manifest shows it is still current.
+   static bool smUseSourceCache;
+
+   /// A feature type and index as stored in the shader cache manifest.
+   struct CachedFeature
+   {
+      String name;
+      S32 index;
+   };
+
+   /// A vertex element as stored in the shader cache manifest.
+   struct CachedVertexElement
+   {
+      String semantic;
+      U32 type;
+      U32 semanticIndex;
+      U32 streamIndex;
+   };
+
+   /// The inputs and outputs of a procedural shader as recorded in 
+   /// the shader cache manifest.
+   struct ShaderCacheEntry
+   {
+      ShaderCacheEntry()
+         :  vertexInstancing( false ),
+            featureSignature( 0 ),
+            vertChecksum( 0 ),
+            pixChecksum( 0 )
+      {}
+
+      Vector<CachedFeature> features;
+      Vector<CachedFeature> materialFeatures;
+
+      Vector<CachedVertexElement> vertexElements;
+      bool vertexInstancing;
+
+      /// The instancing format filled in by the features when 
+      /// the source was generated.
+      Vector<CachedVertexElement> instancingElements;
+
+      Vector<GFXShaderMacro> macros;
+      Vector<String> samplers;
+
+      /// The names of the materials which used this shader.
+      Vector<String> materials;
+
+      /// A hash of the shader features which generated the source.
+      U32 featureSignature;
+
+      /// The CRCs of the generated vertex and pixel shader files.
+      U32 vertChecksum;
+      U32 pixChecksum;
+   };
+
    void setPrinter(ShaderGenPrinter* printer) { mPrinter = printer; }
    void setComponentFactory(ShaderGenComponentFactory* factory) { mComponentFactory = factory; }
    void setFileEnding(String ending) { mFileEnding = ending; }
@@ -169,6 +248,7 @@ public:
 protected:   
 
    friend class ManagedSingleton<ShaderGen>;
+   friend class ::ShaderGenCacheFixture;
 
    // Shader generation 
    MaterialFeatureData  mFeatureData;
@@ -196,6 +276,29 @@ protected:
    typedef Map<String, GFXShaderRef> ShaderMap;
    ShaderMap mProcShaders;
 
+   /// Map of cache string -> manifest entry.
+   typedef Map<String, ShaderCacheEntry> ShaderCacheMap;
+   ShaderCacheMap mShaderCache;
+
+   /// Is the shader cache manifest written to disk?
+   bool mShaderCachePersistent;
+
+   /// Has the manifest changed since it was loaded or saved?
+   bool mShaderCacheDirty;
+
+   /// The cache keys waiting to be pre-warmed.
+   Vector<String> mPrewarmQueue;
+   bool mPrewarmQueued;
+
+   /// Shader cache statistics.
+   U32 mStatMemoryHits;
+   U32 mStatSourceHits;
+   U32 mStatGenerated;
+   U32 mStatFailed;
+   U32 mStatPrewarmed;
+   U32 mStatGenerateMs;
+   U32 mStatCompileMs;
+
    ShaderGen();
 
    bool _handleGFXEvent(GFXDevice::GFXDeviceEventType event);
@@ -223,6 +326,29 @@ protected:
    void _processVertFeatures( Vector<GFXShaderMacro> &macros, bool macrosOnly = false );
    void _printVertShader( Stream &stream );
 
+   /// Returns the path of a generated vertex ("V") or pixel ("P") shader file.
+   String _getShaderFilePath( const String &cacheKey, const char *stage ) const;
+
+   /// Returns a hash of the shader features which generate the source for the features.
+   U32 _getFeatureSignature( const FeatureSet &features ) const;
+
+   /// Returns true if the generated source for the entry exists and is current.
+   bool _isSourceCached( const String &cacheKey, const ShaderCacheEntry &entry, U32 featureSignature ) const;
+
+   /// Records the inputs of a newly generated shader in the manifest.
+   void _recordShaderCacheEntry( const String &cacheKey,
+                                 const MaterialFeatureData &featureData,
+                                 const GFXVertexFormat *vertexFormat,
+                                 const Vector<GFXShaderMacro> *macros,
+                                 const Vector<String> &samplers,
+                                 U32 featureSignature );
+
+   /// Creates the shader for a manifest entry.
+   bool _prewarmEntry( const ShaderCacheEntry &entry );
+
+   /// Reads the shader cache manifest from the shader cache path.
+   bool _loadShaderCache();
+
    // For ManagedSingleton.
    static const char* getSingletonName() { return "ShaderGen"; }   
 };
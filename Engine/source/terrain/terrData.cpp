@@ -54,6 +54,7 @@
 #include "T3D/physics/physicsCollision.h"
 #include "console/engineAPI.h"
 #include "core/util/safeRelease.h"
+#include "lighting/shadowMap/lightShadowMap.h"
 
 #include "T3D/assets/TerrainMaterialAsset.h"
 using namespace Torque;
@@ -205,6 +206,7 @@ TerrainBlock::TerrainBlock()
    mScreenError( 16 ),
    mCastShadows( true ),
    mZoningDirty( false ),
+   mOccluderMeshDirty( true ),
    mUpdateBasetex ( true ),
    mDetailTextureArray( NULL ),
    mMacroTextureArray( NULL ),
@@ -556,6 +558,8 @@ bool TerrainBlock::_setTerrainAsset(void* obj, const char* index, const char* da
 
 void TerrainBlock::_updateBounds()
 {
+   mOccluderMeshDirty = true;
+
    if ( !mFile )
       return; // quick fix to stop crashing when deleting terrainblocks
 
@@ -573,6 +577,132 @@ void TerrainBlock::_updateBounds()
    }
 }
 
+bool TerrainBlock::getOccluderMesh( MatrixF *outTransform, const Vector<Point3F> **outTriangles )
+{
+   if ( !mFile )
+      return false;
+
+   if ( mOccluderMeshDirty )
+      _buildOccluderMesh();
+
+   if ( mOccluderTriangles.empty() )
+      return false;
+
+   *outTransform = getRenderTransform();
+   *outTriangles = &mOccluderTriangles;
+   return true;
+}
+
+void TerrainBlock::_buildOccluderMesh()
+{
+   PROFILE_SCOPE( TerrainBlock_buildOccluderMesh );
+
+   mOccluderMeshDirty = false;
+   mOccluderTriangles.clear();
+
+   // Split the heightmap into a grid of at most 64x64 cells.
+   const U32 blockSize = mFile->mSize;
+   const U32 cellSamples = getMax( blockSize / 64, (U32)1 );
+   const U32 numCells = ( blockSize - 1 ) / cellSamples;
+   if ( numCells == 0 )
+      return;
+
+   // Find the lowest point of each cell and whether
+   // it is solid, i.e. without holes.
+   Vector<F32> cellMin;
+   Vector<bool> cellSolid;
+   cellMin.setSize( numCells * numCells );
+   cellSolid.setSize( numCells * numCells );
+
+   for ( U32 cy = 0; cy < numCells; cy++ )
+   {
+      for ( U32 cx = 0; cx < numCells; cx++ )
+      {
+         U16 minHeight = U16_MAX;
+         bool solid = true;
+
+         for ( U32 y = cy * cellSamples; y <= ( cy + 1 ) * cellSamples; y++ )
+         {
+            for ( U32 x = cx * cellSamples; x <= ( cx + 1 ) * cellSamples; x++ )
+            {
+               minHeight = getMin( minHeight, mFile->getHeight( x, y ) );
+               solid &= !mFile->isEmptyAt( x, y );
+            }
+         }
+
+         cellMin[ cy * numCells + cx ] = fixedToFloat( minHeight );
+         cellSolid[ cy * numCells + cx ] = solid;
+      }
+   }
+
+   // Each vertex takes the lowest height of the cells around it
+   // so the triangles stay below the surface across the whole cell.
+   const U32 numVerts = numCells + 1;
+   Vector<Point3F> verts;
+   verts.setSize( numVerts * numVerts );
+
+   for ( U32 vy = 0; vy < numVerts; vy++ )
+   {
+      for ( U32 vx = 0; vx < numVerts; vx++ )
+      {
+         F32 height = F32_MAX;
+         for ( U32 cy = getMax( vy, (U32)1 ) - 1; cy <= getMin( vy, numCells - 1 ); cy++ )
+            for ( U32 cx = getMax( vx, (U32)1 ) - 1; cx <= getMin( vx, numCells - 1 ); cx++ )
+               height = getMin( height, cellMin[ cy * numCells + cx ] );
+
+         verts[ vy * numVerts + vx ].set( vx * cellSamples * mSquareSize, vy * cellSamples * mSquareSize, height );
+      }
+   }
+
+   for ( U32 cy = 0; cy < numCells; cy++ )
+   {
+      for ( U32 cx = 0; cx < numCells; cx++ )
+      {
+         // Leave out cells next to holes too so nothing seen
+         // through a hole can end up behind the mesh.
+         bool solid = true;
+         for ( U32 ny = getMax( cy, (U32)1 ) - 1; ny <= getMin( cy + 1, numCells - 1 ); ny++ )
+            for ( U32 nx = getMax( cx, (U32)1 ) - 1; nx <= getMin( cx + 1, numCells - 1 ); nx++ )
+               solid &= cellSolid[ ny * numCells + nx ];
+
+         if ( !solid )
+            continue;
+
+         const Point3F &v00 = verts[ cy * numVerts + cx ];
+         const Point3F &v10 = verts[ cy * numVerts + cx + 1 ];
+         const Point3F &v01 = verts[ ( cy + 1 ) * numVerts + cx ];
+         const Point3F &v11 = verts[ ( cy + 1 ) * numVerts + cx + 1 ];
+
+         mOccluderTriangles.push_back( v00 );
+         mOccluderTriangles.push_back( v10 );
+         mOccluderTriangles.push_back( v11 );
+
+         mOccluderTriangles.push_back( v00 );
+         mOccluderTriangles.push_back( v11 );
+         mOccluderTriangles.push_back( v01 );
+      }
+   }
+}
+
+void TerrainBlock::_invalidateStaticShadows( const Point2I &minPt, const Point2I &maxPt )
+{
+   if ( !LightShadowMap::smCacheStaticShadows || !mFile )
+      return;
+
+   // The squares around the grid points changed too.
+   const S32 blockSize = mFile->mSize;
+   Box3F box;
+   box.minExtents.set( mClamp( minPt.x - 1, 0, blockSize ) * mSquareSize,
+                       mClamp( minPt.y - 1, 0, blockSize ) * mSquareSize,
+                       mObjBox.minExtents.z );
+   box.maxExtents.set( mClamp( maxPt.x + 1, 0, blockSize ) * mSquareSize,
+                       mClamp( maxPt.y + 1, 0, blockSize ) * mSquareSize,
+                       mObjBox.maxExtents.z );
+
+   getTransform().mul( box );
+   LightShadowMap::invalidateStaticShadows( box );
+}
+
 void TerrainBlock::_onZoningChanged( SceneZoneSpaceManager *zoneManager )
 {
    const SceneManager* sm = getSceneManager();
@@ -612,6 +742,13 @@ void TerrainBlock::updateGridMaterials( const Point2I &minPt, const Point2I &max
    // before the next time we render the terrain.
    mLayerTexDirty = true;
 
+   // Painting holes changes which cells may occlude.
+   mOccluderMeshDirty = true;
+
+   // ... and what casts shadows.
+   if ( isClientObject() )
+      _invalidateStaticShadows( minPt, maxPt );
+
    // Signal anyone that cares that the opacity was changed.
    smUpdateSignal.trigger( LayersUpdate, this, minPt, maxPt );
 }
@@ -651,6 +788,10 @@ void TerrainBlock::updateGrid( const Point2I &minPt, const Point2I &maxPt, bool
       const RectI gridRect( minPt, maxPt - minPt );
       mCell->updateGrid( gridRect );
 
+      // The world box only changes when the height range does, so
+      // the shadow cache doesn't hear about most edits otherwise.
+      _invalidateStaticShadows( minPt, maxPt );
+
       // Rebuild the physics representation.
       if ( mPhysicsRep )
       {
@@ -223,6 +223,17 @@ protected:
    /// Holds the generated convex list stuff for this terrain
    Convex mTerrainConvexList;
 
+   /// True if mOccluderTriangles needs to be rebuilt.
+   bool mOccluderMeshDirty;
+
+   /// A coarse object space triangulation of the terrain used for
+   /// software occlusion culling.  It is kept below the real surface
+   /// so it never hides anything the terrain doesn't.
+   /// @see getOccluderMesh
+   Vector<Point3F> mOccluderTriangles;
+
+   void _buildOccluderMesh();
+
    String _getBaseTexCacheFileName() const;
 
    void _rebuildQuadtree();
@@ -254,6 +265,9 @@ protected:
 
    void _updateBounds();
 
+   /// Render the cached static shadows over the grid area again.
+   void _invalidateStaticShadows( const Point2I &minPt, const Point2I &maxPt );
+
    void _onZoningChanged( SceneZoneSpaceManager *zoneManager );
 
    void _updateZoning();
@@ -466,6 +480,8 @@ public:
 
    void prepRenderImage  ( SceneRenderState* state ) override;
 
+   bool getOccluderMesh( MatrixF *outTransform, const Vector<Point3F> **outTriangles ) override;
+
    void buildConvex(const Box3F& box,Convex* convex) override;
    bool buildPolyList(PolyListContext context, AbstractPolyList* polyList, const Box3F &box, const SphereF &sphere) override;
    bool castRay(const Point3F &start, const Point3F &end, RayInfo* info) override;
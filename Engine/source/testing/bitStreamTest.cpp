@@ -0,0 +1,213 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "core/stream/bitStream.h"
+#include "math/mRandom.h"
+
+FIXTURE(BitStream)
+{
+public:
+   /// The bit at a time writer BitStream::writeBits() used to be, which the
+   /// word at a time one has to match bit for bit.
+   static void referenceWrite(U8 *buffer, S32 bitNum, S32 bitCount, const U8 *bits)
+   {
+      for (S32 i = 0; i < bitCount; i++, bitNum++)
+      {
+         if (bits[i >> 3] & (1 << (i & 0x7)))
+            buffer[bitNum >> 3] |= (1 << (bitNum & 0x7));
+         else
+            buffer[bitNum >> 3] &= ~(1 << (bitNum & 0x7));
+      }
+   }
+
+   static Point3F randomPoint(MRandomLCG &rand)
+   {
+      Point3F p;
+      p.x = rand.randF(0.0f, 100.0f);
+      p.y = rand.randF(-100.0f, 0.0f);
+      p.z = rand.randF();
+      return p;
+   }
+
+   static bool testBit(const U8 *bits, S32 bitNum)
+   {
+      return (bits[bitNum >> 3] & (1 << (bitNum & 0x7))) != 0;
+   }
+};
+
+TEST_FIX(BitStream, MatchesBitAtATime)
+{
+   MRandomLCG rand(1234);
+
+   for (U32 trial = 0; trial < 2000; trial++)
+   {
+      // Allocate exactly the buffer size so that anything reading or writing
+      // past the end shows up in a memory checker.
+      const S32 size = rand.randI(1, 40);
+      U8 *buffer = (U8*)dMalloc(size);
+      U8 *expected = (U8*)dMalloc(size);
+      for (S32 i = 0; i < size; i++)
+         buffer[i] = expected[i] = U8(rand.randI());
+
+      BitStream stream(buffer, size);
+
+      // Write runs of bits anywhere in the buffer, over what is already
+      // there, and read each back.
+      for (U32 op = 0; op < 16; op++)
+      {
+         const S32 bitCount = rand.randI(1, getMin(size * 8, 200));
+         const S32 bitNum = rand.randI(0, size * 8 - bitCount);
+
+         U8 bits[32];
+         for (U32 i = 0; i < sizeof(bits); i++)
+            bits[i] = U8(rand.randI());
+
+         stream.setCurPos(bitNum);
+         stream.writeBits(bitCount, bits);
+         referenceWrite(expected, bitNum, bitCount, bits);
+
+         ASSERT_TRUE(stream.isValid());
+         EXPECT_EQ(stream.getCurPos(), bitNum + bitCount);
+         ASSERT_EQ(dMemcmp(buffer, expected, size), 0) << "trial " << trial << ", " << bitCount << " bits at " << bitNum;
+
+         U8 read[32];
+         dMemset(read, 0xCD, sizeof(read));
+         stream.setCurPos(bitNum);
+         stream.readBits(bitCount, read);
+         ASSERT_TRUE(stream.isValid());
+
+         for (S32 i = 0; i < bitCount; i++)
+            ASSERT_EQ(testBit(read, i), testBit(bits, i)) << "trial " << trial << ", bit " << i << " of " << bitCount << " at " << bitNum;
+
+         // The rest of the last byte is cleared.
+         for (S32 i = bitCount; i < ((bitCount + 7) & ~7); i++)
+            EXPECT_FALSE(testBit(read, i));
+      }
+
+      dFree(buffer);
+      dFree(expected);
+   }
+}
+
+TEST_FIX(BitStream, RoundTrip)
+{
+   enum { BufferSize = 4096, NumValues = 400 };
+   U8 *buffer = (U8*)dMalloc(BufferSize);
+
+   for (U32 seed = 1; seed <= 50; seed++)
+   {
+      // Write a random sequence of values, then read it back with the same
+      // random sequence.
+      MRandomLCG rand(seed);
+      BitStream stream(buffer, BufferSize);
+      stream.setCompressionPoint(Point3F(10.0f, -20.0f, 5.0f));
+
+      for (U32 i = 0; i < NumValues; i++)
+      {
+         switch (rand.randI(0, 6))
+         {
+         case 0:  stream.writeFlag(rand.randI(0, 1) != 0); break;
+         case 1:  { const S32 bits = rand.randI(1, 32); stream.writeInt(bits == 32 ? S32(rand.randI()) : rand.randI(0, (1 << (bits - 1)) - 1), bits); break; }
+         case 2:  stream.writeSignedInt(rand.randI(-1000, 1000), 12); break;
+         case 3:  stream.writeRangedU32(rand.randI(0, 300), 0, 300); break;
+         case 4:  stream.writeFloat(rand.randF(), 10); break;
+         case 5:  stream.writeCompressedPoint(randomPoint(rand)); break;
+         default:
+            {
+               U8 bytes[40];
+               const U32 count = rand.randI(1, sizeof(bytes));
+               for (U32 j = 0; j < count; j++)
+                  bytes[j] = U8(rand.randI());
+               stream.write(count, bytes);
+            }
+         }
+      }
+      ASSERT_TRUE(stream.isValid());
+
+      const S32 endPos = stream.getCurPos();
+      rand.setSeed(seed);
+      stream.setBuffer(buffer, BufferSize);
+      stream.setCompressionPoint(Point3F(10.0f, -20.0f, 5.0f));
+
+      for (U32 i = 0; i < NumValues; i++)
+      {
+         switch (rand.randI(0, 6))
+         {
+         case 0:  EXPECT_EQ(stream.readFlag(), rand.randI(0, 1) != 0); break;
+         case 1:  { const S32 bits = rand.randI(1, 32); EXPECT_EQ(stream.readInt(bits), bits == 32 ? S32(rand.randI()) : rand.randI(0, (1 << (bits - 1)) - 1)); break; }
+         case 2:  EXPECT_EQ(stream.readSignedInt(12), rand.randI(-1000, 1000)); break;
+         case 3:  EXPECT_EQ(stream.readRangedU32(0, 300), rand.randI(0, 300)); break;
+         case 4:  EXPECT_NEAR(stream.readFloat(10), rand.randF(), 1.0f / 1023.0f); break;
+         case 5:
+            {
+               Point3F p;
+               stream.readCompressedPoint(&p);
+               const Point3F expected = randomPoint(rand);
+               EXPECT_NEAR(p.x, expected.x, 0.002f);
+               EXPECT_NEAR(p.y, expected.y, 0.002f);
+               EXPECT_NEAR(p.z, expected.z, 0.002f);
+               break;
+            }
+         default:
+            {
+               U8 bytes[40];
+               const U32 count = rand.randI(1, sizeof(bytes));
+               stream.read(count, bytes);
+               for (U32 j = 0; j < count; j++)
+                  EXPECT_EQ(bytes[j], U8(rand.randI())) << "seed " << seed << ", value " << i;
+            }
+         }
+      }
+
+      EXPECT_TRUE(stream.isValid());
+      EXPECT_EQ(stream.getCurPos(), endPos);
+   }
+
+   dFree(buffer);
+}
+
+TEST_FIX(BitStream, OutOfRange)
+{
+   U8 buffer[9];
+   BitStream stream(buffer, sizeof(buffer));
+
+   // Right up to the end is fine...
+   U8 bits[9] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+   stream.writeFlag(false);
+   stream.writeBits(71, bits);
+   EXPECT_TRUE(stream.isValid());
+   EXPECT_EQ(buffer[0], 0xFE);
+   EXPECT_EQ(buffer[8], 0xFF);
+
+   stream.setCurPos(3);
+   U8 read[9];
+   stream.readBits(69, read);
+   EXPECT_TRUE(stream.isValid());
+   EXPECT_EQ(read[0], 0xFF);
+   EXPECT_EQ(read[8], 0x1F);
+
+   // ...and a bit more isn't.
+   stream.setCurPos(8);
+   stream.readBits(65, read);
+   EXPECT_FALSE(stream.isValid());
+}
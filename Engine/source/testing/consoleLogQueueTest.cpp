@@ -0,0 +1,133 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "console/consoleLogQueue.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+
+FIXTURE(ConsoleLogQueue)
+{
+public:
+   // Small enough that the producers keep running into a full queue.
+   typedef ConsoleLogQueue<64> Queue;
+
+   static ConsoleLogRecord makeRecord(U32 thread, U32 index)
+   {
+      ConsoleLogRecord record;
+      record.mLevel = ConsoleLogEntry::Normal;
+      record.mType = ConsoleLogEntry::General;
+      record.mThread = thread;
+      record.mFrame = index;
+      record.mString = NULL;
+      return record;
+   }
+
+   struct ProducerThread : public Thread
+   {
+      Queue& mQueue;
+      U32 mIndex;
+      U32 mCount;
+      ProducerThread(Queue& queue, U32 index, U32 count)
+         : mQueue(queue), mIndex(index), mCount(count) {}
+
+      void run(void*) override
+      {
+         for (U32 i = 0; i < mCount; i++)
+         {
+            while (!mQueue.tryPush(makeRecord(mIndex, i)))
+               Platform::sleep(0);
+         }
+      }
+   };
+};
+
+TEST_FIX(ConsoleLogQueue, FillAndDrain)
+{
+   Queue queue;
+   EXPECT_TRUE(queue.isEmpty());
+
+   for (U32 i = 0; i < 64; i++)
+      EXPECT_TRUE(queue.tryPush(makeRecord(0, i)));
+   EXPECT_FALSE(queue.tryPush(makeRecord(0, 64)))
+      << "Queue should be full.";
+
+   const U32 ticket = queue.getTicket();
+   ConsoleLogRecord record;
+   for (U32 i = 0; i < 64; i++)
+   {
+      ASSERT_TRUE(queue.tryPop(record));
+      EXPECT_EQ(record.mFrame, i) << "Records should come out in order.";
+      EXPECT_FALSE(queue.isProcessed(ticket));
+      queue.markProcessed();
+   }
+
+   EXPECT_FALSE(queue.tryPop(record));
+   EXPECT_TRUE(queue.isEmpty());
+   EXPECT_TRUE(queue.isProcessed(ticket));
+}
+
+TEST_FIX(ConsoleLogQueue, ConcurrentProducers)
+{
+   const U32 NumProducers = 4;
+   const U32 NumRecords = 10000;
+
+   Queue queue;
+   Vector<ProducerThread*> producers;
+   for (U32 i = 0; i < NumProducers; i++)
+   {
+      producers.push_back(new ProducerThread(queue, i, NumRecords));
+      producers.last()->start();
+   }
+
+   // Every producer's records must arrive complete and in the order
+   // they were pushed.
+   U32 next[NumProducers] = {};
+   U32 received = 0;
+   const U32 endTime = Platform::getRealMilliseconds() + 30000;
+   while (received < NumProducers * NumRecords && Platform::getRealMilliseconds() < endTime)
+   {
+      ConsoleLogRecord record;
+      if (!queue.tryPop(record))
+      {
+         Platform::sleep(0);
+         continue;
+      }
+
+      EXPECT_LT(record.mThread, NumProducers);
+      if (record.mThread >= NumProducers)
+         break;
+      EXPECT_EQ(record.mFrame, next[record.mThread]);
+      next[record.mThread] = record.mFrame + 1;
+      queue.markProcessed();
+      received++;
+   }
+
+   for (U32 i = 0; i < NumProducers; i++)
+   {
+      producers[i]->join();
+      delete producers[i];
+   }
+
+   EXPECT_EQ(received, NumProducers * NumRecords) << "Consumer timed out.";
+   EXPECT_TRUE(queue.isEmpty());
+}
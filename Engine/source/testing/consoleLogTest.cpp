@@ -0,0 +1,123 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "console/console.h"
+#include "console/script.h"
+#include "core/strings/stringFunctions.h"
+
+FIXTURE(ConsoleLog)
+{
+public:
+   S32 mOldRateLimit;
+   S32 mOldHistorySize;
+
+   void SetUp() override
+   {
+      mOldRateLimit = Con::getIntVariable("$Con::logRateLimit");
+      mOldHistorySize = Con::getIntVariable("$Con::logHistorySize");
+   }
+
+   void TearDown() override
+   {
+      Con::setIntVariable("$Con::logRateLimit", mOldRateLimit);
+      Con::setIntVariable("$Con::logHistorySize", mOldHistorySize);
+   }
+
+   /// Returns the number of history entries containing @a marker.
+   static U32 countLines(const char* marker)
+   {
+      ConsoleLogEntry* log;
+      U32 size;
+      Con::getLockLog(log, size);
+
+      U32 count = 0;
+      for (U32 i = 0; i < size; i++)
+      {
+         if (dStrstr(log[i].mString, marker))
+            count++;
+      }
+
+      Con::unlockLog();
+      return count;
+   }
+};
+
+TEST_FIX(ConsoleLog, RateLimit)
+{
+   Con::setIntVariable("$Con::logRateLimit", 5);
+
+   // Both callsites share the format; they still get a count each.
+   const char* fmt = "ConsoleLogTest rate %s %u";
+   for (U32 window = 0; window < 2; window++)
+   {
+      if (window == 1)
+         Platform::sleep(1100);
+
+      for (U32 i = 0; i < 20; i++)
+         Con::printf(fmt, window ? "C" : "A", i);
+   }
+
+   for (U32 i = 0; i < 20; i++)
+      Con::printf(fmt, "B", i);
+
+   EXPECT_EQ(countLines("ConsoleLogTest rate A"), 5);
+   EXPECT_EQ(countLines("ConsoleLogTest rate B"), 5);
+
+   // The next window starts over and reports what the last one lost.
+   EXPECT_EQ(countLines("ConsoleLogTest rate C"), 5);
+   EXPECT_EQ(countLines("15 more lines from here were dropped"), 1);
+
+   // Lines passed through as they are, like echo(), are never dropped.
+   for (U32 i = 0; i < 20; i++)
+      Con::printf("%s", "ConsoleLogTest pass through");
+   Con::evaluate("for (%i = 0; %i < 20; %i++) echo(\"ConsoleLogTest echo\");", false, "ConsoleLogTest");
+
+   EXPECT_EQ(countLines("ConsoleLogTest pass through"), 20);
+   EXPECT_EQ(countLines("ConsoleLogTest echo"), 20);
+}
+
+TEST_FIX(ConsoleLog, HistoryTrim)
+{
+   Con::setIntVariable("$Con::logRateLimit", 0);
+   Con::setIntVariable("$Con::logHistorySize", 100);
+
+   const U32 trimCount = Con::getLogTrimCount();
+   for (U32 i = 0; i < 200; i++)
+      Con::printf("ConsoleLogTest trim %u", i);
+
+   // Trimming waits for the end of the frame.
+   EXPECT_EQ(countLines("ConsoleLogTest trim"), 200);
+   Con::processLog();
+
+   EXPECT_EQ(Con::getLogTrimCount(), trimCount + 1);
+   EXPECT_EQ(countLines("ConsoleLogTest trim"), 100);
+
+   // The newest lines are the ones kept.
+   ConsoleLogEntry* log;
+   U32 size;
+   Con::getLockLog(log, size);
+   ASSERT_EQ(size, 100);
+   EXPECT_STREQ(log[0].mString, "ConsoleLogTest trim 100");
+   EXPECT_STREQ(log[size - 1].mString, "ConsoleLogTest trim 199");
+   Con::unlockLog();
+}
@@ -196,3 +196,105 @@ TEST_F(ConsoleTest, execute)
 	EXPECT_EQ(Con::getFrameStack().size(), startStackPos) <<
 		"execute should restore stack";
 }
+
+TEST_F(ConsoleTest, consoleValueStringStorage)
+{
+   const bool pooledStrings = ConsoleValue::smPooledStrings;
+   ConsoleValue::smPooledStrings = true;
+
+   // Short strings live inside the value.
+   ConsoleValue shortValue;
+   shortValue.setString("1 2 3");
+   EXPECT_EQ(shortValue.getType(), ConsoleValueType::cvString);
+   EXPECT_STREQ(shortValue.getString(), "1 2 3");
+   EXPECT_EQ(shortValue.getInt(), 1);
+
+   // Moving copies them over.
+   ConsoleValue movedValue = std::move(shortValue);
+   EXPECT_STREQ(movedValue.getString(), "1 2 3");
+   EXPECT_STREQ(shortValue.getString(), "");
+
+   // Longer strings go into the pools.
+   String longString = String::ToString("%s - %s - %s", "a long string", "a long string", "a long string");
+   ConsoleValue longValue;
+   longValue.setString(longString.c_str());
+   EXPECT_STREQ(longValue.getString(), longString.c_str());
+
+   // Appending grows a string across all kinds of storage.
+   ConsoleValue appended;
+   String expected;
+   for (U32 i = 0; i < 100; i++)
+   {
+      appended.appendString("ab", 2);
+      expected += "ab";
+      EXPECT_STREQ(appended.getString(), expected.c_str());
+   }
+
+   // Appending to a number appends to its string form.
+   ConsoleValue number;
+   number.setInt(42);
+   number.appendString("!", 1);
+   EXPECT_STREQ(number.getString(), "42!");
+
+   // Setting a value from its own string.
+   longValue.setString(longValue.getString() + 2);
+   EXPECT_STREQ(longValue.getString(), longString.c_str() + 2);
+   movedValue.setString(movedValue.getString() + 2);
+   EXPECT_STREQ(movedValue.getString(), "2 3");
+
+   // String table entries are referenced, not copied.
+   StringTableEntry ste = StringTable->insert("consoleValueStringStorage");
+   ConsoleValue steValue;
+   steValue.setStringTableEntry(ste);
+   EXPECT_EQ(steValue.getType(), ConsoleValueType::cvSTEntry);
+   EXPECT_EQ(steValue.getString(), ste);
+
+   // Going back to plain heap strings still works.
+   ConsoleValue::smPooledStrings = false;
+   ConsoleValue heapValue;
+   heapValue.setString("heap");
+   heapValue.appendString(" string", 7);
+   EXPECT_STREQ(heapValue.getString(), "heap string");
+
+   ConsoleValue::smPooledStrings = pooledStrings;
+}
+
+TEST_F(ConsoleTest, consoleValueVector)
+{
+   // Vectors are stored in binary and only formatted when read as a string.
+   const F32 components[3] = { 1.0f, 2.5f, -3.0f };
+   ConsoleValue vec;
+   vec.setVector(components, 3);
+   EXPECT_EQ(vec.getType(), ConsoleValueType::cvVector);
+   EXPECT_EQ(vec.getVectorSize(), 3U);
+   EXPECT_STREQ(vec.getString(), "1 2.5 -3");
+   EXPECT_EQ(vec.getFloat(), 1.0f);
+   EXPECT_TRUE(vec.getBool());
+
+   Point3F pt;
+   vec.getVector(pt, 3);
+   EXPECT_EQ(pt, Point3F(1.0f, 2.5f, -3.0f));
+
+   // Moving keeps the components.
+   ConsoleValue moved = std::move(vec);
+   EXPECT_STREQ(moved.getString(), "1 2.5 -3");
+
+   // Strings and numbers are parsed, missing components are zero.
+   ConsoleValue str;
+   str.setString("4 5");
+   str.getVector(pt, 3);
+   EXPECT_EQ(pt, Point3F(4.0f, 5.0f, 0.0f));
+
+   ConsoleValue number;
+   number.setInt(7);
+   number.getVector(pt, 3);
+   EXPECT_EQ(pt, Point3F(7.0f, 0.0f, 0.0f));
+
+   // Vectors returned from engine functions feed straight into others
+   // and read back the same as the old string results.
+   Con::EvalResult result = Con::evaluate("return VectorAdd(\"1 2 3\", VectorScale(\"1 1 1\", 2));", false, NULL);
+   EXPECT_STREQ(result.value.getString(), "3 4 5");
+
+   result = Con::evaluate("%v = VectorScale(\"1 2 3\", 2); return getWord(%v, 1) SPC VectorLen(\"3 4 0\");", false, NULL);
+   EXPECT_STREQ(result.value.getString(), "4 5");
+}
@@ -0,0 +1,225 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#ifdef TORQUE_ADVANCED_LIGHTING
+
+#include "testing/unitTesting.h"
+#include "lighting/advanced/lightClusterGrid.h"
+#include "math/util/frustum.h"
+#include "math/mRandom.h"
+
+FIXTURE(LightClusterGrid)
+{
+public:
+   struct Light
+   {
+      Point3F pos;
+      VectorF dir;
+      F32 range;
+      F32 coneAngle;
+   };
+
+   Frustum frustum;
+   Vector<Light> lights;
+
+   void SetUp() override
+   {
+      // A camera off the origin and turned a bit so that the grid
+      // has to move the lights into view space.
+      MatrixF cameraTrans(EulerF(0.2f, 0.0f, 0.7f));
+      cameraTrans.setPosition(Point3F(10.0f, -20.0f, 5.0f));
+      frustum.set(false, M_HALFPI_F, 16.0f / 9.0f, 0.1f, 200.0f, cameraTrans);
+   }
+
+   /// Scatters lights in front of the camera, with every other one a spot.
+   void addLights(LightClusterGrid &grid, U32 count, S32 seed)
+   {
+      MRandomLCG rand(seed);
+      const MatrixF &cameraTrans = frustum.getTransform();
+
+      lights.clear();
+      for (U32 i = 0; i < count; i++)
+      {
+         Light light;
+         const F32 depth = rand.randF(-10.0f, 150.0f);
+         cameraTrans.mulP(Point3F(rand.randF(-depth, depth), depth, rand.randF(-depth, depth)), &light.pos);
+         light.dir.set(rand.randF(-1.0f, 1.0f), rand.randF(-1.0f, 1.0f), rand.randF(-1.0f, 1.0f));
+         light.dir.normalizeSafe();
+         light.range = rand.randF(1.0f, 30.0f);
+         light.coneAngle = (i & 1) ? rand.randF(10.0f, 150.0f) : 0.0f;
+         lights.push_back(light);
+
+         if (light.coneAngle > 0.0f)
+            grid.addSpotLight(light.pos, light.dir, light.range, light.coneAngle);
+         else
+            grid.addPointLight(light.pos, light.range);
+      }
+   }
+
+   /// Returns true if the light reaches a point, with a little slack so
+   /// points right on the edge don't count.
+   bool isLit(const Light &light, const Point3F &point) const
+   {
+      const VectorF toPoint = point - light.pos;
+      const F32 dist = toPoint.len();
+      if (dist > light.range * 0.99f)
+         return false;
+      if (light.coneAngle <= 0.0f || dist < 0.001f)
+         return true;
+
+      const F32 angle = mAcos(mClampF(mDot(toPoint, light.dir) / dist, -1.0f, 1.0f));
+      return angle < mDegToRad(light.coneAngle * 0.5f) * 0.99f;
+   }
+
+   static bool hasLight(const LightClusterGrid &grid, U32 cluster, U32 light)
+   {
+      const LightClusterGrid::Cluster &c = grid.getClusters()[cluster];
+      for (U32 i = 0; i < c.count; i++)
+      {
+         if (grid.getLightIndices()[c.offset + i] == light)
+            return true;
+      }
+      return false;
+   }
+};
+
+TEST_FIX(LightClusterGrid, Layout)
+{
+   LightClusterGrid grid;
+   grid.setFrustum(frustum);
+   addLights(grid, 300, 1);
+   grid.assign();
+
+   // The clusters have to be packed back to back in order.
+   U32 offset = 0;
+   U32 occupied = 0;
+   for (U32 i = 0; i < grid.getNumClusters(); i++)
+   {
+      const LightClusterGrid::Cluster &c = grid.getClusters()[i];
+      EXPECT_EQ(c.offset, offset);
+      offset += c.count;
+      if (c.count)
+         occupied++;
+   }
+   EXPECT_EQ(offset, grid.getLightIndices().size());
+   EXPECT_EQ(occupied, grid.getNumOccupiedClusters());
+   EXPECT_GT(occupied, 0);
+
+   U32 total = 0;
+   for (U32 i = 0; i < grid.getNumLights(); i++)
+      total += grid.getLightClusterCount(i);
+   EXPECT_EQ(total, grid.getLightIndices().size());
+}
+
+TEST_FIX(LightClusterGrid, Coverage)
+{
+   LightClusterGrid grid;
+   grid.setFrustum(frustum);
+   addLights(grid, 200, 2);
+   grid.assign();
+
+   // Every light that reaches a point has to be in the point's cluster.
+   MRandomLCG rand(3);
+   const MatrixF &cameraTrans = frustum.getTransform();
+   U32 numTested = 0;
+   for (U32 i = 0; i < 20000; i++)
+   {
+      const F32 depth = rand.randF(0.1f, 200.0f);
+      Point3F point;
+      cameraTrans.mulP(Point3F(rand.randF(-depth, depth), depth, rand.randF(-depth, depth) * 0.6f), &point);
+
+      U32 cluster;
+      if (!grid.findCluster(point, &cluster))
+         continue;
+
+      for (U32 n = 0; n < lights.size(); n++)
+      {
+         if (!isLit(lights[n], point))
+            continue;
+
+         numTested++;
+         EXPECT_TRUE(hasLight(grid, cluster, n))
+            << "Light " << n << " is missing from cluster " << cluster;
+      }
+   }
+   EXPECT_GT(numTested, 100);
+}
+
+TEST_FIX(LightClusterGrid, Culling)
+{
+   LightClusterGrid grid;
+   grid.setFrustum(frustum);
+
+   const MatrixF &cameraTrans = frustum.getTransform();
+   Point3F behind, ahead, farAway;
+   cameraTrans.mulP(Point3F(0.0f, -20.0f, 0.0f), &behind);
+   cameraTrans.mulP(Point3F(0.0f, 50.0f, 0.0f), &ahead);
+   cameraTrans.mulP(Point3F(0.0f, 500.0f, 0.0f), &farAway);
+
+   grid.addPointLight(behind, 5.0f);
+   grid.addPointLight(ahead, 2.0f);
+   grid.addPointLight(farAway, 50.0f);
+
+   // A spot just behind the camera whose range reaches well into the
+   // view, but which points away from it.
+   Point3F spotPos;
+   cameraTrans.mulP(Point3F(0.0f, -1.0f, 0.0f), &spotPos);
+   grid.addSpotLight(spotPos, -cameraTrans.getForwardVector(), 50.0f, 30.0f);
+
+   grid.assign();
+
+   EXPECT_EQ(grid.getLightClusterCount(0), 0) << "Light behind the camera";
+   EXPECT_GT(grid.getLightClusterCount(1), 0) << "Light in the middle of the view";
+   EXPECT_LT(grid.getLightClusterCount(1), 20) << "A small light should only touch a few clusters";
+   EXPECT_EQ(grid.getLightClusterCount(2), 0) << "Light beyond the far plane";
+   EXPECT_EQ(grid.getLightClusterCount(3), 0) << "Spot light facing away from the view";
+}
+
+TEST_FIX(LightClusterGrid, Parallel)
+{
+   const bool oldParallel = LightClusterGrid::smParallel;
+   const U32 oldMinLights = LightClusterGrid::smParallelMinLights;
+
+   LightClusterGrid serial, parallel;
+   serial.setFrustum(frustum);
+   parallel.setFrustum(frustum);
+   addLights(serial, 1000, 4);
+   addLights(parallel, 1000, 4);
+
+   LightClusterGrid::smParallel = false;
+   serial.assign();
+
+   LightClusterGrid::smParallel = true;
+   LightClusterGrid::smParallelMinLights = 1;
+   parallel.assign();
+
+   LightClusterGrid::smParallel = oldParallel;
+   LightClusterGrid::smParallelMinLights = oldMinLights;
+
+   ASSERT_EQ(serial.getLightIndices().size(), parallel.getLightIndices().size());
+   for (U32 i = 0; i < serial.getLightIndices().size(); i++)
+      EXPECT_EQ(serial.getLightIndices()[i], parallel.getLightIndices()[i]);
+   for (U32 i = 0; i < serial.getNumClusters(); i++)
+      EXPECT_EQ(serial.getClusters()[i].count, parallel.getClusters()[i].count);
+}
+
+#endif // TORQUE_ADVANCED_LIGHTING
@@ -0,0 +1,153 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "scene/culling/sceneOcclusionBuffer.h"
+#include "math/util/frustum.h"
+
+FIXTURE(SceneOcclusionBuffer)
+{
+public:
+   Frustum frustum;
+   SceneOcclusionBuffer buffer;
+
+   void SetUp() override
+   {
+      // Camera at the origin looking down +Y.
+      frustum.set(false, M_HALFPI_F, 1.0f, 0.1f, 500.0f, MatrixF(true));
+      buffer.setup(frustum);
+   }
+
+   void addTriangle(const Point3F &a, const Point3F &b, const Point3F &c)
+   {
+      const Point3F points[] = { a, b, c };
+      buffer.rasterizeTriangles(MatrixF(true), points, 3);
+   }
+
+   /// A wall facing the camera, 10 units ahead.  It is a single triangle
+   /// since pixels on an edge shared by two triangles are never written.
+   /// It covers the square from -5 to 5 in x and z.
+   void addWall()
+   {
+      addTriangle(Point3F(-15.0f, 10.0f, -5.0f), Point3F(15.0f, 10.0f, -5.0f), Point3F(0.0f, 10.0f, 10.0f));
+      buffer.updateTiles();
+   }
+};
+
+TEST_FIX(SceneOcclusionBuffer, Empty)
+{
+   buffer.updateTiles();
+   EXPECT_FALSE(buffer.hasOccluders());
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, 20, -1), Point3F(1, 22, 1))));
+}
+
+TEST_FIX(SceneOcclusionBuffer, BehindWall)
+{
+   addWall();
+   ASSERT_TRUE(buffer.hasOccluders());
+
+   EXPECT_TRUE(buffer.isOccluded(Box3F(Point3F(-1, 20, -1), Point3F(1, 22, 1))));
+   EXPECT_TRUE(buffer.isOccluded(Box3F(Point3F(-4, 11, -4), Point3F(4, 100, 4))))
+      << "Everything inside the wall's silhouette is hidden";
+
+   // Slightly smaller than the wall's silhouette at this distance
+   // but more than a pixel off the edge.
+   EXPECT_TRUE(buffer.isOccluded(Box3F(Point3F(-9, 20, -9), Point3F(9, 20.5f, 9))));
+}
+
+TEST_FIX(SceneOcclusionBuffer, PartlyOutside)
+{
+   addWall();
+
+   // Sticks out to the side of the wall.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(4, 20, -1), Point3F(24, 22, 1))));
+
+   // Sticks out below the wall.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, 20, -12), Point3F(1, 22, -4))));
+
+   // Larger than the wall's silhouette.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-11, 20, -11), Point3F(11, 20.5f, 11))));
+}
+
+TEST_FIX(SceneOcclusionBuffer, InFront)
+{
+   addWall();
+
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, 5, -1), Point3F(1, 6, 1))));
+
+   // Pierces the wall.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, 9, -1), Point3F(1, 11, 1))));
+
+   // Reaches behind the camera.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, -1, -1), Point3F(1, 30, 1))));
+}
+
+TEST_FIX(SceneOcclusionBuffer, NearPlaneClipping)
+{
+   // A slope rising away from the camera, y = z + 5, that starts behind
+   // it.  Without clipping, the corners behind the camera project to the
+   // wrong side of the screen.
+   addTriangle(Point3F(-40.0f, -15.0f, -20.0f), Point3F(40.0f, -15.0f, -20.0f), Point3F(0.0f, 35.0f, 30.0f));
+   buffer.updateTiles();
+   ASSERT_TRUE(buffer.hasOccluders());
+
+   // Behind the slope straight ahead, where it is at y = 5.
+   EXPECT_TRUE(buffer.isOccluded(Box3F(Point3F(-0.5f, 15, -0.5f), Point3F(0.5f, 16, 0.5f))));
+
+   // Between the camera and the slope.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-0.5f, 1, -0.5f), Point3F(0.5f, 2, 0.5f))));
+
+   // Above the slope, which is at y = 17 there.
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-0.5f, 15, 12), Point3F(0.5f, 16, 13))));
+}
+
+TEST_FIX(SceneOcclusionBuffer, BehindCamera)
+{
+   // Entirely behind the near plane; nothing to rasterize.
+   addTriangle(Point3F(-15.0f, -10.0f, -5.0f), Point3F(15.0f, -10.0f, -5.0f), Point3F(0.0f, -10.0f, 10.0f));
+   buffer.updateTiles();
+   EXPECT_FALSE(buffer.hasOccluders());
+}
+
+TEST_FIX(SceneOcclusionBuffer, DegenerateTriangles)
+{
+   const Point3F points[] =
+   {
+      // Collinear.
+      Point3F(-5.0f, 10.0f, 0.0f), Point3F(0.0f, 10.0f, 0.0f), Point3F(5.0f, 10.0f, 0.0f),
+      // All in one point.
+      Point3F(1.0f, 10.0f, 1.0f), Point3F(1.0f, 10.0f, 1.0f), Point3F(1.0f, 10.0f, 1.0f),
+      // Edge on to the camera.
+      Point3F(0.0f, 10.0f, -5.0f), Point3F(0.0f, 20.0f, -5.0f), Point3F(0.0f, 15.0f, 5.0f),
+   };
+   buffer.rasterizeTriangles(MatrixF(true), points, 9);
+   buffer.updateTiles();
+
+   EXPECT_FALSE(buffer.hasOccluders());
+   EXPECT_FALSE(buffer.isOccluded(Box3F(Point3F(-1, 30, -1), Point3F(1, 32, 1))));
+
+   // A trailing partial triangle is ignored.
+   addWall();
+   buffer.rasterizeTriangles(MatrixF(true), points, 2);
+   buffer.updateTiles();
+   EXPECT_TRUE(buffer.isOccluded(Box3F(Point3F(-1, 20, -1), Point3F(1, 22, 1))));
+}
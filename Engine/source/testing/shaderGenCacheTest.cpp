@@ -0,0 +1,216 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2012 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "shaderGen/shaderGen.h"
+#include "core/memVolume.h"
+#include "core/stream/fileStream.h"
+#include "core/frameAllocator.h"
+
+// These run on the null device, which has no shader generator, so the
+// fixture sets up the cache path that initShaderGen() would.
+
+FIXTURE(ShaderGenCache)
+{
+protected:
+   Torque::FS::FileSystemRef mMemFS;
+   bool mSkipped;
+
+   void SetUp() override
+   {
+      ShaderGen *gen = SHADERGEN;
+      mSkipped = gen->mInit;
+      if ( mSkipped )
+         GTEST_SKIP() << "Only runs without a shader generator";
+
+      mMemFS = new Torque::Mem::MemFileSystem( "shadergen:/" );
+      Torque::FS::Mount( "shadergen", mMemFS );
+
+      gen->mInit = true;
+      gen->mShaderCachePersistent = true;
+      gen->mShaderCache.clear();
+   }
+
+   void TearDown() override
+   {
+      if ( mSkipped )
+         return;
+
+      ShaderGen *gen = SHADERGEN;
+      gen->mShaderCache.clear();
+      gen->mPrewarmQueue.clear();
+      gen->mPrewarmQueued = false;
+      gen->mShaderCacheDirty = false;
+      gen->mShaderCachePersistent = false;
+      gen->mInit = false;
+
+      Torque::FS::Unmount( mMemFS );
+   }
+
+   static void addEntry( const String &cacheKey, const char *feature, const char *material )
+   {
+      ShaderGen::ShaderCacheEntry entry;
+
+      ShaderGen::CachedFeature cachedFeature;
+      cachedFeature.name = feature;
+      cachedFeature.index = 2;
+      entry.features.push_back( cachedFeature );
+
+      ShaderGen::CachedVertexElement element;
+      element.semantic = "POSITION";
+      element.type = GFXDeclType_Float3;
+      element.semanticIndex = 0;
+      element.streamIndex = 0;
+      entry.vertexElements.push_back( element );
+
+      entry.macros.push_back( GFXShaderMacro( "SHADERGEN_TEST", "1" ) );
+      entry.samplers.push_back( "$diffuseMap" );
+      if ( material )
+         entry.materials.push_back( material );
+      entry.featureSignature = 0x1234;
+
+      SHADERGEN->mShaderCache[ cacheKey ] = entry;
+      SHADERGEN->mShaderCacheDirty = true;
+   }
+
+   static bool save() { return SHADERGEN->saveShaderCache(); }
+   static bool load() { return SHADERGEN->_loadShaderCache(); }
+   static U32 getNumEntries() { return SHADERGEN->mShaderCache.size(); }
+   static void clearEntries() { SHADERGEN->mShaderCache.clear(); }
+
+   static const ShaderGen::ShaderCacheEntry* findEntry( const String &cacheKey )
+   {
+      ShaderGen::ShaderCacheMap::Iterator iter = SHADERGEN->mShaderCache.find( cacheKey );
+      return iter != SHADERGEN->mShaderCache.end() ? &iter->value : NULL;
+   }
+
+   static void writeSource( const String &cacheKey, const char *stage, const char *source )
+   {
+      FileStream stream;
+      stream.open( SHADERGEN->_getShaderFilePath( cacheKey, stage ), Torque::FS::File::Write );
+      stream.write( dStrlen( source ), source );
+   }
+
+   /// Records the source files of an entry as generated.
+   static void recordSource( const String &cacheKey )
+   {
+      ShaderGen::ShaderCacheEntry &entry = SHADERGEN->mShaderCache[ cacheKey ];
+      entry.vertChecksum = Torque::FS::GetFileNode( SHADERGEN->_getShaderFilePath( cacheKey, "V" ) )->getChecksum();
+      entry.pixChecksum = Torque::FS::GetFileNode( SHADERGEN->_getShaderFilePath( cacheKey, "P" ) )->getChecksum();
+   }
+
+   static bool isSourceCached( const String &cacheKey )
+   {
+      const ShaderGen::ShaderCacheEntry *entry = findEntry( cacheKey );
+      return entry && SHADERGEN->_isSourceCached( cacheKey, *entry, entry->featureSignature );
+   }
+};
+
+TEST_FIX(ShaderGenCache, SaveAndLoad)
+{
+   // Long enough for the two byte string length.
+   String longKey( "ShaderGenTest" );
+   while ( longKey.length() < 300 )
+      longKey += "x";
+   addEntry( "ShaderGenTestA", "ShaderGenTestFeature", NULL );
+   addEntry( longKey, "ShaderGenTestFeature", "ShaderGenTestMaterial" );
+   ASSERT_TRUE( save() );
+
+   clearEntries();
+
+   const U32 waterMark = FrameAllocator::getWaterMark();
+   ASSERT_TRUE( load() );
+   EXPECT_EQ( FrameAllocator::getWaterMark(), waterMark ) << "Loading shouldn't leave anything on the frame allocator";
+
+   EXPECT_EQ( getNumEntries(), 2 );
+   const ShaderGen::ShaderCacheEntry *entry = findEntry( longKey );
+   ASSERT_TRUE( entry != NULL );
+   ASSERT_EQ( entry->features.size(), 1 );
+   EXPECT_TRUE( entry->features[0].name.equal( "ShaderGenTestFeature" ) );
+   EXPECT_EQ( entry->features[0].index, 2 );
+   ASSERT_EQ( entry->vertexElements.size(), 1 );
+   EXPECT_TRUE( entry->vertexElements[0].semantic.equal( "POSITION" ) );
+   ASSERT_EQ( entry->macros.size(), 1 );
+   EXPECT_TRUE( entry->macros[0].name.equal( "SHADERGEN_TEST" ) );
+   ASSERT_EQ( entry->materials.size(), 1 );
+   EXPECT_TRUE( entry->materials[0].equal( "ShaderGenTestMaterial" ) );
+   EXPECT_EQ( entry->featureSignature, 0x1234 );
+}
+
+TEST_FIX(ShaderGenCache, Truncated)
+{
+   addEntry( "ShaderGenTestA", "ShaderGenTestFeature", NULL );
+   addEntry( "ShaderGenTestB", "ShaderGenTestFeature", NULL );
+   ASSERT_TRUE( save() );
+
+   // Cut the manifest off in the middle of the last entry.
+   FileStream stream;
+   ASSERT_TRUE( stream.open( "shadergen:/shaderCache.manifest", Torque::FS::File::Read ) );
+   const U32 size = stream.getStreamSize();
+   FrameTemp<U8> data( size );
+   ASSERT_TRUE( stream.read( size, data.address() ) );
+   stream.close();
+   ASSERT_TRUE( stream.open( "shadergen:/shaderCache.manifest", Torque::FS::File::Write ) );
+   stream.write( size - 10, data.address() );
+   stream.close();
+
+   const U32 waterMark = FrameAllocator::getWaterMark();
+   EXPECT_FALSE( load() );
+   EXPECT_EQ( FrameAllocator::getWaterMark(), waterMark );
+   EXPECT_EQ( getNumEntries(), 0 );
+}
+
+TEST_FIX(ShaderGenCache, Prewarm)
+{
+   // The features of this one don't exist, so pre-warming drops it.
+   addEntry( "ShaderGenTestA", "ShaderGenTestFeature", NULL );
+
+   // This one is left alone as its material isn't loaded.
+   addEntry( "ShaderGenTestB", "ShaderGenTestFeature", "ShaderGenTestNoSuchMaterial" );
+   ASSERT_TRUE( save() );
+
+   clearEntries();
+   ASSERT_TRUE( load() );
+
+   EXPECT_EQ( SHADERGEN->prewarmShaders(), 0 );
+   EXPECT_EQ( getNumEntries(), 1 );
+   EXPECT_TRUE( findEntry( "ShaderGenTestA" ) == NULL );
+   EXPECT_TRUE( findEntry( "ShaderGenTestB" ) != NULL );
+}
+
+TEST_FIX(ShaderGenCache, ChangedSource)
+{
+   addEntry( "ShaderGenTestA", "ShaderGenTestFeature", NULL );
+   writeSource( "ShaderGenTestA", "V", "void main() { vert(); }" );
+   writeSource( "ShaderGenTestA", "P", "void main() { pix1(); }" );
+   recordSource( "ShaderGenTestA" );
+   ASSERT_TRUE( save() );
+
+   clearEntries();
+   ASSERT_TRUE( load() );
+   EXPECT_TRUE( isSourceCached( "ShaderGenTestA" ) );
+
+   // Different code of the same size, like a feature that changed
+   // what it generates, must not be reused.
+   writeSource( "ShaderGenTestA", "P", "void main() { pix2(); }" );
+   EXPECT_FALSE( isSourceCached( "ShaderGenTestA" ) );
+}
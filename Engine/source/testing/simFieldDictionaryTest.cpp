@@ -0,0 +1,131 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "console/simFieldDictionary.h"
+#include "console/consoleTypes.h"
+#include "core/strings/stringFunctions.h"
+
+FIXTURE(SimFieldDictionary)
+{
+public:
+   static StringTableEntry fieldName(U32 i)
+   {
+      char name[32];
+      dSprintf(name, sizeof(name), "sfdTestField%d", i);
+      return StringTable->insert(name);
+   }
+
+   static U32 countFields(SimFieldDictionary &dict)
+   {
+      U32 count = 0;
+      for (SimFieldDictionaryIterator itr(&dict); *itr; ++itr)
+         count++;
+      return count;
+   }
+};
+
+TEST_FIX(SimFieldDictionary, SetGetRemove)
+{
+   SimFieldDictionary dict;
+   EXPECT_EQ(dict.getFieldValue(fieldName(0)), (const char*)NULL);
+
+   // Enough fields to make the table grow a few times.
+   for (U32 i = 0; i < 200; i++)
+      dict.setFieldValue(fieldName(i), avar("%d", i));
+
+   EXPECT_EQ(dict.getNumFields(), 200);
+   EXPECT_EQ(countFields(dict), 200);
+
+   for (U32 i = 0; i < 200; i++)
+      EXPECT_STREQ(dict.getFieldValue(fieldName(i)), avar("%d", i));
+
+   // Remove every third field; the ones left must still be found.
+   for (U32 i = 0; i < 200; i += 3)
+      dict.setFieldValue(fieldName(i), "");
+
+   for (U32 i = 0; i < 200; i++)
+   {
+      if (i % 3 == 0)
+         EXPECT_EQ(dict.findDynamicField(fieldName(i)), (SimFieldDictionary::Entry*)NULL) << "field " << i;
+      else
+         EXPECT_STREQ(dict.getFieldValue(fieldName(i)), avar("%d", i)) << "field " << i;
+   }
+
+   EXPECT_EQ(dict.getNumFields(), 133);
+   EXPECT_EQ(countFields(dict), 133);
+}
+
+TEST_FIX(SimFieldDictionary, Values)
+{
+   SimFieldDictionary dict;
+   StringTableEntry name = fieldName(0);
+
+   dict.setFieldValue(name, "short");
+   SimFieldDictionary::Entry *entry = dict.findDynamicField(name);
+   ASSERT_TRUE(entry != NULL);
+   EXPECT_TRUE(entry->isValueInline());
+
+   const char *longValue = "a value that is much too long to be stored in the entry";
+   dict.setFieldValue(name, longValue);
+   EXPECT_FALSE(entry->isValueInline());
+   EXPECT_STREQ(entry->value, longValue);
+
+   // Setting a value from part of the old one.
+   dict.setFieldValue(name, entry->value + 2);
+   EXPECT_STREQ(entry->value, longValue + 2);
+   dict.setFieldValue(name, entry->value + dStrlen(entry->value) - 5);
+   EXPECT_TRUE(entry->isValueInline());
+   EXPECT_STREQ(entry->value, "entry");
+   dict.setFieldValue(name, entry->value);
+   EXPECT_STREQ(entry->value, "entry");
+
+   // Entries don't move when other fields are added.
+   for (U32 i = 1; i < 100; i++)
+      dict.setFieldValue(fieldName(i), "1");
+   EXPECT_EQ(dict.findDynamicField(name), entry);
+   EXPECT_STREQ(dict.findDynamicField(String("SFDTESTFIELD0"))->value, "entry");
+
+   // Looking up a name that was never used doesn't add it to the string table.
+   EXPECT_EQ(dict.findDynamicField(String("sfdTestNeverAField")), (SimFieldDictionary::Entry*)NULL);
+   EXPECT_EQ(StringTable->lookup("sfdTestNeverAField"), (StringTableEntry)NULL);
+}
+
+TEST_FIX(SimFieldDictionary, Types)
+{
+   SimFieldDictionary dict;
+   StringTableEntry name = fieldName(0);
+
+   EXPECT_EQ(dict.getFieldType(name), TypeString);
+
+   dict.setFieldType(name, TypeF32);
+   EXPECT_EQ(dict.getNumFields(), 1) << "Setting the type should add the field";
+   EXPECT_EQ(dict.getFieldType(name), TypeF32);
+
+   dict.setFieldValue(name, "1.5");
+   EXPECT_EQ(dict.getFieldType(name), TypeF32);
+
+   SimFieldDictionary copy;
+   copy.assignFrom(&dict);
+   EXPECT_EQ(copy.getFieldType(name), TypeF32);
+   EXPECT_STREQ(copy.getFieldValue(name), "1.5");
+}
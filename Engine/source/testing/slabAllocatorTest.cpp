@@ -0,0 +1,148 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "platform/platformMemory.h"
+#include "platform/threads/thread.h"
+#include "core/util/tVector.h"
+
+FIXTURE(SlabAllocator)
+{
+public:
+   /// Allocates, fills, checks and frees blocks of all sizes, keeping a
+   /// bunch alive at a time so blocks go through the caches in every way.
+   static bool churn(U32 seed, U32 count)
+   {
+      const U32 PoolSize = 256;
+      U8* pool[PoolSize] = {};
+      U32 sizes[PoolSize] = {};
+      bool ok = true;
+
+      U32 random = seed;
+      for (U32 i = 0; i < count; i++)
+      {
+         random = random * 1664525 + 1013904223;
+         const U32 index = (random >> 8) % PoolSize;
+
+         if (pool[index])
+         {
+            for (U32 n = 0; n < sizes[index]; n++)
+               ok &= pool[index][n] == U8(index + seed);
+            Memory::slabFree(pool[index]);
+         }
+
+         sizes[index] = (random >> 16) % ((random & 1) ? 256 : 40000);
+         pool[index] = (U8*)Memory::slabAlloc(sizes[index]);
+         ok &= pool[index] != NULL && (uintptr_t(pool[index]) & 0xF) == 0;
+         dMemset(pool[index], U8(index + seed), sizes[index]);
+      }
+
+      for (U32 i = 0; i < PoolSize; i++)
+         Memory::slabFree(pool[i]);
+
+      return ok;
+   }
+
+   struct ChurnThread : public Thread
+   {
+      U32 mSeed;
+      bool mResult;
+      ChurnThread(U32 seed)
+         : mSeed(seed), mResult(false) {}
+
+      void run(void*) override
+      {
+         mResult = churn(mSeed, 20000);
+      }
+   };
+};
+
+TEST_FIX(SlabAllocator, AllocFree)
+{
+   EXPECT_TRUE(churn(1, 20000)) << "Block contents got overwritten.";
+}
+
+TEST_FIX(SlabAllocator, Realloc)
+{
+   // Grow through every size class and into the system heap and back.
+   U8* mem = NULL;
+   U32 size = 0;
+   for (U32 newSize = 1; newSize < 100000; newSize = newSize * 3 / 2 + 1)
+   {
+      mem = (U8*)Memory::slabRealloc(mem, newSize);
+      ASSERT_TRUE(mem != NULL);
+      for (U32 i = 0; i < size; i++)
+         ASSERT_EQ(mem[i], U8(i)) << "Contents lost growing to " << newSize << " bytes.";
+      for (U32 i = size; i < newSize; i++)
+         mem[i] = U8(i);
+      size = newSize;
+   }
+
+   mem = (U8*)Memory::slabRealloc(mem, 100);
+   for (U32 i = 0; i < 100; i++)
+      EXPECT_EQ(mem[i], U8(i)) << "Contents lost shrinking.";
+
+   EXPECT_TRUE(Memory::slabRealloc(mem, 0) == NULL);
+}
+
+TEST_FIX(SlabAllocator, Tags)
+{
+   const S64 gfxBefore = Memory::getTagBytes(Memory::TAG_Gfx);
+   const S64 netBefore = Memory::getTagBytes(Memory::TAG_Net);
+
+   void* gfx = Memory::slabAlloc(1000, "Engine/source/gfx/gfxDevice.cpp");
+   void* net = Memory::slabAlloc(3000, "Engine\\source\\sim\\netConnection.cpp");
+   void* general = Memory::slabAlloc(5000, "Engine/source/T3D/assets/foo.cpp");
+
+   EXPECT_EQ(Memory::getTagBytes(Memory::TAG_Gfx) - gfxBefore, 1000);
+   EXPECT_EQ(Memory::getTagBytes(Memory::TAG_Net) - netBefore, 3000);
+
+   gfx = Memory::slabRealloc(gfx, 2000);
+   EXPECT_EQ(Memory::getTagBytes(Memory::TAG_Gfx) - gfxBefore, 2000)
+      << "Realloc should keep the block's tag.";
+
+   Memory::slabFree(gfx);
+   Memory::slabFree(net);
+   Memory::slabFree(general);
+
+   EXPECT_EQ(Memory::getTagBytes(Memory::TAG_Gfx), gfxBefore);
+   EXPECT_EQ(Memory::getTagBytes(Memory::TAG_Net), netBefore);
+}
+
+TEST_FIX(SlabAllocator, Concurrent)
+{
+   const U32 NumThreads = 4;
+
+   Vector<ChurnThread*> threads;
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      threads.push_back(new ChurnThread(i + 2));
+      threads.last()->start();
+   }
+
+   for (U32 i = 0; i < NumThreads; i++)
+   {
+      threads[i]->join();
+      EXPECT_TRUE(threads[i]->mResult) << "Block contents got overwritten on thread " << i;
+      delete threads[i];
+   }
+}
@@ -0,0 +1,140 @@
+//-----------------------------------------------------------------------------
+// Copyright (c) 2014 GarageGames, LLC
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to
+// deal in the Software without restriction, including without limitation the
+// rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+// sell copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+// FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+// IN THE SOFTWARE.
+//-----------------------------------------------------------------------------
+
+#include "testing/unitTesting.h"
+#include "platform/platform.h"
+#include "platform/threads/threadPool.h"
+#include "core/util/zip/zipVolume.h"
+#include "core/fileio.h"
+#include "core/util/tVector.h"
+
+FIXTURE(ZipVolume)
+{
+public:
+   static const U32 NUM_FILES = 16;
+
+   String mZipName;
+
+   /// Contents of the files in the zip.  Repetitive enough to be deflated
+   /// and different per file so mixed up reads are caught.
+   static String makeContents(U32 index)
+   {
+      String contents;
+      for (U32 i = 0; i < 200 + index * 50; i++)
+         contents += String::ToString("file %d line %d of some compressible text\n", index, i);
+      return contents;
+   }
+
+   static String makeName(U32 index)
+   {
+      return String::ToString("folder%d/file%d.txt", index % 3, index);
+   }
+
+   void SetUp() override
+   {
+      mZipName = "zipVolumeTest.zip";
+
+      Zip::ZipArchive* zip = new Zip::ZipArchive;
+      ASSERT_TRUE(zip->openArchive(mZipName, Zip::ZipArchive::Write));
+      for (U32 i = 0; i < NUM_FILES; i++)
+      {
+         Stream* stream = zip->openFile(makeName(i), Zip::ZipArchive::Write);
+         ASSERT_TRUE(stream != NULL);
+
+         const String contents = makeContents(i);
+         stream->write(contents.length(), contents.c_str());
+         zip->closeFile(stream);
+      }
+      zip->closeArchive();
+      delete zip;
+   }
+
+   void TearDown() override
+   {
+      dFileDelete(mZipName);
+   }
+
+   /// Reads one file on a worker thread and checks what comes out.
+   struct ReadItem : public ThreadPool::WorkItem
+   {
+      Torque::FS::FileNode* mNode;
+      const String& mExpected;
+      bool& mResult;
+
+      ReadItem(Torque::FS::FileNode* node, const String& expected, bool& result)
+         : mNode(node), mExpected(expected), mResult(result) {}
+
+   protected:
+      void execute() override
+      {
+         Torque::FS::File* file = dynamic_cast<Torque::FS::File*>(mNode);
+
+         Vector<char> buffer;
+         buffer.setSize(mExpected.length());
+         mResult = file && file->open(Torque::FS::File::Read)
+            && file->read(buffer.address(), buffer.size()) == mExpected.length()
+            && dMemcmp(buffer.address(), mExpected.c_str(), mExpected.length()) == 0;
+      }
+   };
+};
+
+TEST_FIX(ZipVolume, Lookup)
+{
+   Torque::ZipFileSystem fs(mZipName);
+
+   EXPECT_TRUE(fs.resolve(Torque::Path("folder1/file4.txt")) != NULL);
+   EXPECT_TRUE(fs.resolve(Torque::Path("folder2")) != NULL)
+      << "Directories should be found as well as files.";
+   EXPECT_TRUE(fs.resolve(Torque::Path("folder1/file5.txt")) == NULL)
+      << "file5.txt is in folder2.";
+   EXPECT_TRUE(fs.resolve(Torque::Path("doesNotExist.txt")) == NULL);
+}
+
+TEST_FIX(ZipVolume, ConcurrentReads)
+{
+   Torque::ZipFileSystem fs(mZipName);
+   EXPECT_TRUE(fs.isMapped()) << "A zip on disk should be memory mapped.";
+
+   // Open everything first, then read all the files at the same time.  The
+   // nodes stay referenced here as their reference counts aren't thread safe.
+   Vector<Torque::FS::FileNodeRef> nodes;
+   Vector<String> contents;
+   for (U32 i = 0; i < NUM_FILES; i++)
+   {
+      contents.push_back(makeContents(i));
+      nodes.push_back(fs.resolve(Torque::Path(makeName(i))));
+      ASSERT_TRUE(nodes.last() != NULL) << makeName(i).c_str();
+   }
+
+   bool results[NUM_FILES];
+   ThreadPool* pool = &ThreadPool::GLOBAL();
+   for (U32 i = 0; i < NUM_FILES; i++)
+   {
+      results[i] = false;
+      ThreadSafeRef<ReadItem> item(new ReadItem(nodes[i].getPointer(), contents[i], results[i]));
+      pool->queueWorkItem(item);
+   }
+   pool->waitForAllItems();
+
+   for (U32 i = 0; i < NUM_FILES; i++)
+      EXPECT_TRUE(results[i]) << "Wrong contents read from " << makeName(i).c_str();
+}
@@ -1269,37 +1269,24 @@ bool TSMesh::buildConvexOpcode( const MatrixF &meshToObjectMat, const Box3F &nod
    Opcode::VertexPointers vp;
    for ( S32 i = 0; i < cnt; i++ )
    {
-      // First, check our active convexes for a potential match (and clean things
-      // up, too.)
       const U32 curIdx = idx[i];
 
-      // See if the square already exists as part of the working set.
-      bool gotMatch = false;
-      CollisionWorkingList& wl = convex->getWorkingList();
-      for ( CollisionWorkingList* itr = wl.wLink.mNext; itr != &wl; itr = itr->wLink.mNext )
+      // See if the triangle already has a convex built by a previous query
+      // against this shape.  If it's already on the working list there is
+      // nothing to do, otherwise the cached convex can simply be relinked.
+      TSStaticPolysoupConvex::Cache *cache = TSStaticPolysoupConvex::smCurCache;
+      if ( cache )
       {
-         if( itr->mConvex->getType() != TSPolysoupConvexType )
-            continue;
-
-         const TSStaticPolysoupConvex *chunkc = static_cast<TSStaticPolysoupConvex*>( itr->mConvex );
-
-         if( chunkc->getObject() != TSStaticPolysoupConvex::smCurObject )
-            continue;
-               
-         if( chunkc->mesh != this )
-            continue;
-
-         if( chunkc->idx != curIdx )
+         TSStaticPolysoupConvex::Cache::Iterator found = cache->find( TSStaticPolysoupConvex::CacheKey( this, curIdx ) );
+         if ( found != cache->end() )
+         {
+            TSStaticPolysoupConvex *cached = found->value;
+            if ( !cached->isOnCurrentWorkingList() )
+               convex->addToWorkingList( cached );
             continue;
-
-         // A match! Don't need to add it.
-         gotMatch = true;
-         break;
+         }
       }
 
-      if( gotMatch )
-         continue;
-
       // Get the triangle...
       mOptTree->GetMeshInterface()->GetTriangle( vp, idx[i] );
 
@@ -1325,6 +1312,12 @@ bool TSMesh::buildConvexOpcode( const MatrixF &meshToObjectMat, const Box3F &nod
       cp->idx     = curIdx;
       cp->mObject = TSStaticPolysoupConvex::smCurObject;
 
+      if ( cache )
+      {
+         cp->mCache = cache;
+         cache->insertUnique( TSStaticPolysoupConvex::CacheKey( this, curIdx ), cp );
+      }
+
       cp->normal = p;
       cp->verts[0] = a;
       cp->verts[1] = b;
@@ -34,6 +34,7 @@
 #include "math/mMath.h"
 #include "math/mathIO.h"
 #include "math/mathUtils.h"
+#include "math/mMathBatch.h"
 #include "console/console.h"
 #include "scene/sceneObject.h"
 #include "core/bitRender.h"
@@ -1283,7 +1284,25 @@ void TSSkinMesh::updateSkinBuffer( const Vector<MatrixF> &transforms, U8* buffer
 void TSSkinMesh::updateSkinBones( const Vector<MatrixF> &transforms, Vector<MatrixF>& destTransforms )
 {
    // Update transforms for current mesh
-   destTransforms.setSize(batchData.nodeIndex.size());
+   const U32 numBones = batchData.nodeIndex.size();
+   destTransforms.setSize(numBones);
+
+   bool allValid = true;
+   for (U32 i = 0; i < numBones; i++)
+   {
+      if (batchData.nodeIndex[i] >= transforms.size())
+      {
+         allValid = false;
+         break;
+      }
+   }
+
+   // Multiply all the bones in one go when we can.
+   if (allValid && numBones > 0)
+   {
+      m_matF_x_matF_batch(*transforms.address(), batchData.nodeIndex.address(), *batchData.initialTransforms.address(), *destTransforms.address(), numBones);
+      return;
+   }
 
    for (int i = 0; i<batchData.nodeIndex.size(); i++)
    {
@@ -29,6 +29,7 @@ mark_as_advanced(WIN32)
 #general
 advanced_option(TORQUE_MULTITHREAD "Multi Threading" ON)
 advanced_option(TORQUE_DISABLE_MEMORY_MANAGER "Disable memory manager" ON)
+advanced_option(TORQUE_SLAB_ALLOCATOR "Use the thread caching slab allocator for dMalloc when the memory manager is disabled" OFF)
 set(TORQUE_ENTRY_FUNCTION "" CACHE STRING "Specify a console function to execute instead of looking for a main.tscript file")
 mark_as_advanced(TORQUE_ENTRY_FUNCTION)
 